@@ -0,0 +1 @@
+../../../../mule_local/python/postprocessing/PerformanceBaseline.py
\ No newline at end of file
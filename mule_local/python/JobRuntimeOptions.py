@@ -42,11 +42,18 @@ class JobRuntimeOptions(InfoError):
 
         self.semi_lagrangian_max_iterations = None
         self.semi_lagrangian_convergence_threshold = None
+        self.semi_lagrangian_fused_departure_points = None
 
         self.timestep_size = None
         self.max_timesteps_nr = -1
 
         self.normal_mode_analysis = None
+        self.normal_mode_analysis_num_modes = None
+        self.normal_mode_analysis_krylov_dim = None
+        self.normal_mode_analysis_tolerance = None
+
+        self.performance_counters = None
+        self.performance_counters_raw_event = None
 
         #
         # REXI method:
@@ -61,6 +68,12 @@ class JobRuntimeOptions(InfoError):
         # Generic REXI parameters
         self.rexi_sphere_preallocation = 0
 
+        # Directory of REXI coefficient cache shared across runs
+        self.rexi_coefficients_cache = None
+
+        # Merge conjugate pole/weight pairs of REXI coefficients
+        self.rexi_conjugate_pairs = None
+
         # List of REXI Coefficients
         self.rexi_files_coefficients = []
 
@@ -132,6 +145,12 @@ class JobRuntimeOptions(InfoError):
         self.max_simulation_time = 0.001
         self.max_wallclock_time = -1
 
+        self.ensemble_size = None
+        self.ensemble_perturbation = None
+
+        self.sweep_file = None
+        self.sweep_parallel = None
+
         self.compute_error = 0
 
         self.reuse_plans = "quick"
@@ -154,6 +173,11 @@ class JobRuntimeOptions(InfoError):
         self.parareal_store_iterations = 1;
         self.parareal_spatial_coarsening = None;
         self.parareal_max_iter = None;
+        self.parareal_slice_distribution = None;
+        self.parareal_thread_groups = None;
+        self.parareal_coarse_fidelity_levels = None;
+        self.parareal_coarse_fidelity_switch_factor = None;
+        self.parareal_coarse_fidelity_max_rate = None;
 
 
         ## XBraid parameters
@@ -191,6 +215,10 @@ class JobRuntimeOptions(InfoError):
         self.xbraid_path_fine_csv_files = None;
         self.xbraid_store_iterations = None;
         self.xbraid_spatial_coarsening = None;
+        self.xbraid_thread_groups = None;
+        self.xbraid_coarse_fidelity_levels = None;
+        self.xbraid_coarse_fidelity_switch_factor = None;
+        self.xbraid_coarse_fidelity_max_rate = None;
 
         #
         # User defined parameters
@@ -355,6 +383,13 @@ class JobRuntimeOptions(InfoError):
             if not 'runtime.max_wallclock_time' in filter_list:
                 idstr += '_W'+str(self.max_wallclock_time).zfill(6)
 
+        if not 'runtime.ensemble' in filter_list:
+            if self.ensemble_size != None:
+                idstr += '_ens'+str(self.ensemble_size).zfill(3)
+
+            if self.ensemble_perturbation != None:
+                idstr += '_ensp'+str("{:0.3e}".format(self.ensemble_perturbation))
+
 
         if not 'runtime.rexi' in filter_list:
             if self.rexi_method != '' and self.rexi_method != None:
@@ -401,6 +436,9 @@ class JobRuntimeOptions(InfoError):
                                     idstr += '_mu'+str(float(self.rexi_ci_mu))
                             idstr += '_pr'+str(self.rexi_ci_primitive)
 
+                    if self.rexi_conjugate_pairs != None:
+                        idstr += '_cp'+str(self.rexi_conjugate_pairs)
+
 
                     #idstr += '_rexithreadpar'+str(1 if self.rexi_thread_par else 0)
 
@@ -482,6 +520,12 @@ class JobRuntimeOptions(InfoError):
                     idstr += '_pSpc_'+str(self.parareal_spatial_coarsening)
                 if not 'runtime.parareal_max_iter' in filter_list:
                     idstr += '_pMaxIter_'+str(self.parareal_max_iter)
+                if not 'runtime.parareal_slice_distribution' in filter_list:
+                    if self.parareal_slice_distribution != None:
+                        idstr += '_pDist_'+str(self.parareal_slice_distribution)
+                if not 'runtime.parareal_thread_groups' in filter_list:
+                    if self.parareal_thread_groups != None:
+                        idstr += '_pTg_'+str(self.parareal_thread_groups)
 
 
         if not 'runtime.xbraid' in filter_list:
@@ -553,6 +597,8 @@ class JobRuntimeOptions(InfoError):
                     idstr += '_xb_store_iterations'+str(self.xbraid_store_iterations)
                 if self.xbraid_spatial_coarsening != None:
                     idstr += '_xb_spc'+str(self.xbraid_spatial_coarsening)
+                if self.xbraid_thread_groups != None:
+                    idstr += '_xb_tg'+str(self.xbraid_thread_groups)
 
         if idstr != '':
             idstr = "RT"+idstr
@@ -642,6 +688,18 @@ class JobRuntimeOptions(InfoError):
 
         retval += ' --max-wallclock-time '+str(self.max_wallclock_time)
 
+        if self.ensemble_size != None:
+            retval += ' --ensemble-size='+str(self.ensemble_size)
+
+        if self.ensemble_perturbation != None:
+            retval += ' --ensemble-perturbation='+str(self.ensemble_perturbation)
+
+        if self.sweep_file != None:
+            retval += ' --sweep-file='+str(self.sweep_file)
+
+        if self.sweep_parallel != None:
+            retval += ' --sweep-parallel='+str(self.sweep_parallel)
+
         if self.instability_checks != None:
             retval += ' --instability-checks='+str(self.instability_checks)
 
@@ -672,9 +730,27 @@ class JobRuntimeOptions(InfoError):
         if self.semi_lagrangian_convergence_threshold != None:
             retval += ' --semi-lagrangian-convergence-threshold='+str(self.semi_lagrangian_convergence_threshold)
 
+        if self.semi_lagrangian_fused_departure_points != None:
+            retval += ' --semi-lagrangian-fused-departure-points='+str(self.semi_lagrangian_fused_departure_points)
+
         if self.normal_mode_analysis != None:
             retval += ' --normal-mode-analysis-generation='+str(self.normal_mode_analysis)
 
+        if self.normal_mode_analysis_num_modes != None:
+            retval += ' --normal-mode-analysis-num-modes='+str(self.normal_mode_analysis_num_modes)
+
+        if self.normal_mode_analysis_krylov_dim != None:
+            retval += ' --normal-mode-analysis-krylov-dim='+str(self.normal_mode_analysis_krylov_dim)
+
+        if self.normal_mode_analysis_tolerance != None:
+            retval += ' --normal-mode-analysis-tolerance='+str(self.normal_mode_analysis_tolerance)
+
+        if self.performance_counters != None:
+            retval += ' --performance-counters='+str(self.performance_counters)
+
+        if self.performance_counters_raw_event != None:
+            retval += ' --performance-counters-raw-event='+str(self.performance_counters_raw_event)
+
         if self.rexi_method != '' and self.rexi_method != None:
             retval += ' --rexi-method='+str(self.rexi_method)
 
@@ -684,6 +760,12 @@ class JobRuntimeOptions(InfoError):
             else:
                 retval += ' --rexi-sphere-preallocation='+str(self.rexi_sphere_preallocation)
 
+                if self.rexi_coefficients_cache != None:
+                    retval += ' --rexi-coefficients-cache='+str(self.rexi_coefficients_cache)
+
+                if self.rexi_conjugate_pairs != None:
+                    retval += ' --rexi-conjugate-pairs='+str(self.rexi_conjugate_pairs)
+
                 if self.rexi_method == 'file':
 
                     if self.p_job_dirpath == None:
@@ -787,6 +869,16 @@ class JobRuntimeOptions(InfoError):
             retval += " --parareal-spatial-coarsening="+str(self.parareal_spatial_coarsening);
             if self.parareal_max_iter != None:
                 retval += " --parareal-max-iter="+str(self.parareal_max_iter);
+            if self.parareal_slice_distribution != None:
+                retval += " --parareal-slice-distribution="+str(self.parareal_slice_distribution);
+            if self.parareal_thread_groups != None:
+                retval += " --parareal-thread-groups="+str(self.parareal_thread_groups);
+            if self.parareal_coarse_fidelity_levels != None:
+                retval += " --parareal-coarse-fidelity-levels="+str(self.parareal_coarse_fidelity_levels);
+            if self.parareal_coarse_fidelity_switch_factor != None:
+                retval += " --parareal-coarse-fidelity-switch-factor="+str(self.parareal_coarse_fidelity_switch_factor);
+            if self.parareal_coarse_fidelity_max_rate != None:
+                retval += " --parareal-coarse-fidelity-max-rate="+str(self.parareal_coarse_fidelity_max_rate);
 
             ##if self.parareal_coarse_timestep_size > 0:
             ##    retval += " --parareal-coarse-timestep-size="+str(self.parareal_coarse_timestep_size);
@@ -829,6 +921,14 @@ class JobRuntimeOptions(InfoError):
             retval += " --xbraid-path-fine-csv-files="+str(self.xbraid_path_fine_csv_files)
             retval += " --xbraid-store-iterations="+str(self.xbraid_store_iterations)
             retval += " --xbraid-spatial-coarsening="+str(self.xbraid_spatial_coarsening)
+            if self.xbraid_thread_groups != None:
+                retval += " --xbraid-thread-groups="+str(self.xbraid_thread_groups)
+            if self.xbraid_coarse_fidelity_levels != None:
+                retval += " --xbraid-coarse-fidelity-levels="+str(self.xbraid_coarse_fidelity_levels)
+            if self.xbraid_coarse_fidelity_switch_factor != None:
+                retval += " --xbraid-coarse-fidelity-switch-factor="+str(self.xbraid_coarse_fidelity_switch_factor)
+            if self.xbraid_coarse_fidelity_max_rate != None:
+                retval += " --xbraid-coarse-fidelity-max-rate="+str(self.xbraid_coarse_fidelity_max_rate)
 
         for key, param in self.user_defined_parameters.items():
             retval += ' '+param['option']+str(param['value'])
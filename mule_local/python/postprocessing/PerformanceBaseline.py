@@ -0,0 +1,258 @@
+#! /usr/bin/env python3
+
+import os
+import re
+import sys
+import json
+import socket
+
+from mule.postprocessing.JobData import *
+
+import glob
+
+
+class PerformanceBaseline:
+
+    # results of compare()
+    PASSED = 'passed'
+    FAILED = 'failed'
+    SKIPPED = 'skipped'
+
+    def __init__(
+            self,
+            jobdir_pattern = None,
+            baseline_dir = None,
+            timing_keys = None,
+            tolerance = None,
+            tolerance_abs = None,
+            verbosity = 0
+        ):
+        """
+        Compare timings of benchmark jobs with a per-machine baseline
+
+        Jobs which only differ in their repetition (same job unique ID)
+        are repetitions of the same configuration. The minimum timing of
+        all repetitions is used to reduce the impact of noise.
+
+        Parameters
+        ----------
+        jobdir_pattern: str
+            pattern to detect job directories
+            Default: './job_bench_*'
+        baseline_dir: str
+            directory with baseline files '[machine_id].json'
+            Default: $SWEET_PERFORMANCE_BASELINE_DIR/[name of current directory]
+            with $SWEET_PERFORMANCE_BASELINE_DIR defaulting to
+            '~/.sweet/performance_baselines'.
+            Baselines are specific to a machine and hence not stored
+            in the repository.
+        timing_keys: list of str
+            output timings to compare (without 'output.' prefix)
+            Default: main_timestepping and breakdown of benchmark timings
+        tolerance: float
+            relative slowdown which is still accepted
+            Default: $SWEET_PERFORMANCE_TOLERANCE or 0.3
+        tolerance_abs: float
+            absolute slowdown in seconds which is always accepted.
+            This avoids failures of very short timing regions due to noise.
+            Default: $SWEET_PERFORMANCE_TOLERANCE_ABS or 0.05
+
+        The baseline is created if it doesn't exist yet for this machine
+        and overwritten if $SWEET_PERFORMANCE_UPDATE_BASELINE=1.
+        Nothing is compared in both cases and the comparison is skipped.
+        """
+
+        if jobdir_pattern == None:
+            jobdir_pattern = './job_bench_*'
+
+        if baseline_dir == None:
+            baseline_root = os.environ.get('SWEET_PERFORMANCE_BASELINE_DIR', '~/.sweet/performance_baselines')
+            baseline_dir = os.path.join(os.path.expanduser(baseline_root), os.path.basename(os.getcwd()))
+
+        if timing_keys == None:
+            timing_keys = [
+                    'simulation_benchmark_timings.main_timestepping',
+                    'simulation_benchmark_timings.main_timestepping_nonlinearities',
+                    'simulation_benchmark_timings.rexi_timestepping',
+                    'simulation_benchmark_timings.rexi_timestepping_solver',
+                    'simulation_benchmark_timings.semi_lagrangian',
+                ]
+
+        if tolerance == None:
+            tolerance = float(os.environ.get('SWEET_PERFORMANCE_TOLERANCE', 0.3))
+
+        if tolerance_abs == None:
+            tolerance_abs = float(os.environ.get('SWEET_PERFORMANCE_TOLERANCE_ABS', 0.05))
+
+        self.jobdir_pattern = jobdir_pattern
+        self.baseline_dir = baseline_dir
+        self.timing_keys = timing_keys
+        self.tolerance = tolerance
+        self.tolerance_abs = tolerance_abs
+        self.verbosity = verbosity
+
+        self.update_baseline = os.environ.get('SWEET_PERFORMANCE_UPDATE_BASELINE', '0') == '1'
+
+        # JobsData would merge the repetitions since they have the same job unique ID
+        self.jobs_data = []
+        for job_dir in sorted(glob.glob(self.jobdir_pattern)):
+            self.jobs_data.append(JobData(job_dir, verbosity=self.verbosity).get_flattened_data())
+
+        if len(self.jobs_data) == 0:
+            raise Exception("No job directories found for '"+self.jobdir_pattern+"'")
+
+        self.timings = self._get_timings()
+
+        self.machine_id = self._get_machine_id()
+        self.baseline_file = self.baseline_dir+'/'+self.machine_id+'.json'
+
+
+    def _get_machine_id(self):
+        """
+        Platform and host name since timings are only comparable on the same machine
+        """
+        platform_id = None
+        for job_data in self.jobs_data:
+            if 'platform_id' in job_data:
+                platform_id = job_data['platform_id']
+                break
+
+        if platform_id == None:
+            platform_id = 'unknown'
+
+        machine_id = str(platform_id)+'_'+socket.gethostname()
+        return re.sub(r'[^a-zA-Z0-9_\-]', '_', machine_id)
+
+
+    def _get_timings(self):
+        """
+        Timings of all jobs
+
+        Returns
+        -------
+        dict: timings[config][timing_key] = seconds
+            with the job unique ID as config and the minimum
+            over all repetitions of this configuration
+        """
+        repetitions = {}
+        for job_data in self.jobs_data:
+            job_dirpath = os.path.basename(os.path.normpath(job_data['jobgeneration.job_dirpath']))
+
+            if 'jobgeneration.job_unique_id' in job_data:
+                config = job_data['jobgeneration.job_unique_id']
+            else:
+                config = job_dirpath
+
+            job_timings = {}
+            for key in self.timing_keys:
+                if 'output.'+key in job_data:
+                    job_timings[key] = float(job_data['output.'+key])
+
+            if len(job_timings) == 0:
+                raise Exception("No timings found for job '"+job_dirpath+"'")
+
+            if config not in repetitions:
+                repetitions[config] = []
+            repetitions[config].append(job_timings)
+
+        self.num_repetitions = {}
+        timings = {}
+        for config, reps in repetitions.items():
+            self.num_repetitions[config] = len(reps)
+
+            timings[config] = {}
+            for key in self.timing_keys:
+                values = [r[key] for r in reps if key in r]
+                if len(values) > 0:
+                    timings[config][key] = min(values)
+
+        return timings
+
+
+    def write_baseline(self):
+        if not os.path.exists(self.baseline_dir):
+            os.makedirs(self.baseline_dir)
+
+        with open(self.baseline_file, 'w') as f:
+            json.dump(self.timings, f, indent=4, sort_keys=True)
+
+        print("Baseline written to '"+self.baseline_file+"'")
+
+
+    def compare(self):
+        """
+        Compare timings with baseline
+
+        Returns
+        -------
+        str: PASSED if no significant slowdown was detected,
+            FAILED if a significant slowdown was detected and
+            SKIPPED if there was no baseline to compare with
+        """
+        print("")
+        print("Machine id: "+self.machine_id)
+        print("Relative tolerance: "+str(self.tolerance))
+        print("Absolute tolerance: "+str(self.tolerance_abs)+" s")
+
+        if self.update_baseline or not os.path.exists(self.baseline_file):
+            print("")
+            for config, timings in sorted(self.timings.items()):
+                print(config+" (minimum of "+str(self.num_repetitions[config])+" repetitions)")
+                for key, value in sorted(timings.items()):
+                    print(" + "+key+": "+str(value))
+
+            self.write_baseline()
+            print("No baseline to compare with, skipping comparison")
+            return self.SKIPPED
+
+        with open(self.baseline_file, 'r') as f:
+            baseline = json.load(f)
+
+        success = True
+        num_compared = 0
+        for config, timings in sorted(self.timings.items()):
+            print("")
+            print(config+" (minimum of "+str(self.num_repetitions[config])+" repetitions)")
+
+            if config not in baseline:
+                print(" + WARNING: No baseline for this configuration, rerun with SWEET_PERFORMANCE_UPDATE_BASELINE=1")
+                continue
+
+            for key, value in sorted(timings.items()):
+                if key not in baseline[config]:
+                    print(" + "+key+": "+str(value)+" (no baseline)")
+                    continue
+
+                num_compared += 1
+
+                ref = baseline[config][key]
+                ratio = value/ref if ref > 0 else float('inf')
+                s = " + "+key+": "+str(value)+" (baseline: "+str(ref)+", ratio: "+str(round(ratio, 3))+")"
+
+                if value > ref*(1.0+self.tolerance) and value-ref > self.tolerance_abs:
+                    s += " SLOWDOWN"
+                    success = False
+
+                elif value < ref*(1.0-self.tolerance) and ref-value > self.tolerance_abs:
+                    s += " (significant speedup, consider updating baseline)"
+
+                print(s)
+
+        print("")
+        if not success:
+            print("Significant slowdown detected!")
+            print("If this is expected, update baseline with SWEET_PERFORMANCE_UPDATE_BASELINE=1")
+            return self.FAILED
+
+        if num_compared == 0:
+            print("No timings with a baseline, skipping comparison")
+            return self.SKIPPED
+
+        return self.PASSED
+
+
+if __name__ == '__main__':
+
+    p = PerformanceBaseline()
+    if p.compare() == PerformanceBaseline.FAILED:
+        sys.exit(1)
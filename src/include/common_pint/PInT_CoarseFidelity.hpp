@@ -0,0 +1,208 @@
+/*
+ * PInT_CoarseFidelity.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+/*
+ * Adaptive fidelity of the coarse propagator for Parareal and XBraid.
+ *
+ * Early iterations are run with cheap coarse propagators (e.g. larger time
+ * step sizes or less REXI poles). The fidelity is raised as soon as the
+ * residual approaches the tolerance or if the convergence stagnates.
+ *
+ * The fixed point of both methods is the fine solution, hence switching the
+ * coarse propagator between iterations only affects the convergence rate.
+ */
+
+#ifndef SRC_INCLUDE_PINT_COARSEFIDELITY_HPP_
+#define SRC_INCLUDE_PINT_COARSEFIDELITY_HPP_
+
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/StringSplit.hpp>
+#include <sweet/SWEETError.hpp>
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+
+class PInT_CoarseFidelity
+{
+public:
+	/*
+	 * Parameters of the coarse propagator which are overwritten
+	 * for a fidelity level (values <= 0: keep configured value)
+	 */
+	class Level
+	{
+	public:
+		double timestep_size = -1;
+		int timestepping_order = -1;
+		int timestepping_order2 = -1;
+		int rexi_ci_n = -1;
+	};
+
+	// Fidelity levels, starting with the cheapest one. The last one is the configured coarse propagator.
+	std::vector<Level> levels;
+
+	// Currently used fidelity level
+	int current_level = 0;
+
+	// Raise fidelity if the residual is below switch_factor * tolerance
+	double switch_factor = 10;
+
+	// Raise fidelity if the residual is reduced by less than this rate in one iteration
+	double max_rate = 0.5;
+
+	// Residual of the previous iteration on the current fidelity level
+	double prev_residual = -1;
+
+
+public:
+	/**
+	 * Setup fidelity levels
+	 *
+	 * \param i_levels	Levels separated by ',', each with parameters separated by ':',
+	 * 			e.g. "dt=400:rexi_ci_n=32,dt=200:rexi_ci_n=64".
+	 * 			Supported parameters: dt, order, order2, rexi_ci_n
+	 */
+	void setup(
+			const std::string &i_levels,
+			double i_switch_factor,
+			double i_max_rate
+	)
+	{
+		levels.clear();
+		current_level = 0;
+		prev_residual = -1;
+
+		switch_factor = i_switch_factor;
+		max_rate = i_max_rate;
+
+		if (i_levels != "")
+		{
+			std::vector<std::string> level_strs = StringSplit::split(i_levels, ",");
+
+			for (std::size_t i = 0; i < level_strs.size(); i++)
+			{
+				Level level;
+
+				std::vector<std::string> param_strs = StringSplit::split(level_strs[i], ":");
+				for (std::size_t j = 0; j < param_strs.size(); j++)
+				{
+					std::vector<std::string> kv = StringSplit::split(param_strs[j], "=");
+					if (kv.size() != 2)
+						SWEETError("Invalid coarse fidelity parameter '"+param_strs[j]+"'");
+
+					if (kv[0] == "dt")
+						level.timestep_size = atof(kv[1].c_str());
+					else if (kv[0] == "order")
+						level.timestepping_order = atoi(kv[1].c_str());
+					else if (kv[0] == "order2")
+						level.timestepping_order2 = atoi(kv[1].c_str());
+					else if (kv[0] == "rexi_ci_n")
+						level.rexi_ci_n = atoi(kv[1].c_str());
+					else
+						SWEETError("Unknown coarse fidelity parameter '"+kv[0]+"'");
+				}
+
+				levels.push_back(level);
+			}
+		}
+
+		// configured coarse propagator
+		levels.push_back(Level());
+	}
+
+
+	bool enabled()	const
+	{
+		return levels.size() > 1;
+	}
+
+
+	int num_levels()	const
+	{
+		return levels.size();
+	}
+
+
+	/**
+	 * Overwrite parameters of the coarse propagator with the ones of the given fidelity level
+	 */
+	void apply(
+			int i_level,
+			SimulationVariables &io_simVars
+	)	const
+	{
+		const Level &level = levels[i_level];
+
+		if (level.timestep_size > 0)
+			io_simVars.timecontrol.current_timestep_size = level.timestep_size;
+
+		if (level.timestepping_order > 0)
+			io_simVars.disc.timestepping_order = level.timestepping_order;
+
+		if (level.timestepping_order2 > 0)
+			io_simVars.disc.timestepping_order2 = level.timestepping_order2;
+
+		if (level.rexi_ci_n > 0)
+			io_simVars.rexi.ci_n = level.rexi_ci_n;
+	}
+
+
+	/**
+	 * Update fidelity level with the residual of the last iteration
+	 *
+	 * \return true if the fidelity level was raised
+	 */
+	bool update(
+			double i_residual,
+			double i_tolerance
+	)
+	{
+		if (current_level == num_levels()-1)
+			return false;
+
+		bool raise = false;
+
+		// residual approaches tolerance
+		if (i_tolerance > 0 && i_residual < switch_factor*i_tolerance)
+			raise = true;
+
+		// convergence stagnates
+		if (prev_residual > 0 && i_residual > max_rate*prev_residual)
+			raise = true;
+
+		prev_residual = i_residual;
+
+		if (!raise)
+			return false;
+
+		current_level++;
+
+		// convergence rate of the new fidelity level is not known yet
+		prev_residual = -1;
+
+		return true;
+	}
+
+
+	void outputConfig()
+	{
+		for (int i = 0; i < num_levels(); i++)
+		{
+			const Level &level = levels[i];
+			std::cout << " + coarse fidelity level " << i << ":";
+			std::cout << " dt=" << level.timestep_size;
+			std::cout << " order=" << level.timestepping_order;
+			std::cout << " order2=" << level.timestepping_order2;
+			std::cout << " rexi_ci_n=" << level.rexi_ci_n;
+			std::cout << std::endl;
+		}
+	}
+};
+
+#endif /* SRC_INCLUDE_PINT_COARSEFIDELITY_HPP_ */
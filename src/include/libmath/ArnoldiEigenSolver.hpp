@@ -0,0 +1,548 @@
+/*
+ * ArnoldiEigenSolver.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_LIBMATH_ARNOLDIEIGENSOLVER_HPP_
+#define SRC_INCLUDE_LIBMATH_ARNOLDIEIGENSOLVER_HPP_
+
+#include <vector>
+#include <complex>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <sweet/SWEETError.hpp>
+#include <sweet/openmp_helper.hpp>
+
+
+
+/*
+ * Matrix-free eigenvalue solver for real linear operators
+ *
+ * The operator is only available as a function computing y = A x,
+ * e.g., a time step of a linear(ized) time integrator. Only the
+ * eigenvalues with the largest magnitude (and their eigenvectors)
+ * are computed.
+ *
+ * This is an explicitly restarted Arnoldi method:
+ *  - A Krylov basis V (orthonormal, real) of dimension krylov_dim is built
+ *    with modified Gram-Schmidt and one reorthogonalization.
+ *  - The eigenpairs of the (small) Hessenberg matrix H = V^T A V are the
+ *    Ritz pairs and computed with a complex Schur decomposition.
+ *  - The method is restarted with a real combination of the wanted Ritz
+ *    vectors until the residuals of all wanted Ritz pairs are below the
+ *    tolerance.
+ *
+ * Each iteration requires krylov_dim applications of A compared to the
+ * n applications required to assemble the full matrix.
+ */
+class ArnoldiEigenSolver
+{
+public:
+	typedef std::complex<double> complex;
+
+	/// Number of wanted eigenvalues
+	int num_eigenvalues = 8;
+
+	/// Dimension of the Krylov subspace
+	int krylov_dim = 32;
+
+	/// Maximum number of restarts
+	int max_restarts = 100;
+
+	/// Tolerance of the residual relative to the magnitude of the eigenvalue
+	double tolerance = 1e-10;
+
+	/// Output some information after each restart
+	int verbosity = 0;
+
+
+	/// Eigenvalues, sorted by decreasing magnitude
+	std::vector<complex> eigenvalues;
+
+	/// Residuals |A x - lambda x| of the normalized eigenvectors
+	std::vector<double> residuals;
+
+	/// Eigenvectors, normalized
+	std::vector< std::vector<complex> > eigenvectors;
+
+	/// Number of applications of the operator
+	int num_operator_applications = 0;
+
+	/// Number of restarts
+	int num_restarts = 0;
+
+	/// True if all wanted eigenpairs converged
+	bool converged = false;
+
+
+private:
+	/*
+	 * Givens rotation G = [c, s; -conj(s), c] with G [x; y] = [r; 0]
+	 */
+	static
+	void p_givens(
+			const complex &i_x,
+			const complex &i_y,
+			double &o_c,
+			complex &o_s
+	)
+	{
+		double ax = std::abs(i_x);
+		double ay = std::abs(i_y);
+
+		if (ay == 0)
+		{
+			o_c = 1;
+			o_s = 0;
+			return;
+		}
+
+		if (ax == 0)
+		{
+			o_c = 0;
+			o_s = 1;
+			return;
+		}
+
+		double norm = std::sqrt(ax*ax + ay*ay);
+		o_c = ax/norm;
+		o_s = (i_x/ax)*std::conj(i_y)/norm;
+	}
+
+
+
+	/*
+	 * Complex Schur decomposition H = Q T Q^H of an upper Hessenberg
+	 * matrix with single shift QR iterations (Wilkinson shift).
+	 *
+	 * io_H (row major) is overwritten with the upper triangular T
+	 */
+	static
+	void p_hessenberg_schur(
+			std::vector<complex> &io_H,
+			std::vector<complex> &o_Q,
+			int i_m
+	)
+	{
+		const double eps = std::numeric_limits<double>::epsilon();
+
+		auto H = [&](int i, int j) -> complex& { return io_H[i*i_m+j]; };
+		auto Q = [&](int i, int j) -> complex& { return o_Q[i*i_m+j]; };
+
+		o_Q.assign(i_m*i_m, 0);
+		for (int i = 0; i < i_m; i++)
+			Q(i, i) = 1;
+
+		int hi = i_m-1;
+		int iter = 0;
+		int total_iter = 0;
+
+		while (hi > 0)
+		{
+			// search for a negligible subdiagonal element
+			int l = hi;
+			for (; l > 0; l--)
+			{
+				double s = std::abs(H(l-1, l-1)) + std::abs(H(l, l));
+				if (std::abs(H(l, l-1)) <= eps*s || std::abs(H(l, l-1)) < std::numeric_limits<double>::min())
+				{
+					H(l, l-1) = 0;
+					break;
+				}
+			}
+
+			if (l == hi)
+			{
+				// eigenvalue deflated
+				hi--;
+				iter = 0;
+				continue;
+			}
+
+			if (total_iter > 100*i_m)
+				SWEETError("ArnoldiEigenSolver: QR iterations did not converge");
+
+			iter++;
+			total_iter++;
+
+			/*
+			 * Wilkinson shift from the trailing 2x2 block
+			 */
+			complex mu;
+			if (iter % 10 == 0)
+			{
+				// exceptional shift
+				mu = H(hi, hi) + std::abs(H(hi, hi-1));
+			}
+			else
+			{
+				complex a = H(hi-1, hi-1);
+				complex b = H(hi-1, hi);
+				complex c = H(hi, hi-1);
+				complex d = H(hi, hi);
+
+				complex tr2 = 0.5*(a+d);
+				complex disc = std::sqrt(tr2*tr2 - (a*d - b*c));
+
+				complex mu1 = tr2 + disc;
+				complex mu2 = tr2 - disc;
+				mu = (std::abs(mu1-d) < std::abs(mu2-d)) ? mu1 : mu2;
+			}
+
+			/*
+			 * Implicit QR step on the active block [l, hi] via bulge chasing
+			 */
+			complex x = H(l, l) - mu;
+			complex y = H(l+1, l);
+
+			for (int k = l; k < hi; k++)
+			{
+				double c;
+				complex s;
+				p_givens(x, y, c, s);
+
+				// H = G H
+				for (int j = std::max(l, k-1); j < i_m; j++)
+				{
+					complex t1 = H(k, j);
+					complex t2 = H(k+1, j);
+					H(k, j) = c*t1 + s*t2;
+					H(k+1, j) = -std::conj(s)*t1 + c*t2;
+				}
+
+				// H = H G^H
+				int imax = std::min(k+2, hi);
+				for (int i = 0; i <= imax; i++)
+				{
+					complex t1 = H(i, k);
+					complex t2 = H(i, k+1);
+					H(i, k) = c*t1 + std::conj(s)*t2;
+					H(i, k+1) = -s*t1 + c*t2;
+				}
+
+				// Q = Q G^H
+				for (int i = 0; i < i_m; i++)
+				{
+					complex t1 = Q(i, k);
+					complex t2 = Q(i, k+1);
+					Q(i, k) = c*t1 + std::conj(s)*t2;
+					Q(i, k+1) = -s*t1 + c*t2;
+				}
+
+				if (k < hi-1)
+				{
+					x = H(k+1, k);
+					y = H(k+2, k);
+				}
+			}
+		}
+	}
+
+
+
+	/*
+	 * Compute eigenvalues and normalized eigenvectors of the upper
+	 * Hessenberg matrix i_H (row major)
+	 */
+	static
+	void p_hessenberg_eigen(
+			const std::vector<complex> &i_H,
+			int i_m,
+			std::vector<complex> &o_lambda,
+			std::vector< std::vector<complex> > &o_Y
+	)
+	{
+		std::vector<complex> T = i_H;
+		std::vector<complex> Q;
+		p_hessenberg_schur(T, Q, i_m);
+
+		double norm = 0;
+		for (int i = 0; i < i_m*i_m; i++)
+			norm = std::max(norm, std::abs(T[i]));
+
+		double small = std::max(norm, 1.0)*std::numeric_limits<double>::epsilon();
+
+		o_lambda.resize(i_m);
+		o_Y.resize(i_m);
+
+		std::vector<complex> z(i_m);
+		for (int i = 0; i < i_m; i++)
+		{
+			complex lambda = T[i*i_m+i];
+			o_lambda[i] = lambda;
+
+			// back substitution for (T - lambda I) z = 0 with z[i] = 1
+			std::fill(z.begin(), z.end(), complex(0));
+			z[i] = 1;
+			for (int k = i-1; k >= 0; k--)
+			{
+				complex sum = 0;
+				for (int j = k+1; j <= i; j++)
+					sum += T[k*i_m+j]*z[j];
+
+				complex denom = T[k*i_m+k] - lambda;
+				if (std::abs(denom) < small)
+					denom = small;
+
+				z[k] = -sum/denom;
+			}
+
+			// y = Q z
+			std::vector<complex> &y = o_Y[i];
+			y.assign(i_m, 0);
+			for (int r = 0; r < i_m; r++)
+				for (int k = 0; k <= i; k++)
+					y[r] += Q[r*i_m+k]*z[k];
+
+			double ynorm = 0;
+			for (int r = 0; r < i_m; r++)
+				ynorm += std::norm(y[r]);
+			ynorm = std::sqrt(ynorm);
+
+			for (int r = 0; r < i_m; r++)
+				y[r] /= ynorm;
+		}
+	}
+
+
+
+	static
+	double p_dot(
+			const std::vector<double> &i_a,
+			const std::vector<double> &i_b
+	)
+	{
+		std::size_t n = i_a.size();
+
+		/*
+		 * Partial sums over a fixed number of chunks.
+		 * The result doesn't depend on the number of threads,
+		 * hence it's the same on all MPI ranks.
+		 */
+		const std::size_t num_chunks = 64;
+		double partial_sums[num_chunks];
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t c = 0; c < num_chunks; c++)
+		{
+			double sum = 0;
+			for (std::size_t i = c*n/num_chunks; i < (c+1)*n/num_chunks; i++)
+				sum += i_a[i]*i_b[i];
+			partial_sums[c] = sum;
+		}
+
+		double sum = 0;
+		for (std::size_t c = 0; c < num_chunks; c++)
+			sum += partial_sums[c];
+
+		return sum;
+	}
+
+
+
+	static
+	void p_axpy(
+			double i_alpha,
+			const std::vector<double> &i_x,
+			std::vector<double> &io_y
+	)
+	{
+		std::size_t n = i_x.size();
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < n; i++)
+			io_y[i] += i_alpha*i_x[i];
+	}
+
+
+
+public:
+	/**
+	 * Compute the eigenvalues with the largest magnitude
+	 *
+	 * \param i_n				size of the vectors
+	 * \param i_apply			function computing o_y = A i_x
+	 * \param i_start_vector	optional start vector of size i_n
+	 */
+	void solve(
+			std::size_t i_n,
+			const std::function<void(const double *i_x, double *o_y)> &i_apply,
+			const double *i_start_vector = nullptr
+	)
+	{
+		int m = std::min<std::size_t>(krylov_dim, i_n);
+		int k = std::min(num_eigenvalues, m);
+
+		if (m < 1 || k < 1)
+			SWEETError("ArnoldiEigenSolver: Invalid number of eigenvalues or Krylov dimension");
+
+		num_operator_applications = 0;
+		num_restarts = 0;
+		converged = false;
+
+		// Krylov basis
+		std::vector< std::vector<double> > V(m+1, std::vector<double>(i_n));
+
+		if (i_start_vector != nullptr)
+		{
+			for (std::size_t i = 0; i < i_n; i++)
+				V[0][i] = i_start_vector[i];
+		}
+		else
+		{
+			// deterministic pseudo random start vector
+			std::uint64_t state = 88172645463325252ull;
+			for (std::size_t i = 0; i < i_n; i++)
+			{
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				V[0][i] = (double)(state >> 11)*(1.0/9007199254740992.0) - 0.5;
+			}
+		}
+
+		std::vector<complex> H;
+		std::vector<complex> lambda;
+		std::vector< std::vector<complex> > Y;
+		std::vector<int> order;
+
+		for (num_restarts = 0; ; num_restarts++)
+		{
+			double norm = std::sqrt(p_dot(V[0], V[0]));
+			if (norm == 0)
+				SWEETError("ArnoldiEigenSolver: Start vector is zero");
+
+			for (std::size_t i = 0; i < i_n; i++)
+				V[0][i] /= norm;
+
+			H.assign(m*m, 0);
+			double h_next = 0;
+			int mm = m;
+
+			/*
+			 * Arnoldi process
+			 */
+			for (int j = 0; j < m; j++)
+			{
+				i_apply(V[j].data(), V[j+1].data());
+				num_operator_applications++;
+
+				std::vector<double> &w = V[j+1];
+
+				// modified Gram-Schmidt with one reorthogonalization
+				for (int pass = 0; pass < 2; pass++)
+				{
+					for (int i = 0; i <= j; i++)
+					{
+						double h = p_dot(V[i], w);
+						p_axpy(-h, V[i], w);
+						H[i*m+j] += h;
+					}
+				}
+
+				h_next = std::sqrt(p_dot(w, w));
+
+				if (j < m-1)
+				{
+					if (h_next <= std::numeric_limits<double>::epsilon()*std::abs(H[j*m+j]) || h_next == 0)
+					{
+						// invariant subspace found
+						mm = j+1;
+						h_next = 0;
+						break;
+					}
+
+					H[(j+1)*m+j] = h_next;
+					for (std::size_t i = 0; i < i_n; i++)
+						w[i] /= h_next;
+				}
+			}
+
+			/*
+			 * Ritz pairs
+			 */
+			std::vector<complex> Hm(mm*mm);
+			for (int i = 0; i < mm; i++)
+				for (int j = 0; j < mm; j++)
+					Hm[i*mm+j] = H[i*m+j];
+
+			p_hessenberg_eigen(Hm, mm, lambda, Y);
+
+			order.resize(mm);
+			for (int i = 0; i < mm; i++)
+				order[i] = i;
+
+			std::stable_sort(order.begin(), order.end(),
+					[&](int a, int b) -> bool { return std::abs(lambda[a]) > std::abs(lambda[b]); }
+				);
+
+			int kk = std::min(k, mm);
+
+			eigenvalues.resize(kk);
+			residuals.resize(kk);
+
+			converged = true;
+			for (int i = 0; i < kk; i++)
+			{
+				int o = order[i];
+				eigenvalues[i] = lambda[o];
+				residuals[i] = h_next*std::abs(Y[o][mm-1]);
+
+				if (residuals[i] > tolerance*std::max(std::abs(lambda[o]), 1e-300))
+					converged = false;
+			}
+
+			if (verbosity > 0)
+			{
+				double max_residual = *std::max_element(residuals.begin(), residuals.end());
+				std::cout << "Arnoldi restart " << num_restarts << ": max. residual " << max_residual << ", largest eigenvalue " << eigenvalues[0] << std::endl;
+			}
+
+			if (converged || num_restarts >= max_restarts)
+			{
+				/*
+				 * Ritz vectors x = V y
+				 */
+				eigenvectors.resize(kk);
+				for (int i = 0; i < kk; i++)
+				{
+					const std::vector<complex> &y = Y[order[i]];
+					std::vector<complex> &x = eigenvectors[i];
+					x.assign(i_n, 0);
+
+					SWEET_THREADING_SPACE_PARALLEL_FOR
+					for (std::size_t r = 0; r < i_n; r++)
+					{
+						complex sum = 0;
+						for (int j = 0; j < mm; j++)
+							sum += V[j][r]*y[j];
+						x[r] = sum;
+					}
+				}
+				return;
+			}
+
+			/*
+			 * Restart with a real combination of the wanted Ritz vectors
+			 */
+			std::vector<double> v0(i_n, 0);
+			for (int i = 0; i < kk; i++)
+			{
+				const std::vector<complex> &y = Y[order[i]];
+				for (int j = 0; j < mm; j++)
+					p_axpy(y[j].real() + y[j].imag(), V[j], v0);
+			}
+			V[0].swap(v0);
+		}
+	}
+};
+
+
+
+#endif
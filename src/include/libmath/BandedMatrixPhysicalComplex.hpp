@@ -89,7 +89,7 @@ public:
 		halosize_off_diagonal = i_halosize_off_diagonal;
 		num_diagonals = 2*halosize_off_diagonal+1;
 
-		data = MemBlockAlloc::alloc<T>( sizeof(T)*sphereDataConfig->spectral_complex_array_data_number_of_elements*num_diagonals );
+		data = MemBlockAlloc::alloc<T>( sizeof(T)*sphereDataConfig->spectral_complex_array_data_number_of_elements*num_diagonals, "BandedMatrixPhysicalComplex" );
 
 		zeroAll();
 	}
@@ -262,7 +262,7 @@ public:
 	void convertToFortranArray()
 	{
 		if (fortran_data == nullptr)
-			fortran_data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_complex_array_data_number_of_elements*num_diagonals);
+			fortran_data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_complex_array_data_number_of_elements*num_diagonals, "BandedMatrixPhysicalComplex");
 
 		for (int j = 0; j < sphereDataConfig->spectral_complex_array_data_number_of_elements; j++)
 			for (int i = 0; i < num_diagonals; i++)
@@ -88,7 +88,7 @@ public:
 		halosize_off_diagonal = i_halosize_offdiagonal;
 		num_diagonals = 2*halosize_off_diagonal+1;
 
-		data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_array_data_number_of_elements*num_diagonals);
+		data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_array_data_number_of_elements*num_diagonals, "BandedMatrixPhysicalReal");
 
 		zeroAll();
 	}
@@ -265,7 +265,7 @@ public:
 	void convertToFortranArray()
 	{
 		if (fortran_data == nullptr)
-			fortran_data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_array_data_number_of_elements*num_diagonals);
+			fortran_data = MemBlockAlloc::alloc<T>(sizeof(T)*sphereDataConfig->spectral_array_data_number_of_elements*num_diagonals, "BandedMatrixPhysicalReal");
 
 		for (int j = 0; j < sphereDataConfig->spectral_array_data_number_of_elements; j++)
 			for (int i = 0; i < num_diagonals; i++)
@@ -233,6 +233,9 @@ class LapackBandedMatrixSolver<std::complex<double>>	:
 	 * i_b: RHS of equation
 	 *
 	 * o_x: Solution
+	 *
+	 * i_num_rhs: Number of RHS stored one after another in i_b and o_x,
+	 *            the matrix is factorized only once for all of them
 	 */
 public:
 	void solve_diagBandedInverse_Carray(
@@ -240,7 +243,8 @@ public:
 		const std::complex<double>* i_b,
 		std::complex<double>* o_x,
 		int i_size,
-		int i_debug_block
+		int i_debug_block,
+		int i_num_rhs = 1
 	)	const
 	{
 		assert(max_N >= i_size);
@@ -370,7 +374,7 @@ public:
 		}
 #endif
 
-		solve_diagBandedInverse_FortranArray(AB, i_b, o_x, i_size, i_debug_block);
+		solve_diagBandedInverse_FortranArray(AB, i_b, o_x, i_size, i_debug_block, i_num_rhs);
 	}
 
 
@@ -381,7 +385,8 @@ public:
 		const std::complex<double>* i_b,
 		std::complex<double>* o_x,
 		int i_size,
-		int i_debug_block
+		int i_debug_block,
+		int i_num_rhs = 1
 	)	const
 	{
 		/*
@@ -390,9 +395,9 @@ public:
 		if (AB != i_A)
 			memcpy((void*)AB, (const void*)i_A, sizeof(std::complex<double>)*num_diagonals*LDAB);
 
-		memcpy((void*)o_x, (const void*)i_b, sizeof(std::complex<double>)*i_size);
+		memcpy((void*)o_x, (const void*)i_b, sizeof(std::complex<double>)*i_size*i_num_rhs);
 
-		solve_diagBandedInverse_FortranArray_inplace(AB, o_x, i_size, i_debug_block);
+		solve_diagBandedInverse_FortranArray_inplace(AB, o_x, i_size, i_debug_block, i_num_rhs);
 	}
 
 
@@ -402,7 +407,8 @@ public:
 		std::complex<double>* io_A,		///< A of max size
 		std::complex<double>* io_b_x,	///< rhs and solution x
 		int i_size,
-		int i_debug_block
+		int i_debug_block,
+		int i_num_rhs = 1
 	)	const
 	{
 		assert((num_diagonals & 1) == 1);
@@ -422,7 +428,7 @@ public:
 				i_size,				// number of linear equations
 				num_halo_size_diagonals,	// number of subdiagonals
 				num_halo_size_diagonals,	// number of superdiagonals
-				1,				// number of columns of matrix B
+				i_num_rhs,			// number of columns of matrix B
 				io_A,				// array with matrix A to solve for
 				LDAB,				// leading dimension of matrix A
 				IPIV,				// integer array for pivoting
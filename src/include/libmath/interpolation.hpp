@@ -19,8 +19,8 @@
  */
 template <int N>
 double interpolation_lagrange_nonequidistant(
-    double *x,    /// interpolation points
-    double *y,    /// interpolation values
+    const double *x,    /// interpolation points
+    const double *y,    /// interpolation values
     double x_sample /// sample position
 )
 {
@@ -57,7 +57,7 @@ double interpolation_lagrange_nonequidistant(
  */
 template <int N>
 double interpolation_lagrange_equidistant(
-    double *y,    /// interpolation values
+    const double *y,    /// interpolation values
     double x_sample /// sample position
 )
 {
@@ -82,4 +82,65 @@ double interpolation_lagrange_equidistant(
     return retval;
 }
 
+
+
+/**
+ * Weights of the Lagrange interpolation for given nonequidistant
+ * interpolation points, see interpolation_lagrange_nonequidistant
+ */
+template <int N>
+void interpolation_lagrange_nonequidistant_weights(
+    const double *x,    /// interpolation points
+    double x_sample,    /// sample position
+    double *o_weights   /// weights of interpolation values
+)
+{
+    for (int i = 0; i < N; i++)
+    {
+        double denom = 1;
+        double nom = 1;
+
+        for (int j = 0; j < N; j++)
+        {
+            if (i == j)
+                continue;
+
+            nom *= x_sample - x[j];
+            denom *= x[i] - x[j];
+        }
+
+        o_weights[i] = nom/denom;
+    }
+}
+
+
+
+/**
+ * Weights of the Lagrange interpolation for equidistantly spaced points
+ * starting at 0, see interpolation_lagrange_equidistant
+ */
+template <int N>
+void interpolation_lagrange_equidistant_weights(
+    double x_sample,    /// sample position
+    double *o_weights   /// weights of interpolation values
+)
+{
+    for (int i = 0; i < N; i++)
+    {
+        double denom = 1;
+        double nom = 1;
+
+        for (int j = 0; j < N; j++)
+        {
+            if (i == j)
+                continue;
+
+            nom *= x_sample - (double)j;
+            denom *= (double)(i - j);
+        }
+
+        o_weights[i] = nom/denom;
+    }
+}
+
 #endif
@@ -35,11 +35,16 @@
 #include <mpi.h>
 #endif
 
+#if SWEET_THREADING
+#include <omp.h>
+#endif
+
 #include <parareal/Parareal_ConsolePrefix.hpp>
 #include <parareal/Parareal_SimulationInstance.hpp>
 #include <parareal/Parareal_SimulationVariables.hpp>
 
 #include <parareal/Parareal_GenericData.hpp>
+#include <common_pint/PInT_CoarseFidelity.hpp>
 
 #if SWEET_PARAREAL_SCALAR
 #include <parareal/Parareal_GenericData_Scalar.hpp>
@@ -58,6 +63,7 @@
 #include <string>
 #include <math.h>
 #include <map>
+#include <algorithm>
 
 /**
  * This class takes over the control and
@@ -116,6 +122,23 @@ class Parareal_Controller
 	std::map<int, int> global_to_local_slice;
 	int buffer_size;
 
+	// Length of each time slice
+	double time_slice_size = 0;
+
+	// Ranks which computed the last fine time stepping of each slice
+	std::vector<int> proc_for_slices_last_fine = {};
+
+	// Fine time steppers and simulation variables of each thread group
+	std::vector<t_tsmType*> timeSteppersFine_thread_groups = {};
+	std::vector<SimulationVariables*> simVars_thread_groups = {};
+
+	// Adaptive fidelity of the coarse propagator
+	PInT_CoarseFidelity coarseFidelity;
+
+	// Coarse time steppers and simulation variables of each fidelity level (the last level uses timeSteppersCoarse)
+	std::vector<t_tsmType*> timeSteppersCoarse_fidelity = {};
+	std::vector<SimulationVariables*> simVars_coarse_fidelity = {};
+
 
 
 public:
@@ -275,6 +298,29 @@ public:
 															it++)
 			if (*it)
 				delete *it;
+
+		parareal_simulationInstances.clear();
+		global_to_local_slice.clear();
+		timeframe_do_output.clear();
+
+		for (std::size_t g = 0; g < timeSteppersFine_thread_groups.size(); g++)
+		{
+			delete timeSteppersFine_thread_groups[g];
+			delete simVars_thread_groups[g];
+		}
+
+		timeSteppersFine_thread_groups.clear();
+		simVars_thread_groups.clear();
+
+		for (std::size_t f = 0; f < timeSteppersCoarse_fidelity.size(); f++)
+		{
+			if (timeSteppersCoarse_fidelity[f] != timeSteppersCoarse)
+				delete timeSteppersCoarse_fidelity[f];
+			delete simVars_coarse_fidelity[f];
+		}
+
+		timeSteppersCoarse_fidelity.clear();
+		simVars_coarse_fidelity.clear();
 	}
 
 
@@ -301,7 +347,10 @@ public:
 			exit(1);
 		}
 
-		if (pVars->coarse_slices % mpi_nprocs != 0)
+		if (pVars->slice_distribution != "block" && pVars->slice_distribution != "cyclic" && pVars->slice_distribution != "rebalance")
+			SWEETError(std::string("Unknown slice distribution '")+pVars->slice_distribution+"'");
+
+		if (pVars->slice_distribution == "block" && pVars->coarse_slices % mpi_nprocs != 0)
 		{
 			SWEETError("Number of coarse slices must be a multiple integer of the number of MPI processes");
 		}
@@ -312,117 +361,112 @@ public:
 			exit(1);
 		}
 
+		if (pVars->thread_groups < 1)
+			SWEETError("Number of thread groups must be at least 1");
+
+#if SWEET_PARAREAL==2 || !SWEET_THREADING
+		if (pVars->thread_groups > 1)
+			SWEETError("Thread groups are only supported for serial Parareal with threading enabled");
+#endif
+
 		// allocate raw simulation instances
 		////simulationInstances = new t_SimulationInstance[pVars->coarse_slices];
 
+		MemBlockAllocTag memTag("parareal");
+
 		CONSOLEPREFIX.start("[MAIN] ");
 		std::cout << "Resetting simulation instances" << std::endl;
 
 
-		// Distribute slices for each MPI proc
-		// mpi_rank = 0 contains all processes to compute all serial parts
-		int slices_per_proc = pVars->coarse_slices / mpi_nprocs;
-
-		if (mpi_rank == 0)
-			for (int k = 0; k < pVars->coarse_slices; k++)
-				global_to_local_slice.emplace(std::make_pair(k, k)); // slice k is the i-th slice treated by proc mpi_rank
-
-		int i = 0;
-		for (int k = mpi_rank * slices_per_proc; k < (mpi_rank + 1) * slices_per_proc; k++)
-		{
-			slices_for_proc.push_back(k); // slice k is treated by proc mpi_rank
-			if (mpi_rank > 0)
-				global_to_local_slice.emplace(std::make_pair(k, i)); // slice k is the i-th slice treated by proc mpi_rank
-			i++;
-		}
-		if (mpi_rank > 0)
-			for (int k = 0; k < pVars->coarse_slices; k++)
-				if (k < mpi_rank * slices_per_proc || k >= (mpi_rank + 1) * slices_per_proc)
-					global_to_local_slice.emplace(std::make_pair(k, -1)); // slice k is not treated by proc mpi_rank
-
-		//// Distribute MPI proc for each slice
-		proc_for_slices = std::vector<int>(pVars->coarse_slices);
-		if (mpi_rank == 0)
-			for (int i = 0; i < mpi_nprocs; i++)
-				for (int k = i * slices_per_proc; k < (i + 1) * slices_per_proc; k++)
-					proc_for_slices[k] = i;
-
-#if SWEET_PARAREAL==2
-		MPI_Bcast(&proc_for_slices[0], proc_for_slices.size() , MPI_INT, 0, MPI_COMM_WORLD );
-#endif
-
-
 		// size of coarse time step
-		double time_slice_size = pVars->max_simulation_time / pVars->coarse_slices;
+		time_slice_size = pVars->max_simulation_time / pVars->coarse_slices;
 		if (pVars->coarse_timestep_size < 0)
 			pVars->coarse_timestep_size = time_slice_size;
 
 
-		// convert to pararealsimulationInstances to get Parareal interfaces
-		for (int k = 0; k < pVars->coarse_slices; k++)
-		{
+		/*
+		 * Setup simulation instances including their time frames
+		 *
+		 * mpi_rank = 0 contains all slices to compute all serial parts.
+		 * The other ranks create the instances of their slices while distributing them.
+		 */
+		if (mpi_rank == 0)
+			for (int k = 0; k < pVars->coarse_slices; k++)
+				setup_slice_instance(k);
 
-			// except for mpi_rank = 0, only create instances for slices treated by mpi_rank
-			if (mpi_rank > 0)
-				if (k < slices_for_proc[0] || k > slices_for_proc.back())
-					continue;
+		// Distribute slices for each MPI proc
+		distribute_slices(0);
+		proc_for_slices_last_fine = proc_for_slices;
 
-			CONSOLEPREFIX_start(k);
 
-			int local_k = global_to_local_slice.at(k);
-			parareal_simulationInstances.push_back(new Parareal_SimulationInstance<t_tsmType, N>);
-			std::cout << "mpi_rank " << mpi_rank << " setting up instance " << k << " " << local_k << std::endl;
-#if SWEET_PARAREAL_SCALAR
-				parareal_simulationInstances[local_k]->setup(this->simVars,
-								       this->timeSteppersFine,
-								       this->timeSteppersCoarse);
+		// if time slices are not homogeneous, this should be called by each parareal_simulationInstance
+		if (parareal_simulationInstances.size() > 0)
+		{
+			CONSOLEPREFIX_start(0);
+			parareal_simulationInstances[0]->sim_check_timesteps(time_slice_size);
+		}
 
-#elif SWEET_PARAREAL_PLANE
-				parareal_simulationInstances[local_k]->setup(this->simVars,
-								       this->planeDataConfig,
-								       this->op_plane,
-								       this->timeSteppersFine,
-								       this->timeSteppersCoarse);
+		/*
+		 * Setup fine time steppers for each thread group
+		 *
+		 * The time steppers store state of the time integration (e.g.
+		 * departure points or REXI buffers) and the simulation variables
+		 * keep track of the current time, hence each group requires its
+		 * own copies. Operators and data configs are shared. Cached
+		 * operators (e.g. for implicit diffusion) are shared through a
+		 * synchronized cache, hence they can be called concurrently.
+		 */
+		if (pVars->thread_groups > 1 && parareal_simulationInstances.size() > 0)
+		{
+			for (int g = 0; g < pVars->thread_groups; g++)
+			{
+				simVars_thread_groups.push_back(new SimulationVariables(*simVars));
+				timeSteppersFine_thread_groups.push_back(new t_tsmType);
 
-#elif SWEET_PARAREAL_SPHERE
-				parareal_simulationInstances[local_k]->setup(this->simVars,
-								       this->sphereDataConfig,
-								       this->op_sphere,
-								       this->op_sphere_nodealiasing,
-								       this->timeSteppersFine,
-								       this->timeSteppersCoarse);
-#endif
+				parareal_simulationInstances[0]->setup_timesteppers_fine(timeSteppersFine_thread_groups[g], simVars_thread_groups[g]);
+			}
 		}
 
 
-		CONSOLEPREFIX_start("[MAIN] ");
-		std::cout << "Setup time frames" << std::endl;
-
 		/*
-		 * SETUP time frame
+		 * Setup coarse time steppers for each fidelity level
+		 *
+		 * The coarse propagation is only executed on rank 0.
 		 */
+		coarseFidelity.setup(pVars->coarse_fidelity_levels, pVars->coarse_fidelity_switch_factor, pVars->coarse_fidelity_max_rate);
 
-
-		// if time slices are not homogeneous, this should be called by each parareal_simulationInstance
-		//for (int k = 0; k < pVars->coarse_slices; k++)
-		//{
-		CONSOLEPREFIX_start(0);
-		parareal_simulationInstances[0]->sim_check_timesteps(time_slice_size);
-		//}
-
-		for (int k = 0; k < pVars->coarse_slices; k++)
-		////for (int k = slices_for_proc[0]; k <= slices_for_proc.back(); k++)
+		if (coarseFidelity.enabled() && mpi_rank == 0)
 		{
-			if (mpi_rank > 0)
-				if (k < slices_for_proc[0] || k > slices_for_proc.back())
-					continue;
+			CONSOLEPREFIX_start("[MAIN] ");
+			std::cout << "Coarse fidelity levels:" << std::endl;
+			coarseFidelity.outputConfig();
+
+			for (int f = 0; f < coarseFidelity.num_levels(); f++)
+			{
+				SimulationVariables* simVars_f = new SimulationVariables(*parareal_simulationInstances[0]->simVars_coarse);
+				coarseFidelity.apply(f, *simVars_f);
+
+				double mod_coarse = fmod(time_slice_size, simVars_f->timecontrol.current_timestep_size);
+				if (std::abs(mod_coarse) > 1e-12 && std::abs(mod_coarse - simVars_f->timecontrol.current_timestep_size) > 1e-12)
+					SWEETError("Time slice length must be an integer multiple of the coarse time step of each fidelity level!");
+
+				simVars_coarse_fidelity.push_back(simVars_f);
+
+				if (f == coarseFidelity.num_levels()-1)
+				{
+					timeSteppersCoarse_fidelity.push_back(timeSteppersCoarse);
+				}
+				else
+				{
+					timeSteppersCoarse_fidelity.push_back(new t_tsmType);
+					parareal_simulationInstances[0]->setup_timesteppers_coarse(timeSteppersCoarse_fidelity[f], simVars_f);
+				}
+			}
 
-			CONSOLEPREFIX_start(k);
-			int local_k = global_to_local_slice.at(k);
-			parareal_simulationInstances[local_k]->sim_set_timeframe(time_slice_size*k, time_slice_size*(k+1));
-			this->timeframe_do_output.push_back(this->check_do_output(time_slice_size*(k+1)));
+			set_coarse_fidelity(0);
 		}
 
+
 		/*
 		 * Setup first simulation instance
 		 */
@@ -448,6 +492,268 @@ public:
 	}
 
 
+	/**
+	 * Create and setup the simulation instance of time slice i_slice on this rank
+	 */
+	void setup_slice_instance(
+			int i_slice
+	)
+	{
+		// reuse slot of a released instance
+		int local_k = std::find(parareal_simulationInstances.begin(), parareal_simulationInstances.end(), nullptr) - parareal_simulationInstances.begin();
+		if (local_k == (int)parareal_simulationInstances.size())
+		{
+			parareal_simulationInstances.push_back(nullptr);
+			timeframe_do_output.push_back(false);
+		}
+
+		global_to_local_slice[i_slice] = local_k;
+
+		CONSOLEPREFIX_start(i_slice);
+
+		parareal_simulationInstances[local_k] = new Parareal_SimulationInstance<t_tsmType, N>;
+		std::cout << "mpi_rank " << mpi_rank << " setting up instance " << i_slice << " " << local_k << std::endl;
+#if SWEET_PARAREAL_SCALAR
+		parareal_simulationInstances[local_k]->setup(this->simVars,
+							   this->timeSteppersFine,
+							   this->timeSteppersCoarse);
+
+#elif SWEET_PARAREAL_PLANE
+		parareal_simulationInstances[local_k]->setup(this->simVars,
+							   this->planeDataConfig,
+							   this->op_plane,
+							   this->timeSteppersFine,
+							   this->timeSteppersCoarse);
+
+#elif SWEET_PARAREAL_SPHERE
+		parareal_simulationInstances[local_k]->setup(this->simVars,
+							   this->sphereDataConfig,
+							   this->op_sphere,
+							   this->op_sphere_nodealiasing,
+							   this->timeSteppersFine,
+							   this->timeSteppersCoarse);
+#endif
+
+		parareal_simulationInstances[local_k]->sim_set_timeframe(time_slice_size*i_slice, time_slice_size*(i_slice+1));
+		this->timeframe_do_output[local_k] = this->check_do_output(time_slice_size*(i_slice+1));
+	}
+
+
+	/**
+	 * Free the simulation instances of time slices i < i_first_slice and
+	 * of slices which were migrated to other ranks
+	 *
+	 * Rank 0 keeps the instances of all slices for the serial parts.
+	 * This must be called after the previous time step of each slice was
+	 * sent to the next slice (SL).
+	 */
+	void release_slice_instances(
+			int i_first_slice
+	)
+	{
+		if (mpi_rank == 0)
+			return;
+
+		std::map<int, int>::iterator it = global_to_local_slice.begin();
+		while (it != global_to_local_slice.end())
+		{
+			int k = it->first;
+			if (k >= i_first_slice && proc_for_slices[k] == mpi_rank)
+			{
+				it++;
+				continue;
+			}
+
+			delete parareal_simulationInstances[it->second];
+			parareal_simulationInstances[it->second] = nullptr;
+			global_to_local_slice.erase(it++);
+		}
+	}
+
+
+	/**
+	 * Fine time stepping of time slices i_first_slice, ..., coarse_slices-1
+	 * concurrently in groups of threads
+	 *
+	 * Each time slice is a task which is executed by one thread of the outer
+	 * team. This thread uses its own time steppers and simulation variables
+	 * and opens a nested team for the parallelization in space.
+	 */
+	void run_timestep_fine_thread_groups(
+			int i_first_slice
+	)
+	{
+#if SWEET_THREADING
+		int num_groups = timeSteppersFine_thread_groups.size();
+		int threads_per_group = std::max(1, omp_get_max_threads()/num_groups);
+
+		int max_active_levels = omp_get_max_active_levels();
+		omp_set_max_active_levels(2);
+
+		CONSOLEPREFIX_start("[MAIN] ");
+
+#pragma omp parallel num_threads(num_groups) proc_bind(spread)
+#pragma omp single
+		{
+			for (std::size_t j = 0; j < slices_for_proc.size(); j++)
+			{
+				int i = slices_for_proc[j];
+				if (i < i_first_slice)
+					continue;
+
+#pragma omp task firstprivate(i)
+				{
+					int g = omp_get_thread_num();
+					omp_set_num_threads(threads_per_group);
+
+					parareal_simulationInstances[get_local_slice(i)]->run_timestep_fine(
+							timeSteppersFine_thread_groups[g],
+							simVars_thread_groups[g]
+						);
+				}
+			}
+		}
+
+		omp_set_max_active_levels(max_active_levels);
+#endif
+	}
+
+
+	/**
+	 * Use the coarse propagator of the given fidelity level for all time slices
+	 */
+	void set_coarse_fidelity(
+			int i_level
+	)
+	{
+		for (std::size_t i = 0; i < parareal_simulationInstances.size(); i++)
+			if (parareal_simulationInstances[i])
+				parareal_simulationInstances[i]->sim_set_coarse_propagator(
+						timeSteppersCoarse_fidelity[i_level],
+						simVars_coarse_fidelity[i_level]
+					);
+	}
+
+
+	/**
+	 * Raise the fidelity of the coarse propagator if required by the convergence of the last iteration
+	 *
+	 * The coarse solutions of time slices i_first_slice, ..., coarse_slices-1 are recomputed
+	 * with the new propagator since they are subtracted in the correction of the next iteration.
+	 *
+	 * The penult coarse timestep of time slice i_first_slice-1 was computed with the previous
+	 * propagator (e.g. with a different time step size) and can't be used for SL methods.
+	 */
+	void update_coarse_fidelity(
+			int i_first_slice,
+			double i_convergence
+	)
+	{
+		if (!coarseFidelity.update(i_convergence, pVars->convergence_error_threshold))
+			return;
+
+		CONSOLEPREFIX_start("[MAIN] ");
+		std::cout << "Switching to coarse fidelity level " << coarseFidelity.current_level << " with convergence value " << i_convergence << std::endl;
+
+		set_coarse_fidelity(coarseFidelity.current_level);
+
+		for (int i = i_first_slice; i < pVars->coarse_slices; i++)
+		{
+			CONSOLEPREFIX_start(i);
+
+			if (i == i_first_slice)
+			{
+				// SL: restart with the start data of this time slice
+				parareal_simulationInstances[i]->sim_reset_data_coarse_previous_time_slice();
+			}
+			else
+			{
+				// SL:
+				Parareal_GenericData &tmp2 = parareal_simulationInstances[i-1]->get_reference_to_data_timestep_coarse_previous_timestep();
+				parareal_simulationInstances[i]->sim_set_data_coarse_previous_time_slice(tmp2);
+			}
+
+			parareal_simulationInstances[i]->run_timestep_coarse();
+		}
+	}
+
+
+	/**
+	 * Return the local index of the simulation instance of time slice i_slice or -1 if it doesn't exist on this rank
+	 */
+	int get_local_slice(
+			int i_slice
+	)	const
+	{
+		std::map<int, int>::const_iterator it = global_to_local_slice.find(i_slice);
+		if (it == global_to_local_slice.end())
+			return -1;
+
+		return it->second;
+	}
+
+
+	/**
+	 * Distribute the time slices i_first_slice, ..., coarse_slices-1 to the MPI ranks
+	 *
+	 * This is computed redundantly on all ranks. Instances of slices newly
+	 * assigned to this rank are created on the fly. Their data is sent by
+	 * rank 0 in each iteration, hence no further state has to be migrated.
+	 */
+	void distribute_slices(
+			int i_first_slice
+	)
+	{
+		int num_slices = pVars->coarse_slices;
+
+		proc_for_slices = std::vector<int>(num_slices, 0);
+
+		if (pVars->slice_distribution == "block")
+		{
+			int slices_per_proc = num_slices / mpi_nprocs;
+			for (int k = 0; k < num_slices; k++)
+				proc_for_slices[k] = k / slices_per_proc;
+		}
+		else if (pVars->slice_distribution == "cyclic")
+		{
+			for (int k = 0; k < num_slices; k++)
+				proc_for_slices[k] = k % mpi_nprocs;
+		}
+		else if (pVars->slice_distribution == "rebalance")
+		{
+			// contiguous and balanced blocks of the remaining slices
+			int num_active = num_slices - i_first_slice;
+			for (int k = i_first_slice; k < num_slices; k++)
+				proc_for_slices[k] = ((k - i_first_slice) * std::min(mpi_nprocs, num_active)) / num_active;
+		}
+
+		slices_for_proc.clear();
+		for (int k = i_first_slice; k < num_slices; k++)
+		{
+			if (proc_for_slices[k] != mpi_rank)
+				continue;
+
+			slices_for_proc.push_back(k); // slice k is treated by proc mpi_rank
+
+			if (get_local_slice(k) < 0)
+				setup_slice_instance(k);
+		}
+
+		if (pVars->verbosity > 0 && mpi_rank == 0)
+		{
+			std::vector<int> num_slices_for_proc(mpi_nprocs, 0);
+			for (int k = i_first_slice; k < num_slices; k++)
+				num_slices_for_proc[proc_for_slices[k]]++;
+
+			CONSOLEPREFIX_start("[MAIN] ");
+			std::cout << "Slices per rank:";
+			for (int i = 0; i < mpi_nprocs; i++)
+				std::cout << " " << num_slices_for_proc[i];
+			std::cout << std::endl;
+		}
+	}
+
+
 	bool check_do_output(
 				double t
 			)
@@ -602,6 +908,10 @@ public:
 				CONSOLEPREFIX_start("[MAIN] ");
 				std::cout << "Iteration Nr. " << k << std::endl;
 			}
+
+			// redistribute unconverged slices
+			if (pVars->slice_distribution == "rebalance" && k > 0)
+				distribute_slices(k);
 			/*
 			 * All the following loops should start with 0.
 			 * For debugging reasons, we leave it here at 0
@@ -613,7 +923,7 @@ public:
 			for (int i = k; i < pVars->coarse_slices; i++)
 			{
 				int working_rank = proc_for_slices[i];
-				int local_slice = global_to_local_slice.at(i);
+				int local_slice = get_local_slice(i);
 
 				///Parareal_GenericData* tmp2 = &parareal_simulationInstances[local_slice]->get_reference_to_data_timestep_coarse();
 				Parareal_GenericData* tmp2;
@@ -634,7 +944,7 @@ public:
 				}
 				else if (mpi_rank == 0) // send
 				{
-					int local_slice_prev = global_to_local_slice.at(i-1);
+					int local_slice_prev = get_local_slice(i-1);
 					tmp2 = &parareal_simulationInstances[local_slice_prev]->get_reference_to_output_data();
 					this->communicate_solution(tmp2, 0, working_rank, 10000 + i);
 
@@ -654,63 +964,68 @@ public:
 
 				// identify proc responsible for this time slice
 				int working_rank = proc_for_slices[i];
-				int local_slice = global_to_local_slice.at(i);
+				int local_slice = get_local_slice(i);
+
+				// identify proc which computed the last fine time step of the previous slice
+				int source_rank = proc_for_slices_last_fine[i - 1];
 
-				// dummy init
-				///Parareal_GenericData* tmp2 = &parareal_simulationInstances[local_slice]->get_reference_to_data_timestep_fine_previous_timestep();
-				//Parareal_GenericData* tmp2 = parareal_simulationInstances[0]->create_new_data_container();
 				Parareal_GenericData* tmp2;
 
 				// there is a previous timestep in this same proc
-				if (local_slice > 0 && working_rank == mpi_rank )
+				if (source_rank == working_rank)
 				{
-					tmp2 = &parareal_simulationInstances[global_to_local_slice.at(i - 1)]->get_reference_to_data_timestep_fine_previous_timestep();
-					parareal_simulationInstances[local_slice]->sim_set_data_fine_previous_time_slice(*tmp2);
+					if (working_rank == mpi_rank)
+					{
+						tmp2 = &parareal_simulationInstances[get_local_slice(i - 1)]->get_reference_to_data_timestep_fine_previous_timestep();
+						parareal_simulationInstances[local_slice]->sim_set_data_fine_previous_time_slice(*tmp2);
+					}
 				}
 
 #if SWEET_PARAREAL == 2
-				else if (local_slice == 0 || mpi_rank == 0) // communicate
+				else if (working_rank == mpi_rank) // recv
 				{
-					if (local_slice == 0) // recv
-					{
-						///tmp2 = &parareal_simulationInstances[local_slice]->get_reference_to_data_timestep_fine_previous_timestep();
-						tmp2 = parareal_simulationInstances[local_slice]->create_new_data_container("fine");
-						this->communicate_solution(tmp2, 0, mpi_rank, 20000 + i);
-						parareal_simulationInstances[local_slice]->sim_set_data_fine_previous_time_slice(*tmp2);
-						delete tmp2;
-					}
-					else // send
-					{
-						tmp2 = &parareal_simulationInstances[global_to_local_slice.at(i - 1)]->get_reference_to_data_timestep_fine_previous_timestep();
-						this->communicate_solution(tmp2, 0, working_rank, 20000 + i);
-					}
+					tmp2 = parareal_simulationInstances[local_slice]->create_new_data_container("fine");
+					this->communicate_solution(tmp2, source_rank, mpi_rank, 20000 + i);
+					parareal_simulationInstances[local_slice]->sim_set_data_fine_previous_time_slice(*tmp2);
+					delete tmp2;
+				}
+				else if (source_rank == mpi_rank) // send
+				{
+					tmp2 = &parareal_simulationInstances[get_local_slice(i - 1)]->get_reference_to_data_timestep_fine_previous_timestep();
+					this->communicate_solution(tmp2, source_rank, working_rank, 20000 + i);
 				}
 #endif
 			}
 
+			// instances of converged or migrated slices are not required anymore
+			release_slice_instances(k);
+
 
 
 			/**
 			 * Fine time stepping (in parallel)
 			 */
-			for (int i = slices_for_proc[0]; i <= slices_for_proc.back(); i++)
+			// solution already converged at time slices i < k
+			if (timeSteppersFine_thread_groups.size() > 0)
 			{
-
-				// solution already converged at time slices i < k
-				if (i < k)
-					continue;
-
-				// identify proc responsible for this time slice
-				int working_rank = proc_for_slices[i];
-				int local_slice = global_to_local_slice.at(i);
-
-				if (mpi_rank == working_rank)
+				run_timestep_fine_thread_groups(k);
+			}
+			else
+			{
+				for (std::size_t j = 0; j < slices_for_proc.size(); j++)
 				{
+					int i = slices_for_proc[j];
+					if (i < k)
+						continue;
+
 					CONSOLEPREFIX_start(i);
-					parareal_simulationInstances[local_slice]->run_timestep_fine();
+					parareal_simulationInstances[get_local_slice(i)]->run_timestep_fine();
 				}
 			}
 
+			for (int i = k; i < pVars->coarse_slices; i++)
+				proc_for_slices_last_fine[i] = proc_for_slices[i];
+
 #if SWEET_PARAREAL == 2
 			MPI_Barrier(MPI_COMM_WORLD);
 #endif
@@ -723,7 +1038,7 @@ public:
 
 				CONSOLEPREFIX_start(i);
 				int working_rank = proc_for_slices[i];
-				int local_slice = global_to_local_slice.at(i);
+				int local_slice = get_local_slice(i);
 
 				// continue only if this proc is responsible for this time slice
 				// or if it is proc 0 (it will receive the computed differences)
@@ -761,9 +1076,9 @@ public:
 			 * 2) Compute output + convergence check (serial)
 			 * 3) Forward to next frame (serial)
 			 */
+			double max_convergence = -2;
 			if (mpi_rank == 0)
 			{
-				double max_convergence = -2;
 				for (int i = k; i < pVars->coarse_slices; i++)
 				{
 					CONSOLEPREFIX_start(i);
@@ -860,6 +1175,10 @@ public:
 
 			if (pVars->max_iter >= 0 && k == pVars->max_iter)
 				break;
+
+			// adapt coarse propagator for the next iteration
+			if (coarseFidelity.enabled() && mpi_rank == 0 && max_convergence >= 0)
+				update_coarse_fidelity(k, max_convergence);
 		}
 
 converged:
@@ -329,7 +329,7 @@ public:
 			double i_timeframe_end		///< end time stamp of coarse time step
 	){
 		// check if seup has been called
-		assert(simVars_coarse->timecontrol.current_timestep_size == simVars->parareal.coarse_timestep_size);
+		assert(simVars_coarse != nullptr);
 
 		if (simVars->parareal.verbosity > 2)
 			std::cout << "Timeframe: [" << i_timeframe_start << ", " << i_timeframe_end << "]" << std::endl;
@@ -346,7 +346,7 @@ public:
 		assert( std::abs(this->timeframe_start + this->nb_timesteps_coarse * simVars_coarse->timecontrol.current_timestep_size - this->timeframe_end) < 1e-14);
 
 		this->dt_fine = simVars->timecontrol.current_timestep_size;
-		this->dt_coarse = simVars->parareal.coarse_timestep_size;
+		this->dt_coarse = simVars_coarse->timecontrol.current_timestep_size;
 
 		// set time to parareal_genericdata instances
 		this->parareal_data_start->set_time(i_timeframe_end);
@@ -508,6 +508,25 @@ public:
 		parareal_data_coarse_previous_time_slice->set_time(this->timeframe_end);
 	};
 
+	/**
+	 * Reset solution of penult coarse timestep of previous time slice to the start data
+	 * of this time slice, as it is done for the first time slice
+	 *
+	 * Required if the coarse propagator changed (see PInT_CoarseFidelity).
+	 */
+	void sim_reset_data_coarse_previous_time_slice()
+	{
+		if (simVars->parareal.verbosity > 2)
+			std::cout << "sim_reset_data_coarse_previous_time_slice()" << std::endl;
+
+		if (this->simVars->parareal.spatial_coarsening)
+			parareal_data_coarse_previous_time_slice->restrict(*parareal_data_start);
+		else
+			*parareal_data_coarse_previous_time_slice = *parareal_data_start;
+
+		parareal_data_coarse_previous_time_slice->set_time(this->timeframe_end);
+	};
+
 	/**
 	 * Set solution of penult fine timestep of previous time slice
 	 */
@@ -663,6 +682,111 @@ public:
 	};
 
 
+	/**
+	 * Setup additional fine time steppers using the given simulation variables,
+	 * e.g. for each group of threads running the fine time stepping concurrently.
+	 *
+	 * Data configs and operators are shared. Cached operators are
+	 * synchronized and can be called concurrently.
+	 */
+	void setup_timesteppers_fine(
+			t_tsmType* io_timeSteppersFine,
+			SimulationVariables* i_simVars
+	)
+	{
+#if SWEET_PARAREAL_SCALAR
+		io_timeSteppersFine->setup(*i_simVars);
+
+#elif SWEET_PARAREAL_PLANE
+		io_timeSteppersFine->setup(
+				i_simVars->disc.timestepping_method,
+				i_simVars->disc.timestepping_order,
+				i_simVars->disc.timestepping_order2,
+				*this->op_plane[0],
+				*i_simVars
+			);
+
+#elif SWEET_PARAREAL_SPHERE
+		io_timeSteppersFine->setup(
+				i_simVars->disc.timestepping_method,
+				*this->op_sphere[0],
+				*i_simVars
+			);
+#endif
+	}
+
+
+	/**
+	 * compute solution on time slice with fine timestep using the
+	 * given time steppers and simulation variables instead of the
+	 * shared ones. This allows running several time slices concurrently.
+	 */
+	void run_timestep_fine(
+			t_tsmType* i_timeSteppersFine,
+			SimulationVariables* i_simVars
+	)
+	{
+		t_tsmType* timeSteppersFine_ = this->timeSteppersFine;
+		SimulationVariables* simVars_ = this->simVars;
+
+		this->timeSteppersFine = i_timeSteppersFine;
+		this->simVars = i_simVars;
+
+		this->run_timestep_fine();
+
+		this->timeSteppersFine = timeSteppersFine_;
+		this->simVars = simVars_;
+	}
+
+
+	/**
+	 * Setup additional coarse time steppers using the given simulation variables,
+	 * e.g. for another fidelity level of the coarse propagator.
+	 */
+	void setup_timesteppers_coarse(
+			t_tsmType* io_timeSteppersCoarse,
+			SimulationVariables* i_simVars_coarse
+	)
+	{
+#if SWEET_PARAREAL_SCALAR
+		io_timeSteppersCoarse->setup(*i_simVars_coarse);
+
+#elif SWEET_PARAREAL_PLANE
+		io_timeSteppersCoarse->setup(
+				i_simVars_coarse->disc.timestepping_method,
+				i_simVars_coarse->disc.timestepping_order,
+				i_simVars_coarse->disc.timestepping_order2,
+				*this->op_plane[1],
+				*i_simVars_coarse
+			);
+
+#elif SWEET_PARAREAL_SPHERE
+		io_timeSteppersCoarse->setup(
+				i_simVars_coarse->disc.timestepping_method,
+				*this->op_sphere[1],
+				*i_simVars_coarse
+			);
+#endif
+	}
+
+
+	/**
+	 * Use another coarse propagator, e.g. with a different fidelity.
+	 * The time steppers have to be set up with the given simulation variables.
+	 */
+	void sim_set_coarse_propagator(
+			t_tsmType* i_timeSteppersCoarse,
+			SimulationVariables* i_simVars_coarse
+	)
+	{
+		this->timeSteppersCoarse = i_timeSteppersCoarse;
+		*this->simVars_coarse = *i_simVars_coarse;
+
+		// update number of coarse time steps
+		this->sim_set_timeframe(this->timeframe_start, this->timeframe_end);
+	}
+
+
 	/**
 	 * return the data after running computations with the fine timestepping:
 	 * return Y^F
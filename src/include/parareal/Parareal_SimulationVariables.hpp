@@ -107,6 +107,38 @@ public:
 	 */
 	int max_iter = -1;
 
+	/**
+	 * Distribution of time slices to MPI ranks
+	 *
+	 * block: contiguous blocks of slices
+	 * cyclic: round robin
+	 * rebalance: contiguous blocks of the unconverged slices, updated in each iteration
+	 */
+	std::string slice_distribution = "block";
+
+	/**
+	 * Number of thread groups running the fine time stepping of
+	 * different time slices concurrently (serial Parareal only)
+	 */
+	int thread_groups = 1;
+
+	/**
+	 * Fidelity levels of the coarse propagator used in the first iterations,
+	 * starting with the cheapest one, e.g. "dt=400:rexi_ci_n=32,dt=200".
+	 * The configured coarse propagator is used as the last level.
+	 */
+	std::string coarse_fidelity_levels = "";
+
+	/**
+	 * Raise fidelity if the convergence value is below this factor times the convergence threshold
+	 */
+	double coarse_fidelity_switch_factor = 10;
+
+	/**
+	 * Raise fidelity if the convergence value is reduced by less than this rate in one iteration
+	 */
+	double coarse_fidelity_max_rate = 0.5;
+
 	/**
 	 * setup long options for program arguments
 	 */
@@ -170,6 +202,21 @@ public:
 
 		io_long_options[io_next_free_program_option] = {"parareal-max-iter", required_argument, 0, (int)256+io_next_free_program_option};
 		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-slice-distribution", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-thread-groups", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-coarse-fidelity-levels", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-coarse-fidelity-switch-factor", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"parareal-coarse-fidelity-max-rate", required_argument, 0, (int)256+io_next_free_program_option};
+		io_next_free_program_option++;
 	}
 
 
@@ -196,6 +243,11 @@ public:
 		std::cout << "	--parareal-store-iterations=[0/1]	Store physical files at each iteration (default=1)" << std::endl;
 		std::cout << "	--parareal-spatial-coarsening=[0/1]	Spatial coarsening between the fine and coarse levels (default=0)" << std::endl;
 		std::cout << "	--parareal-max-iter=[int]	Maximum number of parareal iterations (default=-1)" << std::endl;
+		std::cout << "	--parareal-slice-distribution=[string]	Distribution of time slices to MPI ranks: block, cyclic, rebalance (default=block)" << std::endl;
+		std::cout << "	--parareal-thread-groups=[int]	Number of thread groups for concurrent fine time stepping, serial Parareal only (default=1)" << std::endl;
+		std::cout << "	--parareal-coarse-fidelity-levels=[string]	Cheaper coarse propagators for the first iterations, e.g. dt=400:rexi_ci_n=32,dt=200 (default="")" << std::endl;
+		std::cout << "	--parareal-coarse-fidelity-switch-factor=[float]	Raise coarse fidelity if convergence < factor*threshold (default=10)" << std::endl;
+		std::cout << "	--parareal-coarse-fidelity-max-rate=[float]	Raise coarse fidelity if convergence is reduced by less than this rate (default=0.5)" << std::endl;
 		std::cout << std::endl;
 	}
 
@@ -222,6 +274,11 @@ public:
 		std::cout << " + store_iterations: " << store_iterations << std::endl;
 		std::cout << " + spatial coarsening: " << spatial_coarsening << std::endl;
 		std::cout << " + max_iter: " << max_iter << std::endl;
+		std::cout << " + slice_distribution: " << slice_distribution << std::endl;
+		std::cout << " + thread_groups: " << thread_groups << std::endl;
+		std::cout << " + coarse_fidelity_levels: " << coarse_fidelity_levels << std::endl;
+		std::cout << " + coarse_fidelity_switch_factor: " << coarse_fidelity_switch_factor << std::endl;
+		std::cout << " + coarse_fidelity_max_rate: " << coarse_fidelity_max_rate << std::endl;
 		std::cout << std::endl;
 	}
 
@@ -302,9 +359,29 @@ public:
 		case 15:
 			max_iter = atoi(i_value);
 			return -1;
+
+		case 16:
+			slice_distribution = i_value;
+			return -1;
+
+		case 17:
+			thread_groups = atoi(i_value);
+			return -1;
+
+		case 18:
+			coarse_fidelity_levels = i_value;
+			return -1;
+
+		case 19:
+			coarse_fidelity_switch_factor = atof(i_value);
+			return -1;
+
+		case 20:
+			coarse_fidelity_max_rate = atof(i_value);
+			return -1;
 		}
 
-		return 16;
+		return 21;
 	}
 
 
@@ -13,6 +13,7 @@
 #include <rexi/REXI_Terry.hpp>
 #include <rexi/REXI_CI.hpp>
 #include <rexi/REXICoefficients.hpp>
+#include <rexi/REXICoefficientsCache.hpp>
 #include <vector>
 #include <complex>
 
@@ -50,38 +51,67 @@ public:
 		if (i_rexiSimVars->exp_method == "terry")
 		{
 			std::cout << "WARNING: This way of using REXI is deprecated" << std::endl;
-			/// REXI stuff
-			REXI_Terry<T, T> rexi_terry;
-			rexi_terry.setup(i_function_name, i_rexiSimVars->terry_h, i_rexiSimVars->terry_M, i_rexiSimVars->terry_L, i_rexiSimVars->terry_reduce_to_half, i_rexiSimVars->terry_normalization);
+			std::string cache_key = REXICoefficientsCache<T>::key_terry(
+					i_function_name,
+					i_rexiSimVars->terry_h, i_rexiSimVars->terry_M, i_rexiSimVars->terry_L,
+					i_rexiSimVars->terry_reduce_to_half, i_rexiSimVars->terry_normalization
+				);
+
+			// T-REXI doesn't provide gamma, hence o_gamma is left untouched
+			std::string cached_function_name;
+			std::complex<T> cached_gamma;
+			if (!REXICoefficientsCache<T>::load(i_rexiSimVars->rexi_coefficients_cache, cache_key, o_alpha, o_beta, cached_gamma, cached_function_name))
+			{
+				/// REXI stuff
+				REXI_Terry<T, T> rexi_terry;
+				rexi_terry.setup(i_function_name, i_rexiSimVars->terry_h, i_rexiSimVars->terry_M, i_rexiSimVars->terry_L, i_rexiSimVars->terry_reduce_to_half, i_rexiSimVars->terry_normalization);
+
+				o_alpha = rexi_terry.alpha;
+				o_beta = rexi_terry.beta;
 
-			o_alpha = rexi_terry.alpha;
-			o_beta = rexi_terry.beta;
+				REXICoefficientsCache<T>::store(i_rexiSimVars->rexi_coefficients_cache, cache_key, o_alpha, o_beta, std::complex<T>(0), i_function_name);
+			}
 		}
 		else if (i_rexiSimVars->exp_method == "ci")
 		{
 			std::cout << "WARNING: This way of using REXI is deprecated" << std::endl;
 			std::cout << "WARNING: Compile SWEET with quad precision if using an order > 2." << std::endl;
 
-			/// REXI stuff
-			REXI_CI<T, T> rexi_ci;
+			std::string cache_key = REXICoefficientsCache<T>::key_ci(
+					i_function_name,
+					i_rexiSimVars->ci_n, i_rexiSimVars->ci_primitive,
+					i_rexiSimVars->ci_max_real, i_rexiSimVars->ci_max_imag,
+					i_rexiSimVars->ci_s_real, i_rexiSimVars->ci_s_imag, i_rexiSimVars->ci_mu
+				);
 
-			if (i_rexiSimVars->ci_max_real >= 0)
-			{
-				rexi_ci.setup_shifted_circle(
-						i_function_name,
-						i_rexiSimVars->ci_n, i_rexiSimVars->ci_max_real, i_rexiSimVars->ci_max_imag
-					);
-			}
-			else
+			// CI-REXI doesn't provide gamma, hence o_gamma is left untouched
+			std::string cached_function_name;
+			std::complex<T> cached_gamma;
+			if (!REXICoefficientsCache<T>::load(i_rexiSimVars->rexi_coefficients_cache, cache_key, o_alpha, o_beta, cached_gamma, cached_function_name))
 			{
-				rexi_ci.setup(
-						i_function_name,
-						i_rexiSimVars->ci_n, i_rexiSimVars->ci_primitive, i_rexiSimVars->ci_s_real, i_rexiSimVars->ci_s_imag, i_rexiSimVars->ci_mu
-					);
+				/// REXI stuff
+				REXI_CI<T, T> rexi_ci;
+
+				if (i_rexiSimVars->ci_max_real >= 0)
+				{
+					rexi_ci.setup_shifted_circle(
+							i_function_name,
+							i_rexiSimVars->ci_n, i_rexiSimVars->ci_max_real, i_rexiSimVars->ci_max_imag
+						);
+				}
+				else
+				{
+					rexi_ci.setup(
+							i_function_name,
+							i_rexiSimVars->ci_n, i_rexiSimVars->ci_primitive, i_rexiSimVars->ci_s_real, i_rexiSimVars->ci_s_imag, i_rexiSimVars->ci_mu
+						);
+				}
+
+				o_alpha = rexi_ci.alpha;
+				o_beta = rexi_ci.beta;
+
+				REXICoefficientsCache<T>::store(i_rexiSimVars->rexi_coefficients_cache, cache_key, o_alpha, o_beta, std::complex<T>(0), i_function_name);
 			}
-
-			o_alpha = rexi_ci.alpha;
-			o_beta = rexi_ci.beta;
 		}
 		else if (i_rexiSimVars->exp_method == "direct")
 		{
@@ -158,7 +188,7 @@ public:
 			)
 			{
 				if (iter->function_name == i_function_name)
-					return o_rexiCoefficients.load_from_file(iter->filename);
+					return o_rexiCoefficients.load_from_file(iter->filename, i_rexiSimVars->rexi_coefficients_cache);
 			}
 
 			return false;
@@ -11,6 +11,7 @@
 #include <vector>
 #include <complex>
 #include <libmath/DQStuff.hpp>
+#include <rexi/REXICoefficientsCache.hpp>
 #include <fstream>
 
 
@@ -91,12 +92,26 @@ public:
 	 * # betas				<- betas start here
 	 * 5.1 -1
 	 * 3 1.3
+	 *
+	 * If a cache directory is given, the parsed coefficients are taken from
+	 * and stored in the REXI coefficient cache (see REXICoefficientsCache).
 	 */
 	bool load_from_file(
-			const std::string &i_filename
+			const std::string &i_filename,
+			const std::string &i_cache_dir = ""
 	)
 	{
 		filename = i_filename;
+
+		std::string cache_key;
+		if (i_cache_dir != "")
+		{
+			cache_key = REXICoefficientsCache<T>::key_file(i_filename);
+
+			if (REXICoefficientsCache<T>::load(i_cache_dir, cache_key, alphas, betas, gamma, function_name))
+				return true;
+		}
+
 		std::ifstream infile(i_filename, std::ios::in | std::ios::binary);
 
 		if (!infile.is_open())
@@ -250,8 +265,82 @@ public:
 			SWEETError("Size doesn't match!");
 		}
 
+		REXICoefficientsCache<T>::store(i_cache_dir, cache_key, alphas, betas, gamma, function_name);
+
 		return true;
 	}
+
+
+
+	/**
+	 * Merge conjugate-symmetric pole/weight pairs
+	 *
+	 *   (alpha, beta), (conj(alpha), conj(beta))  ->  (alpha, 2*beta)
+	 *
+	 * This is only valid if the REXI is applied to real-valued data with a
+	 * real-valued linear operator and if only the real part of the REXI sum
+	 * is used: The solution for the conjugate pole is then the complex
+	 * conjugate of the other one and both have the same real part.
+	 *
+	 * Poles without a conjugate partner are kept as they are.
+	 *
+	 * \return Number of merged pairs
+	 */
+	int reduce_conjugate_pairs(
+			double i_rel_tol = 1e-12
+	)
+	{
+		std::size_t N = alphas.size();
+
+		std::vector<bool> removed(N, false);
+		int num_pairs = 0;
+
+		for (std::size_t i = 0; i < N; i++)
+		{
+			if (removed[i])
+				continue;
+
+			// Self-conjugate poles stay as they are
+			if (alphas[i].imag() == 0)
+				continue;
+
+			double scale_alpha = std::abs(alphas[i]);
+			double scale_beta = std::abs(betas[i]);
+
+			for (std::size_t j = i+1; j < N; j++)
+			{
+				if (removed[j])
+					continue;
+
+				if (std::abs(alphas[j] - std::conj(alphas[i])) > i_rel_tol*scale_alpha)
+					continue;
+
+				if (std::abs(betas[j] - std::conj(betas[i])) > i_rel_tol*scale_beta)
+					continue;
+
+				betas[i] *= 2.0;
+				removed[j] = true;
+				num_pairs++;
+				break;
+			}
+		}
+
+		std::size_t k = 0;
+		for (std::size_t i = 0; i < N; i++)
+		{
+			if (removed[i])
+				continue;
+
+			alphas[k] = alphas[i];
+			betas[k] = betas[i];
+			k++;
+		}
+
+		alphas.resize(k);
+		betas.resize(k);
+
+		return num_pairs;
+	}
 };
 
 
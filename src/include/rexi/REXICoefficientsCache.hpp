@@ -0,0 +1,337 @@
+/*
+ * REXICoefficientsCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_REXI_REXI_COEFFICIENTS_CACHE_HPP__
+#define SRC_INCLUDE_REXI_REXI_COEFFICIENTS_CACHE_HPP__
+
+#include <vector>
+#include <complex>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+
+/*
+ * Persistent on-disk cache of REXI coefficient sets
+ *
+ * Computing T-REXI and CI-REXI coefficients (and parsing large text
+ * coefficient files) can take a considerable part of the runtime of short
+ * simulations. Computed sets are stored in a binary file in the cache
+ * directory which is shared across runs.
+ *
+ * The cache is content-addressed: The file name is given by a hash of a
+ * key string which contains all parameters of the coefficients (method,
+ * function name, h, M, L, reduce to half, normalization, ...) with the
+ * floating point values in exact hex representation and the size of the
+ * floating point type. The full key is also
+ * stored in the file and compared on loading to detect hash collisions.
+ *
+ * File layout (native endianness):
+ *   char[8] magic
+ *   uint64  sizeof(T)
+ *   uint64  length of key
+ *   uint64  length of function name
+ *   uint64  N
+ *   key, function name
+ *   gamma, alphas[N], betas[N] as std::complex<T>
+ *
+ * All errors are treated as cache misses.
+ */
+template <typename T = double>
+class REXICoefficientsCache
+{
+public:
+	typedef std::complex<T> TComplex;
+
+private:
+	static constexpr char magic[8] = {'S','W','R','E','X','I','1','\0'};
+
+
+	static
+	std::uint64_t p_hash(
+			const std::string &i_key
+	)
+	{
+		// FNV-1a
+		std::uint64_t hash = 14695981039346656037ull;
+		for (std::size_t i = 0; i < i_key.size(); i++)
+		{
+			hash ^= (unsigned char)i_key[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+
+	/*
+	 * Prefix of all keys: coefficients computed with different
+	 * floating point types must not share a cache file
+	 */
+	static
+	std::string p_key_prefix()
+	{
+		std::ostringstream ss;
+		ss << "sizeof_T=" << sizeof(T) << ";";
+		return ss.str();
+	}
+
+
+	static
+	std::string p_filepath(
+			const std::string &i_cache_dir,
+			const std::string &i_key
+	)
+	{
+		std::ostringstream ss;
+		ss << i_cache_dir << "/rexi_" << std::hex << std::setw(16) << std::setfill('0') << p_hash(i_key) << ".bin";
+		return ss.str();
+	}
+
+
+public:
+	/**
+	 * Key for T-REXI coefficients
+	 */
+	static
+	std::string key_terry(
+			const std::string &i_function_name,
+			double i_h,
+			int i_M,
+			int i_L,
+			bool i_reduce_to_half,
+			bool i_normalization
+	)
+	{
+		std::ostringstream ss;
+		ss << std::hexfloat;
+		ss << p_key_prefix() << "terry;" << i_function_name << ";h=" << i_h << ";M=" << i_M << ";L=" << i_L;
+		ss << ";reduce_to_half=" << i_reduce_to_half << ";normalization=" << i_normalization;
+		return ss.str();
+	}
+
+
+	/**
+	 * Key for CI-REXI coefficients
+	 */
+	static
+	std::string key_ci(
+			const std::string &i_function_name,
+			int i_n,
+			const std::string &i_primitive,
+			double i_max_real,
+			double i_max_imag,
+			double i_s_real,
+			double i_s_imag,
+			double i_mu
+	)
+	{
+		std::ostringstream ss;
+		ss << std::hexfloat;
+		ss << p_key_prefix() << "ci;" << i_function_name << ";n=" << i_n << ";primitive=" << i_primitive;
+		ss << ";max_real=" << i_max_real << ";max_imag=" << i_max_imag;
+		ss << ";s_real=" << i_s_real << ";s_imag=" << i_s_imag << ";mu=" << i_mu;
+		return ss.str();
+	}
+
+
+	/**
+	 * Key for coefficients loaded from a file.
+	 *
+	 * This includes the size and the modification time of the file.
+	 * An empty string is returned if the file doesn't exist.
+	 */
+	static
+	std::string key_file(
+			const std::string &i_filename
+	)
+	{
+		struct stat st;
+		if (stat(i_filename.c_str(), &st) != 0)
+			return "";
+
+		std::ostringstream ss;
+		ss << p_key_prefix() << "file;" << i_filename << ";size=" << st.st_size;
+		ss << ";mtime=" << st.st_mtim.tv_sec << "." << st.st_mtim.tv_nsec;
+		return ss.str();
+	}
+
+
+	/**
+	 * Load coefficients from the cache via mmap
+	 *
+	 * \return true if the coefficients were found in the cache
+	 */
+	static
+	bool load(
+			const std::string &i_cache_dir,
+			const std::string &i_key,
+
+			std::vector<TComplex> &o_alphas,
+			std::vector<TComplex> &o_betas,
+			TComplex &o_gamma,
+			std::string &o_function_name
+	)
+	{
+		if (i_cache_dir == "" || i_key == "")
+			return false;
+
+		std::string filepath = p_filepath(i_cache_dir, i_key);
+
+		int fd = open(filepath.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size < (off_t)(sizeof(magic) + 4*sizeof(std::uint64_t)))
+		{
+			close(fd);
+			return false;
+		}
+
+		std::size_t size = st.st_size;
+		void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (addr == MAP_FAILED)
+			return false;
+
+		const char *data = (const char*)addr;
+		bool retval = false;
+
+		do
+		{
+			if (std::memcmp(data, magic, sizeof(magic)) != 0)
+				break;
+
+			std::uint64_t header[4];
+			std::memcpy(header, data + sizeof(magic), sizeof(header));
+
+			std::uint64_t sizeof_T = header[0];
+			std::uint64_t key_len = header[1];
+			std::uint64_t name_len = header[2];
+			std::uint64_t N = header[3];
+
+			if (sizeof_T != sizeof(T))
+				break;
+
+			std::size_t offset = sizeof(magic) + sizeof(header);
+			if (size != offset + key_len + name_len + (2*N+1)*sizeof(TComplex))
+				break;
+
+			if (i_key.size() != key_len || std::memcmp(data + offset, i_key.data(), key_len) != 0)
+				break;
+			offset += key_len;
+
+			o_function_name.assign(data + offset, name_len);
+			offset += name_len;
+
+			std::memcpy((void*)&o_gamma, data + offset, sizeof(TComplex));
+			offset += sizeof(TComplex);
+
+			o_alphas.resize(N);
+			std::memcpy((void*)o_alphas.data(), data + offset, N*sizeof(TComplex));
+			offset += N*sizeof(TComplex);
+
+			o_betas.resize(N);
+			std::memcpy((void*)o_betas.data(), data + offset, N*sizeof(TComplex));
+
+			retval = true;
+		} while (0);
+
+		munmap(addr, size);
+		return retval;
+	}
+
+
+	/**
+	 * Store coefficients in the cache
+	 *
+	 * The file is written to a temporary file first and then renamed
+	 * which makes this safe for concurrent jobs using the same cache.
+	 */
+	static
+	bool store(
+			const std::string &i_cache_dir,
+			const std::string &i_key,
+
+			const std::vector<TComplex> &i_alphas,
+			const std::vector<TComplex> &i_betas,
+			const TComplex &i_gamma,
+			const std::string &i_function_name
+	)
+	{
+		if (i_cache_dir == "" || i_key == "")
+			return false;
+
+		if (i_alphas.size() != i_betas.size())
+			return false;
+
+		// Ignore errors, e.g., if the directory already exists
+		mkdir(i_cache_dir.c_str(), 0755);
+
+		std::string filepath = p_filepath(i_cache_dir, i_key);
+
+		std::ostringstream tmp_ss;
+		tmp_ss << filepath << ".tmp." << getpid();
+		std::string tmp_filepath = tmp_ss.str();
+
+		{
+			std::ofstream file(tmp_filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+				return false;
+
+			std::uint64_t header[4] = {
+					sizeof(T),
+					i_key.size(),
+					i_function_name.size(),
+					i_alphas.size()
+			};
+
+			file.write(magic, sizeof(magic));
+			file.write((const char*)header, sizeof(header));
+			file.write(i_key.data(), i_key.size());
+			file.write(i_function_name.data(), i_function_name.size());
+			file.write((const char*)&i_gamma, sizeof(TComplex));
+			file.write((const char*)i_alphas.data(), i_alphas.size()*sizeof(TComplex));
+			file.write((const char*)i_betas.data(), i_betas.size()*sizeof(TComplex));
+
+			if (!file.good())
+			{
+				file.close();
+				std::remove(tmp_filepath.c_str());
+				return false;
+			}
+		}
+
+		if (std::rename(tmp_filepath.c_str(), filepath.c_str()) != 0)
+		{
+			std::remove(tmp_filepath.c_str());
+			return false;
+		}
+
+		return true;
+	}
+};
+
+
+template <typename T>
+constexpr char REXICoefficientsCache<T>::magic[8];
+
+
+
+#endif
@@ -27,7 +27,8 @@ public:
 	 * Load REXI coefficients from filenames
 	 */
 	void setup_from_files(
-			const std::string &i_rexi_filenames
+			const std::string &i_rexi_filenames,
+			const std::string &i_cache_dir = ""		///< Directory of REXI coefficient cache
 	)
 	{
 		rexiCoefficientVector.clear();
@@ -51,12 +52,12 @@ public:
 			else if (split2.size() == 1)
 			{
 				REXICoefficients<T> rexiCoefficients;
-				rexiCoefficients.load_from_file(split2[0]);
+				rexiCoefficients.load_from_file(split2[0], i_cache_dir);
 			}
 			else if (split2.size() == 2)
 			{
 				REXICoefficients<T> rexiCoefficients;
-				rexiCoefficients.load_from_file(split2[1]);
+				rexiCoefficients.load_from_file(split2[1], i_cache_dir);
 
 				if (rexiCoefficients.filename != "")
 					if (rexiCoefficients.function_name != split2[0])
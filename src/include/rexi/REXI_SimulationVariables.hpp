@@ -130,6 +130,18 @@ struct EXP_SimulationVariables
 	 */
 	std::string rexi_files;
 
+	/*
+	 * Directory of the persistent on-disk cache of REXI coefficients
+	 * which is shared across runs, disabled if empty
+	 */
+	std::string rexi_coefficients_cache;
+
+	/*
+	 * Only solve for one pole of each conjugate-symmetric pole/weight pair
+	 * (only valid for real-valued data and operators)
+	 */
+	bool conjugate_pairs = false;
+
 	/***************************************************
 	 * Direct EXP
 	 */
@@ -166,6 +178,8 @@ public:
 		std::cout << " + taylor_num_expansions: " << taylor_num_expansions << std::endl;
 		std::cout << "REXI generic parameters:" << std::endl;
 		std::cout << " + rexi_sphere_solver_preallocation: " << sphere_solver_preallocation << std::endl;
+		std::cout << " + rexi_coefficients_cache: " << rexi_coefficients_cache << std::endl;
+		std::cout << " + rexi_conjugate_pairs: " << conjugate_pairs << std::endl;
 
 		std::cout << " [REXI Files]" << std::endl;
 		std::cout << " + rexi_files: " << rexi_files << std::endl;
@@ -199,6 +213,8 @@ public:
 		std::cout << "	--rexi-method [str]	Choose REXI method ('terry', 'file', 'direct'), default:0" << std::endl;
 		std::cout << std::endl;
 		std::cout << "	--rexi-sphere-preallocation [bool]	Use preallocation of SPH-REXI solver coefficients, default:1" << std::endl;
+		std::cout << "	--rexi-coefficients-cache [str]	Directory of cache for REXI coefficients shared across runs, default: '' (disabled)" << std::endl;
+		std::cout << "	--rexi-conjugate-pairs [bool]	Solve only one pole of conjugate pole/weight pairs (real-valued data), default:0" << std::endl;
 		std::cout << std::endl;
 		std::cout << "  REXI file interface:" << std::endl;
 		std::cout << "	--rexi-files [str]	REXI files: [function_name0:]filepath0,[function_name1:]filepath1,..." << std::endl;
@@ -300,6 +316,12 @@ public:
 		io_long_options[io_next_free_program_option] = {"exp-direct-precompute-phin", required_argument, 0, 256+io_next_free_program_option};
 		io_next_free_program_option++;
 
+		io_long_options[io_next_free_program_option] = {"rexi-coefficients-cache", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"rexi-conjugate-pairs", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
 	}
 
 
@@ -365,6 +387,8 @@ public:
 			case 15:	ci_s_imag = atof(optarg);	return -1;
 			case 16:	ci_mu = atof(optarg);	return -1;
 			case 17:	exp_direct_precompute_phin = atoi(optarg);	return -1;
+			case 18:	rexi_coefficients_cache = optarg;	return -1;
+			case 19:	conjugate_pairs = atoi(optarg);	return -1;
 		}
 
 		if (rexi_files_given)
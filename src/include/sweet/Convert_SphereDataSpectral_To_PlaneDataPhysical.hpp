@@ -10,6 +10,7 @@
 
 #include <sweet/plane/PlaneData_Physical.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/GridLayoutTranspose.hpp>
 
 class Convert_SphereDataSpectral_To_PlaneDataPhysical
 {
@@ -24,23 +25,23 @@ public:
 		assert(i_sphereDataSpectral.sphereDataConfig->physical_num_lat == (int)i_planeDataConfig->physical_res[1]);
 		assert(i_planeDataConfig->physical_array_data_number_of_elements == i_sphereDataSpectral.sphereDataConfig->physical_array_data_number_of_elements);
 
-		SphereData_Physical i_sphereData = i_sphereDataSpectral.toPhys();
-
 		PlaneData_Physical out(i_planeDataConfig);
 
-
-
 #if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
 
-		SWEET_THREADING_SPACE_PARALLEL_FOR
-		for (int i = 0; i < i_sphereData.sphereDataConfig->physical_num_lon; i++)
-			for (int j = 0; j < i_sphereData.sphereDataConfig->physical_num_lat; j++)
-				out.physical_space_data[(i_sphereData.sphereDataConfig->physical_num_lat-1-j)*i_sphereData.sphereDataConfig->physical_num_lon + i] = i_sphereData.physical_space_data[i*i_sphereData.sphereDataConfig->physical_num_lat + j];
+		SphereData_Physical i_sphereData = i_sphereDataSpectral.toPhys();
+		GridLayoutTranspose::sphere_to_plane(i_sphereData.sphereDataConfig, i_sphereData.physical_space_data, out.physical_space_data);
+
 #else
-		SWEET_THREADING_SPACE_PARALLEL_FOR
-		for (int j = 0; j < i_sphereData.sphereDataConfig->physical_num_lat; j++)
-			for (int i = 0; i < i_sphereData.sphereDataConfig->physical_num_lon; i++)
-				out.physical_space_data[(i_sphereData.sphereDataConfig->physical_num_lat-1-j)*i_sphereData.sphereDataConfig->physical_num_lon + i] = i_sphereData.physical_space_data[j*i_sphereData.sphereDataConfig->physical_num_lon + i];
+
+		/*
+		 * Transform directly to the output array and flip the latitudes in place.
+		 * A copy of the spectral data is required since the transformation is destructive.
+		 */
+		SphereData_Spectral tmp(i_sphereDataSpectral);
+		SH_to_spat(tmp.sphereDataConfig->shtns, tmp.spectral_space_data, out.physical_space_data);
+		GridLayoutTranspose::sphere_to_plane(tmp.sphereDataConfig, out.physical_space_data, out.physical_space_data);
+
 #endif
 
 		return out;
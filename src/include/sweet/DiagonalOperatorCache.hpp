@@ -0,0 +1,237 @@
+/*
+ * DiagonalOperatorCache.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_DIAGONALOPERATORCACHE_HPP_
+#define SRC_INCLUDE_SWEET_DIAGONALOPERATORCACHE_HPP_
+
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <cstddef>
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
+
+
+
+/*
+ * Kinds of cached operators
+ */
+enum DiagonalOperatorKind
+{
+	DIAGONAL_OPERATOR_HELMHOLTZ,
+	DIAGONAL_OPERATOR_HELMHOLTZ_HIGHER_ORDER,
+	DIAGONAL_OPERATOR_IMPLICIT_HYPERDIFFUSION,
+	DIAGONAL_OPERATOR_IMPLICIT_DIFFUSION
+};
+
+
+
+/*
+ * Cache of operators which are diagonal in spectral space
+ * (implicit diffusion, Helmholtz solvers, ...)
+ *
+ * Operators are identified by the data config, the shape of its
+ * spectral space, the kind of the operator and its parameters.
+ * The shape is part of the key since a new data config might be
+ * allocated at the address of a freed one.
+ *
+ * The cache is shared by all threads. Lookups and insertions are
+ * synchronized and the operators are handed out as shared pointers,
+ * hence they can be used concurrently (e.g. by Parareal thread groups
+ * or XBraid tasks) and stay valid if they are evicted meanwhile.
+ * Only the most recently used operators are kept.
+ */
+template <typename T>
+class DiagonalOperatorCache
+{
+public:
+	typedef std::array<double, 6> Params;
+
+	/// Maximum number of cached operators
+	static const std::size_t max_entries = 32;
+
+private:
+	struct Key
+	{
+		const void *config;
+		std::array<std::size_t, 2> shape;
+		int kind;
+		Params params;
+
+		bool operator<(const Key &i_key)	const
+		{
+			return std::tie(config, shape, kind, params) < std::tie(i_key.config, i_key.shape, i_key.kind, i_key.params);
+		}
+	};
+
+	typedef std::list<Key> LRUList;
+
+	struct Entry
+	{
+		std::shared_ptr<const T> op;
+		typename LRUList::iterator lru_iter;
+	};
+
+	std::map<Key, Entry> entries;
+
+	/// Keys from the most to the least recently used one
+	LRUList lru;
+
+	std::size_t num_hits = 0;
+	std::size_t num_misses = 0;
+
+
+	static
+	DiagonalOperatorCache& getSingletonRef()
+	{
+		static DiagonalOperatorCache cache;
+		return cache;
+	}
+
+
+	/*
+	 * Return cached operator or nullptr. Requires synchronization.
+	 */
+	std::shared_ptr<const T> p_lookup(
+			const Key &i_key
+	)
+	{
+		typename std::map<Key, Entry>::iterator iter = entries.find(i_key);
+
+		if (iter == entries.end())
+		{
+			num_misses++;
+			return std::shared_ptr<const T>();
+		}
+
+		num_hits++;
+		lru.splice(lru.begin(), lru, iter->second.lru_iter);
+		return iter->second.op;
+	}
+
+
+	/*
+	 * Insert operator unless another thread was faster and return
+	 * the cached one. Requires synchronization.
+	 */
+	std::shared_ptr<const T> p_insert(
+			const Key &i_key,
+			const std::shared_ptr<const T> &i_op
+	)
+	{
+		typename std::map<Key, Entry>::iterator iter = entries.find(i_key);
+		if (iter != entries.end())
+			return iter->second.op;
+
+		lru.push_front(i_key);
+
+		Entry &e = entries[i_key];
+		e.op = i_op;
+		e.lru_iter = lru.begin();
+
+		if (entries.size() > max_entries)
+		{
+			entries.erase(lru.back());
+			lru.pop_back();
+		}
+
+		return i_op;
+	}
+
+
+public:
+	/**
+	 * Return the operator for the given data config and parameters
+	 *
+	 * If it's not cached yet, i_setup(T &) is called to set it up.
+	 * The setup is done outside of the critical region.
+	 */
+	template <typename TSetup>
+	static
+	std::shared_ptr<const T> get(
+			const void *i_config,					///< data config
+			const std::array<std::size_t, 2> &i_shape,	///< shape of spectral space of data config
+			int i_kind,								///< kind of operator, defined by caller
+			const Params &i_params,					///< parameters of operator
+			TSetup i_setup
+	)
+	{
+		DiagonalOperatorCache &c = getSingletonRef();
+
+		Key key;
+		key.config = i_config;
+		key.shape = i_shape;
+		key.kind = i_kind;
+		key.params = i_params;
+
+		std::shared_ptr<const T> op;
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	pragma omp critical (diagonal_operator_cache)
+#endif
+		op = c.p_lookup(key);
+
+		if (op)
+			return op;
+
+		std::shared_ptr<T> new_op = std::make_shared<T>();
+		i_setup(*new_op);
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	pragma omp critical (diagonal_operator_cache)
+#endif
+		op = c.p_insert(key, new_op);
+
+		return op;
+	}
+
+
+	/**
+	 * Number of cache hits and misses since the last clear()
+	 */
+	static
+	void get_statistics(
+			std::size_t &o_num_hits,
+			std::size_t &o_num_misses
+	)
+	{
+		DiagonalOperatorCache &c = getSingletonRef();
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	pragma omp critical (diagonal_operator_cache)
+#endif
+		{
+			o_num_hits = c.num_hits;
+			o_num_misses = c.num_misses;
+		}
+	}
+
+
+	static
+	void clear()
+	{
+		DiagonalOperatorCache &c = getSingletonRef();
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	pragma omp critical (diagonal_operator_cache)
+#endif
+		{
+			c.entries.clear();
+			c.lru.clear();
+			c.num_hits = 0;
+			c.num_misses = 0;
+		}
+	}
+};
+
+
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * GridLayoutTranspose.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_GRIDLAYOUTTRANSPOSE_HPP_
+#define SRC_INCLUDE_SWEET_GRIDLAYOUTTRANSPOSE_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <sweet/openmp_helper.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+
+
+
+/*
+ * Conversions between the physical grid layouts of sphere and plane data
+ *
+ * Sphere data is stored with the latitudes from north to south and
+ * either longitude (SPHERE_DATA_LON_CONTINUOUS) or latitude contiguous
+ * (SPHERE_DATA_LAT_CONTINUOUS) in memory. Plane data is stored longitude
+ * contiguous with the latitudes from south to north.
+ *
+ * Transposes are processed in square tiles which fit into the L1 cache.
+ * Each tile is read row by row into a local buffer and written row by
+ * row to the destination. This keeps all accesses to main memory
+ * contiguous and the innermost loops can be vectorized.
+ */
+class GridLayoutTranspose
+{
+public:
+	/// Size of tiles for blocked transposes
+	static const int block_size = 32;
+
+
+	/**
+	 * Transpose a matrix stored in row-major order
+	 *
+	 * o_dst[c*i_num_rows + r] = i_src[r*i_num_cols + c]
+	 *
+	 * If i_reverse_dst_rows is set, the rows of the destination are
+	 * stored in reversed order, i.e. row c is written to row (i_num_cols-1-c).
+	 */
+	static
+	void transpose(
+			const double *i_src,
+			int i_num_rows,
+			int i_num_cols,
+			double *o_dst,
+			bool i_reverse_dst_rows = false
+	)
+	{
+		assert(i_src != o_dst);
+
+		int num_block_rows = (i_num_rows + block_size - 1)/block_size;
+		int num_block_cols = (i_num_cols + block_size - 1)/block_size;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for collapse(2)
+#endif
+		for (int br = 0; br < num_block_rows; br++)
+		{
+			for (int bc = 0; bc < num_block_cols; bc++)
+			{
+				int r0 = br*block_size;
+				int c0 = bc*block_size;
+				int nr = std::min(block_size, i_num_rows-r0);
+				int nc = std::min(block_size, i_num_cols-c0);
+
+				double tile[block_size*block_size];
+
+				// contiguous reads of source rows
+				for (int r = 0; r < nr; r++)
+				{
+					const double *src = &i_src[(std::size_t)(r0+r)*i_num_cols + c0];
+					for (int c = 0; c < nc; c++)
+						tile[c*block_size + r] = src[c];
+				}
+
+				// contiguous writes of destination rows
+				for (int c = 0; c < nc; c++)
+				{
+					int dst_row = i_reverse_dst_rows ? i_num_cols-1-(c0+c) : c0+c;
+					double *dst = &o_dst[(std::size_t)dst_row*i_num_rows + r0];
+					const double *t = &tile[c*block_size];
+
+#if SWEET_SIMD_ENABLE
+#pragma omp simd
+#endif
+					for (int r = 0; r < nr; r++)
+						dst[r] = t[r];
+				}
+			}
+		}
+	}
+
+
+
+	/**
+	 * Copy a matrix stored in row-major order with reversed row order
+	 *
+	 * o_dst[(i_num_rows-1-r)*i_num_cols + c] = i_src[r*i_num_cols + c]
+	 *
+	 * This also works in place (i_src == o_dst).
+	 */
+	static
+	void reverse_rows(
+			const double *i_src,
+			int i_num_rows,
+			int i_num_cols,
+			double *o_dst
+	)
+	{
+		if (i_src == o_dst)
+		{
+			// swap rows from both ends
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+			for (int r = 0; r < i_num_rows/2; r++)
+			{
+				double *a = &o_dst[(std::size_t)r*i_num_cols];
+				double *b = &o_dst[(std::size_t)(i_num_rows-1-r)*i_num_cols];
+
+#if SWEET_SIMD_ENABLE
+#pragma omp simd
+#endif
+				for (int c = 0; c < i_num_cols; c++)
+				{
+					double tmp = a[c];
+					a[c] = b[c];
+					b[c] = tmp;
+				}
+			}
+			return;
+		}
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+		for (int r = 0; r < i_num_rows; r++)
+		{
+			std::memcpy(
+					&o_dst[(std::size_t)(i_num_rows-1-r)*i_num_cols],
+					&i_src[(std::size_t)r*i_num_cols],
+					sizeof(double)*i_num_cols
+				);
+		}
+	}
+
+
+
+	/**
+	 * Sphere physical layout to plane physical layout
+	 *
+	 * For SPHERE_DATA_LON_CONTINUOUS, this also works in place.
+	 */
+	static
+	void sphere_to_plane(
+			const SphereData_Config *i_sphereDataConfig,
+			const double *i_sphere_data,
+			double *o_plane_data
+	)
+	{
+		int num_lon = i_sphereDataConfig->physical_num_lon;
+		int num_lat = i_sphereDataConfig->physical_num_lat;
+
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		// [lon][lat] -> [num_lat-1-lat][lon]
+		transpose(i_sphere_data, num_lon, num_lat, o_plane_data, true);
+#else
+		// [lat][lon] -> [num_lat-1-lat][lon]
+		reverse_rows(i_sphere_data, num_lat, num_lon, o_plane_data);
+#endif
+	}
+
+
+
+	/**
+	 * Plane physical layout to sphere physical layout
+	 *
+	 * For SPHERE_DATA_LON_CONTINUOUS, this also works in place.
+	 */
+	static
+	void plane_to_sphere(
+			const SphereData_Config *i_sphereDataConfig,
+			const double *i_plane_data,
+			double *o_sphere_data
+	)
+	{
+		int num_lon = i_sphereDataConfig->physical_num_lon;
+		int num_lat = i_sphereDataConfig->physical_num_lat;
+
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		// [num_lat-1-lat][lon] -> [lon][lat]
+		transpose(i_plane_data, num_lat, num_lon, o_sphere_data);
+
+		// reverse latitudes in each contiguous column
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+		for (int i = 0; i < num_lon; i++)
+			std::reverse(&o_sphere_data[(std::size_t)i*num_lat], &o_sphere_data[(std::size_t)(i+1)*num_lat]);
+#else
+		reverse_rows(i_plane_data, num_lat, num_lon, o_sphere_data);
+#endif
+	}
+
+
+
+	/**
+	 * Sphere physical layout to longitude contiguous layout
+	 * with the latitudes from north to south
+	 *
+	 * \return pointer to data in this layout which is either the
+	 * sphere data itself or o_buffer
+	 */
+	static
+	const double* sphere_to_lon_contiguous(
+			const SphereData_Config *i_sphereDataConfig,
+			const double *i_sphere_data,
+			double *o_buffer
+	)
+	{
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		transpose(i_sphere_data, i_sphereDataConfig->physical_num_lon, i_sphereDataConfig->physical_num_lat, o_buffer);
+		return o_buffer;
+#else
+		return i_sphere_data;
+#endif
+	}
+};
+
+
+
+#endif
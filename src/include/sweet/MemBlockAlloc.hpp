@@ -7,6 +7,7 @@
  * Changelog:
  *   - 2021-12-23: Made fully configurable via environment variable
  *   - 2022-01-08: Various updates to help finding bugs, more information if used with help
+ *   - 2026-10-19: Accounting of memory per data type and subsystem
  *
  */
 #ifndef INCLUDE_MEMBLOCKALLOC_NEW_HPP_
@@ -20,7 +21,11 @@
 #include <cstdlib>
 #include <cassert>
 #include <iostream>
+#include <fstream>
 #include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
 
 #include <stdexcept>
 #include <cstdlib>
@@ -113,6 +118,11 @@ class MemBlockAlloc
 		 " 		1: Enable verbose mode during initialization\n"
 		 " 		9: Print information on allocating / releasing memory\n"
 		 "\n"
+		 " 	accounting=[int]\n"
+		 " 		0: Disabled\n"
+		 " 		1: Track current and peak memory per data type and subsystem tag\n"
+		 " 		   and print a report at exit\n"
+		 "\n"
 		 " 	firsttouch=[int]\n"
 		 " 		0: Disabled\n"
 		 " 		1: Enabled, threaded with 'omp parallel for'\n"
@@ -164,6 +174,11 @@ class MemBlockAlloc
 	 */
 	int verbosity_level = 1;
 
+	/**
+	 * Accounting of allocated memory
+	 */
+	int accounting = 0;
+
 	/**
 	 * Number of allocation domains
 	 *
@@ -219,6 +234,76 @@ private:
 	bool _setup_done = false;
 
 
+public:
+	/**
+	 * Memory statistics of a data type or subsystem tag
+	 */
+	class AccountingStats
+	{
+	public:
+		std::size_t current_bytes = 0;
+		std::size_t peak_bytes = 0;
+		std::size_t num_allocs = 0;
+
+		void add(std::size_t i_size)
+		{
+			current_bytes += i_size;
+			num_allocs++;
+			if (current_bytes > peak_bytes)
+				peak_bytes = current_bytes;
+		}
+
+		void sub(std::size_t i_size)
+		{
+			assert(current_bytes >= i_size);
+			current_bytes -= i_size;
+		}
+	};
+
+
+private:
+	/**
+	 * Data type and tag of a block in use
+	 */
+	struct AccountingBlock
+	{
+		int type_id;
+		int tag_id;
+	};
+
+	/// names of data types and subsystem tags
+	std::vector<std::string> _accounting_type_names;
+	std::vector<std::string> _accounting_tag_names;
+
+	std::vector<AccountingStats> _accounting_types;
+	std::vector<AccountingStats> _accounting_tags;
+
+	/// memory in use by the program
+	AccountingStats _accounting_in_use;
+
+	/// memory allocated from the system (including cached free blocks)
+	AccountingStats _accounting_reserved;
+
+	/// memory in use of each tag at the time of the peak of memory in use
+	std::vector<std::size_t> _accounting_tags_at_peak;
+
+	/// blocks in use
+	std::unordered_map<void*, AccountingBlock> _accounting_blocks;
+
+	/**
+	 * Current subsystem tag of this thread, see MemBlockAllocTag
+	 *
+	 * Tags are per thread since e.g. Parareal thread groups or XBraid
+	 * tasks run different subsystems concurrently.
+	 */
+	static
+	int& getThreadLocalAccountingTagRef()
+	{
+		static thread_local int tag_id = 0;
+		return tag_id;
+	}
+
+
 
 private:
 	inline
@@ -247,6 +332,7 @@ private:
 		std::cout << MEMBLOCKALLOC_PREFIX "*** MemBlockAlloc VERBOSE information ***" << std::endl;
 		std::cout << MEMBLOCKALLOC_PREFIX " + verbosity_level: " << verbosity_level << std::endl;
 		std::cout << MEMBLOCKALLOC_PREFIX " + first_touch_policy: " << first_touch_policy << std::endl;
+		std::cout << MEMBLOCKALLOC_PREFIX " + accounting: " << accounting << std::endl;
 		std::cout << MEMBLOCKALLOC_PREFIX " + mem_block_allocation_mode: ";
 
 		if (mem_block_allocation_mode == MEMBLOCKALLOC_MODE__SYSTEM)
@@ -322,6 +408,17 @@ private:
 				else
 					verbosity_level = std::atoi(split_params[1].c_str());
 			}
+			else if (split_params[0] == "accounting")
+			{
+				/*
+				 * Parse, e.g.,
+				 * 	accounting=1
+				 */
+				if (split_params.size() == 1)
+					accounting = 1;
+				else
+					accounting = std::atoi(split_params[1].c_str());
+			}
 			else if (split_params[0] == "firsttouch")
 			{
 				/*
@@ -516,10 +613,296 @@ public:
 
 		_domain_block_groups.resize(_num_block_chain_domains);
 
+		// allocations without type and tag
+		_accounting_type_names.push_back("untyped");
+		_accounting_types.resize(1);
+		_accounting_tag_names.push_back("untagged");
+		_accounting_tags.resize(1);
+		_accounting_tags_at_peak.resize(1, 0);
+
 		_setup_done = true;
 	}
 
 
+private:
+	/**
+	 * Return id of name, add it if it doesn't exist
+	 */
+	static
+	int p_accounting_get_id(
+			const char *i_name,
+			std::vector<std::string> &io_names,
+			std::vector<AccountingStats> &io_stats
+	)
+	{
+		if (i_name == nullptr)
+			return 0;
+
+		for (std::size_t i = 0; i < io_names.size(); i++)
+			if (io_names[i] == i_name)
+				return i;
+
+		io_names.push_back(i_name);
+		io_stats.resize(io_names.size());
+		return io_names.size()-1;
+	}
+
+
+	/**
+	 * Account a block which is going to be used by the program
+	 */
+	void p_accounting_alloc(
+			void *i_data,
+			std::size_t i_size,
+			bool i_new_block,
+			const char *i_type
+	)
+	{
+#if MEMBLOCKALLOC_ENABLE_OMP
+#	pragma omp critical (memblockalloc_accounting)
+#endif
+		{
+			AccountingBlock b;
+			b.type_id = p_accounting_get_id(i_type, _accounting_type_names, _accounting_types);
+			b.tag_id = getThreadLocalAccountingTagRef();
+			_accounting_blocks[i_data] = b;
+
+			_accounting_types[b.type_id].add(i_size);
+			_accounting_tags[b.tag_id].add(i_size);
+
+			if (i_new_block)
+				_accounting_reserved.add(i_size);
+
+			_accounting_in_use.add(i_size);
+
+			// snapshot of tags at new peak
+			if (_accounting_in_use.current_bytes == _accounting_in_use.peak_bytes)
+			{
+				_accounting_tags_at_peak.resize(_accounting_tags.size());
+				for (std::size_t i = 0; i < _accounting_tags.size(); i++)
+					_accounting_tags_at_peak[i] = _accounting_tags[i].current_bytes;
+			}
+		}
+	}
+
+
+	/**
+	 * Account a block which is released by the program
+	 */
+	void p_accounting_free(
+			void *i_data,
+			std::size_t i_size,
+			bool i_release_block
+	)
+	{
+#if MEMBLOCKALLOC_ENABLE_OMP
+#	pragma omp critical (memblockalloc_accounting)
+#endif
+		{
+			std::unordered_map<void*, AccountingBlock>::iterator it = _accounting_blocks.find(i_data);
+
+			// blocks allocated before accounting was enabled are ignored
+			if (it != _accounting_blocks.end())
+			{
+				_accounting_types[it->second.type_id].sub(i_size);
+				_accounting_tags[it->second.tag_id].sub(i_size);
+				_accounting_in_use.sub(i_size);
+
+				if (i_release_block)
+					_accounting_reserved.sub(i_size);
+
+				_accounting_blocks.erase(it);
+			}
+		}
+	}
+
+
+	/**
+	 * Peak resident set size of the process in bytes (0 if not available)
+	 */
+	static
+	std::size_t p_get_process_peak_rss()
+	{
+		std::ifstream f("/proc/self/status");
+		std::string line;
+
+		while (std::getline(f, line))
+			if (line.compare(0, 6, "VmHWM:") == 0)
+				return std::atoll(line.c_str()+6)*1024;
+
+		return 0;
+	}
+
+
+public:
+	/**
+	 * Return whether accounting is enabled
+	 */
+	static
+	bool accounting_enabled()
+	{
+		return getSingletonRef().accounting != 0;
+	}
+
+
+	/**
+	 * Set the subsystem tag of following allocations and return the previous one
+	 *
+	 * Use MemBlockAllocTag instead of calling this directly.
+	 */
+	static
+	int accounting_set_tag(
+			const char *i_tag
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		int prev_tag = getThreadLocalAccountingTagRef();
+
+		if (n.accounting)
+		{
+#if MEMBLOCKALLOC_ENABLE_OMP
+#	pragma omp critical (memblockalloc_accounting)
+#endif
+			{
+				getThreadLocalAccountingTagRef() = p_accounting_get_id(i_tag, n._accounting_tag_names, n._accounting_tags);
+				n._accounting_tags_at_peak.resize(n._accounting_tags.size(), 0);
+			}
+		}
+
+		return prev_tag;
+	}
+
+
+	static
+	void accounting_restore_tag(
+			int i_tag_id
+	)
+	{
+		getThreadLocalAccountingTagRef() = i_tag_id;
+	}
+
+
+	/**
+	 * Return the subsystem tag of the current thread
+	 *
+	 * This is used to hand over the tag to the threads of a parallel region.
+	 */
+	static
+	int accounting_get_tag_id()
+	{
+		return getThreadLocalAccountingTagRef();
+	}
+
+
+	/**
+	 * Statistics of memory in use by the program
+	 */
+	static
+	AccountingStats accounting_get_in_use()
+	{
+		return getSingletonRef()._accounting_in_use;
+	}
+
+
+	/**
+	 * Statistics of memory allocated from the system
+	 */
+	static
+	AccountingStats accounting_get_reserved()
+	{
+		return getSingletonRef()._accounting_reserved;
+	}
+
+
+	/**
+	 * Statistics of a data type (empty if it doesn't exist)
+	 */
+	static
+	AccountingStats accounting_get_type(
+			const std::string &i_type
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		for (std::size_t i = 0; i < n._accounting_type_names.size(); i++)
+			if (n._accounting_type_names[i] == i_type)
+				return n._accounting_types[i];
+
+		return AccountingStats();
+	}
+
+
+	/**
+	 * Statistics of a subsystem tag (empty if it doesn't exist)
+	 */
+	static
+	AccountingStats accounting_get_tag(
+			const std::string &i_tag
+	)
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		for (std::size_t i = 0; i < n._accounting_tag_names.size(); i++)
+			if (n._accounting_tag_names[i] == i_tag)
+				return n._accounting_tags[i];
+
+		return AccountingStats();
+	}
+
+
+	/**
+	 * Print report of current and peak memory per data type and subsystem tag
+	 *
+	 * This can be called at any time, e.g. after setting up a simulation.
+	 */
+	static
+	void output_accounting()
+	{
+		MemBlockAlloc &n = getSingletonRef();
+
+		if (!n.accounting)
+			return;
+
+#if MEMBLOCKALLOC_ENABLE_OMP
+#	pragma omp critical (memblockalloc_accounting)
+#endif
+		{
+			std::cout << "[MULE] memblockalloc.in_use.current_bytes: " << n._accounting_in_use.current_bytes << std::endl;
+			std::cout << "[MULE] memblockalloc.in_use.peak_bytes: " << n._accounting_in_use.peak_bytes << std::endl;
+			std::cout << "[MULE] memblockalloc.in_use.num_allocs: " << n._accounting_in_use.num_allocs << std::endl;
+			std::cout << "[MULE] memblockalloc.reserved.current_bytes: " << n._accounting_reserved.current_bytes << std::endl;
+			std::cout << "[MULE] memblockalloc.reserved.peak_bytes: " << n._accounting_reserved.peak_bytes << std::endl;
+			std::cout << "[MULE] memblockalloc.process_peak_rss_bytes: " << p_get_process_peak_rss() << std::endl;
+
+			for (std::size_t i = 0; i < n._accounting_types.size(); i++)
+			{
+				const AccountingStats &a = n._accounting_types[i];
+				if (a.num_allocs == 0)
+					continue;
+
+				std::string prefix = "[MULE] memblockalloc.type." + n._accounting_type_names[i];
+				std::cout << prefix << ".current_bytes: " << a.current_bytes << std::endl;
+				std::cout << prefix << ".peak_bytes: " << a.peak_bytes << std::endl;
+				std::cout << prefix << ".num_allocs: " << a.num_allocs << std::endl;
+			}
+
+			for (std::size_t i = 0; i < n._accounting_tags.size(); i++)
+			{
+				const AccountingStats &a = n._accounting_tags[i];
+				if (a.num_allocs == 0)
+					continue;
+
+				std::string prefix = "[MULE] memblockalloc.tag." + n._accounting_tag_names[i];
+				std::cout << prefix << ".current_bytes: " << a.current_bytes << std::endl;
+				std::cout << prefix << ".peak_bytes: " << a.peak_bytes << std::endl;
+				std::cout << prefix << ".bytes_at_peak: " << n._accounting_tags_at_peak[i] << std::endl;
+				std::cout << prefix << ".num_allocs: " << a.num_allocs << std::endl;
+			}
+		}
+	}
+
+
 	static
 	inline
 	void init()
@@ -650,11 +1033,15 @@ public:
 	static
 	inline
 	T *alloc(
-			std::size_t i_size		///< size of block
+			std::size_t i_size,		///< size of block
+			const char *i_type = nullptr	///< data type for accounting
 	)
 	{
 		T *data = nullptr;
 
+		// block is newly allocated from the system
+		bool new_block = true;
+
 		int _mem_block_allocation_mode = getSingletonRef().mem_block_allocation_mode;
 
 		if (_mem_block_allocation_mode == MEMBLOCKALLOC_MODE__SYSTEM)
@@ -682,6 +1069,8 @@ public:
 				data = (T*)getBlockSameSize(i_size);
 			}
 
+			new_block = (data == nullptr);
+
 			if (data == nullptr)
 			{
 				int retval = posix_memalign((void**)&data, 4096, i_size);
@@ -700,6 +1089,8 @@ public:
 		{
 			data = (T*)getBlockSameSize(i_size);
 
+			new_block = (data == nullptr);
+
 			if (data == nullptr)
 			{
 				data = (T*)numa_alloc_local(i_size);
@@ -717,6 +1108,8 @@ public:
 				data = (T*)getBlockSameSize(i_size);
 			}
 
+			new_block = (data == nullptr);
+
 			if (data == nullptr)
 			{
 				// Allocate block
@@ -732,9 +1125,12 @@ public:
 			return nullptr;
 		}
 
-#if MEMBLOCKALLOC_DEBUG
 		MemBlockAlloc &n = MemBlockAlloc::getSingletonRef();
 
+		if (n.accounting)
+			n.p_accounting_alloc(data, i_size, new_block, i_type);
+
+#if MEMBLOCKALLOC_DEBUG
 		if (n.verbosity_level >= 100)
 			std::cout << "ALLOC " << (long long)data << ", " << i_size << std::endl;
 #endif
@@ -772,6 +1168,9 @@ public:
 
 		int _mem_block_allocation_mode = n.mem_block_allocation_mode;
 
+		if (n.accounting)
+			n.p_accounting_free(i_data, i_size, _mem_block_allocation_mode == MEMBLOCKALLOC_MODE__SYSTEM);
+
 		if (_mem_block_allocation_mode == MEMBLOCKALLOC_MODE__SYSTEM)
 		{
 			::free(i_data);
@@ -806,6 +1205,9 @@ public:
 			std::cout << MEMBLOCKALLOC_PREFIX << "~MemBlockAlloc() called (deconstructor, should be called only once)" << std::endl;
 		}
 
+		if (accounting)
+			output_accounting();
+
 		getSingletonRef()._shutdown();
 
 		if (verbosity_level > 1)
@@ -862,4 +1264,53 @@ public:
 };
 
 
+/**
+ * Set the subsystem tag of all allocations in the current scope, e.g.
+ *
+ *   MemBlockAllocTag tag("rexi");
+ *
+ * Tags are set for the current thread only. Allocations of other threads
+ * (e.g. in nested parallel regions) are not tagged. To tag them, hand
+ * over the tag of the current thread to each thread of the region:
+ *
+ *   int tag_id = MemBlockAlloc::accounting_get_tag_id();
+ *
+ *   #pragma omp parallel for
+ *   for (...)
+ *   {
+ *     MemBlockAllocTag tag(tag_id);
+ *     ...
+ *   }
+ *
+ * Tags given by name should be set during the setup and not in time
+ * steps, since registering the name requires a critical region.
+ * The previous tag is restored at the end of the scope.
+ */
+class MemBlockAllocTag
+{
+	int prev_tag_id;
+
+public:
+	MemBlockAllocTag(
+			const char *i_tag
+	)
+	{
+		prev_tag_id = MemBlockAlloc::accounting_set_tag(i_tag);
+	}
+
+	MemBlockAllocTag(
+			int i_tag_id		///< tag from MemBlockAlloc::accounting_get_tag_id()
+	)
+	{
+		prev_tag_id = MemBlockAlloc::accounting_get_tag_id();
+		MemBlockAlloc::accounting_restore_tag(i_tag_id);
+	}
+
+	~MemBlockAllocTag()
+	{
+		MemBlockAlloc::accounting_restore_tag(prev_tag_id);
+	}
+};
+
+
 #endif
@@ -0,0 +1,148 @@
+/*
+ * NormalModeColumnAssembly.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_NORMALMODECOLUMNASSEMBLY_HPP_
+#define SRC_INCLUDE_SWEET_NORMALMODECOLUMNASSEMBLY_HPP_
+
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+#if SWEET_MPI
+#include <mpi.h>
+#endif
+
+
+
+/*
+ * Distribution of the columns of the brute-force normal mode analysis
+ * (one time step per perturbed degree of freedom) across MPI ranks.
+ *
+ * Column c is computed by rank (c % size). All columns are written in
+ * their original order by rank 0 which receives each column right after
+ * it has written the previous one. Hence, the output file is identical
+ * to the one of a serial run and only a single row is kept in memory.
+ *
+ * Time steppers using MPI (e.g. REXI with its terms distributed across
+ * ranks) rely on collective operations, hence all ranks have to run each
+ * time step. For these, the columns are replicated: each rank computes
+ * all columns and no rows are sent.
+ *
+ * Usage for each column c:
+ *
+ *   if (!nmca.is_active(c))
+ *       continue;
+ *
+ *   if (nmca.is_owner(c))
+ *       ... run time step and fill row ...
+ *
+ *   nmca.gather(c, row);
+ *
+ *   if (nmca.is_writer())
+ *       nmca.write(file, row);
+ */
+class NormalModeColumnAssembly
+{
+	int rank;
+	int size;
+
+	/// Columns are replicated on all ranks if the time stepper communicates over MPI
+	bool replicated;
+
+public:
+	NormalModeColumnAssembly(
+			bool i_timestepper_uses_mpi = false
+	)	:
+		rank(0),
+		size(1),
+		replicated(i_timestepper_uses_mpi)
+	{
+#if SWEET_MPI
+		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+		MPI_Comm_size(MPI_COMM_WORLD, &size);
+#endif
+	}
+
+
+	/**
+	 * Return true if this rank writes the output file
+	 */
+	bool is_writer()	const
+	{
+		return rank == 0;
+	}
+
+
+	/**
+	 * Return true if this rank computes column i_col
+	 */
+	bool is_owner(std::size_t i_col)	const
+	{
+		if (replicated)
+			return true;
+
+		return (int)(i_col % size) == rank;
+	}
+
+
+	/**
+	 * Return true if this rank participates in column i_col
+	 */
+	bool is_active(std::size_t i_col)	const
+	{
+		return is_owner(i_col) || is_writer();
+	}
+
+
+	/**
+	 * Send the row of column i_col to the writer
+	 */
+	void gather(
+			std::size_t i_col,
+			std::vector<double> &io_row
+	)
+	{
+#if SWEET_MPI
+		if (replicated)
+			return;
+
+		int owner = i_col % size;
+
+		if (owner == 0)
+			return;
+
+		if (rank == owner)
+			MPI_Send(io_row.data(), io_row.size(), MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
+		else if (rank == 0)
+			MPI_Recv(io_row.data(), io_row.size(), MPI_DOUBLE, owner, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+#endif
+	}
+
+
+	/**
+	 * Write a row as tab separated values
+	 */
+	static
+	void write(
+			std::ostream &io_file,
+			const std::vector<double> &i_row
+	)
+	{
+		for (std::size_t k = 0; k < i_row.size(); k++)
+		{
+			io_file << i_row[k];
+			if (k != i_row.size()-1)
+				io_file << "\t";
+			else
+				io_file << std::endl;
+		}
+	}
+};
+
+
+
+#endif
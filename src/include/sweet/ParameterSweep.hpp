@@ -0,0 +1,391 @@
+/*
+ * ParameterSweep.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PARAMETERSWEEP_HPP_
+#define SRC_INCLUDE_SWEET_PARAMETERSWEEP_HPP_
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <sweet/SWEETError.hpp>
+
+#include <sched.h>
+#include <spawn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+
+
+/*
+ * Sweep over parameter sets in a single program run
+ *
+ * The sweep file contains one configuration per line given by program
+ * arguments, e.g.
+ *
+ *   # REXI convergence
+ *   --timestepping-method=l_exp --dt=600 --rexi-method=terry
+ *   --timestepping-method=l_exp --dt=1200 --rexi-method=terry
+ *
+ * Empty lines and lines starting with '#' are ignored. The arguments of
+ * a configuration are appended to the program arguments, hence they
+ * override them.
+ *
+ * Configurations are either executed one after another in the same
+ * process or concurrently by workers, which are new instances of the
+ * program. Each worker runs a strided subset of the configurations, is
+ * pinned to its own subset of the available cores and writes its output
+ * to a separate log file.
+ */
+class ParameterSweep
+{
+public:
+	/// Arguments of each configuration
+	std::vector< std::vector<std::string> > configs;
+
+	/// Lines of the sweep file of each configuration
+	std::vector<std::string> config_lines;
+
+
+	/**
+	 * Load configurations from sweep file
+	 */
+	void load(
+			const std::string &i_filename
+	)
+	{
+		std::ifstream file(i_filename);
+		if (!file.is_open())
+			SWEETError(std::string("Unable to open sweep file '")+i_filename+"'");
+
+		configs.clear();
+		config_lines.clear();
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream ss(line);
+			std::vector<std::string> args;
+			std::string arg;
+
+			while (ss >> arg)
+			{
+				if (arg[0] == '#')
+					break;
+				args.push_back(arg);
+			}
+
+			if (args.size() == 0)
+				continue;
+
+			configs.push_back(args);
+			config_lines.push_back(line);
+		}
+
+		if (configs.size() == 0)
+			SWEETError(std::string("No configurations found in sweep file '")+i_filename+"'");
+	}
+
+
+	/**
+	 * Arguments of configuration i_config_id appended to the program arguments
+	 *
+	 * The returned argv points into o_storage and is terminated by nullptr.
+	 * getopt is reset to allow parsing the program arguments again.
+	 */
+	void get_args(
+			int i_config_id,
+			int i_argc,
+			char *const i_argv[],
+			std::vector<std::string> &o_storage,
+			std::vector<char*> &o_argv
+	)	const
+	{
+		o_storage.clear();
+		for (int i = 0; i < i_argc; i++)
+			o_storage.push_back(i_argv[i]);
+
+		for (std::size_t i = 0; i < configs[i_config_id].size(); i++)
+			o_storage.push_back(configs[i_config_id][i]);
+
+		o_argv.clear();
+		for (std::size_t i = 0; i < o_storage.size(); i++)
+			o_argv.push_back(&o_storage[i][0]);
+		o_argv.push_back(nullptr);
+
+		// full reinitialization of getopt
+		optind = 0;
+	}
+
+
+	/**
+	 * Prefix of output files of configuration i_config_id
+	 */
+	static
+	std::string get_prefix(
+			int i_config_id
+	)
+	{
+		char buffer[32];
+		sprintf(buffer, "sweep%03d_", i_config_id);
+		return buffer;
+	}
+
+
+	/**
+	 * Add the prefix of the configuration to the file name (and not to its directory)
+	 */
+	static
+	std::string get_prefixed_filename(
+			int i_config_id,
+			const std::string &i_filename
+	)
+	{
+		std::size_t pos = i_filename.rfind('/');
+
+		if (pos == std::string::npos)
+			return get_prefix(i_config_id) + i_filename;
+
+		return i_filename.substr(0, pos+1) + get_prefix(i_config_id) + i_filename.substr(pos+1);
+	}
+
+
+	/**
+	 * Run all configurations
+	 *
+	 * i_run(config_id) executes a single configuration in this process and returns 0 on success.
+	 *
+	 * For concurrent configurations, one worker is started per slot of
+	 * cores. Worker w runs the configurations w, w+N, w+2N, ... one after
+	 * another in-process, hence setups which are shared by configurations
+	 * (e.g. spectral transformations of the same resolution) can be
+	 * reused. Workers are new instances of this program started with the
+	 * program arguments i_argv and --sweep-worker-id. Forking this
+	 * process instead isn't safe since threads (OpenMP, SHTNS, FFTW)
+	 * might be running already.
+	 *
+	 * \return number of failed configurations
+	 */
+	template <typename TRun>
+	int run(
+			int i_num_workers,		///< number of concurrent workers
+			int i_worker_id,		///< run only the configurations of this worker if >= 0
+			int i_argc,
+			char *const i_argv[],
+			TRun i_run
+	)
+	{
+		int num_configs = configs.size();
+		int num_failed = 0;
+
+		if (i_worker_id >= std::max(i_num_workers, 1))
+			SWEETError("Invalid sweep worker id");
+
+		if (i_num_workers <= 1 || i_worker_id >= 0)
+		{
+			int first = 0;
+			int stride = 1;
+
+			if (i_worker_id >= 0)
+			{
+				first = i_worker_id;
+				stride = i_num_workers;
+			}
+
+			for (int i = first; i < num_configs; i += stride)
+			{
+				std::cout << "[MULE] sweep_config_id: " << i << std::endl;
+				std::cout << "[MULE] sweep_config: " << config_lines[i] << std::endl;
+
+				int retval = i_run(i);
+				if (retval != 0)
+					num_failed++;
+
+				std::cout << "[MULE] sweep_config_retval: " << retval << std::endl;
+			}
+
+			return num_failed;
+		}
+
+		/*
+		 * Split available cores into one contiguous subset per worker
+		 */
+		cpu_set_t process_cpus;
+		CPU_ZERO(&process_cpus);
+		if (sched_getaffinity(0, sizeof(process_cpus), &process_cpus) != 0)
+			SWEETError("sched_getaffinity failed");
+
+		std::vector<int> cpus;
+		for (int c = 0; c < CPU_SETSIZE; c++)
+			if (CPU_ISSET(c, &process_cpus))
+				cpus.push_back(c);
+
+		int num_workers = std::min<int>(i_num_workers, num_configs);
+
+		std::cout << "Running " << num_configs << " configurations with " << num_workers << " workers on " << cpus.size() << " cores" << std::endl;
+
+		// make sure buffered output isn't mixed up with the output of the new processes
+		std::cout << std::flush;
+		std::cerr << std::flush;
+		fflush(nullptr);
+
+		std::vector<pid_t> worker_pid(num_workers);
+
+		for (int w = 0; w < num_workers; w++)
+		{
+			int cpu_start = (w*cpus.size())/num_workers;
+			int cpu_end = ((w+1)*cpus.size())/num_workers;
+
+			// more workers than cores
+			if (cpu_end <= cpu_start && cpus.size() > 0)
+			{
+				cpu_start = w % cpus.size();
+				cpu_end = cpu_start+1;
+			}
+
+			worker_pid[w] = p_spawn(w, i_argc, i_argv, cpus, cpu_start, cpu_end, process_cpus);
+		}
+
+		for (int w = 0; w < num_workers; w++)
+		{
+			int status;
+			if (waitpid(worker_pid[w], &status, 0) < 0)
+				SWEETError("waitpid failed");
+
+			// the exit status of a worker is its number of failed configurations
+			int worker_num_configs = (num_configs - w + i_num_workers - 1)/i_num_workers;
+			int worker_num_failed = WIFEXITED(status) ? WEXITSTATUS(status) : worker_num_configs;
+
+			num_failed += worker_num_failed;
+
+			std::cout << "[MULE] sweep_worker_id: " << w << std::endl;
+			std::cout << "[MULE] sweep_worker_output: " << get_worker_log_filename(w) << std::endl;
+			std::cout << "[MULE] sweep_worker_num_configs: " << worker_num_configs << std::endl;
+			std::cout << "[MULE] sweep_worker_num_failed: " << worker_num_failed << std::endl;
+		}
+
+		return num_failed;
+	}
+
+
+	/**
+	 * Exit status of a worker for the given number of failed configurations
+	 */
+	static
+	int get_worker_exit_status(
+			int i_num_failed
+	)
+	{
+		return std::min(i_num_failed, 255);
+	}
+
+
+	/**
+	 * Log file of worker i_worker_id
+	 */
+	static
+	std::string get_worker_log_filename(
+			int i_worker_id
+	)
+	{
+		char buffer[48];
+		sprintf(buffer, "sweep_worker%03d_output.txt", i_worker_id);
+		return buffer;
+	}
+
+
+private:
+	/**
+	 * Start a new instance of this program as worker i_worker_id
+	 * on the cores cpus[i_cpu_start], ..., cpus[i_cpu_end-1]
+	 *
+	 * \return process id
+	 */
+	pid_t p_spawn(
+			int i_worker_id,
+			int i_argc,
+			char *const i_argv[],
+			const std::vector<int> &i_cpus,
+			int i_cpu_start,
+			int i_cpu_end,
+			const cpu_set_t &i_process_cpus
+	)
+	{
+		std::vector<std::string> args_storage;
+		for (int i = 0; i < i_argc; i++)
+			args_storage.push_back(i_argv[i]);
+		args_storage.push_back("--sweep-worker-id="+std::to_string(i_worker_id));
+
+		std::vector<char*> args;
+		for (std::size_t i = 0; i < args_storage.size(); i++)
+			args.push_back(&args_storage[i][0]);
+		args.push_back(nullptr);
+
+		/*
+		 * Environment with the number of threads for this worker
+		 */
+		std::vector<std::string> env_storage;
+		for (char **e = environ; *e != nullptr; e++)
+			if (std::string(*e).compare(0, 16, "OMP_NUM_THREADS=") != 0)
+				env_storage.push_back(*e);
+
+		if (i_cpu_end > i_cpu_start)
+			env_storage.push_back("OMP_NUM_THREADS="+std::to_string(i_cpu_end-i_cpu_start));
+
+		std::vector<char*> env;
+		for (std::size_t i = 0; i < env_storage.size(); i++)
+			env.push_back(&env_storage[i][0]);
+		env.push_back(nullptr);
+
+		/*
+		 * Redirect output to log file
+		 */
+		std::string log_filename = get_worker_log_filename(i_worker_id);
+
+		posix_spawn_file_actions_t file_actions;
+		posix_spawn_file_actions_init(&file_actions);
+		posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, log_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		posix_spawn_file_actions_adddup2(&file_actions, STDOUT_FILENO, STDERR_FILENO);
+
+		/*
+		 * The new process inherits the affinity of the calling thread
+		 */
+		if (i_cpu_end > i_cpu_start)
+		{
+			cpu_set_t slot_cpus;
+			CPU_ZERO(&slot_cpus);
+			for (int c = i_cpu_start; c < i_cpu_end; c++)
+				CPU_SET(i_cpus[c], &slot_cpus);
+
+			sched_setaffinity(0, sizeof(slot_cpus), &slot_cpus);
+		}
+
+		pid_t pid;
+		int retval = posix_spawn(&pid, "/proc/self/exe", &file_actions, nullptr, args.data(), env.data());
+
+		sched_setaffinity(0, sizeof(i_process_cpus), &i_process_cpus);
+		posix_spawn_file_actions_destroy(&file_actions);
+
+		if (retval != 0)
+			SWEETError("posix_spawn failed");
+
+		return pid;
+	}
+};
+
+
+
+#endif
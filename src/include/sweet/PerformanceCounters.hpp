@@ -0,0 +1,448 @@
+/*
+ * PerformanceCounters.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PERFORMANCECOUNTERS_HPP_
+#define SRC_INCLUDE_SWEET_PERFORMANCECOUNTERS_HPP_
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+#if __linux__
+#	include <linux/perf_event.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME_REXI || SWEET_THREADING
+#	define SWEET_PERFORMANCE_COUNTERS_OMP 1
+#	include <omp.h>
+#else
+#	define SWEET_PERFORMANCE_COUNTERS_OMP 0
+#endif
+
+
+
+/*
+ * Hardware performance counters based on perf_event_open
+ *
+ * The counters of each thread of the OpenMP thread pool are opened once
+ * by the thread itself as one event group and keep running. All events of
+ * a group are scheduled together on the PMU and read with a single read()
+ * of the group leader, hence derived metrics such as instructions per
+ * cycle are computed from consistent values even if counters are
+ * multiplexed.
+ *
+ * Regions take snapshots of all counters of all threads at their start
+ * and stop. Since the counters of other threads can be read via their
+ * file descriptors, this doesn't require any parallel region and regions
+ * can be started and stopped anywhere outside of parallel regions.
+ *
+ * This assumes a persistent thread pool where each thread id is always
+ * executed by the same system thread (which is the case for GNU and
+ * Intel OpenMP for teams of the same size).
+ *
+ * Threads of nested parallel regions are not part of this thread pool
+ * and are not counted.
+ *
+ * Events which are not supported (e.g. in virtual machines) or which
+ * can't be scheduled together with the other events of the group are
+ * ignored.
+ */
+class PerformanceCounters
+{
+public:
+	enum
+	{
+		EVENT_TASK_CLOCK = 0,
+		EVENT_CYCLES,
+		EVENT_INSTRUCTIONS,
+		EVENT_LLC_REFERENCES,
+		EVENT_LLC_MISSES,
+		EVENT_STALLED_CYCLES_BACKEND,
+		EVENT_RAW,
+		NUM_EVENTS
+	};
+
+	/// Number of threads with counters
+	int num_threads = 0;
+
+	/// File descriptors of counters, -1 if not available
+	std::vector<int> fds;
+
+	/// File descriptor of the group leader of each thread, -1 if no event is available
+	std::vector<int> group_leader_fds;
+
+	/// Events of the group of each thread in the order of the values read from the group leader
+	std::vector<std::vector<int> > group_events;
+
+	/// Event is available for at least one thread
+	bool event_available[NUM_EVENTS];
+
+	/// At least one event is available
+	bool available = false;
+
+
+	static
+	const char* get_event_name(
+			int i_event
+	)
+	{
+		static const char* names[NUM_EVENTS] = {
+				"task_clock_ns",
+				"cycles",
+				"instructions",
+				"llc_references",
+				"llc_misses",
+				"stalled_cycles_backend",
+				"raw"
+		};
+
+		return names[i_event];
+	}
+
+
+	static
+	PerformanceCounters& getInstance()
+	{
+		static PerformanceCounters instance;
+		return instance;
+	}
+
+
+	PerformanceCounters()
+	{
+		for (int e = 0; e < NUM_EVENTS; e++)
+			event_available[e] = false;
+	}
+
+
+	~PerformanceCounters()
+	{
+		cleanup();
+	}
+
+
+	void cleanup()
+	{
+#if __linux__
+		for (std::size_t i = 0; i < fds.size(); i++)
+			if (fds[i] >= 0)
+				close(fds[i]);
+#endif
+
+		fds.clear();
+		group_leader_fds.clear();
+		group_events.clear();
+		num_threads = 0;
+		available = false;
+
+		for (int e = 0; e < NUM_EVENTS; e++)
+			event_available[e] = false;
+	}
+
+
+	/**
+	 * Open the counters for all threads
+	 *
+	 * \param i_raw_event	config of a CPU specific raw event,
+	 * 			e.g. to count vector instructions (0: not used)
+	 */
+	void setup(
+			uint64_t i_raw_event = 0
+	)
+	{
+		cleanup();
+
+#if SWEET_PERFORMANCE_COUNTERS_OMP
+		num_threads = omp_get_max_threads();
+#else
+		num_threads = 1;
+#endif
+
+		fds.resize(num_threads*NUM_EVENTS, -1);
+		group_leader_fds.resize(num_threads, -1);
+		group_events.resize(num_threads);
+
+#if SWEET_PERFORMANCE_COUNTERS_OMP
+#pragma omp parallel num_threads(num_threads)
+#endif
+		{
+#if SWEET_PERFORMANCE_COUNTERS_OMP
+			int t = omp_get_thread_num();
+#else
+			int t = 0;
+#endif
+			p_open_group(t, i_raw_event);
+		}
+
+		for (int t = 0; t < num_threads; t++)
+			for (int e = 0; e < NUM_EVENTS; e++)
+				if (fds[t*NUM_EVENTS + e] >= 0)
+					event_available[e] = true;
+
+		for (int e = 0; e < NUM_EVENTS; e++)
+			available = available || event_available[e];
+
+		if (!available)
+			std::cerr << "Warning: No performance counters available" << std::endl;
+	}
+
+
+	/**
+	 * Read all counters of all threads
+	 *
+	 * The group of each thread is read at once.
+	 * Values are scaled to the full time if the group was multiplexed.
+	 * Not available counters are set to 0.
+	 */
+	void read(
+			std::vector<double> &o_values
+	)	const
+	{
+		o_values.assign(fds.size(), 0);
+
+#if __linux__
+		for (int t = 0; t < num_threads; t++)
+		{
+			if (group_leader_fds[t] < 0)
+				continue;
+
+			// number of events, time enabled, time running, values
+			uint64_t buf[3+NUM_EVENTS];
+			std::size_t size = (3+group_events[t].size())*sizeof(uint64_t);
+			if (::read(group_leader_fds[t], buf, size) != (ssize_t)size)
+				continue;
+
+			if (buf[0] != group_events[t].size() || buf[2] == 0)
+				continue;
+
+			double scale = 1.0;
+			if (buf[2] < buf[1])
+				scale = (double)buf[1]/(double)buf[2];
+
+			for (std::size_t i = 0; i < group_events[t].size(); i++)
+				o_values[t*NUM_EVENTS + group_events[t][i]] = (double)buf[3+i]*scale;
+		}
+#endif
+	}
+
+
+private:
+	/**
+	 * Open the event group of the calling thread
+	 *
+	 * Hardware events are opened first so that the group leader is a
+	 * hardware event. The first event which can be opened becomes the
+	 * group leader.
+	 */
+	void p_open_group(
+			int i_thread,
+			uint64_t i_raw_event
+	)
+	{
+		static const int order[NUM_EVENTS] = {
+				EVENT_CYCLES,
+				EVENT_INSTRUCTIONS,
+				EVENT_LLC_REFERENCES,
+				EVENT_LLC_MISSES,
+				EVENT_STALLED_CYCLES_BACKEND,
+				EVENT_RAW,
+				EVENT_TASK_CLOCK
+		};
+
+		for (int i = 0; i < NUM_EVENTS; i++)
+		{
+			int e = order[i];
+			int fd = p_open_event(e, i_raw_event, group_leader_fds[i_thread]);
+			if (fd < 0)
+				continue;
+
+			if (group_leader_fds[i_thread] < 0)
+				group_leader_fds[i_thread] = fd;
+
+			fds[i_thread*NUM_EVENTS + e] = fd;
+			group_events[i_thread].push_back(e);
+		}
+	}
+
+
+	/**
+	 * Open counter for calling thread
+	 *
+	 * \param i_group_fd	file descriptor of group leader (-1: open new group)
+	 *
+	 * \return file descriptor or -1 if not available
+	 */
+	static
+	int p_open_event(
+			int i_event,
+			uint64_t i_raw_event,
+			int i_group_fd
+	)
+	{
+#if __linux__
+		struct perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		switch(i_event)
+		{
+		case EVENT_TASK_CLOCK:
+			attr.type = PERF_TYPE_SOFTWARE;
+			attr.config = PERF_COUNT_SW_TASK_CLOCK;
+			break;
+
+		case EVENT_CYCLES:
+			attr.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+
+		case EVENT_INSTRUCTIONS:
+			attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+
+		case EVENT_LLC_REFERENCES:
+			attr.config = PERF_COUNT_HW_CACHE_REFERENCES;
+			break;
+
+		case EVENT_LLC_MISSES:
+			attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			break;
+
+		case EVENT_STALLED_CYCLES_BACKEND:
+			attr.config = PERF_COUNT_HW_STALLED_CYCLES_BACKEND;
+			break;
+
+		case EVENT_RAW:
+			if (i_raw_event == 0)
+				return -1;
+
+			attr.type = PERF_TYPE_RAW;
+			attr.config = i_raw_event;
+			break;
+
+		default:
+			return -1;
+		}
+
+		// calling thread on any CPU
+		long fd = syscall(__NR_perf_event_open, &attr, 0, -1, i_group_fd, 0);
+		return fd < 0 ? -1 : (int)fd;
+#else
+		return -1;
+#endif
+	}
+};
+
+
+
+/*
+ * Counter values accumulated over all executions of a region
+ */
+class PerformanceCounterRegion
+{
+	std::vector<double> values_start;
+	std::vector<double> values_stop;
+
+public:
+	/// accumulated values for each thread and event
+	std::vector<double> values;
+
+
+	void reset()
+	{
+		values.clear();
+	}
+
+
+	void start()
+	{
+		PerformanceCounters::getInstance().read(values_start);
+	}
+
+
+	void stop()
+	{
+		PerformanceCounters::getInstance().read(values_stop);
+
+		if (values.size() != values_stop.size())
+			values.assign(values_stop.size(), 0);
+
+		for (std::size_t i = 0; i < values.size(); i++)
+			values[i] += values_stop[i] - values_start[i];
+	}
+
+
+	/**
+	 * Sum of event over all threads
+	 */
+	double get_total(
+			int i_event
+	)	const
+	{
+		double sum = 0;
+		for (std::size_t i = i_event; i < values.size(); i += PerformanceCounters::NUM_EVENTS)
+			sum += values[i];
+
+		return sum;
+	}
+
+
+	/**
+	 * Output counters of each thread and totals
+	 *
+	 * \param i_prefix	prefix of each line, e.g. "[MULE] simulation_benchmark_counters.rexi"
+	 * \param i_time	wall clock time of region to compute rates (0: not used)
+	 */
+	void output(
+			const std::string &i_prefix,
+			double i_time = 0
+	)	const
+	{
+		const PerformanceCounters &pc = PerformanceCounters::getInstance();
+
+		if (values.size() == 0)
+			return;
+
+		for (int t = 0; t < pc.num_threads; t++)
+			for (int e = 0; e < PerformanceCounters::NUM_EVENTS; e++)
+				if (pc.fds[t*PerformanceCounters::NUM_EVENTS + e] >= 0)
+					std::cout << i_prefix << ".thread" << t << "." << PerformanceCounters::get_event_name(e) << ": " << (uint64_t)values[t*PerformanceCounters::NUM_EVENTS + e] << std::endl;
+
+		for (int e = 0; e < PerformanceCounters::NUM_EVENTS; e++)
+			if (pc.event_available[e])
+				std::cout << i_prefix << ".total." << PerformanceCounters::get_event_name(e) << ": " << (uint64_t)get_total(e) << std::endl;
+
+		/*
+		 * Derived metrics
+		 */
+		double cycles = get_total(PerformanceCounters::EVENT_CYCLES);
+		double instructions = get_total(PerformanceCounters::EVENT_INSTRUCTIONS);
+		double llc_references = get_total(PerformanceCounters::EVENT_LLC_REFERENCES);
+		double llc_misses = get_total(PerformanceCounters::EVENT_LLC_MISSES);
+
+		if (cycles > 0 && pc.event_available[PerformanceCounters::EVENT_INSTRUCTIONS])
+			std::cout << i_prefix << ".instructions_per_cycle: " << instructions/cycles << std::endl;
+
+		if (llc_references > 0 && pc.event_available[PerformanceCounters::EVENT_LLC_MISSES])
+			std::cout << i_prefix << ".llc_miss_rate: " << llc_misses/llc_references << std::endl;
+
+		// proxy of memory bandwidth: each LLC miss transfers one cache line of 64 bytes
+		if (i_time > 0 && pc.event_available[PerformanceCounters::EVENT_LLC_MISSES])
+			std::cout << i_prefix << ".llc_miss_bandwidth_gbytes_per_sec: " << llc_misses*64.0/i_time*1e-9 << std::endl;
+	}
+};
+
+
+
+#endif
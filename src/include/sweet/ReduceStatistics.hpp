@@ -0,0 +1,274 @@
+/*
+ * ReduceStatistics.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_REDUCESTATISTICS_HPP_
+#define SRC_INCLUDE_SWEET_REDUCESTATISTICS_HPP_
+
+#include <cstddef>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <sweet/openmp_helper.hpp>
+
+#if SWEET_THREADING_SPACE
+	#include <omp.h>
+#endif
+
+
+
+/*
+ * Fused reduction of several statistics in a single pass over the data
+ *
+ * The min, max, max_abs, sum, sum of squares and the NaN/Inf flag
+ * are always computed together since they come without additional
+ * memory traffic. The quadrature-weighted integral is only computed
+ * if weights are provided.
+ *
+ * For complex-valued (spectral) data, min/max/sum are computed based on
+ * the real part, max_abs and sum_sqr based on the modulus.
+ *
+ * Deterministic mode:
+ * The data is split into blocks of fixed size which are reduced
+ * independently and then combined in a fixed order.
+ * Results are then bitwise identical regardless of the number of threads.
+ */
+class ReduceStatistics
+{
+public:
+	double min = std::numeric_limits<double>::infinity();
+	double max = -std::numeric_limits<double>::infinity();
+	double max_abs = 0;
+	double sum = 0;
+	double sum_sqr = 0;
+	double integral = 0;
+	bool nan_or_inf = false;
+
+	std::size_t number_of_elements = 0;
+
+
+	/**
+	 * Block size used for the deterministic reduction.
+	 * This must not depend on the number of threads.
+	 */
+	static constexpr std::size_t deterministic_block_size = 4096;
+
+
+public:
+	double mean()	const
+	{
+		return sum/(double)number_of_elements;
+	}
+
+
+	double rms()	const
+	{
+		return std::sqrt(sum_sqr/(double)number_of_elements);
+	}
+
+
+	double norm2()	const
+	{
+		return std::sqrt(sum_sqr);
+	}
+
+
+	/**
+	 * Combine with the statistics of another part of the data
+	 */
+	void combine(
+			const ReduceStatistics &i_stats
+	)
+	{
+		min = std::min(min, i_stats.min);
+		max = std::max(max, i_stats.max);
+		max_abs = std::max(max_abs, i_stats.max_abs);
+		sum += i_stats.sum;
+		sum_sqr += i_stats.sum_sqr;
+		integral += i_stats.integral;
+		nan_or_inf = nan_or_inf || i_stats.nan_or_inf;
+		number_of_elements += i_stats.number_of_elements;
+	}
+
+
+	void print(
+			const std::string &i_prefix = ""
+	)	const
+	{
+		std::cout << i_prefix << "min: " << min << std::endl;
+		std::cout << i_prefix << "max: " << max << std::endl;
+		std::cout << i_prefix << "max_abs: " << max_abs << std::endl;
+		std::cout << i_prefix << "sum: " << sum << std::endl;
+		std::cout << i_prefix << "rms: " << rms() << std::endl;
+		std::cout << i_prefix << "integral: " << integral << std::endl;
+		std::cout << i_prefix << "nan_or_inf: " << nan_or_inf << std::endl;
+	}
+
+
+private:
+	static double p_real(double i_value)					{ return i_value; }
+	static double p_real(const std::complex<double> &i_value)	{ return i_value.real(); }
+
+	static double p_abs2(double i_value)					{ return i_value*i_value; }
+	static double p_abs2(const std::complex<double> &i_value)	{ return std::norm(i_value); }
+
+	static bool p_isfinite(double i_value)					{ return std::isfinite(i_value); }
+	static bool p_isfinite(const std::complex<double> &i_value)	{ return std::isfinite(i_value.real()) && std::isfinite(i_value.imag()); }
+
+
+	/*
+	 * Reduce elements [i_start, i_end) without threading
+	 */
+	template <bool t_with_weights, typename T, typename TWeightFun>
+	static
+	void p_reduce_range(
+			const T *i_data,
+			std::size_t i_start,
+			std::size_t i_end,
+			TWeightFun i_weight,
+			ReduceStatistics &o_stats
+	)
+	{
+		double v_min = o_stats.min;
+		double v_max = o_stats.max;
+		double v_max_abs2 = o_stats.max_abs*o_stats.max_abs;
+		double v_sum = 0;
+		double v_sum_sqr = 0;
+		double v_integral = 0;
+		int v_non_finite = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp simd reduction(min:v_min) reduction(max:v_max,v_max_abs2) reduction(+:v_sum,v_sum_sqr,v_integral) reduction(|:v_non_finite)
+#endif
+		for (std::size_t i = i_start; i < i_end; i++)
+		{
+			double re = p_real(i_data[i]);
+			double a2 = p_abs2(i_data[i]);
+
+			v_min = std::min(v_min, re);
+			v_max = std::max(v_max, re);
+			v_max_abs2 = std::max(v_max_abs2, a2);
+			v_sum += re;
+			v_sum_sqr += a2;
+
+			if (t_with_weights)
+				v_integral += re*i_weight(i);
+
+			v_non_finite |= !p_isfinite(i_data[i]);
+		}
+
+		o_stats.min = v_min;
+		o_stats.max = v_max;
+		o_stats.max_abs = std::sqrt(v_max_abs2);
+		o_stats.sum += v_sum;
+		o_stats.sum_sqr += v_sum_sqr;
+		o_stats.integral += v_integral;
+		o_stats.nan_or_inf = o_stats.nan_or_inf || v_non_finite;
+		o_stats.number_of_elements += i_end - i_start;
+
+		// NaN values are ignored by min/max, make them visible in max_abs
+		if (v_non_finite)
+			o_stats.max_abs = std::numeric_limits<double>::infinity();
+	}
+
+
+	template <bool t_with_weights, typename T, typename TWeightFun>
+	static
+	ReduceStatistics p_reduce(
+			const T *i_data,
+			std::size_t i_number_of_elements,
+			TWeightFun i_weight,
+			bool i_deterministic
+	)
+	{
+		ReduceStatistics stats;
+
+		if (i_deterministic)
+		{
+			std::size_t num_blocks = (i_number_of_elements + deterministic_block_size - 1) / deterministic_block_size;
+			std::vector<ReduceStatistics> block_stats(num_blocks);
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE schedule(static)
+#endif
+			for (std::size_t b = 0; b < num_blocks; b++)
+			{
+				std::size_t start = b*deterministic_block_size;
+				std::size_t end = std::min(start + deterministic_block_size, i_number_of_elements);
+				p_reduce_range<t_with_weights>(i_data, start, end, i_weight, block_stats[b]);
+			}
+
+			// Fixed order of combination
+			for (std::size_t b = 0; b < num_blocks; b++)
+				stats.combine(block_stats[b]);
+
+			return stats;
+		}
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel PROC_BIND_CLOSE
+		{
+			ReduceStatistics thread_stats;
+
+			int num_threads = omp_get_num_threads();
+			int thread_id = omp_get_thread_num();
+
+			std::size_t chunk = (i_number_of_elements + num_threads - 1) / num_threads;
+			std::size_t start = std::min(chunk*thread_id, i_number_of_elements);
+			std::size_t end = std::min(start + chunk, i_number_of_elements);
+
+			p_reduce_range<t_with_weights>(i_data, start, end, i_weight, thread_stats);
+
+#pragma omp critical
+			stats.combine(thread_stats);
+		}
+#else
+		p_reduce_range<t_with_weights>(i_data, 0, i_number_of_elements, i_weight, stats);
+#endif
+
+		return stats;
+	}
+
+
+public:
+	/**
+	 * Reduce data without quadrature weights
+	 */
+	template <typename T>
+	static
+	ReduceStatistics reduce(
+			const T *i_data,
+			std::size_t i_number_of_elements,
+			bool i_deterministic = false
+	)
+	{
+		return p_reduce<false>(i_data, i_number_of_elements, [](std::size_t) -> double { return 0; }, i_deterministic);
+	}
+
+
+	/**
+	 * Reduce data including the integral with the quadrature weight i_weight(idx) for each element
+	 */
+	template <typename T, typename TWeightFun>
+	static
+	ReduceStatistics reduce_weighted(
+			const T *i_data,
+			std::size_t i_number_of_elements,
+			TWeightFun i_weight,
+			bool i_deterministic = false
+	)
+	{
+		return p_reduce<true>(i_data, i_number_of_elements, i_weight, i_deterministic);
+	}
+};
+
+
+
+#endif
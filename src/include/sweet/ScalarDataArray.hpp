@@ -20,6 +20,7 @@
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
 #include <sweet/SWEETError.hpp>
+#include <sweet/ReduceStatistics.hpp>
 
 /*
  * Precompiler helper functions to handle loops in spectral and physical space
@@ -75,7 +76,7 @@ private:
 	void p_allocate_buffers()
 	{
 		scalar_data = MemBlockAlloc::alloc<double>(
-				number_of_elements*sizeof(double)
+				number_of_elements*sizeof(double), "ScalarDataArray"
 		);
 	}
 
@@ -284,6 +285,18 @@ public:
 		);
 	}
 
+	/**
+	 * Return min, max, max_abs, sum, sum of squares and NaN/Inf flag in a single pass
+	 */
+	ReduceStatistics reduce_statistics(
+			bool i_deterministic = false
+	)	const
+	{
+		return ReduceStatistics::reduce(scalar_data, number_of_elements, i_deterministic);
+	}
+
+
+
 	bool reduce_isAnyNaNorInf()	const
 	{
 		for (std::size_t i = 0; i < number_of_elements; i++)
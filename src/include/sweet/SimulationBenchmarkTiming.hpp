@@ -10,7 +10,15 @@
 #define SWEET_BENCHMARK_TIMINGS 1
 #endif
 
+#include <vector>
+#include <string>
+#include <utility>
 #include <sweet/Stopwatch.hpp>
+#include <sweet/PerformanceCounters.hpp>
+
+#if SWEET_MPI
+#	include <mpi.h>
+#endif
 
 class SimulationBenchmarkTimings
 {
@@ -35,6 +43,83 @@ public:
 	Stopwatch main_timestepping_semi_lagrangian;
 #endif
 
+	/// Performance counters of each stopwatch (if enabled)
+	std::vector<PerformanceCounterRegion> performance_counter_regions;
+
+
+	/**
+	 * Names and stopwatches of all timing regions
+	 */
+	std::vector<std::pair<std::string, Stopwatch*> > get_stopwatches()
+	{
+		std::vector<std::pair<std::string, Stopwatch*> > s;
+
+		s.push_back(std::make_pair("main", &main));
+		s.push_back(std::make_pair("main_setup", &main_setup));
+		s.push_back(std::make_pair("main_timestepping", &main_timestepping));
+#if SWEET_BENCHMARK_TIMINGS
+		s.push_back(std::make_pair("main_timestepping_nonlinearities", &main_timestepping_nonlinearities));
+
+		s.push_back(std::make_pair("rexi", &rexi));
+		s.push_back(std::make_pair("rexi_setup", &rexi_setup));
+		s.push_back(std::make_pair("rexi_shutdown", &rexi_shutdown));
+		s.push_back(std::make_pair("rexi_timestepping", &rexi_timestepping));
+		s.push_back(std::make_pair("rexi_timestepping_solver", &rexi_timestepping_solver));
+		s.push_back(std::make_pair("rexi_timestepping_broadcast", &rexi_timestepping_broadcast));
+		s.push_back(std::make_pair("rexi_timestepping_reduce", &rexi_timestepping_reduce));
+		s.push_back(std::make_pair("rexi_timestepping_miscprocessing", &rexi_timestepping_miscprocessing));
+
+		s.push_back(std::make_pair("semi_lagrangian", &main_timestepping_semi_lagrangian));
+#endif
+
+		return s;
+	}
+
+
+	/**
+	 * Sample performance counters in all timing regions
+	 */
+	void setup_performance_counters(
+			uint64_t i_raw_event = 0
+	)
+	{
+		// already set up
+		if (performance_counter_regions.size() > 0)
+			return;
+
+		PerformanceCounters::getInstance().setup(i_raw_event);
+
+		std::vector<std::pair<std::string, Stopwatch*> > s = get_stopwatches();
+		performance_counter_regions.resize(s.size());
+
+		for (std::size_t i = 0; i < s.size(); i++)
+			s[i].second->set_performance_counters(&performance_counter_regions[i]);
+	}
+
+
+	/**
+	 * Output performance counters of all timing regions of this rank
+	 */
+	void output_performance_counters()
+	{
+		if (performance_counter_regions.size() == 0)
+			return;
+
+		std::string prefix = "[MULE] simulation_benchmark_counters.";
+
+#if SWEET_MPI
+		int mpi_rank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+		prefix += "rank" + std::to_string(mpi_rank) + ".";
+#endif
+
+		std::vector<std::pair<std::string, Stopwatch*> > s = get_stopwatches();
+
+		for (std::size_t i = 0; i < s.size(); i++)
+			if ((*s[i].second)() != 0)
+				performance_counter_regions[i].output(prefix + s[i].first, (*s[i].second)());
+	}
+
 
 
 	static SimulationBenchmarkTimings& getInstance()
@@ -102,6 +187,8 @@ public:
 			std::cout << "[MULE] simulation_benchmark_timings.semi_lagrangian: " << main_timestepping_semi_lagrangian() << std::endl;
 		}
 #endif
+
+		output_performance_counters();
 	}
 
 
@@ -18,6 +18,7 @@
 #include <sweet/StringSplit.hpp>
 #include <sweet/SWEETError.hpp>
 #include <sweet/TransformationPlans.hpp>
+#include <sweet/TimeStepSizeChanged.hpp>
 
 #if SWEET_THREADING
 #include <omp.h>
@@ -690,6 +691,9 @@ public:
 		/// Use accurate spherical geometry (???) or approximation (Ritchie 1995)
 		double semi_lagrangian_approximate_sphere_geometry = 0;
 
+		/// Compute departure points with fused per-point kernel and early exit
+		bool semi_lagrangian_fused_departure_points = true;
+
 
 		/// String of time stepping method
 		/// See doc/swe/swe_plane_timesteppings
@@ -722,6 +726,7 @@ public:
 			std::cout << " + semi_lagrangian_sampler_use_pole_pseudo_points: " << semi_lagrangian_sampler_use_pole_pseudo_points << std::endl;
 			std::cout << " + semi_lagrangian_convergence_threshold: " << semi_lagrangian_convergence_threshold << std::endl;
 			std::cout << " + semi_lagrangian_approximate_sphere_geometry: " << semi_lagrangian_approximate_sphere_geometry << std::endl;
+			std::cout << " + semi_lagrangian_fused_departure_points: " << semi_lagrangian_fused_departure_points << std::endl;
 			std::cout << " + plane_dealiasing (compile time): " <<
 #if SWEET_USE_PLANE_SPECTRAL_DEALIASING
 			1
@@ -753,6 +758,7 @@ public:
 			std::cout << "  >Time:" << std::endl;
 			std::cout << "	--timestepping-method [string]	String of time stepping method" << std::endl;
 			std::cout << "	--timestepping-order [int]			Specify the order of the time stepping" << std::endl;
+			std::cout << "						For explicit RK: -3/-4 for low-storage (2N) RK of order 3/4" << std::endl;
 			std::cout << "	--timestepping-order2 [int]			Specify the order of the time stepping" << std::endl;
 			std::cout << "	--leapfrog-robert-asselin-filter [0;1]		Damping parameter for Robert-Asselin filter" << std::endl;
 			std::cout << "	--normal-mode-analysis-generation [0;1;2;3]	Generate output data for normal mode analysis" << std::endl;
@@ -768,6 +774,7 @@ public:
 			std::cout << "	--semi-lagrangian-interpolation-limiter [bool]	Use limiter for cubic interpolation" << std::endl;
 			std::cout << "	--semi-lagrangian-convergence-threshold [float]	Threshold to stop iterating, Use -1 to disable" << std::endl;
 			std::cout << "	--semi-lagrangian-approximate-sphere-geometry [int]	0: no approximation, 1: Richies approximation, default: 0" << std::endl;
+			std::cout << "	--semi-lagrangian-fused-departure-points [bool]	Fused per-point computation of departure points, default: 1" << std::endl;
 
 		}
 
@@ -815,6 +822,9 @@ public:
 
 	        long_options[next_free_program_option] = {"space-grid-use-c-staggering", required_argument, 0, 256+next_free_program_option};
 	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"semi-lagrangian-fused-departure-points", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
 		}
 
 
@@ -880,9 +890,13 @@ public:
 			case 11:
 				space_grid_use_c_staggering = atof(i_value);
 				return -1;
+
+			case 12:
+				semi_lagrangian_fused_departure_points = atoi(i_value);
+				return -1;
 			}
 
-			return 12;
+			return 13;
 		}
 	} disc;
 
@@ -911,6 +925,9 @@ public:
 		/// do instability checks for simulation
 		int instability_checks = 1;
 
+		/// use reductions with fixed order of summation (bitwise reproducible for any number of threads)
+		bool reduce_deterministic = false;
+
 		/// activate GUI mode?
 		bool gui_enabled = (SWEET_GUI == 0 ? false : true);
 
@@ -931,6 +948,21 @@ public:
 		 */
 		int normal_mode_analysis_generation = 0;
 
+		/*
+		 * Matrix-free normal mode analysis (generation 5 and 15):
+		 * Number of leading modes, dimension of Krylov subspace and
+		 * relative tolerance of the Arnoldi iterations
+		 */
+		int normal_mode_analysis_num_modes = 8;
+		int normal_mode_analysis_krylov_dim = 32;
+		double normal_mode_analysis_tolerance = 1e-10;
+
+		/// Sample hardware performance counters in timing regions
+		int performance_counters = 0;
+
+		/// Config of an additional CPU specific raw event, e.g. "0x1c7" (empty: not used)
+		std::string performance_counters_raw_event = "";
+
 		/*
 		 * Some flexible variable where one can just add options like
 		 * --comma-separated-tags=galewsky_analytical_geostrophic_setup
@@ -944,12 +976,18 @@ public:
 			std::cout << " + verbosity: " << verbosity << std::endl;
 			std::cout << " + compute_errors " << compute_errors << std::endl;
 			std::cout << " + instability_checks: " << instability_checks << std::endl;
+			std::cout << " + reduce_deterministic: " << reduce_deterministic << std::endl;
 			std::cout << " + gui_enabled: " << gui_enabled << std::endl;
 			std::cout << " + vis_id: " << vis_id << std::endl;
 			std::cout << " + use_nonlinear_only_visc: " << use_nonlinear_only_visc << std::endl;
 			std::cout << " + reuse_spectral_transformation_plans: " << TransformationPlans::getStringFromEnum(reuse_spectral_transformation_plans) << std::endl;
 			std::cout << std::endl;
 			std::cout << " + normal_mode_analysis_generation: " << normal_mode_analysis_generation << std::endl;
+			std::cout << " + normal_mode_analysis_num_modes: " << normal_mode_analysis_num_modes << std::endl;
+			std::cout << " + normal_mode_analysis_krylov_dim: " << normal_mode_analysis_krylov_dim << std::endl;
+			std::cout << " + normal_mode_analysis_tolerance: " << normal_mode_analysis_tolerance << std::endl;
+			std::cout << " + performance_counters: " << performance_counters << std::endl;
+			std::cout << " + performance_counters_raw_event: " << performance_counters_raw_event << std::endl;
 			std::cout << " + comma_separated_tags: " << comma_separated_tags << std::endl;
 			std::cout << std::endl;
 		}
@@ -975,6 +1013,14 @@ public:
 			std::cout << "					1: compute optimized plans, use wisdom if available and store wisdom" << std::endl;
 			std::cout << "					2: use wisdom if available if not, trigger error if wisdom doesn't exist (not yet working for SHTNS)" << std::endl;
 			std::cout << "					default: -1 (quick mode)" << std::endl;
+			std::cout << "	--reduce-deterministic [0/1]	Reductions with fixed order of summation, reproducible for any number of threads, default:0" << std::endl;
+			std::cout << "	--normal-mode-analysis-generation [int]	Normal mode analysis, 2/3: assemble full matrix, 5: leading modes with matrix-free Arnoldi solver" << std::endl;
+			std::cout << "					+10: Use max. number of time steps instead of a single one, default:0" << std::endl;
+			std::cout << "	--normal-mode-analysis-num-modes [int]	Number of leading modes computed by Arnoldi solver, default:8" << std::endl;
+			std::cout << "	--normal-mode-analysis-krylov-dim [int]	Dimension of Krylov subspace of Arnoldi solver, default:32" << std::endl;
+			std::cout << "	--normal-mode-analysis-tolerance [float]	Relative tolerance of Arnoldi solver, default:1e-10" << std::endl;
+			std::cout << "	--performance-counters [0/1]	Sample hardware performance counters in timing regions, default:0" << std::endl;
+			std::cout << "	--performance-counters-raw-event [hex]	Additional CPU specific raw event, e.g. for vector instructions, default: none" << std::endl;
 			std::cout << "" << std::endl;
 		}
 
@@ -1001,6 +1047,24 @@ public:
 
 	        long_options[next_free_program_option] = {"comma-separated-tags", required_argument, 0, 256+next_free_program_option};
 	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"reduce-deterministic", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"normal-mode-analysis-num-modes", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"normal-mode-analysis-krylov-dim", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"normal-mode-analysis-tolerance", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"performance-counters", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
+
+	        long_options[next_free_program_option] = {"performance-counters-raw-event", required_argument, 0, 256+next_free_program_option};
+	        next_free_program_option++;
 		}
 
 
@@ -1042,9 +1106,33 @@ public:
 			case 5:
 				comma_separated_tags = i_value;
 				return -1;
+
+			case 6:
+				reduce_deterministic = atoi(i_value);
+				return -1;
+
+			case 7:
+				normal_mode_analysis_num_modes = atoi(i_value);
+				return -1;
+
+			case 8:
+				normal_mode_analysis_krylov_dim = atoi(i_value);
+				return -1;
+
+			case 9:
+				normal_mode_analysis_tolerance = atof(i_value);
+				return -1;
+
+			case 10:
+				performance_counters = atoi(i_value);
+				return -1;
+
+			case 11:
+				performance_counters_raw_event = i_value;
+				return -1;
 			}
 
-			return 6;
+			return 12;
 		}
 
 
@@ -1142,6 +1230,88 @@ public:
 		/// Maximum wallclock time to execute the simulation for
 		double max_wallclock_time = -1;
 
+		/// Adaptive time step size control with embedded RK pairs
+		bool dt_adaptive = false;
+
+		/// Absolute and relative tolerances for adaptive time stepping
+		double dt_adaptive_atol = 0;
+		double dt_adaptive_rtol = 1e-6;
+
+		/// Limits for the time step size in adaptive time stepping
+		double dt_adaptive_min = 0;
+		double dt_adaptive_max = std::numeric_limits<double>::infinity();
+
+		/// Time step size proposed by the adaptive controller for the next time step
+		double adaptive_next_timestep_size = -1;
+
+		/// Time step size of adaptive time stepping before shortening it to hit output or end times
+		double adaptive_timestep_size = -1;
+
+		/// Output or end time to hit exactly with the current adaptive time step, -1 if none
+		double adaptive_target_time = -1;
+
+		/// Shortened time step size to hit adaptive_target_time
+		double adaptive_target_timestep_size = -1;
+
+
+		/**
+		 * Setup the time step size of the next adaptive time step.
+		 *
+		 * The proposal of the controller is only used if TimeStepSizeChanged
+		 * considers it as changed. Hence time steppers and operators only
+		 * re-setup their sub-solvers for real changes.
+		 *
+		 * The time step is shortened to end exactly at the next output time
+		 * (if i_next_output_time > current time) or the end of the simulation.
+		 */
+		void adaptive_setup_timestep_size(
+				double i_next_output_time
+		)
+		{
+			if (adaptive_timestep_size <= 0)
+				adaptive_timestep_size = current_timestep_size;
+			else if (adaptive_next_timestep_size > 0 && TimeStepSizeChanged::is_changed(adaptive_timestep_size, adaptive_next_timestep_size, false))
+				adaptive_timestep_size = adaptive_next_timestep_size;
+
+			current_timestep_size = adaptive_timestep_size;
+			adaptive_target_time = -1;
+
+			double target_time = max_simulation_time;
+			if (i_next_output_time > current_simulation_time && i_next_output_time < target_time)
+				target_time = i_next_output_time;
+
+			if (current_simulation_time + current_timestep_size >= target_time)
+			{
+				current_timestep_size = target_time - current_simulation_time;
+				adaptive_target_time = target_time;
+				adaptive_target_timestep_size = current_timestep_size;
+			}
+		}
+
+
+		/**
+		 * Finish an adaptive time step after advancing the simulation time
+		 * with the accepted time step size current_timestep_size.
+		 *
+		 * If the step was shortened to hit the target time and accepted,
+		 * the simulation time is set to this time to avoid round-off errors.
+		 * The time step size before shortening it is used again for the next
+		 * step unless the controller proposes a smaller one.
+		 */
+		void adaptive_finish_timestep()
+		{
+			// Shortened step accepted without reduction by the controller
+			if (adaptive_target_time >= 0 && current_timestep_size == adaptive_target_timestep_size)
+			{
+				current_simulation_time = adaptive_target_time;
+
+				if (adaptive_next_timestep_size >= current_timestep_size)
+					adaptive_next_timestep_size = std::max(adaptive_next_timestep_size, adaptive_timestep_size);
+			}
+
+			adaptive_target_time = -1;
+		}
+
 
 		void outputConfig()
 		{
@@ -1155,6 +1325,11 @@ public:
 			std::cout << " + max_timesteps_nr: " << max_timesteps_nr << std::endl;
 			std::cout << " + max_simulation_time: " << max_simulation_time << std::endl;
 			std::cout << " + max_wallclock_time: " << max_wallclock_time << std::endl;
+			std::cout << " + dt_adaptive: " << dt_adaptive << std::endl;
+			std::cout << " + dt_adaptive_atol: " << dt_adaptive_atol << std::endl;
+			std::cout << " + dt_adaptive_rtol: " << dt_adaptive_rtol << std::endl;
+			std::cout << " + dt_adaptive_min: " << dt_adaptive_min << std::endl;
+			std::cout << " + dt_adaptive_max: " << dt_adaptive_max << std::endl;
 			std::cout << std::endl;
 		}
 
@@ -1169,6 +1344,21 @@ public:
 
 			long_options[next_free_program_option] = {"max-wallclock-time", required_argument, 0, 256+next_free_program_option};
 			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"dt-adaptive", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"dt-adaptive-atol", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"dt-adaptive-rtol", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"dt-adaptive-min", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"dt-adaptive-max", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
 		}
 
 
@@ -1194,15 +1384,209 @@ public:
 			case 1:
 				max_wallclock_time = atof(i_value);
 				return -1;
+
+			case 2:
+				dt_adaptive = atoi(i_value);
+				return -1;
+
+			case 3:
+				dt_adaptive_atol = atof(i_value);
+				return -1;
+
+			case 4:
+				dt_adaptive_rtol = atof(i_value);
+				return -1;
+
+			case 5:
+				dt_adaptive_min = atof(i_value);
+				return -1;
+
+			case 6:
+				dt_adaptive_max = atof(i_value);
+				return -1;
 			}
 
-			return 2;
+			return 7;
 		}
 
 	} timecontrol;
 
 
 
+	/**
+	 * Ensemble of simulations advanced together in one process
+	 */
+	struct Ensemble
+	{
+		/// Number of ensemble members
+		int ensemble_size = 1;
+
+		/// Amplitude of random perturbations of the geopotential for members > 0
+		double perturbation_amplitude = 0;
+
+		/// Seed for random perturbations, member m uses (seed + m)
+		int perturbation_seed = 0;
+
+
+		void outputConfig()
+		{
+			std::cout << std::endl;
+			std::cout << "ENSEMBLE:" << std::endl;
+			std::cout << " + ensemble_size: " << ensemble_size << std::endl;
+			std::cout << " + perturbation_amplitude: " << perturbation_amplitude << std::endl;
+			std::cout << " + perturbation_seed: " << perturbation_seed << std::endl;
+			std::cout << std::endl;
+		}
+
+
+		void outputProgParams()
+		{
+			std::cout << "" << std::endl;
+			std::cout << "Ensemble:" << std::endl;
+			std::cout << "	--ensemble-size [int]			Number of ensemble members advanced together, default: 1" << std::endl;
+			std::cout << "	--ensemble-perturbation [float]		Amplitude of random geopotential perturbation of members > 0, default: 0" << std::endl;
+			std::cout << "	--ensemble-perturbation-seed [int]	Random seed of perturbations, default: 0" << std::endl;
+			std::cout << "" << std::endl;
+		}
+
+
+		void setup_longOptionsList(
+				struct option *long_options,
+				int &next_free_program_option
+		)
+		{
+			long_options[next_free_program_option] = {"ensemble-size", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"ensemble-perturbation", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"ensemble-perturbation-seed", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+		}
+
+
+		/*
+		 * This method is called to parse a particular
+		 * long option related to some ID.
+		 *
+		 * \return: -1 if the option has been processed
+		 */
+		int setup_longOptionValue(
+				int i_option_index,		///< Index relative to the parameters setup in this class only, starts with 0
+				const char *i_value		///< Value in string format
+		)
+		{
+			switch(i_option_index)
+			{
+			case 0:
+				ensemble_size = atoi(i_value);
+				if (ensemble_size <= 0)
+					SWEETError("Ensemble size must be at least 1");
+				return -1;
+
+			case 1:
+				perturbation_amplitude = atof(i_value);
+				return -1;
+
+			case 2:
+				perturbation_seed = atoi(i_value);
+				return -1;
+			}
+
+			return 3;
+		}
+
+	} ensemble;
+
+
+
+	/**
+	 * Sweep over parameter sets in a single program run
+	 */
+	struct Sweep
+	{
+		/// File with one set of program arguments per line
+		std::string sweep_file = "";
+
+		/// Number of workers running configurations concurrently on separate cores
+		int sweep_parallel = 1;
+
+		/// Run only the configurations of this worker (used for processes started as workers)
+		int sweep_worker_id = -1;
+
+
+		void outputConfig()
+		{
+			std::cout << std::endl;
+			std::cout << "SWEEP:" << std::endl;
+			std::cout << " + sweep_file: " << sweep_file << std::endl;
+			std::cout << " + sweep_parallel: " << sweep_parallel << std::endl;
+			std::cout << " + sweep_worker_id: " << sweep_worker_id << std::endl;
+			std::cout << std::endl;
+		}
+
+
+		void outputProgParams()
+		{
+			std::cout << "" << std::endl;
+			std::cout << "Sweep:" << std::endl;
+			std::cout << "	--sweep-file [string]		File with program arguments of one configuration per line, default: ''" << std::endl;
+			std::cout << "	--sweep-parallel [int]		Number of workers running configurations concurrently on separate cores, default: 1" << std::endl;
+			std::cout << "	--sweep-worker-id [int]		Run only the configurations of this worker, default: -1" << std::endl;
+			std::cout << "" << std::endl;
+		}
+
+
+		void setup_longOptionsList(
+				struct option *long_options,
+				int &next_free_program_option
+		)
+		{
+			long_options[next_free_program_option] = {"sweep-file", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"sweep-parallel", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+
+			long_options[next_free_program_option] = {"sweep-worker-id", required_argument, 0, 256+next_free_program_option};
+			next_free_program_option++;
+		}
+
+
+		/*
+		 * This method is called to parse a particular
+		 * long option related to some ID.
+		 *
+		 * \return: -1 if the option has been processed
+		 */
+		int setup_longOptionValue(
+				int i_option_index,		///< Index relative to the parameters setup in this class only, starts with 0
+				const char *i_value		///< Value in string format
+		)
+		{
+			switch(i_option_index)
+			{
+			case 0:
+				sweep_file = i_value;
+				return -1;
+
+			case 1:
+				sweep_parallel = atoi(i_value);
+				return -1;
+
+			case 2:
+				sweep_worker_id = atoi(i_value);
+				return -1;
+			}
+
+			return 3;
+		}
+
+	} sweep;
+
+
+
 	void outputConfig()
 	{
 		sim.outputConfig();
@@ -1210,6 +1594,8 @@ public:
 		benchmark.outputConfig();
 		iodata.outputConfig();
 		timecontrol.outputConfig();
+		ensemble.outputConfig();
+		sweep.outputConfig();
 
 		rexi.outputConfig();
 		swe_polvani.outputConfig();
@@ -1232,6 +1618,22 @@ public:
 	}
 
 
+	/**
+	 * Reset all parameters to their defaults, e.g. before parsing the
+	 * arguments of another configuration of a parameter sweep
+	 */
+	void reset_to_defaults()
+	{
+#if SWEET_USE_SPHERE_SPECTRAL_SPACE
+		// release topography since it is not overwritten by data which isn't set up
+		benchmark.h_topo.free();
+#endif
+
+		static const SimulationVariables defaults;
+		*this = defaults;
+	}
+
+
 	/**
 	 * update variables which are based on others
 	 */
@@ -1246,6 +1648,10 @@ public:
 		timecontrol.current_timestep_nr = 0;
 		timecontrol.current_simulation_time = 0;
 		timecontrol.current_timestep_size = timecontrol.setup_timestep_size;
+		timecontrol.adaptive_next_timestep_size = -1;
+		timecontrol.adaptive_timestep_size = -1;
+		timecontrol.adaptive_target_time = -1;
+		timecontrol.adaptive_target_timestep_size = -1;
 
 		if ((disc.space_res_physical[0] != -1) && (disc.space_res_physical[1] != -1))
 			if ((disc.space_res_physical[0] & 1) || (disc.space_res_physical[1] & 1))
@@ -1369,11 +1775,18 @@ public:
 		std::cout << "Control:" << std::endl;
 		std::cout << "	--dt [time]	timestep size, default=?" << std::endl;
 		std::cout << "	--max-wallclock-time [time]	wallclock time limitation, default=-1" << std::endl;
+		std::cout << "	--dt-adaptive [0/1]	adaptive time step size with embedded RK pairs (orders 3 and 5), default=0" << std::endl;
+		std::cout << "	--dt-adaptive-atol [float]	absolute tolerance for adaptive time stepping, default=0" << std::endl;
+		std::cout << "	--dt-adaptive-rtol [float]	relative tolerance for adaptive time stepping, default=1e-6" << std::endl;
+		std::cout << "	--dt-adaptive-min [time]	minimum time step size for adaptive time stepping, default=0" << std::endl;
+		std::cout << "	--dt-adaptive-max [time]	maximum time step size for adaptive time stepping, default=inf" << std::endl;
 		std::cout << "	-t [time]	maximum simulation time, default=-1 (infinity)" << std::endl;
 		std::cout << "	-T [stepnr]	maximum number of time steps, default=-1 (infinity)" << std::endl;
 		std::cout << "	-o [time]	time interval at which output should be written, (set to 0 for output at every time step), default=-1 (no output) " << std::endl;
 
 		misc.outputProgParams();
+		ensemble.outputProgParams();
+		sweep.outputProgParams();
 		rexi.outputProgParams();
 		swe_polvani.outputProgParams();
 
@@ -1439,6 +1852,12 @@ public:
         int timecontrol_start_option_index = next_free_program_option;
 		timecontrol.setup_longOptionsList(long_options, next_free_program_option);
 
+        int ensemble_start_option_index = next_free_program_option;
+		ensemble.setup_longOptionsList(long_options, next_free_program_option);
+
+        int sweep_start_option_index = next_free_program_option;
+		sweep.setup_longOptionsList(long_options, next_free_program_option);
+
 #if SWEET_PARAREAL
         int parareal_start_option_index = next_free_program_option;
         parareal.setup_longOptionList(
@@ -1592,6 +2011,20 @@ public:
 						c += retval;
 					}
 
+					{
+						int retval = ensemble.setup_longOptionValue(i-ensemble_start_option_index, optarg);
+						if (retval == -1)
+							continue;
+						c += retval;
+					}
+
+					{
+						int retval = sweep.setup_longOptionValue(i-sweep_start_option_index, optarg);
+						if (retval == -1)
+							continue;
+						c += retval;
+					}
+
 #if SWEET_PARAREAL
 					{
 						int retval = parareal.setup_longOptionValue(i-parareal_start_option_index, optarg);
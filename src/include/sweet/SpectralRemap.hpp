@@ -0,0 +1,132 @@
+/*
+ * SpectralRemap.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPECTRALREMAP_HPP_
+#define SRC_INCLUDE_SWEET_SPECTRALREMAP_HPP_
+
+#include <complex>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <functional>
+#include <sweet/openmp_helper.hpp>
+
+
+
+/*
+ * Index map to copy spectral coefficients between two
+ * spectral configurations with a different number of modes
+ * (truncation / zero padding) without any transformation.
+ *
+ * The map is given by contiguous blocks. For each block,
+ * 'num_copy' coefficients are copied from the source and the
+ * following 'num_zero' coefficients in the destination are zeroed.
+ *
+ * The blocks cover the entire destination array.
+ */
+class SpectralRemap
+{
+public:
+	struct Block
+	{
+		std::size_t src_idx;
+		std::size_t dst_idx;
+		std::size_t num_copy;
+		std::size_t num_zero;
+	};
+
+	std::vector<Block> blocks;
+
+
+	void add_block(
+			std::size_t i_src_idx,
+			std::size_t i_dst_idx,
+			std::size_t i_num_copy,
+			std::size_t i_num_zero
+	)
+	{
+		blocks.push_back({i_src_idx, i_dst_idx, i_num_copy, i_num_zero});
+	}
+
+
+	/**
+	 * Apply the map: o_dst = remap(i_src)*i_scale
+	 */
+	void apply(
+			const std::complex<double> *i_src,
+			std::complex<double> *o_dst,
+			double i_scale = 1.0
+	)	const
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (std::size_t b = 0; b < blocks.size(); b++)
+		{
+			const Block &block = blocks[b];
+
+			const std::complex<double> *src = i_src + block.src_idx;
+			std::complex<double> *dst = o_dst + block.dst_idx;
+
+			if (i_scale == 1.0)
+			{
+				std::memcpy(dst, src, sizeof(std::complex<double>)*block.num_copy);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < block.num_copy; i++)
+					dst[i] = src[i]*i_scale;
+			}
+
+			std::fill(dst + block.num_copy, dst + block.num_copy + block.num_zero, std::complex<double>(0));
+		}
+	}
+};
+
+
+
+/*
+ * Cache for spectral index maps.
+ *
+ * The maps only depend on the number of modes of both
+ * configurations which is used as the key.
+ */
+class SpectralRemapCache
+{
+	std::map<std::vector<std::size_t>, SpectralRemap> cache;
+
+public:
+	const SpectralRemap& get(
+			const std::vector<std::size_t> &i_key,
+			std::function<void(SpectralRemap&)> i_setup
+	)
+	{
+		SpectralRemap *remap;
+
+#if SWEET_THREADING_SPACE || SWEET_THREADING_TIME
+#pragma omp critical (SpectralRemapCache)
+#endif
+		{
+			auto iter = cache.find(i_key);
+
+			if (iter == cache.end())
+			{
+				remap = &cache[i_key];
+				i_setup(*remap);
+			}
+			else
+			{
+				remap = &iter->second;
+			}
+		}
+
+		return *remap;
+	}
+};
+
+
+
+#endif
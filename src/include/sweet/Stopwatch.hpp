@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <cassert>
 #include <iostream>
+#include <sweet/PerformanceCounters.hpp>
 
 #define SWEET_TIMER_CHRONO	1
 
@@ -52,6 +53,8 @@ private:
 
 	int recursive_counter;	/// count recursions to support nested calls
 
+	PerformanceCounterRegion *counters = nullptr;	///< optional performance counters of this region
+
 public:
 	double time;		///< stopped time (difference between start and stop time)
 
@@ -63,6 +66,31 @@ public:
 		time = 0.0f;
 
 		recursive_counter = 0;
+
+		if (counters != nullptr)
+			counters->reset();
+	}
+
+
+	/**
+	 * Sample performance counters between start and stop
+	 *
+	 * If the stopwatch is already running, sampling starts immediately.
+	 */
+	void set_performance_counters(
+			PerformanceCounterRegion *i_counters
+	)
+	{
+		counters = i_counters;
+
+		if (counters != nullptr && recursive_counter > 0)
+			counters->start();
+	}
+
+
+	const PerformanceCounterRegion* get_performance_counters()	const
+	{
+		return counters;
 	}
 
 	/**
@@ -92,6 +120,9 @@ public:
 #else
 			gettimeofday(&timevalue_start, NULL);
 #endif
+
+			if (counters != nullptr)
+				counters->start();
 		}
 
 		recursive_counter++;
@@ -109,6 +140,9 @@ public:
 
 		if (recursive_counter == 0)
 		{
+			if (counters != nullptr)
+				counters->stop();
+
 #if SWEET_TIMER_CHRONO
 			timevalue_stop = std::chrono::system_clock::now();
 
@@ -30,7 +30,7 @@ public:
 		{
 //#if SWEET_DEBUG
 			if (i_output)
-				std::cout << "Warning: Reducing time step size from " << i_old_timestep_size << " to " << i_new_timestep_size << std::endl;
+				std::cout << "Warning: Changing time step size from " << i_old_timestep_size << " to " << i_new_timestep_size << std::endl;
 //#endif
 
 			return true;
@@ -0,0 +1,127 @@
+/*
+ * TimeStepSizeControllerPI.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPSIZECONTROLLERPI_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPSIZECONTROLLERPI_HPP_
+
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+
+/*
+ * PI time step size controller for embedded Runge-Kutta pairs
+ *
+ * See Hairer, Wanner: Solving Ordinary Differential Equations II, Sec. IV.2
+ * and Gustafsson: Control theoretic techniques for stepsize selection
+ * in explicit Runge-Kutta methods, ACM TOMS, 1991
+ *
+ *   dt_new = dt * safety * err^(-beta1) * err_prev^(beta2)
+ *
+ * with err being the error estimate scaled by the tolerances.
+ *
+ * To avoid a re-setup of implicit/REXI sub-solvers for tiny changes
+ * (see TimeStepSizeChanged), the time step size is kept bitwise
+ * identical if the proposed growth factor is within [1, keep_factor_max].
+ */
+class TimeStepSizeControllerPI
+{
+public:
+	double safety = 0.9;
+
+	/// Exponent of the local error, this is (order of embedded method)+1
+	double k = 1;
+
+	double beta1 = 0;
+	double beta2 = 0;
+
+	/// Limits for the change of the time step size
+	double factor_min = 0.2;
+	double factor_max = 5.0;
+
+	/// Keep time step size if the growth factor is below this value
+	double keep_factor_max = 1.2;
+
+	/// Limits for the time step size
+	double dt_min = 0;
+	double dt_max = std::numeric_limits<double>::infinity();
+
+	/// Scaled error of last accepted step
+	double err_prev = 1.0;
+
+	/// Whether the last step has been rejected
+	bool last_rejected = false;
+
+
+public:
+	void setup(
+			int i_order_embedded,	///< order of the embedded (lower order) method
+			double i_dt_min = 0,
+			double i_dt_max = std::numeric_limits<double>::infinity()
+	)
+	{
+		k = i_order_embedded+1;
+
+		beta1 = 0.7/k;
+		beta2 = 0.4/k;
+
+		dt_min = i_dt_min;
+		dt_max = i_dt_max;
+
+		err_prev = 1.0;
+		last_rejected = false;
+	}
+
+
+	/*
+	 * Return whether the step with the scaled error i_err is accepted
+	 * and provide the time step size to try next.
+	 */
+	bool propose(
+			double i_dt,		///< time step size used for the step
+			double i_err,		///< error scaled by tolerances (accept if <= 1)
+			double &o_dt_next	///< time step size to use next
+	)
+	{
+		double err = std::max(i_err, 1e-10);
+
+		bool accept = (i_err <= 1.0) || (i_dt <= dt_min);
+
+		double factor;
+		if (accept)
+		{
+			factor = safety*std::pow(err, -beta1)*std::pow(err_prev, beta2);
+
+			// No increase of time step size directly after a rejection
+			if (last_rejected)
+				factor = std::min(factor, 1.0);
+
+			err_prev = err;
+		}
+		else
+		{
+			// Pure I controller for rejected steps
+			factor = safety*std::pow(err, -1.0/k);
+			factor = std::min(factor, 0.9);
+		}
+
+		factor = std::max(factor_min, std::min(factor_max, factor));
+
+		if (accept && factor >= 1.0 && factor <= keep_factor_max)
+			o_dt_next = i_dt;
+		else
+			o_dt_next = std::max(dt_min, std::min(dt_max, i_dt*factor));
+
+		last_rejected = !accept;
+		return accept;
+	}
+};
+
+
+
+#endif
@@ -0,0 +1,346 @@
+/*
+ * TimesteppingEmbeddedRK.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPPINGEMBEDDEDRK_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPPINGEMBEDDEDRK_HPP_
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <sweet/TimeStepSizeControllerPI.hpp>
+#include <sweet/SWEETError.hpp>
+
+
+
+/*
+ * Butcher tableau of an embedded explicit Runge-Kutta pair
+ */
+class EmbeddedRKTableau
+{
+public:
+	std::string name;
+
+	int stages = 0;
+
+	/// Order of the solution which is propagated
+	int order = 0;
+
+	/// Order of the embedded solution used for the error estimate
+	int order_embedded = 0;
+
+	std::vector<std::vector<double>> a;
+	std::vector<double> b;
+	std::vector<double> b_embedded;
+	std::vector<double> c;
+
+
+	/*
+	 * Setup embedded RK pair.
+	 *
+	 * Supported:
+	 *   3: Bogacki-Shampine 3(2)
+	 *   5: Dormand-Prince 5(4)
+	 *
+	 * Both pairs have the FSAL property which we don't exploit since the
+	 * solution might be modified between time steps (e.g. by hyperviscosity).
+	 */
+	void setup(
+			int i_order
+	)
+	{
+		if (i_order == 3)
+		{
+			/*
+			 * Bogacki, Shampine: A 3(2) pair of Runge-Kutta formulas,
+			 * Appl. Math. Letters, 1989
+			 */
+			name = "bs32";
+			stages = 4;
+			order = 3;
+			order_embedded = 2;
+
+			a = {
+					{},
+					{1.0/2.0},
+					{0.0, 3.0/4.0},
+					{2.0/9.0, 1.0/3.0, 4.0/9.0},
+			};
+			b = {2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0};
+			b_embedded = {7.0/24.0, 1.0/4.0, 1.0/3.0, 1.0/8.0};
+			c = {0.0, 1.0/2.0, 3.0/4.0, 1.0};
+		}
+		else if (i_order == 5)
+		{
+			/*
+			 * Dormand, Prince: A family of embedded Runge-Kutta formulae,
+			 * J. Comp. Appl. Math., 1980
+			 */
+			name = "dp54";
+			stages = 7;
+			order = 5;
+			order_embedded = 4;
+
+			a = {
+					{},
+					{1.0/5.0},
+					{3.0/40.0, 9.0/40.0},
+					{44.0/45.0, -56.0/15.0, 32.0/9.0},
+					{19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0},
+					{9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0},
+					{35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0},
+			};
+			b = {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0};
+			b_embedded = {5179.0/57600.0, 0.0, 7571.0/16695.0, 393.0/640.0, -92097.0/339200.0, 187.0/2100.0, 1.0/40.0};
+			c = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+		}
+		else
+		{
+			SWEETError("Only orders 3 (Bogacki-Shampine 3(2)) and 5 (Dormand-Prince 5(4)) supported for embedded RK time stepping");
+		}
+	}
+};
+
+
+
+/*
+ * Adaptive time stepping with embedded RK pairs for three prognostic variables
+ *
+ * TData is the spectral data type (SphereData_Spectral, PlaneData_Spectral).
+ * The error is estimated in spectral space as the maximum absolute value of
+ * the difference of both solutions, scaled by
+ *
+ *   atol + rtol * max(|U^n|, |U^{n+1}|)
+ *
+ * individually for each prognostic variable.
+ */
+template <typename TData>
+class TimesteppingEmbeddedRK
+{
+public:
+	EmbeddedRKTableau tableau;
+	TimeStepSizeControllerPI controller;
+
+	double atol = 0;
+	double rtol = 1e-6;
+
+	/// Maximum number of rejections before giving up
+	int max_rejections = 50;
+
+	/// Statistics
+	int num_accepted_steps = 0;
+	int num_rejected_steps = 0;
+
+private:
+	/// Stage derivatives
+	std::vector<TData> k0, k1, k2;
+
+	/// Stage values, new solution and error estimate, allocated once
+	std::vector<TData> u0, u1, u2;
+
+
+public:
+	void setup(
+			int i_order,
+			double i_atol,
+			double i_rtol,
+			double i_dt_min = 0,
+			double i_dt_max = std::numeric_limits<double>::infinity()
+	)
+	{
+		tableau.setup(i_order);
+		controller.setup(tableau.order_embedded, i_dt_min, i_dt_max);
+
+		atol = i_atol;
+		rtol = i_rtol;
+
+		k0.clear();
+		k1.clear();
+		k2.clear();
+
+		u0.clear();
+		u1.clear();
+		u2.clear();
+
+		num_accepted_steps = 0;
+		num_rejected_steps = 0;
+	}
+
+
+	bool isSetup()	const
+	{
+		return tableau.stages > 0;
+	}
+
+
+private:
+	static
+	double p_maxabs(const TData &i_data)
+	{
+		// spectral_reduce_max_abs() returns the squared magnitude
+		return std::sqrt(i_data.spectral_reduce_max_abs());
+	}
+
+
+public:
+	/*
+	 * Run one accepted time step.
+	 *
+	 * io_dt is the time step size to try first and returns the
+	 * time step size which was finally used.
+	 */
+	template <class BaseClass>
+	void run_timestep(
+			BaseClass *i_baseClass,
+			void (BaseClass::*i_compute_euler_timestep_update)(
+					const TData &i_U0,
+					const TData &i_U1,
+					const TData &i_U2,
+
+					TData &o_U0_t,
+					TData &o_U1_t,
+					TData &o_U2_t,
+
+					double i_simulation_time
+			),
+
+			TData &io_U0,
+			TData &io_U1,
+			TData &io_U2,
+
+			double &io_dt,			///< in: time step size to try, out: time step size used
+			double &o_dt_next,		///< proposed time step size for the next step
+
+			double i_simulation_time
+	)
+	{
+		if (!isSetup())
+			SWEETError("TimesteppingEmbeddedRK not setup");
+
+		int S = tableau.stages;
+
+		if ((int)k0.size() != S)
+		{
+			k0.assign(S, io_U0);
+			k1.assign(S, io_U1);
+			k2.assign(S, io_U2);
+
+			// [0]: stage value / new solution, [1]: error estimate
+			u0.assign(2, io_U0);
+			u1.assign(2, io_U1);
+			u2.assign(2, io_U2);
+		}
+
+		TData &U0 = u0[0], &U1 = u1[0], &U2 = u2[0];
+		TData &E0 = u0[1], &E1 = u1[1], &E2 = u2[1];
+
+		double dt = io_dt;
+
+		for (int rejection = 0; ; rejection++)
+		{
+			if (rejection > max_rejections)
+				SWEETError("Too many rejected time steps in adaptive RK time stepping");
+
+			for (int s = 0; s < S; s++)
+			{
+				if (s == 0)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							io_U0, io_U1, io_U2,
+							k0[0], k1[0], k2[0],
+							i_simulation_time
+						);
+					continue;
+				}
+
+				U0 = io_U0;
+				U1 = io_U1;
+				U2 = io_U2;
+
+				for (int j = 0; j < s; j++)
+				{
+					double f = dt*tableau.a[s][j];
+					if (f == 0)
+						continue;
+
+					U0 += f*k0[j];
+					U1 += f*k1[j];
+					U2 += f*k2[j];
+				}
+
+				(i_baseClass->*i_compute_euler_timestep_update)(
+						U0, U1, U2,
+						k0[s], k1[s], k2[s],
+						i_simulation_time + tableau.c[s]*dt
+					);
+			}
+
+			/*
+			 * New solution and error estimate
+			 */
+			U0 = io_U0;
+			U1 = io_U1;
+			U2 = io_U2;
+
+			E0.spectral_set_zero();
+			E1.spectral_set_zero();
+			E2.spectral_set_zero();
+
+			for (int j = 0; j < S; j++)
+			{
+				double fb = dt*tableau.b[j];
+				double fe = dt*(tableau.b[j] - tableau.b_embedded[j]);
+
+				if (fb != 0)
+				{
+					U0 += fb*k0[j];
+					U1 += fb*k1[j];
+					U2 += fb*k2[j];
+				}
+
+				if (fe != 0)
+				{
+					E0 += fe*k0[j];
+					E1 += fe*k1[j];
+					E2 += fe*k2[j];
+				}
+			}
+
+			double err = 0;
+			err = std::max(err, p_maxabs(E0)/(atol + rtol*std::max(p_maxabs(io_U0), p_maxabs(U0))));
+			err = std::max(err, p_maxabs(E1)/(atol + rtol*std::max(p_maxabs(io_U1), p_maxabs(U1))));
+			err = std::max(err, p_maxabs(E2)/(atol + rtol*std::max(p_maxabs(io_U2), p_maxabs(U2))));
+
+			if (std::isnan(err))
+				SWEETError("NaN detected in error estimate of adaptive RK time stepping");
+
+			double dt_next;
+			bool accepted = controller.propose(dt, err, dt_next);
+
+			if (accepted)
+			{
+				io_U0.swap(U0);
+				io_U1.swap(U1);
+				io_U2.swap(U2);
+
+				io_dt = dt;
+				o_dt_next = dt_next;
+
+				num_accepted_steps++;
+				return;
+			}
+
+			num_rejected_steps++;
+			dt = dt_next;
+		}
+	}
+};
+
+
+
+#endif
@@ -0,0 +1,332 @@
+/*
+ * TimesteppingExplicitRKStages.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPPINGEXPLICITRKSTAGES_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPPINGEXPLICITRKSTAGES_HPP_
+
+#include <vector>
+#include <sweet/SWEETError.hpp>
+
+
+
+/*
+ * Butcher tableaux of the explicit RK methods used by the RK drivers,
+ * known at compile time
+ *
+ * See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
+ * See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
+ */
+template <int t_order>
+class ExplicitRKTableau;
+
+
+/*
+ * Forward Euler
+ */
+template <>
+class ExplicitRKTableau<1>
+{
+public:
+	static constexpr int stages = 1;
+
+	static double a(int, int)	{ return 0; }
+	static double b(int)		{ return 1.0; }
+	static double c(int)		{ return 0; }
+};
+
+
+/*
+ * c     a
+ * 0   |
+ * 1/2 | 1/2
+ * --------------
+ *     | 0   1    b
+ */
+template <>
+class ExplicitRKTableau<2>
+{
+public:
+	static constexpr int stages = 2;
+
+	static double a(int i, int j)
+	{
+		static const double a_[2][2] = {
+				{0, 0},
+				{0.5, 0}
+		};
+		return a_[i][j];
+	}
+
+	static double b(int i)
+	{
+		static const double b_[2] = {0.0, 1.0};
+		return b_[i];
+	}
+
+	static double c(int i)
+	{
+		static const double c_[2] = {0.0, 0.5};
+		return c_[i];
+	}
+};
+
+
+/*
+ * c     a
+ * 0   |
+ * 1/3 | 1/3
+ * 2/3 | 0    2/3
+ * --------------
+ *     | 1/4  0   3/4
+ */
+template <>
+class ExplicitRKTableau<3>
+{
+public:
+	static constexpr int stages = 3;
+
+	static double a(int i, int j)
+	{
+		static const double a_[3][3] = {
+				{0, 0, 0},
+				{1.0/3.0, 0, 0},
+				{0.0, 2.0/3.0, 0}
+		};
+		return a_[i][j];
+	}
+
+	static double b(int i)
+	{
+		static const double b_[3] = {1.0/4.0, 0.0, 3.0/4.0};
+		return b_[i];
+	}
+
+	static double c(int i)
+	{
+		static const double c_[3] = {0.0, 1.0/3.0, 2.0/3.0};
+		return c_[i];
+	}
+};
+
+
+/*
+ * c     a
+ * 0   |
+ * 1/2 | 1/2
+ * 1/2 | 0    1/2
+ * 1   | 0    0    1
+ * --------------
+ *     | 1/6  1/3  1/3  1/6
+ */
+template <>
+class ExplicitRKTableau<4>
+{
+public:
+	static constexpr int stages = 4;
+
+	static double a(int i, int j)
+	{
+		static const double a_[4][4] = {
+				{0, 0, 0, 0},
+				{0.5, 0, 0, 0},
+				{0.0, 0.5, 0, 0},
+				{0.0, 0.0, 1.0, 0}
+		};
+		return a_[i][j];
+	}
+
+	static double b(int i)
+	{
+		static const double b_[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
+		return b_[i];
+	}
+
+	static double c(int i)
+	{
+		static const double c_[4] = {0.0, 0.5, 0.5, 1.0};
+		return c_[i];
+	}
+};
+
+
+
+/*
+ * Stage handling of explicit RK methods for an arbitrary number of
+ * prognostic fields of type TData (SphereData_Spectral, PlaneData_Spectral).
+ *
+ * The tableau is a template parameter. The input of each stage and the
+ * final update are computed by fused linear combinations of all previous
+ * stages (TData::spectral_linear_combination) in a single pass per field.
+ * Stages with zero coefficients are skipped.
+ *
+ * The stage inputs are written into buffers which are reused for all stages
+ * and time steps. The tendencies are stored in the buffers of the RK driver
+ * which are provided by i_k(stage, field).
+ */
+template <typename TData>
+class TimesteppingExplicitRKStages
+{
+	/// Input of the current stage, one buffer per field
+	std::vector<TData> U_stage;
+
+
+private:
+	/*
+	 * o_U = i_U + sum_j i_alpha[j] * i_y[j]
+	 */
+	static
+	void p_combine(
+			TData &o_U,
+			const TData &i_U,
+			int i_num_terms,
+			const double *i_alpha,
+			const TData *const *i_y
+	)
+	{
+		switch (i_num_terms)
+		{
+		case 0:
+			if (&o_U != &i_U)
+				o_U = i_U;
+			break;
+
+		case 1:	o_U.template spectral_linear_combination<1>(i_U, i_alpha, i_y);	break;
+		case 2:	o_U.template spectral_linear_combination<2>(i_U, i_alpha, i_y);	break;
+		case 3:	o_U.template spectral_linear_combination<3>(i_U, i_alpha, i_y);	break;
+		case 4:	o_U.template spectral_linear_combination<4>(i_U, i_alpha, i_y);	break;
+
+		default:
+			SWEETError("Number of terms for fused RK stage combination not supported");
+		}
+	}
+
+
+	/*
+	 * io_U[f] = i_U[f] + i_dt * sum_{j<i_num_stages} i_coeff(j) * k(j, f)
+	 */
+	template <typename TCoeff, typename TStageBuffer>
+	static
+	void p_combine_stages(
+			TData *const *o_U,
+			TData *const *i_U,
+			int i_num_fields,
+			int i_num_stages,
+			double i_dt,
+			TCoeff i_coeff,
+			TStageBuffer &i_k
+	)
+	{
+		double alpha[4];
+		const TData *y[4];
+
+		for (int f = 0; f < i_num_fields; f++)
+		{
+			int n = 0;
+			for (int j = 0; j < i_num_stages; j++)
+			{
+				double coeff = i_coeff(j);
+				if (coeff == 0)
+					continue;
+
+				alpha[n] = i_dt*coeff;
+				y[n] = &i_k(j, f);
+				n++;
+			}
+
+			p_combine(*o_U[f], *i_U[f], n, alpha, y);
+		}
+	}
+
+
+public:
+	/**
+	 * Run one time step with the tableau of order t_order
+	 *
+	 * i_eval(U, stage, time) computes the tendencies of the fields U
+	 * and stores them in i_k(stage, field).
+	 */
+	template <int t_order, typename TEval, typename TStageBuffer>
+	void run_timestep(
+			TEval i_eval,
+			TStageBuffer i_k,
+			TData *const *io_U,
+			int i_num_fields,
+			double i_dt,
+			double i_simulation_time
+	)
+	{
+		typedef ExplicitRKTableau<t_order> Tableau;
+
+		if ((int)U_stage.size() != i_num_fields)
+		{
+			U_stage.clear();
+			for (int f = 0; f < i_num_fields; f++)
+				U_stage.push_back(*io_U[f]);
+		}
+
+		TData *U_stage_ptr[4];
+		for (int f = 0; f < i_num_fields; f++)
+			U_stage_ptr[f] = &U_stage[f];
+
+		for (int s = 0; s < Tableau::stages; s++)
+		{
+			if (s == 0)
+			{
+				i_eval(io_U, 0, i_simulation_time);
+				continue;
+			}
+
+			p_combine_stages(
+					U_stage_ptr, io_U, i_num_fields, s, i_dt,
+					[s](int j) -> double { return Tableau::a(s, j); },
+					i_k
+				);
+
+			i_eval(U_stage_ptr, s, i_simulation_time + Tableau::c(s)*i_dt);
+		}
+
+		p_combine_stages(
+				io_U, io_U, i_num_fields, Tableau::stages, i_dt,
+				[](int j) -> double { return Tableau::b(j); },
+				i_k
+			);
+	}
+
+
+	/**
+	 * Dispatch to the tableau specialized for the given order
+	 */
+	template <typename TEval, typename TStageBuffer>
+	void run_timestep(
+			int i_order,
+			TEval i_eval,
+			TStageBuffer i_k,
+			TData *const *io_U,
+			int i_num_fields,
+			double i_dt,
+			double i_simulation_time
+	)
+	{
+		if (i_num_fields > 4)
+			SWEETError("Only up to 4 prognostic fields supported");
+
+		switch (i_order)
+		{
+		case 1:	run_timestep<1>(i_eval, i_k, io_U, i_num_fields, i_dt, i_simulation_time);	break;
+		case 2:	run_timestep<2>(i_eval, i_k, io_U, i_num_fields, i_dt, i_simulation_time);	break;
+		case 3:	run_timestep<3>(i_eval, i_k, io_U, i_num_fields, i_dt, i_simulation_time);	break;
+		case 4:	run_timestep<4>(i_eval, i_k, io_U, i_num_fields, i_dt, i_simulation_time);	break;
+
+		default:
+			SWEETError("This order of the Runge-Kutta time stepping is not supported!");
+		}
+	}
+};
+
+
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * TimesteppingLowStorageRK.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_TIMESTEPPINGLOWSTORAGERK_HPP_
+#define SRC_INCLUDE_SWEET_TIMESTEPPINGLOWSTORAGERK_HPP_
+
+#include <vector>
+#include <sweet/SWEETError.hpp>
+
+
+
+/*
+ * Coefficients of 2N-storage explicit Runge-Kutta methods
+ * in Williamson form
+ *
+ *   for i = 0..stages-1:
+ *     dU = A[i]*dU + dt*F(U, t + c[i]*dt)
+ *     U = U + B[i]*dU
+ *
+ * Only the register dU is required in addition to the solution U
+ * (and a buffer for the output of the tendencies F).
+ *
+ * These methods are selected with negative time stepping orders:
+ *   -3: Williamson, Low-storage Runge-Kutta schemes, JCP, 1980 (3 stages, order 3)
+ *   -4: Carpenter, Kennedy, Fourth-order 2N-storage Runge-Kutta schemes,
+ *       NASA TM-109112, 1994 (5 stages, order 4)
+ */
+class TimesteppingLowStorageRK
+{
+public:
+	int order = 0;
+	int stages = 0;
+
+	std::vector<double> A;
+	std::vector<double> B;
+	std::vector<double> c;
+
+
+	static
+	bool isLowStorageOrder(int i_order)
+	{
+		return i_order == -3 || i_order == -4;
+	}
+
+
+	void setup(
+			int i_order
+	)
+	{
+		if (i_order == order)
+			return;
+
+		order = i_order;
+
+		if (i_order == -3)
+		{
+			stages = 3;
+			A = {0.0, -5.0/9.0, -153.0/128.0};
+			B = {1.0/3.0, 15.0/16.0, 8.0/15.0};
+			c = {0.0, 1.0/3.0, 3.0/4.0};
+		}
+		else if (i_order == -4)
+		{
+			stages = 5;
+			A = {
+					0.0,
+					-567301805773.0/1357537059087.0,
+					-2404267990393.0/2016746695238.0,
+					-3550918686646.0/2091501179385.0,
+					-1275806237668.0/842570457699.0
+			};
+			B = {
+					1432997174477.0/9575080441755.0,
+					5161836677717.0/13612068292357.0,
+					1720146321549.0/2090206949498.0,
+					3134564353537.0/4481467310338.0,
+					2277821191437.0/14882151754819.0
+			};
+			c = {
+					0.0,
+					1432997174477.0/9575080441755.0,
+					2526269341429.0/6820363962896.0,
+					2006345519317.0/3224310063776.0,
+					2802321613138.0/2924317926251.0
+			};
+		}
+		else
+		{
+			SWEETError("Only orders -3 and -4 supported for low-storage RK time stepping");
+		}
+	}
+};
+
+
+
+#endif
@@ -496,7 +496,7 @@ private:
 			/*
 			 * Physical space data
 			 */
-			double *data_physical = MemBlockAlloc::alloc<double>(physical_array_data_number_of_elements*sizeof(double));
+			double *data_physical = MemBlockAlloc::alloc<double>(physical_array_data_number_of_elements*sizeof(double), "PlaneDataConfig");
 
 			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 			for (std::size_t i = 0; i < physical_array_data_number_of_elements; i++)
@@ -505,7 +505,7 @@ private:
 			/*
 			 * Spectral space data
 			 */
-			std::complex<double> *data_spectral = MemBlockAlloc::alloc< std::complex<double> >(spectral_array_data_number_of_elements*sizeof(std::complex<double>));
+			std::complex<double> *data_spectral = MemBlockAlloc::alloc< std::complex<double> >(spectral_array_data_number_of_elements*sizeof(std::complex<double>), "PlaneDataConfig");
 
 			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 			for (std::size_t i = 0; i < spectral_array_data_number_of_elements; i++)
@@ -605,7 +605,7 @@ private:
 			/*
 			 * Physical space data
 			 */
-			std::complex<double> *data_physical = MemBlockAlloc::alloc< std::complex<double> >(physical_array_data_number_of_elements*sizeof(std::complex<double>));
+			std::complex<double> *data_physical = MemBlockAlloc::alloc< std::complex<double> >(physical_array_data_number_of_elements*sizeof(std::complex<double>), "PlaneDataConfig");
 
 			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 			for (std::size_t i = 0; i < physical_array_data_number_of_elements; i++)
@@ -614,7 +614,7 @@ private:
 			/*
 			 * Spectral space data
 			 */
-			std::complex<double> *data_spectral = MemBlockAlloc::alloc< std::complex<double> >(spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>));
+			std::complex<double> *data_spectral = MemBlockAlloc::alloc< std::complex<double> >(spectral_complex_array_data_number_of_elements*sizeof(std::complex<double>), "PlaneDataConfig");
 
 			SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
 			for (std::size_t i = 0; i < spectral_complex_array_data_number_of_elements; i++)
@@ -3,6 +3,10 @@
 #define PLANEDATA_TIMESTEPPING_EXPLICIT_RK_HPP__
 
 #include "PlaneData_Spectral.hpp"
+#include <sweet/TimesteppingEmbeddedRK.hpp>
+#include <sweet/TimesteppingLowStorageRK.hpp>
+#include <sweet/TimesteppingExplicitRKStages.hpp>
+#include <sweet/MemBlockAlloc.hpp>
 
 class PlaneDataTimesteppingExplicitRK
 {
@@ -13,12 +17,25 @@ class PlaneDataTimesteppingExplicitRK
 
 	int runge_kutta_order;
 
+	// Number of allocated buffers for each variable
+	int num_stage_buffers;
+
+	// Embedded RK pairs for adaptive time stepping
+	TimesteppingEmbeddedRK<PlaneData_Spectral> embeddedRK;
+
+	// Coefficients of low-storage RK methods (negative orders)
+	TimesteppingLowStorageRK lowStorageRK;
+
+	// Fused stage combinations of RK methods with compile-time tableaux
+	TimesteppingExplicitRKStages<PlaneData_Spectral> explicitRKStages;
+
 public:
 	PlaneDataTimesteppingExplicitRK()	:
 		RK_h_t(nullptr),
 		RK_u_t(nullptr),
 		RK_v_t(nullptr),
-		runge_kutta_order(-1)
+		runge_kutta_order(-1),
+		num_stage_buffers(0)
 	{
 	}
 
@@ -32,12 +49,24 @@ public:
 		if (RK_h_t != nullptr)	///< already allocated?
 			return;
 
+		MemBlockAllocTag memTag("rk_stages");
+
 		runge_kutta_order = i_rk_order;
 		int N = i_rk_order;
 
-		if (N <= 0 || N > 4)
+		if (TimesteppingLowStorageRK::isLowStorageOrder(i_rk_order))
+		{
+			/*
+			 * Low-storage RK: One buffer for the tendencies and
+			 * one register independent of the number of stages
+			 */
+			N = 2;
+		}
+		else if (N <= 0 || N > 4)
 			SWEETError("Invalid order for RK time stepping (Please set --timestepping-order and/or --timestepping-order2)");
 
+		num_stage_buffers = N;
+
 		RK_h_t = new PlaneData_Spectral*[N];
 		RK_u_t = new PlaneData_Spectral*[N];
 		RK_v_t = new PlaneData_Spectral*[N];
@@ -54,7 +83,7 @@ public:
 
 	~PlaneDataTimesteppingExplicitRK()
 	{
-		int N = runge_kutta_order;
+		int N = num_stage_buffers;
 
 		if (RK_h_t != nullptr)
 		{
@@ -108,193 +137,142 @@ public:
 	{
 		setupBuffers(io_var0.planeDataConfig, i_runge_kutta_order);
 
-		if (i_runge_kutta_order == 1)
+		if (TimesteppingLowStorageRK::isLowStorageOrder(i_runge_kutta_order))
 		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,	// input
-					io_var1,
-					io_var2,
-					*RK_h_t[0],	// output
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
+			/*
+			 * 2N-storage RK, see TimesteppingLowStorageRK
+			 *
+			 * RK_*_t[0]: tendencies
+			 * RK_*_t[1]: register dU
+			 */
+			lowStorageRK.setup(i_runge_kutta_order);
 
+			PlaneData_Spectral &var0_t = *RK_h_t[0];
+			PlaneData_Spectral &var1_t = *RK_u_t[0];
+			PlaneData_Spectral &var2_t = *RK_v_t[0];
 
-			io_var0 += i_dt**RK_h_t[0];
-			io_var1 += i_dt**RK_u_t[0];
-			io_var2 += i_dt**RK_v_t[0];
+			PlaneData_Spectral &d_var0 = *RK_h_t[1];
+			PlaneData_Spectral &d_var1 = *RK_u_t[1];
+			PlaneData_Spectral &d_var2 = *RK_v_t[1];
 
+			for (int i = 0; i < lowStorageRK.stages; i++)
+			{
+				(i_baseClass->*i_compute_euler_timestep_update)(
+						io_var0,
+						io_var1,
+						io_var2,
+						var0_t,
+						var1_t,
+						var2_t,
+						i_simulation_time + lowStorageRK.c[i]*i_dt
+				);
+
+				// fused in-place updates to avoid temporaries
+				if (i == 0)
+				{
+					d_var0 = var0_t;
+					d_var1 = var1_t;
+					d_var2 = var2_t;
+
+					d_var0 *= i_dt;
+					d_var1 *= i_dt;
+					d_var2 *= i_dt;
+				}
+				else
+				{
+					d_var0.spectral_axpby(i_dt, var0_t, lowStorageRK.A[i]);
+					d_var1.spectral_axpby(i_dt, var1_t, lowStorageRK.A[i]);
+					d_var2.spectral_axpby(i_dt, var2_t, lowStorageRK.A[i]);
+				}
+
+				io_var0.spectral_axpby(lowStorageRK.B[i], d_var0, 1.0);
+				io_var1.spectral_axpby(lowStorageRK.B[i], d_var1, 1.0);
+				io_var2.spectral_axpby(lowStorageRK.B[i], d_var2, 1.0);
+			}
 		}
-		else if (i_runge_kutta_order == 2)
+		else
 		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
+			PlaneData_Spectral *U[3] = {&io_var0, &io_var1, &io_var2};
+			PlaneData_Spectral **U_stage_t[3] = {RK_h_t, RK_u_t, RK_v_t};
+
+			explicitRKStages.run_timestep(
+					i_runge_kutta_order,
+					[&](PlaneData_Spectral *const *i_U, int i_stage, double i_time)
+					{
+						(i_baseClass->*i_compute_euler_timestep_update)(
+								*i_U[0],
+								*i_U[1],
+								*i_U[2],
+								*RK_h_t[i_stage],
+								*RK_u_t[i_stage],
+								*RK_v_t[i_stage],
+								i_time
+						);
+					},
+					[&](int i_stage, int i_field) -> PlaneData_Spectral&
+					{
+						return *U_stage_t[i_field][i_stage];
+					},
+					U, 3,
+					i_dt,
 					i_simulation_time
-			);
+				);
+		}
+	}
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0 + ( i_dt*a2[0]*(*RK_h_t[0]) ),
-					io_var1 + ( i_dt*a2[0]*(*RK_u_t[0]) ),
-					io_var2 + ( i_dt*a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
 
-			io_var0 += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_h_t[1]) );
-			io_var1 += i_dt*(/* b[0]*(*RK_u_t[0]) +*/ b[1]*(*RK_u_t[1]) );
-			io_var2 += i_dt*(/* b[0]*(*RK_v_t[0]) +*/ b[1]*(*RK_v_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_var1	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_var2	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
+	/**
+	 * Execute an adaptive time step with an embedded RK pair
+	 * (order 3: Bogacki-Shampine 3(2), order 5: Dormand-Prince 5(4)).
+	 *
+	 * io_dt is the time step size to try first and returns the
+	 * accepted time step size. o_dt_next is the proposal for the next step.
+	 */
+	template <class BaseClass>
+	void run_timestep_adaptive(
+			BaseClass *i_baseClass,
+			void (BaseClass::*i_compute_euler_timestep_update)(
+					const PlaneData_Spectral &i_P,	///< prognostic variables
+					const PlaneData_Spectral &i_u,	///< prognostic variables
+					const PlaneData_Spectral &i_v,	///< prognostic variables
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a3[0]*(*RK_h_t[0]) + a3[1]*(*RK_h_t[1]) ),
-					io_var1	+ i_dt*( a3[0]*(*RK_u_t[0]) + a3[1]*(*RK_u_t[1]) ),
-					io_var2	+ i_dt*( a3[0]*(*RK_v_t[0]) + a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
+					PlaneData_Spectral &o_P_t,		///< time updates
+					PlaneData_Spectral &o_u_t,		///< time updates
+					PlaneData_Spectral &o_v_t,		///< time updates
 
-			io_var0 += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) );
-			io_var1 += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) );
-			io_var2 += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0,
-					io_var1,
-					io_var2,
-					*RK_h_t[0],
-					*RK_u_t[0],
-					*RK_v_t[0],
-					i_simulation_time
-			);
+					double i_simulation_time	///< simulation time, e.g. for tidal waves
+			),
 
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( a2[0]*(*RK_h_t[0]) ),
-					io_var1	+ i_dt*( a2[0]*(*RK_u_t[0]) ),
-					io_var2	+ i_dt*( a2[0]*(*RK_v_t[0]) ),
-					*RK_h_t[1],
-					*RK_u_t[1],
-					*RK_v_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
+			PlaneData_Spectral &io_var0,
+			PlaneData_Spectral &io_var1,
+			PlaneData_Spectral &io_var2,
 
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_h_t[1]) ),
-					io_var1	+ i_dt*( /*a3[0]*(*RK_u_t[0]) +*/ a3[1]*(*RK_u_t[1]) ),
-					io_var2	+ i_dt*( /*a3[0]*(*RK_v_t[0]) +*/ a3[1]*(*RK_v_t[1]) ),
-					*RK_h_t[2],
-					*RK_u_t[2],
-					*RK_v_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
+			double &io_dt,				///< in: time step size to try, out: accepted time step size
+			double &o_dt_next,			///< proposed time step size for next time step
 
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_var0	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_h_t[2]) ),
-					io_var1	+ i_dt*( /*a4[0]*(*RK_u_t[0]) + a4[1]*(*RK_u_t[1]) +*/ a4[2]*(*RK_u_t[2]) ),
-					io_var2	+ i_dt*( /*a4[0]*(*RK_v_t[0]) + a4[1]*(*RK_v_t[1]) +*/ a4[2]*(*RK_v_t[2]) ),
-					*RK_h_t[3],
-					*RK_u_t[3],
-					*RK_v_t[3],
-					i_simulation_time + c[2]*i_dt
-			);
+			int i_runge_kutta_order,	///< Order of embedded RK pair
 
+			double i_atol,
+			double i_rtol,
+			double i_dt_min,
+			double i_dt_max,
 
-			io_var0 += i_dt*( (b[0]*(*RK_h_t[0])) + (b[1]*(*RK_h_t[1]))  + (b[2]*(*RK_h_t[2])) + (b[3]*(*RK_h_t[3])) );
-			io_var1 += i_dt*( (b[0]*(*RK_u_t[0])) + (b[1]*(*RK_u_t[1]))  + (b[2]*(*RK_u_t[2])) + (b[3]*(*RK_u_t[3])) );
-			io_var2 += i_dt*( (b[0]*(*RK_v_t[0])) + (b[1]*(*RK_v_t[1]))  + (b[2]*(*RK_v_t[2])) + (b[3]*(*RK_v_t[3])) );
-		}
-		else
-		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
-		}
+			double i_simulation_time	///< Current simulation time.
+	)
+	{
+		if (!embeddedRK.isSetup() || embeddedRK.tableau.order != i_runge_kutta_order)
+			embeddedRK.setup(i_runge_kutta_order, i_atol, i_rtol, i_dt_min, i_dt_max);
+
+		embeddedRK.run_timestep(
+				i_baseClass,
+				i_compute_euler_timestep_update,
+				io_var0, io_var1, io_var2,
+				io_dt, o_dt_next,
+				i_simulation_time
+			);
 	}
+
 };
 
 #endif
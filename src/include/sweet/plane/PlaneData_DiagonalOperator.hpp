@@ -0,0 +1,134 @@
+/*
+ * PlaneData_DiagonalOperator.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_PLANE_PLANEDATA_DIAGONALOPERATOR_HPP_
+#define SRC_INCLUDE_SWEET_PLANE_PLANEDATA_DIAGONALOPERATOR_HPP_
+
+#include <vector>
+#include <functional>
+#include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/plane/PlaneData_Spectral.hpp>
+
+
+
+/*
+ * Operator which is diagonal in Fourier space with real coefficients
+ * (Laplace, Helmholtz, hyperdiffusion, ...)
+ *
+ * The coefficients are stored per spectral array element and computed
+ * once, e.g. based on the operators in PlaneOperators.
+ */
+class PlaneData_DiagonalOperator
+{
+public:
+	const PlaneDataConfig *planeDataConfig = nullptr;
+
+	/// One coefficient per spectral array element
+	std::vector<double> coeffs;
+
+
+public:
+	PlaneData_DiagonalOperator()
+	{
+	}
+
+
+	/**
+	 * Setup with the real part of an operator given in spectral space
+	 */
+	void setup(
+			const PlaneData_Spectral &i_op
+	)
+	{
+		planeDataConfig = i_op.planeDataConfig;
+
+		coeffs.resize(planeDataConfig->spectral_array_data_number_of_elements);
+		for (std::size_t i = 0; i < coeffs.size(); i++)
+			coeffs[i] = i_op.spectral_space_data[i].real();
+	}
+
+
+	bool isSetup()	const
+	{
+		return planeDataConfig != nullptr;
+	}
+
+
+	/**
+	 * Return a new operator with i_fun applied to each coefficient
+	 */
+	PlaneData_DiagonalOperator map(
+			std::function<double(double)> i_fun
+	)	const
+	{
+		PlaneData_DiagonalOperator out(*this);
+		for (std::size_t i = 0; i < coeffs.size(); i++)
+			out.coeffs[i] = i_fun(coeffs[i]);
+
+		return out;
+	}
+
+
+	/**
+	 * Composition of two diagonal operators into a single one
+	 */
+	PlaneData_DiagonalOperator operator*(
+			const PlaneData_DiagonalOperator &i_op
+	)	const
+	{
+		assert(planeDataConfig == i_op.planeDataConfig);
+
+		PlaneData_DiagonalOperator out(*this);
+		for (std::size_t i = 0; i < coeffs.size(); i++)
+			out.coeffs[i] *= i_op.coeffs[i];
+
+		return out;
+	}
+
+
+	/**
+	 * Return D(i_x)
+	 */
+	PlaneData_Spectral operator()(
+			const PlaneData_Spectral &i_x
+	)	const
+	{
+		PlaneData_Spectral out(i_x);
+		out.spectral_update_diagonal(coeffs.data());
+		return out;
+	}
+
+
+	/**
+	 * io_x = D(io_x)
+	 */
+	void apply_inplace(
+			PlaneData_Spectral &io_x
+	)	const
+	{
+		assert(planeDataConfig == io_x.planeDataConfig);
+		io_x.spectral_update_diagonal(coeffs.data());
+	}
+
+
+	/**
+	 * io_y += i_alpha * D(i_x) in a single pass
+	 */
+	void apply_axpy(
+			double i_alpha,
+			const PlaneData_Spectral &i_x,
+			PlaneData_Spectral &io_y
+	)	const
+	{
+		assert(planeDataConfig == i_x.planeDataConfig);
+		io_y.spectral_axpy_diagonal(i_alpha, coeffs.data(), i_x);
+	}
+};
+
+
+
+#endif
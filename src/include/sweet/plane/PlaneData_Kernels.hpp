@@ -9,9 +9,16 @@
 #define SRC_INCLUDE_SWEET_PLANE_PLANEDATA_KERNELS_HPP_
 
 
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <sweet/openmp_helper.hpp>
+
+
 class PlaneData_Kernels
 {
 
+protected:
 //#if !SWEET_USE_PLANE_SPECTRAL_SPACE
 	int kernel_size = -1;
 	double *kernel_data = nullptr;
@@ -34,7 +41,7 @@ public:
 //#if !SWEET_USE_PLANE_SPECTRAL_SPACE
 
 		kernel_size = S;
-		kernel_data = MemBlockAlloc::alloc<double>(sizeof(double)*S*S);
+		kernel_data = MemBlockAlloc::alloc<double>(sizeof(double)*S*S, "PlaneData_Kernels");
 		for (int y = 0; y < S; y++)
 			for (int x = 0; x < S; x++)
 				kernel_data[y*S+x] = i_kernel_array[S-1-y][x];
@@ -192,229 +199,140 @@ public:
 ///#if !SWEET_USE_PLANE_SPECTRAL_SPACE
 
 public:
-	void kernel_apply(
+	/*
+	 * Tile sizes for cache blocking of the stencil engine.
+	 *
+	 * A tile reads (block_size_y+2) rows of block_size_x values
+	 * which should fit into the L2 cache, and the three input rows
+	 * of a single output row should fit into the L1 cache.
+	 */
+	static constexpr int block_size_x = 1024;
+	static constexpr int block_size_y = 16;
+
+
+	/**
+	 * Apply several 3x3 stencils to the same periodic input data in a single sweep
+	 *
+	 *   o_data[k] = kernel_k(i_data)
+	 *
+	 * Each kernel is given by 9 coefficients in the order of kernel_data
+	 * (row-wise, starting with the lower row y-1).
+	 */
+	static
+	void kernel_apply_3x3_fused(
 			int res_x,
 			int res_y,
-			double *i_data,
+			const double *i_data,
 
-			double *o_data
-	)	const
+			int i_num_kernels,
+			const double *const *i_kernels,
+			double *const *o_data
+	)
 	{
-
-		/**
-		 * TODO: optimize this!!!
-		 *
-		 *  - cache blocking
-		 *  - if branching elimination
-		 *  - etc.....
+		/*
+		 * Rows of kernels with only zero coefficients are skipped
 		 */
-
-		if (kernel_size == 3)
+		std::vector<int> rows_nonzero(i_num_kernels*3);
+		for (int k = 0; k < i_num_kernels; k++)
+			for (int r = 0; r < 3; r++)
+				rows_nonzero[k*3+r] = (i_kernels[k][r*3+0] != 0) || (i_kernels[k][r*3+1] != 0) || (i_kernels[k][r*3+2] != 0);
+
+		const int num_blocks_x = (res_x + block_size_x - 1) / block_size_x;
+		const int num_blocks_y = (res_y + block_size_y - 1) / block_size_y;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for collapse(2) PROC_BIND_CLOSE schedule(static)
+#endif
+		for (int by = 0; by < num_blocks_y; by++)
 		{
-			switch (kernel_id)
+			for (int bx = 0; bx < num_blocks_x; bx++)
 			{
-			case get_kernel_mask3x3(0, 0, 0, 1, 0, 1, 0, 0, 0):	// (X, 0, X)
+				const int x0 = bx*block_size_x;
+				const int x1 = std::min(x0 + block_size_x, res_x);
+				const int y0 = by*block_size_y;
+				const int y1 = std::min(y0 + block_size_y, res_y);
+
+				// Interior range without periodic boundary in x
+				const int xi0 = std::max(x0, 1);
+				const int xi1 = std::min(x1, res_x-1);
 
-				SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-				for (int y = 0; y < res_y; y++)
+				for (int y = y0; y < y1; y++)
 				{
-					for (int x = 0; x < res_x; x++)
+					// Periodic rows y-1, y, y+1
+					const double *rows[3] = {
+							&i_data[((y-1+res_y) % res_y)*res_x],
+							&i_data[y*res_x],
+							&i_data[((y+1) % res_y)*res_x]
+					};
+
+					for (int k = 0; k < i_num_kernels; k++)
 					{
-						double &data_out = o_data[y*res_x+x];
-						data_out = 0;
+						double *out = &o_data[k][y*res_x];
+						const double *kernel = i_kernels[k];
 
-						int pos_y = y;
-						assert(pos_y >= 0 && pos_y < res_y);
+						for (int x = x0; x < x1; x++)
+							out[x] = 0;
 
-						if (x > 0 && x < res_x-1)
+						for (int r = 0; r < 3; r++)
 						{
-							double *kernel_scalar_ptr = &kernel_data[3];
-							double *data_scalar_ptr = &i_data[pos_y*res_x+x-1];
-
-							data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-							data_out += kernel_scalar_ptr[2]*data_scalar_ptr[2];
-						}
-						else
-						{
-							for (int i = -1; i <= 1; i+=2)
-							{
-								int pos_x = x+i;
-								pos_x -= (pos_x >= res_x ? res_x : 0);
-								pos_x += (pos_x < 0 ? res_x : 0);
-								int idx = i+4;
-								double kernel_scalar = kernel_data[idx];
-								double data_scalar = i_data[pos_y*res_x+pos_x];
-
-								data_out += kernel_scalar*data_scalar;
-							}
+							if (!rows_nonzero[k*3+r])
+								continue;
+
+							const double *in = rows[r];
+							const double c0 = kernel[r*3+0];
+							const double c1 = kernel[r*3+1];
+							const double c2 = kernel[r*3+2];
+
+#if SWEET_SIMD_ENABLE
+#pragma omp simd
+#endif
+							for (int x = xi0; x < xi1; x++)
+								out[x] += c0*in[x-1] + c1*in[x] + c2*in[x+1];
+
+							// Periodic boundaries in x
+							if (x0 == 0)
+								out[0] += c0*in[res_x-1] + c1*in[0] + c2*in[1 % res_x];
+
+							if (x1 == res_x && res_x > 1)
+								out[res_x-1] += c0*in[res_x-2] + c1*in[res_x-1] + c2*in[0];
 						}
 					}
 				}
-				break;
-
-
-
-			case get_kernel_mask3x3(0, 0, 0, 1, 1, 1, 0, 0, 0):	// (X, X, X)
-					SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							int pos_y = y+res_y;
-							pos_y -= (pos_y >= res_y ? res_y : 0);
-							pos_y += (pos_y < 0 ? res_y : 0);
-
-							assert(pos_y >= 0 && pos_y < res_y);
-
-							if (x > 0 && x < res_x-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[3];
-								double *data_scalar_ptr = &i_data[pos_y*res_x+x-1];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[1]*data_scalar_ptr[1];
-								data_out += kernel_scalar_ptr[2]*data_scalar_ptr[2];
-							}
-							else
-							{
-								for (int i = -1; i <= 1; i++)
-								{
-									int pos_x = (x+i);
-									pos_x -= (pos_x >= res_x ? res_x : 0);
-									pos_x += (pos_x < 0 ? res_x : 0);
-									int idx = i+4;
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+pos_x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			case get_kernel_mask3x3(0, 1, 0, 0, 0, 0, 0, 1, 0):	// (X, 0, X)^T
-
-					SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							if (y > 0 && y < res_y-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[1];
-								double *data_scalar_ptr = &i_data[(y-1)*res_x+x];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[6]*data_scalar_ptr[2*res_x];
-							}
-							else
-							{
-								for (int j = -1; j <= 1; j+=2)
-								{
-									int pos_y = y+j;
-
-									pos_y -= (pos_y >= res_y ? res_y : 0);
-									pos_y += (pos_y < 0 ? res_y : 0);
-
-									int idx = (j+1)*3+1;
-
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			case get_kernel_mask3x3(0, 1, 0, 0, 1, 0, 0, 1, 0):	// (X, 0, X)^T
-
-					SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-					for (int y = 0; y < res_y; y++)
-					{
-						for (int x = 0; x < res_x; x++)
-						{
-							double &data_out = o_data[y*res_x+x];
-							data_out = 0;
-
-							if (y > 0 && y < res_y-1)
-							{
-								double *kernel_scalar_ptr = &kernel_data[1];
-								double *data_scalar_ptr = &i_data[(y-1)*res_x+x];
-
-								data_out += kernel_scalar_ptr[0]*data_scalar_ptr[0];
-								data_out += kernel_scalar_ptr[3]*data_scalar_ptr[res_x];
-								data_out += kernel_scalar_ptr[6]*data_scalar_ptr[2*res_x];
-							}
-							else
-							{
-								for (int j = -1; j <= 1; j++)
-								{
-									int pos_y = y+j;
-
-									pos_y -= (pos_y >= res_y ? res_y : 0);
-									pos_y += (pos_y < 0 ? res_y : 0);
-
-									int idx = (j+1)*3+1;
-
-									double kernel_scalar = kernel_data[idx];
-									double data_scalar = i_data[pos_y*res_x+x];
-
-									data_out += kernel_scalar*data_scalar;
-								}
-							}
-						}
-					}
-					break;
-
-			default:
-
-				SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD_COLLAPSE2
-				for (int y = 0; y < res_y; y++)
-				{
-					for (int x = 0; x < res_x; x++)
-					{
-						double &data_out = o_data[y*res_x+x];
-						data_out = 0;
-
-						for (int j = -1; j <= 1; j++)
-						{
-							int pos_y = y+j;
+			}
+		}
+	}
 
-							pos_y -= (pos_y >= res_y ? res_y : 0);
-							pos_y += (pos_y < 0 ? res_y : 0);
 
-							assert(pos_y >= 0 && pos_y < res_y);
+	/**
+	 * Return the coefficients of the 3x3 stencil
+	 */
+	const double* get_kernel_data()	const
+	{
+		return kernel_data;
+	}
 
-							for (int i = -1; i <= 1; i++)
-							{
-								int pos_x = x+i;
 
-								pos_x -= (pos_x >= res_x ? res_x : 0);
-								pos_x += (pos_x < 0 ? res_x : 0);
+	int get_kernel_size()	const
+	{
+		return kernel_size;
+	}
 
-								assert(pos_x >= 0 && pos_x < res_x);
 
-								int idx = (j+1)*3+(i+1);
-								assert(idx >= 0 && idx < 9);
+public:
+	void kernel_apply(
+			int res_x,
+			int res_y,
+			double *i_data,
 
-								double kernel_scalar = kernel_data[idx];
-								double data_scalar = i_data[pos_y*res_x+pos_x];
+			double *o_data
+	)	const
+	{
+		if (kernel_size == 3)
+		{
+			const double *kernels[1] = {kernel_data};
+			double *outputs[1] = {o_data};
 
-								data_out += kernel_scalar*data_scalar;
-							}
-						}
-					}
-				}
-			}
+			kernel_apply_3x3_fused(res_x, res_y, i_data, 1, kernels, outputs);
 		}
 		else
 		{
@@ -36,6 +36,7 @@
 #include <sweet/openmp_helper.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
 #include <sweet/SWEETError.hpp>
+#include <sweet/ReduceStatistics.hpp>
 #include <sweet/plane/PlaneData_Kernels.hpp>
 
 //#include <sweet/plane/PlaneData_Spectral.hpp>
@@ -274,7 +275,7 @@ private:
 	void alloc_data()
 	{
 		assert(physical_space_data == nullptr);
-		physical_space_data = MemBlockAlloc::alloc<double>(planeDataConfig->physical_array_data_number_of_elements * sizeof(double));
+		physical_space_data = MemBlockAlloc::alloc<double>(planeDataConfig->physical_array_data_number_of_elements * sizeof(double), "PlaneData_Physical");
 	}
 
 
@@ -669,6 +670,49 @@ public:
 		return out;
 	}
 
+
+	/**
+	 * Apply several linear operators given by stencils to this data array
+	 * in a single sweep over the data:
+	 *
+	 *   *o_outputs[i] = (*i_operators[i])(*this)
+	 *
+	 * This avoids loading the input data for each operator separately.
+	 */
+	void kernel_apply_fused(
+			const std::vector<const PlaneData_Physical*> &i_operators,
+			const std::vector<PlaneData_Physical*> &o_outputs
+	)	const
+	{
+		if (i_operators.size() != o_outputs.size())
+			SWEETError("Number of operators and outputs differ");
+
+		std::vector<const double*> kernels(i_operators.size());
+		std::vector<double*> outputs(o_outputs.size());
+
+		for (std::size_t i = 0; i < i_operators.size(); i++)
+		{
+			if (i_operators[i]->get_kernel_size() != 3)
+				SWEETError("Only 3x3 stencils are supported for fused stencil application");
+
+			assert(o_outputs[i]->planeDataConfig == planeDataConfig);
+			assert(o_outputs[i]->physical_space_data != physical_space_data);
+
+			kernels[i] = i_operators[i]->get_kernel_data();
+			outputs[i] = o_outputs[i]->physical_space_data;
+		}
+
+		PlaneData_Kernels::kernel_apply_3x3_fused(
+				planeDataConfig->physical_data_size[0],
+				planeDataConfig->physical_data_size[1],
+				physical_space_data,
+
+				(int)kernels.size(),
+				kernels.data(),
+				outputs.data()
+		);
+	}
+
 	friend
 	inline
 	std::ostream& operator<<(
@@ -721,7 +765,7 @@ public:
 
 		// create spectral data container
 		std::complex<double> *spectral_space_data = nullptr;
-		spectral_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->spectral_array_data_number_of_elements * sizeof(std::complex<double>));
+		spectral_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->spectral_array_data_number_of_elements * sizeof(std::complex<double>), "PlaneData_Physical_spectral_tmp");
 
 		// FFT
 		planeDataConfig->fft_physical_to_spectral(io_data.physical_space_data, spectral_space_data);
@@ -1067,6 +1111,26 @@ public:
 
 
 
+	/**
+	 * Return min, max, max_abs, sum, sum of squares, NaN/Inf flag and the
+	 * integral over a domain of unit area in a single pass
+	 */
+	ReduceStatistics physical_reduce_statistics(
+			bool i_deterministic = false
+	)	const
+	{
+		const double weight = 1.0/(double)planeDataConfig->physical_array_data_number_of_elements;
+
+		return ReduceStatistics::reduce_weighted(
+				physical_space_data,
+				planeDataConfig->physical_array_data_number_of_elements,
+				[&](std::size_t) -> double { return weight; },
+				i_deterministic
+			);
+	}
+
+
+
 	bool physical_isAnyNaNorInf()	const
 	{
 		for (std::size_t i = 0; i < planeDataConfig->physical_array_data_number_of_elements; i++)
@@ -218,7 +218,7 @@ public:
 	{
 		planeDataConfig = i_planeDataConfig;
 
-		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>));
+		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>), "PlaneData_PhysicalComplex");
 	}
 
 
@@ -235,7 +235,7 @@ public:
 		}
 
 		planeDataConfig = i_planeDataConfig;
-		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>));
+		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(planeDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>), "PlaneData_PhysicalComplex");
 	}
 
 
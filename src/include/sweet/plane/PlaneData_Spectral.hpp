@@ -28,6 +28,8 @@
 #include <sweet/plane/PlaneData_Physical.hpp>
 #include <sweet/plane/PlaneData_PhysicalComplex.hpp>
 #include <sweet/SWEETError.hpp>
+#include <sweet/ReduceStatistics.hpp>
+#include <sweet/SpectralRemap.hpp>
 
 
 #define PLANE_DATA_SPECTRAL_FOR_IDX(CORE)					\
@@ -370,236 +372,124 @@ public:
 	}
 
 
-public:
-	PlaneData_Spectral spectral_returnWithDifferentModes(
-			const PlaneDataConfig *i_planeDataConfig
-	)	const
+private:
+	/**
+	 * Return (cached) index map from the modes of i_src to the modes of i_dst
+	 */
+	static
+	const SpectralRemap& p_getSpectralRemap(
+			const PlaneDataConfig *i_src,
+			const PlaneDataConfig *i_dst
+	)
 	{
-		PlaneData_Spectral out(i_planeDataConfig);
-
-		/*
-		 *  0 = invalid
-		 * -1 = scale down
-		 *  1 = scale up
-		 */
-		int scaling_mode = 0;
+		static SpectralRemapCache remapCache;
 
-		if (planeDataConfig->spectral_modes[0] < out.planeDataConfig->spectral_modes[0])
+		std::vector<std::size_t> key;
+		for (const PlaneDataConfig *c : {i_src, i_dst})
 		{
-			scaling_mode = 1;
-		}
-		else if (planeDataConfig->spectral_modes[0] > out.planeDataConfig->spectral_modes[0])
-		{
-			scaling_mode = -1;
-		}
-
-		if (planeDataConfig->spectral_modes[1] < out.planeDataConfig->spectral_modes[1])
-		{
-			assert(scaling_mode != -1);
-			scaling_mode = 1;
-		}
-		else if (planeDataConfig->spectral_modes[1] > out.planeDataConfig->spectral_modes[1])
-		{
-			assert(scaling_mode != 1);
-			scaling_mode = -1;
-		}
-
-		if (scaling_mode == 0)
-		{
-			// Just copy the data
-			out = *this;
-			return out;
+			key.push_back(c->spectral_data_size[0]);
+			key.push_back(c->spectral_data_size[1]);
+			for (int r = 0; r < 2; r++)
+				for (int d = 0; d < 2; d++)
+					for (int k = 0; k < 2; k++)
+						key.push_back(c->spectral_data_iteration_ranges[r][d][k]);
 		}
 
-		double rescale =
-				(double)(out.planeDataConfig->physical_array_data_number_of_elements)
-				/
-				(double)(planeDataConfig->physical_array_data_number_of_elements);
-
-		//rescale = 1.0;
-
-		{
-			if (scaling_mode == -1)
-			{
-				/*
-				 * more modes -> less modes
-				 */
-
-				/*
-				 * Region #1
-				 *
-				 * 00000000 7
-				 * 00000000 6
-				 * 00000000 5
-				 * 00000000 4
-				 * 00000000 3
-				 * XXXXX000 2
-				 * XXXXX000 1
-				 * XXXXX000 0
-				 */
+		return remapCache.get(
+				key,
+				[&](SpectralRemap &o_remap)
 				{
-					const std::size_t* src_range_dim0 = &(planeDataConfig->spectral_data_iteration_ranges[0][0][0]);
-					const std::size_t* src_range_dim1 = &(planeDataConfig->spectral_data_iteration_ranges[0][1][0]);
-
-					const std::size_t* dst_range_dim0 = &(out.planeDataConfig->spectral_data_iteration_ranges[0][0][0]);
-					const std::size_t* dst_range_dim1 = &(out.planeDataConfig->spectral_data_iteration_ranges[0][1][0]);
-
-					assert(src_range_dim0[0] == 0);
-					assert(dst_range_dim0[0] == 0);
-					assert(src_range_dim1[0] == 0);
-					assert(dst_range_dim1[0] == 0);
-
-					std::size_t dst_size = dst_range_dim0[1];//-dst_range_dim0[0];
-
-					SWEET_THREADING_SPACE_PARALLEL_FOR
-					for (std::size_t j = 0; j < dst_range_dim1[1]; j++)
+					const std::size_t src_row_size = i_src->spectral_data_size[0];
+					const std::size_t dst_row_size = i_dst->spectral_data_size[0];
+
+					/*
+					 * Number of coefficients per row which exist in both configurations
+					 */
+					assert(i_src->spectral_data_iteration_ranges[0][0][0] == 0);
+					assert(i_dst->spectral_data_iteration_ranges[0][0][0] == 0);
+					const std::size_t num_copy = std::min(
+							i_src->spectral_data_iteration_ranges[0][0][1],
+							i_dst->spectral_data_iteration_ranges[0][0][1]
+						);
+
+					const std::size_t *src_r0 = i_src->spectral_data_iteration_ranges[0][1];
+					const std::size_t *src_r1 = i_src->spectral_data_iteration_ranges[1][1];
+					const std::size_t *dst_r0 = i_dst->spectral_data_iteration_ranges[0][1];
+					const std::size_t *dst_r1 = i_dst->spectral_data_iteration_ranges[1][1];
+
+					/*
+					 * One block per row in the destination
+					 *
+					 * Region #1 (lower rows): identical row index
+					 * Region #2 (upper rows, negative wavenumbers): identical distance to the end of the range
+					 */
+					for (std::size_t j = 0; j < i_dst->spectral_data_size[1]; j++)
 					{
-						std::complex<double> *src = &spectral_space_data[planeDataConfig->spectral_data_size[0]*j];
-						std::complex<double> *dst = &out.spectral_space_data[out.planeDataConfig->spectral_data_size[0]*j];
-
-						for (std::size_t i = 0; i < dst_size; i++)
-							dst[i] = src[i]*rescale;
-					}
-				}
-
-
-				/*
-				 * Region #2
-				 *
-				 * XXXXX000 7
-				 * XXXXX000 6
-				 * XXXXX000 5
-				 * 00000000 4
-				 * 00000000 3
-				 * 00000000 2
-				 * 00000000 1
-				 * 00000000 0
-				 */
-				{
-					const std::size_t* src_range_dim0 = &(planeDataConfig->spectral_data_iteration_ranges[1][0][0]);
-					const std::size_t* src_range_dim1 = &(planeDataConfig->spectral_data_iteration_ranges[1][1][0]);
-
-					const std::size_t* dst_range_dim0 = &(out.planeDataConfig->spectral_data_iteration_ranges[1][0][0]);
-					const std::size_t* dst_range_dim1 = &(out.planeDataConfig->spectral_data_iteration_ranges[1][1][0]);
-
-					assert(src_range_dim0[0] == 0);
-					assert(dst_range_dim0[0] == 0);
-
-					std::size_t dst_size = dst_range_dim0[1];//-dst_range_dim0[0];
-
-					SWEET_THREADING_SPACE_PARALLEL_FOR
-					for (std::size_t j = dst_range_dim1[0]; j < dst_range_dim1[1]; j++)
-					{
-						std::complex<double> *src = &spectral_space_data[planeDataConfig->spectral_data_size[0]*(src_range_dim1[1]-(dst_range_dim1[1]-j))];
-						std::complex<double> *dst = &out.spectral_space_data[out.planeDataConfig->spectral_data_size[0]*j];
-
-						for (std::size_t i = 0; i < dst_size; i++)
-							dst[i] = src[i]*rescale;
-					}
-				}
-
-				out.spectral_zeroAliasingModes();
-			}
-			else
-			{
-				/*
-				 * less modes -> more modes
-				 */
-
-				/*
-				 * Region #1
-				 *
-				 * 00000000 7
-				 * 00000000 6
-				 * 00000000 5
-				 * 00000000 4
-				 * 00000000 3
-				 * XXXXX000 2
-				 * XXXXX000 1
-				 * XXXXX000 0
-				 */
-				out.spectral_set_zero();
-
-				{
-					int r = 0;
-
-					const std::size_t* src_range_dim0 = &(planeDataConfig->spectral_data_iteration_ranges[r][0][0]);
-					const std::size_t* src_range_dim1 = &(planeDataConfig->spectral_data_iteration_ranges[r][1][0]);
-
-					const std::size_t* dst_range_dim0 = &(out.planeDataConfig->spectral_data_iteration_ranges[r][0][0]);
-					const std::size_t* dst_range_dim1 = &(out.planeDataConfig->spectral_data_iteration_ranges[r][1][0]);
-
-					assert(src_range_dim0[0] == 0);
-					assert(dst_range_dim0[0] == 0);
-					assert(src_range_dim1[0] == 0);
-
-					std::size_t src_size = src_range_dim0[1];//-dst_range_dim0[0];
+						std::size_t dst_idx = dst_row_size*j;
 
+						if (j >= dst_r0[0] && j < dst_r0[1] && j < src_r0[1])
+						{
+							o_remap.add_block(src_row_size*j, dst_idx, num_copy, dst_row_size - num_copy);
+							continue;
+						}
 
-					SWEET_THREADING_SPACE_PARALLEL_FOR
-					for (std::size_t j = 0; j < src_range_dim1[1]; j++)
-					{
-						std::complex<double> *src = &spectral_space_data[planeDataConfig->spectral_data_size[0]*(j-src_range_dim1[0]+dst_range_dim1[0])];
-						std::complex<double> *dst = &out.spectral_space_data[out.planeDataConfig->spectral_data_size[0]*j];
+						if (j >= dst_r1[0] && j < dst_r1[1])
+						{
+							std::size_t k = dst_r1[1] - j;
+							if (k <= src_r1[1] - src_r1[0])
+							{
+								o_remap.add_block(src_row_size*(src_r1[1] - k), dst_idx, num_copy, dst_row_size - num_copy);
+								continue;
+							}
+						}
 
-						for (std::size_t i = 0; i < src_size; i++)
-							dst[i] = src[i]*rescale;
+						o_remap.add_block(0, dst_idx, 0, dst_row_size);
 					}
 				}
+			);
+	}
 
 
-				/*
-				 * Region #2
-				 *
-				 * XXXXX000 7
-				 * XXXXX000 6
-				 * XXXXX000 5
-				 * 00000000 4
-				 * 00000000 3
-				 * 00000000 2
-				 * 00000000 1
-				 * 00000000 0
-				 */
-				{
-					int r = 1;
-
-					const std::size_t* src_range_dim0 = &(planeDataConfig->spectral_data_iteration_ranges[r][0][0]);
-					const std::size_t* src_range_dim1 = &(planeDataConfig->spectral_data_iteration_ranges[r][1][0]);
-
-					const std::size_t* dst_range_dim0 = &(out.planeDataConfig->spectral_data_iteration_ranges[r][0][0]);
-					const std::size_t* dst_range_dim1 = &(out.planeDataConfig->spectral_data_iteration_ranges[r][1][0]);
-
-					assert(src_range_dim0[0] == 0);
-					assert(dst_range_dim0[0] == 0);
-
-					std::size_t src_size0 = src_range_dim0[1];//-dst_range_dim0[0];
-					std::size_t src_size1 = src_range_dim1[1]-src_range_dim1[0];
-
-
-					SWEET_THREADING_SPACE_PARALLEL_FOR
-					for (std::size_t j = src_range_dim1[0]; j < src_range_dim1[1]; j++)
-					{
-						std::complex<double> *src = &spectral_space_data[planeDataConfig->spectral_data_size[0]*j];
-						std::complex<double> *dst = &out.spectral_space_data[out.planeDataConfig->spectral_data_size[0]*(dst_range_dim1[1]-src_size1+(j-src_range_dim1[0]))];
+public:
+	/**
+	 * Copy the spectral coefficients to o_out which might have a different
+	 * number of modes. Modes which don't exist in this data are set to zero.
+	 */
+	void spectral_remap_to(
+			PlaneData_Spectral &o_out
+	)	const
+	{
+		if (	planeDataConfig->spectral_modes[0] == o_out.planeDataConfig->spectral_modes[0] &&
+				planeDataConfig->spectral_modes[1] == o_out.planeDataConfig->spectral_modes[1] &&
+				planeDataConfig->spectral_array_data_number_of_elements == o_out.planeDataConfig->spectral_array_data_number_of_elements
+		)
+		{
+			// Just copy the data
+			parmemcpy(o_out.spectral_space_data, spectral_space_data, sizeof(std::complex<double>)*planeDataConfig->spectral_array_data_number_of_elements);
+			return;
+		}
 
-						for (std::size_t i = 0; i < src_size0; i++)
-						{
-#if SWEET_DEBUG
-							assert((int)(out.spectral_space_data - &dst[i]) < (int)out.planeDataConfig->spectral_array_data_number_of_elements);
-#endif
-							dst[i] = src[i]*rescale;
-						}
-					}
+		double rescale =
+				(double)(o_out.planeDataConfig->physical_array_data_number_of_elements)
+				/
+				(double)(planeDataConfig->physical_array_data_number_of_elements);
 
-				}
-			}
+		p_getSpectralRemap(planeDataConfig, o_out.planeDataConfig).apply(spectral_space_data, o_out.spectral_space_data, rescale);
+	}
 
-		}
 
+public:
+	PlaneData_Spectral spectral_returnWithDifferentModes(
+			const PlaneDataConfig *i_planeDataConfig
+	)	const
+	{
+		PlaneData_Spectral out(i_planeDataConfig);
+		spectral_remap_to(out);
 		return out;
 	}
 
 
+
 	/**
 	 * Return Plane Array with all spectral coefficients a+bi --> 1/(a+bi)
 	 */
@@ -733,7 +623,7 @@ private:
 	void alloc_data()
 	{
 		assert(spectral_space_data == nullptr);
-		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(planeDataConfig->spectral_array_data_number_of_elements * sizeof(Tcomplex));
+		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(planeDataConfig->spectral_array_data_number_of_elements * sizeof(Tcomplex), "PlaneData_Spectral");
 	}
 
 
@@ -1218,6 +1108,105 @@ public:
 	}
 
 
+	/**
+	 * Multiply each mode with a real per-mode coefficient
+	 *
+	 * This avoids the indirect call of spectral_update_lambda per
+	 * coefficient for operators which are diagonal in spectral space.
+	 */
+	void spectral_update_diagonal(
+			const double *i_coeffs		///< one coefficient per spectral array element
+	)
+	{
+		PLANE_DATA_SPECTRAL_FOR_IDX(
+					spectral_space_data[idx] *= i_coeffs[idx];
+				)
+	}
+
+
+	/**
+	 * Fused diagonal operator and axpy:
+	 *
+	 * this += i_alpha * D(i_x)
+	 */
+	void spectral_axpy_diagonal(
+			double i_alpha,
+			const double *i_coeffs,		///< one coefficient per spectral array element
+			const PlaneData_Spectral &i_x
+	)
+	{
+		assert(planeDataConfig == i_x.planeDataConfig);
+
+		PLANE_DATA_SPECTRAL_FOR_IDX(
+					spectral_space_data[idx] += (i_alpha*i_coeffs[idx])*i_x.spectral_space_data[idx];
+				)
+	}
+
+
+	/**
+	 * Fused linear combination with a number of terms known at compile time:
+	 *
+	 * this = i_x + sum_j i_alpha[j] * i_y[j]
+	 *
+	 * i_x may be this array itself.
+	 */
+	template <int t_num_terms>
+	void spectral_linear_combination(
+			const PlaneData_Spectral &i_x,
+			const double *i_alpha,
+			const PlaneData_Spectral *const *i_y
+	)
+	{
+		check(i_x.planeDataConfig);
+
+		const Tcomplex *y[t_num_terms];
+		double alpha[t_num_terms];
+		for (int j = 0; j < t_num_terms; j++)
+		{
+			check(i_y[j]->planeDataConfig);
+			y[j] = i_y[j]->spectral_space_data;
+			alpha[j] = i_alpha[j];
+		}
+
+		const Tcomplex *x = i_x.spectral_space_data;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t idx = 0; idx < planeDataConfig->spectral_array_data_number_of_elements; idx++)
+		{
+			Tcomplex value = x[idx];
+			for (int j = 0; j < t_num_terms; j++)
+				value += alpha[j]*y[j][idx];
+
+			spectral_space_data[idx] = value;
+		}
+
+		spectral_zeroAliasingModes();
+	}
+
+
+	/**
+	 * Fused in-place update without temporaries:
+	 *
+	 * this = i_alpha * i_x + i_beta * this
+	 */
+	void spectral_axpby(
+			double i_alpha,
+			const PlaneData_Spectral &i_x,
+			double i_beta
+	)
+	{
+		check(i_x.planeDataConfig);
+
+		const Tcomplex *x = i_x.spectral_space_data;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t idx = 0; idx < planeDataConfig->spectral_array_data_number_of_elements; idx++)
+			spectral_space_data[idx] = i_alpha*x[idx] + i_beta*spectral_space_data[idx];
+
+		spectral_zeroAliasingModes();
+	}
+
+
 	void spectral_update_lambda(
 			std::function<void(int,int,Tcomplex&)> i_lambda
 	)
@@ -1452,6 +1441,24 @@ public:
 	}
 
 
+	/**
+	 * Return statistics of all spectral coefficients in a single pass
+	 *
+	 * max_abs and sum_sqr are based on the modulus,
+	 * min, max and sum on the real part of the coefficients.
+	 */
+	ReduceStatistics spectral_reduce_statistics(
+			bool i_deterministic = false
+	)	const
+	{
+		return ReduceStatistics::reduce(
+				spectral_space_data,
+				planeDataConfig->spectral_array_data_number_of_elements,
+				i_deterministic
+			);
+	}
+
+
 	/**
 	 * Return the max abs value
 	 */
@@ -2219,8 +2226,8 @@ public:
 	)
 	{
 
-		PlaneData_Spectral out = *this;
-		out = i_array_data.spectral_returnWithDifferentModes(out.planeDataConfig);
+		PlaneData_Spectral out(planeDataConfig);
+		i_array_data.spectral_remap_to(out);
 
 		//////std::size_t M_fine = i_array_data.planeDataConfig->spectral_data_size[0];
 		//////std::size_t N_fine = i_array_data.planeDataConfig->spectral_data_size[1];
@@ -2261,8 +2268,8 @@ public:
 	)
 	{
 
-		PlaneData_Spectral out = *this;
-		out = i_array_data.spectral_returnWithDifferentModes(out.planeDataConfig);
+		PlaneData_Spectral out(planeDataConfig);
+		i_array_data.spectral_remap_to(out);
 
 		///////std::size_t M_coarse = i_array_data.planeDataConfig->spectral_data_size[0];
 		///////std::size_t N_coarse = i_array_data.planeDataConfig->spectral_data_size[1];
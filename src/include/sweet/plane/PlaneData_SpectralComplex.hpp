@@ -647,7 +647,7 @@ public:
 
 		planeDataConfig = i_planeConfig;
 
-		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(planeDataConfig->spectral_complex_array_data_number_of_elements * sizeof(Tcomplex));
+		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(planeDataConfig->spectral_complex_array_data_number_of_elements * sizeof(Tcomplex), "PlaneData_SpectralComplex");
 	}
 
 
@@ -13,7 +13,15 @@
 #endif
 
 #include <sweet/plane/PlaneData_Spectral.hpp>
+#include <sweet/plane/PlaneData_DiagonalOperator.hpp>
 #include <sweet/plane/PlaneDataConfig.hpp>
+#include <sweet/DiagonalOperatorCache.hpp>
+#include <vector>
+#include <complex>
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
 
 
 class PlaneOperators
@@ -37,6 +45,68 @@ public:
 	PlaneData_Physical shift_up;
 	PlaneData_Physical shift_down;
 
+	// Precomputed Laplace operator D^2 = diff2_c_x + diff2_c_y
+	PlaneData_DiagonalOperator diag_laplace;
+
+private:
+	// Parameters of the differential operators, part of the key of cached operators
+	double domain_size[2] = {0, 0};
+	bool use_spectral_basis_diffs = true;
+
+	/*
+	 * Factors of the central differential operators.
+	 * d/dx only depends on the column (i), d/dy only on the row (j).
+	 * These are small enough to stay in cache instead of streaming
+	 * the full 2D operators diff_c_x / diff_c_y.
+	 */
+	std::vector<std::complex<double>> diff_c_x_1d;
+	std::vector<std::complex<double>> diff_c_y_1d;
+
+
+	/*
+	 * Iterate over all valid spectral modes and call
+	 *   i_kernel(idx, d/dx factor, d/dy factor)
+	 */
+	template <typename TKernel>
+	inline void p_spectral_sweep(
+			TKernel i_kernel
+	)	const
+	{
+		const std::size_t size0 = planeDataConfig->spectral_data_size[0];
+		const std::complex<double> *dx = diff_c_x_1d.data();
+		const std::complex<double> *dy = diff_c_y_1d.data();
+
+		for (int r = 0; r < 2; r++)
+		{
+			const std::size_t (&range)[2][2] = planeDataConfig->spectral_data_iteration_ranges[r];
+
+			SWEET_THREADING_SPACE_PARALLEL_FOR
+			for (std::size_t jj = range[1][0]; jj < range[1][1]; jj++)
+			{
+				const std::complex<double> ky = dy[jj];
+
+				for (std::size_t ii = range[0][0]; ii < range[0][1]; ii++)
+					i_kernel(jj*size0 + ii, dx[ii], ky);
+			}
+		}
+	}
+
+
+	void p_setup_diff_1d()
+	{
+		const std::size_t size0 = planeDataConfig->spectral_data_size[0];
+		const std::size_t size1 = planeDataConfig->spectral_data_size[1];
+
+		diff_c_x_1d.resize(size0);
+		for (std::size_t i = 0; i < size0; i++)
+			diff_c_x_1d[i] = diff_c_x.spectral_space_data[i];
+
+		diff_c_y_1d.resize(size1);
+		for (std::size_t j = 0; j < size1; j++)
+			diff_c_y_1d[j] = diff_c_y.spectral_space_data[j*size0];
+	}
+
+public:
 
 	/**
 	 * D2, e.g. for viscosity
@@ -58,7 +128,7 @@ public:
 			const PlaneData_Spectral &i_a
 	)
 	{
-		return diff2_c_x(i_a)+diff2_c_y(i_a);
+		return diag_laplace(i_a);
 	}
 
 
@@ -73,7 +143,17 @@ public:
 			const PlaneData_Spectral &b
 	)
 	{
-		return diff_c_x(b) - diff_c_y(a);
+		PlaneData_Spectral out(planeDataConfig);
+
+		p_spectral_sweep(
+			[&](std::size_t idx, const std::complex<double> &kx, const std::complex<double> &ky)
+			{
+				out.spectral_space_data[idx] = kx*b.spectral_space_data[idx] - ky*a.spectral_space_data[idx];
+			}
+		);
+
+		out.spectral_zeroAliasingModes();
+		return out;
 	}
 
 
@@ -88,7 +168,87 @@ public:
 			const PlaneData_Spectral &b
 	)
 	{
-		return diff_c_x(a) + diff_c_y(b);
+		PlaneData_Spectral out(planeDataConfig);
+
+		p_spectral_sweep(
+			[&](std::size_t idx, const std::complex<double> &kx, const std::complex<double> &ky)
+			{
+				out.spectral_space_data[idx] = kx*a.spectral_space_data[idx] + ky*b.spectral_space_data[idx];
+			}
+		);
+
+		out.spectral_zeroAliasingModes();
+		return out;
+	}
+
+
+
+	/**
+	 * Derivative in x direction, same as diff_c_x(a)
+	 */
+	PlaneData_Spectral diff_x(
+			const PlaneData_Spectral &a
+	)
+	{
+		PlaneData_Spectral out(planeDataConfig);
+
+		p_spectral_sweep(
+			[&](std::size_t idx, const std::complex<double> &kx, const std::complex<double> &)
+			{
+				out.spectral_space_data[idx] = kx*a.spectral_space_data[idx];
+			}
+		);
+
+		out.spectral_zeroAliasingModes();
+		return out;
+	}
+
+
+
+	/**
+	 * Derivative in y direction, same as diff_c_y(a)
+	 */
+	PlaneData_Spectral diff_y(
+			const PlaneData_Spectral &a
+	)
+	{
+		PlaneData_Spectral out(planeDataConfig);
+
+		p_spectral_sweep(
+			[&](std::size_t idx, const std::complex<double> &, const std::complex<double> &ky)
+			{
+				out.spectral_space_data[idx] = ky*a.spectral_space_data[idx];
+			}
+		);
+
+		out.spectral_zeroAliasingModes();
+		return out;
+	}
+
+
+
+	/**
+	 * Gradient
+	 *
+	 * (o_x, o_y) = (da/dx, da/dy)
+	 */
+	void grad(
+			const PlaneData_Spectral &a,
+			PlaneData_Spectral &o_x,
+			PlaneData_Spectral &o_y
+	)
+	{
+		p_spectral_sweep(
+			[&](std::size_t idx, const std::complex<double> &kx, const std::complex<double> &ky)
+			{
+				const std::complex<double> v = a.spectral_space_data[idx];
+				o_x.spectral_space_data[idx] = kx*v;
+				o_y.spectral_space_data[idx] = ky*v;
+			}
+		);
+
+		o_x.spectral_zeroAliasingModes();
+		o_y.spectral_zeroAliasingModes();
 	}
 
 	/**
@@ -117,7 +277,28 @@ public:
 			const PlaneData_Spectral &b
 	)
 	{
-		return diff_c_x(a)*diff_c_y(b) - diff_c_y(a)*diff_c_x(b);
+		PlaneData_Spectral a_x(planeDataConfig), a_y(planeDataConfig);
+		PlaneData_Spectral b_x(planeDataConfig), b_y(planeDataConfig);
+
+		grad(a, a_x, a_y);
+		grad(b, b_x, b_y);
+
+		PlaneData_Physical a_x_phys = a_x.toPhys();
+		PlaneData_Physical a_y_phys = a_y.toPhys();
+		PlaneData_Physical b_x_phys = b_x.toPhys();
+		PlaneData_Physical b_y_phys = b_y.toPhys();
+
+		// Single transformation back to spectral space for both products
+		PlaneData_Physical out(planeDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < planeDataConfig->physical_array_data_number_of_elements; i++)
+			out.physical_space_data[i] =
+					  a_x_phys.physical_space_data[i]*b_y_phys.physical_space_data[i]
+					- a_y_phys.physical_space_data[i]*b_x_phys.physical_space_data[i];
+
+		// Dealiasing is performed inside the following call
+		return PlaneData_Spectral(out);
 	}
 
 
@@ -133,10 +314,37 @@ public:
 			const PlaneData_Spectral &b_t
 	)
 	{
-		return	  diff_c_x(a_t)*diff_c_y(b)
-				+ diff_c_x(a)*diff_c_y(b_t)
-				- diff_c_y(a_t)*diff_c_x(b)
-				- diff_c_y(a)*diff_c_x(b_t);
+		PlaneData_Spectral a_x(planeDataConfig), a_y(planeDataConfig);
+		PlaneData_Spectral b_x(planeDataConfig), b_y(planeDataConfig);
+		PlaneData_Spectral a_t_x(planeDataConfig), a_t_y(planeDataConfig);
+		PlaneData_Spectral b_t_x(planeDataConfig), b_t_y(planeDataConfig);
+
+		grad(a, a_x, a_y);
+		grad(b, b_x, b_y);
+		grad(a_t, a_t_x, a_t_y);
+		grad(b_t, b_t_x, b_t_y);
+
+		PlaneData_Physical a_x_phys = a_x.toPhys();
+		PlaneData_Physical a_y_phys = a_y.toPhys();
+		PlaneData_Physical b_x_phys = b_x.toPhys();
+		PlaneData_Physical b_y_phys = b_y.toPhys();
+		PlaneData_Physical a_t_x_phys = a_t_x.toPhys();
+		PlaneData_Physical a_t_y_phys = a_t_y.toPhys();
+		PlaneData_Physical b_t_x_phys = b_t_x.toPhys();
+		PlaneData_Physical b_t_y_phys = b_t_y.toPhys();
+
+		PlaneData_Physical out(planeDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t i = 0; i < planeDataConfig->physical_array_data_number_of_elements; i++)
+			out.physical_space_data[i] =
+					  a_t_x_phys.physical_space_data[i]*b_y_phys.physical_space_data[i]
+					+ a_x_phys.physical_space_data[i]*b_t_y_phys.physical_space_data[i]
+					- a_t_y_phys.physical_space_data[i]*b_x_phys.physical_space_data[i]
+					- a_y_phys.physical_space_data[i]*b_t_x_phys.physical_space_data[i];
+
+		// Dealiasing is performed inside the following call
+		return PlaneData_Spectral(out);
 	}
 
 
@@ -149,7 +357,7 @@ public:
 			const PlaneData_Spectral &i_a
 	)
 	{
-		return diff_c_x(i_a)+diff_c_y(i_a);
+		return div(i_a, i_a);
 	}
 
 
@@ -252,20 +460,54 @@ public:
 			int i_order
 	)
 	{
-		PlaneData_Spectral out=i_data;
+		/*
+		 * The operator only changes with the time step size or viscosity.
+		 * It's cached for each set of parameters, also for concurrent callers.
+		 */
+		std::shared_ptr<const PlaneData_DiagonalOperator> diag = DiagonalOperatorCache<PlaneData_DiagonalOperator>::get(
+				planeDataConfig,
+				{{planeDataConfig->spectral_data_size[0], planeDataConfig->spectral_data_size[1]}},
+				DIAGONAL_OPERATOR_IMPLICIT_DIFFUSION,
+				{{i_coef, (double)i_order, domain_size[0], domain_size[1], (double)use_spectral_basis_diffs, 0}},
+				[&](PlaneData_DiagonalOperator &o_diag)
+				{
+					setup_implicit_diffusion(o_diag, i_coef, i_order);
+				}
+			);
 
-		// Get diffusion coefficients (these are the -mu*dt*D^q, where q is the order
-		PlaneData_Spectral diff = -i_coef*diffusion_coefficient(i_order);
+		return (*diag)(i_data);
+	}
 
-		// Add 1 to get denominator
-		diff = diff.spectral_addScalarAll(1.0);
+private:
+	/*
+	 * Setup implicit diffusion operator 1/(1-mu*dt*D^q)
+	 */
+	void setup_implicit_diffusion(
+			PlaneData_DiagonalOperator &o_diag,
+			double i_coef,
+			int i_order
+	)	const
+	{
+		assert(i_order % 2 == 0);
+		assert(i_order > 0);
 
-		// Invert
-		diff = diff.spectral_invert();
-		// apply to data
-		out=diff(out);
-		return out;
+		/*
+		 * D^q with the same sign convention as in diffusion_coefficient()
+		 */
+		PlaneData_DiagonalOperator diff = diag_laplace;
+		for (int i = 1; i < i_order/2; i++)
+			diff = (diag_laplace*diff).map([](double d) -> double { return -d; });
+
+		// 1/(1-mu*dt*D^q)
+		o_diag = diff.map(
+				[&](double d) -> double
+				{
+					return 1.0/(1.0 - i_coef*d);
+				}
+			);
 	}
+
+public:
 #endif
 
 	PlaneOperators()	:
@@ -334,6 +576,9 @@ public:
 			bool i_use_spectral_basis_diffs
 	)
 	{
+		domain_size[0] = i_domain_size[0];
+		domain_size[1] = i_domain_size[1];
+		use_spectral_basis_diffs = i_use_spectral_basis_diffs;
 
 		double h[2] = {
 				(double)i_domain_size[0] / (double)planeDataConfig->physical_res[0],
@@ -606,6 +851,10 @@ public:
 			tmp.kernel_stencil_setup(diff2_y_kernel, 1.0/(h[1]*h[1]));
 			diff2_c_y.loadPlaneDataPhysical(tmp);
 		}
+
+		diag_laplace.setup(diff2_c_x + diff2_c_y);
+
+		p_setup_diff_1d();
 	}
 
 	PlaneOperators(
@@ -106,6 +106,13 @@ public:
 	double *lat_cogaussian;
 
 
+	/**
+	 * Array with Gauss quadrature weights for each latitude (sum up to 2)
+	 */
+public:
+	double *lat_gauss_weights;
+
+
 
 public:
 	SphereData_Config()	:
@@ -121,7 +128,8 @@ public:
 
 		lat(nullptr),
 		lat_gaussian(nullptr),
-		lat_cogaussian(nullptr)
+		lat_cogaussian(nullptr),
+		lat_gauss_weights(nullptr)
 	{
 	}
 
@@ -369,6 +377,21 @@ private:
 		for (int i = 0; i < physical_num_lat; i++)
 			lat_cogaussian[i] = shtns->st[i];	/// cos(phi) (SHTNS stores sin(phi))
 
+		lat_gauss_weights = (double*)fftw_malloc(sizeof(double)*shtns->nlat);
+		int num_gauss_weights = shtns_gauss_wts(shtns, lat_gauss_weights);
+		if (num_gauss_weights > 0)
+		{
+			/// SHTNS only provides the weights of the northern hemisphere
+			for (int i = 0; i < num_gauss_weights; i++)
+				lat_gauss_weights[physical_num_lat-1-i] = lat_gauss_weights[i];
+		}
+		else
+		{
+			/// No Gaussian grid: use midpoint rule
+			for (int i = 0; i < physical_num_lat; i++)
+				lat_gauss_weights[i] = shtns->st[i]*M_PI/(double)physical_num_lat;
+		}
+
 #if 0
 		getConfigInformationString();
 		std::cout << "physical_num_lat: " << physical_num_lat << std::endl;
@@ -732,6 +755,9 @@ public:
 		fftw_free(lat_cogaussian);
 		lat_cogaussian = nullptr;
 
+		fftw_free(lat_gauss_weights);
+		lat_gauss_weights = nullptr;
+
 		shtns_unset_grid(shtns);
 		shtns_destroy(shtns);
 		shtns = nullptr;
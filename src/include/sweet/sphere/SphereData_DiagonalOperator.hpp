@@ -0,0 +1,127 @@
+/*
+ * SphereData_DiagonalOperator.hpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ */
+
+#ifndef SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_DIAGONALOPERATOR_HPP_
+#define SRC_INCLUDE_SWEET_SPHERE_SPHEREDATA_DIAGONALOPERATOR_HPP_
+
+#include <vector>
+#include <functional>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/SWEETError.hpp>
+
+
+
+/*
+ * Operator which is diagonal in spherical harmonics space.
+ *
+ * All isotropic operators (Laplace, Helmholtz, hyperdiffusion) only
+ * depend on the degree n. Hence, we store one real coefficient per n
+ * which is computed once during the setup.
+ */
+class SphereData_DiagonalOperator
+{
+public:
+	const SphereData_Config *sphereDataConfig = nullptr;
+
+	/// Coefficients for n = 0, ..., spectral_modes_n_max
+	std::vector<double> coeffs_n;
+
+
+public:
+	SphereData_DiagonalOperator()
+	{
+	}
+
+
+	SphereData_DiagonalOperator(
+			const SphereData_Config *i_sphereDataConfig,
+			std::function<double(int)> i_coeff_lambda		///< coefficient for degree n
+	)
+	{
+		setup(i_sphereDataConfig, i_coeff_lambda);
+	}
+
+
+	void setup(
+			const SphereData_Config *i_sphereDataConfig,
+			std::function<double(int)> i_coeff_lambda		///< coefficient for degree n
+	)
+	{
+		sphereDataConfig = i_sphereDataConfig;
+
+		coeffs_n.resize(sphereDataConfig->spectral_modes_n_max+1);
+		for (int n = 0; n <= sphereDataConfig->spectral_modes_n_max; n++)
+			coeffs_n[n] = i_coeff_lambda(n);
+	}
+
+
+	bool isSetup()	const
+	{
+		return sphereDataConfig != nullptr;
+	}
+
+
+	/**
+	 * Composition of two diagonal operators into a single one
+	 */
+	SphereData_DiagonalOperator operator*(
+			const SphereData_DiagonalOperator &i_op
+	)	const
+	{
+		assert(sphereDataConfig == i_op.sphereDataConfig);
+
+		SphereData_DiagonalOperator out(*this);
+		for (std::size_t n = 0; n < coeffs_n.size(); n++)
+			out.coeffs_n[n] *= i_op.coeffs_n[n];
+
+		return out;
+	}
+
+
+	/**
+	 * Return D(i_x)
+	 */
+	SphereData_Spectral operator()(
+			const SphereData_Spectral &i_x
+	)	const
+	{
+		SphereData_Spectral out(i_x);
+		out.spectral_update_diagonal_n(coeffs_n.data());
+		return out;
+	}
+
+
+	/**
+	 * io_x = D(io_x)
+	 */
+	void apply_inplace(
+			SphereData_Spectral &io_x
+	)	const
+	{
+		assert(sphereDataConfig == io_x.sphereDataConfig);
+		io_x.spectral_update_diagonal_n(coeffs_n.data());
+	}
+
+
+	/**
+	 * io_y += i_alpha * D(i_x) in a single pass
+	 */
+	void apply_axpy(
+			double i_alpha,
+			const SphereData_Spectral &i_x,
+			SphereData_Spectral &io_y
+	)	const
+	{
+		assert(sphereDataConfig == i_x.sphereDataConfig);
+		io_y.spectral_axpy_diagonal_n(i_alpha, coeffs_n.data(), i_x);
+	}
+};
+
+
+
+#endif
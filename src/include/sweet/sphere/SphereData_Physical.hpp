@@ -27,6 +27,8 @@
 #include <sweet/openmp_helper.hpp>
 #include <sweet/sphere/SphereData_Config.hpp>
 #include <sweet/SWEETError.hpp>
+#include <sweet/ReduceStatistics.hpp>
+#include <sweet/GridLayoutTranspose.hpp>
 
 
 
@@ -403,7 +405,7 @@ private:
 	void alloc_data()
 	{
 		assert(physical_space_data == nullptr);
-		physical_space_data = MemBlockAlloc::alloc<double>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(double));
+		physical_space_data = MemBlockAlloc::alloc<double>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(double), "SphereData_Physical");
 	}
 
 
@@ -944,6 +946,35 @@ public:
 
 
 
+	/**
+	 * Return min, max, max_abs, sum, sum of squares, NaN/Inf flag and the
+	 * integral over the unit sphere (Gauss quadrature) in a single pass
+	 */
+	ReduceStatistics physical_reduce_statistics(
+			bool i_deterministic = false
+	)	const
+	{
+		const double *lat_weights = sphereDataConfig->lat_gauss_weights;
+		const double scale = 2.0*M_PI/(double)sphereDataConfig->physical_num_lon;
+
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		const std::size_t num_lat = sphereDataConfig->physical_num_lat;
+		auto weight = [&](std::size_t idx) -> double { return lat_weights[idx % num_lat]*scale; };
+#else
+		const std::size_t num_lon = sphereDataConfig->physical_num_lon;
+		auto weight = [&](std::size_t idx) -> double { return lat_weights[idx / num_lon]*scale; };
+#endif
+
+		return ReduceStatistics::reduce_weighted(
+				physical_space_data,
+				sphereDataConfig->physical_array_data_number_of_elements,
+				weight,
+				i_deterministic
+			);
+	}
+
+
+
 	bool physical_isAnyNaNorInf()	const
 	{
 		for (std::size_t i = 0; i < sphereDataConfig->physical_array_data_number_of_elements; i++)
@@ -1016,6 +1047,13 @@ public:
 		}
 		file << std::endl;
 
+		// rows of data from north to south
+		std::vector<double> buffer;
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		buffer.resize(sphereDataConfig->physical_array_data_number_of_elements);
+#endif
+		const double *data = GridLayoutTranspose::sphere_to_lon_contiguous(sphereDataConfig, physical_space_data, buffer.data());
+
         for (int j = sphereDataConfig->physical_num_lat-1; j >= 0; j--)
         {
 //        		double lat_degree =  M_PI*0.5 - acos(shtns->ct[j]);
@@ -1026,11 +1064,7 @@ public:
 
         		for (int i = 0; i < sphereDataConfig->physical_num_lon; i++)
         		{
-#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
-        			file << physical_space_data[i*sphereDataConfig->physical_num_lat+j];
-#else
-        			file << physical_space_data[j*sphereDataConfig->physical_num_lon+i];
-#endif
+        			file << data[j*sphereDataConfig->physical_num_lon+i];
         			if (i < sphereDataConfig->physical_num_lon-1)
         				file << "\t";
         		}
@@ -1070,6 +1104,13 @@ public:
 		}
 		file << std::endl;
 
+		// rows of data from north to south
+		std::vector<double> buffer;
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+		buffer.resize(sphereDataConfig->physical_array_data_number_of_elements);
+#endif
+		const double *data = GridLayoutTranspose::sphere_to_lon_contiguous(sphereDataConfig, physical_space_data, buffer.data());
+
         for (int j = sphereDataConfig->physical_num_lat-1; j >= 0; j--)
         {
 //        		double lat_degree =  M_PI*0.5 - acos(shtns->ct[j]);
@@ -1084,11 +1125,7 @@ public:
         			if (ia >= sphereDataConfig->physical_num_lon)
         				ia -= sphereDataConfig->physical_num_lon;
 
-#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
-        			file << physical_space_data[ia*sphereDataConfig->physical_num_lat+j];
-#else
-        			file << physical_space_data[j*sphereDataConfig->physical_num_lon+ia];
-#endif
+        			file << data[j*sphereDataConfig->physical_num_lon+ia];
         			if (i < sphereDataConfig->physical_num_lon-1)
         				file << "\t";
         		}
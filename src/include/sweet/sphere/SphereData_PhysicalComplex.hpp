@@ -378,7 +378,7 @@ public:
 	{
 		sphereDataConfig = i_sphereDataConfig;
 
-		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>));
+		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>), "SphereData_PhysicalComplex");
 	}
 
 
@@ -395,7 +395,7 @@ public:
 		}
 
 		sphereDataConfig = i_sphereDataConfig;
-		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>));
+		physical_space_data = MemBlockAlloc::alloc<std::complex<double>>(sphereDataConfig->physical_array_data_number_of_elements * sizeof(std::complex<double>), "SphereData_PhysicalComplex");
 	}
 
 
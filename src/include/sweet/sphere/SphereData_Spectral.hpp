@@ -18,6 +18,7 @@
 #include <cassert>
 #include <limits>
 #include <utility>
+#include <vector>
 #include <functional>
 
 #include <cmath>
@@ -28,6 +29,9 @@
 #include <sweet/sphere/SphereData_Physical.hpp>
 #include <sweet/sphere/SphereData_PhysicalComplex.hpp>
 #include <sweet/SWEETError.hpp>
+#include <sweet/ReduceStatistics.hpp>
+#include <sweet/SpectralRemap.hpp>
+#include <sweet/DiagonalOperatorCache.hpp>
 
 
 
@@ -223,83 +227,79 @@ public:
 	}
 
 
-public:
-	SphereData_Spectral spectral_returnWithDifferentModes(
-			const SphereData_Config *i_sphereDataConfig
-	)	const
+private:
+	/**
+	 * Return (cached) index map from the modes of i_src to the modes of i_dst
+	 */
+	static
+	const SpectralRemap& p_getSpectralRemap(
+			const SphereData_Config *i_src,
+			const SphereData_Config *i_dst
+	)
 	{
-		SphereData_Spectral out(i_sphereDataConfig);
+		static SpectralRemapCache remapCache;
 
-		/*
-		 *  0 = invalid
-		 * -1 = scale down
-		 *  1 = scale up
-		 */
-		int scaling_mode = 0;
-
-		if (sphereDataConfig->spectral_modes_m_max < out.sphereDataConfig->spectral_modes_m_max)
-		{
-			scaling_mode = 1;
-		}
-		else if (sphereDataConfig->spectral_modes_m_max > out.sphereDataConfig->spectral_modes_m_max)
-		{
-			scaling_mode = -1;
-		}
+		return remapCache.get(
+				{
+					(std::size_t)i_src->spectral_modes_m_max, (std::size_t)i_src->spectral_modes_n_max,
+					(std::size_t)i_dst->spectral_modes_m_max, (std::size_t)i_dst->spectral_modes_n_max
+				},
+				[&](SpectralRemap &o_remap)
+				{
+					/*
+					 * One block per m: copy all n which exist in both configurations,
+					 * zero the remaining ones in the destination
+					 */
+					for (int m = 0; m <= i_dst->spectral_modes_m_max; m++)
+					{
+						std::size_t dst_idx = i_dst->getArrayIndexByModes(m, m);
+						std::size_t dst_size = i_dst->spectral_modes_n_max - m + 1;
+
+						std::size_t src_idx = 0;
+						std::size_t num_copy = 0;
+
+						if (m <= i_src->spectral_modes_m_max)
+						{
+							src_idx = i_src->getArrayIndexByModes(m, m);
+							num_copy = std::min<std::size_t>(i_src->spectral_modes_n_max - m + 1, dst_size);
+						}
+
+						o_remap.add_block(src_idx, dst_idx, num_copy, dst_size - num_copy);
+					}
+				}
+			);
+	}
 
 
-		if (sphereDataConfig->spectral_modes_n_max < out.sphereDataConfig->spectral_modes_n_max)
-		{
-			assert(scaling_mode != -1);
-			scaling_mode = 1;
-		}
-		else if (sphereDataConfig->spectral_modes_n_max > out.sphereDataConfig->spectral_modes_n_max)
-		{
-			assert(scaling_mode != 1);
-			scaling_mode = -1;
-		}
-
-		if (scaling_mode == 0)
+public:
+	/**
+	 * Copy the spectral coefficients to o_out which might have a different
+	 * number of modes. Modes which don't exist in this data are set to zero.
+	 */
+	void spectral_remap_to(
+			SphereData_Spectral &o_out
+	)	const
+	{
+		if (	sphereDataConfig->spectral_modes_m_max == o_out.sphereDataConfig->spectral_modes_m_max &&
+				sphereDataConfig->spectral_modes_n_max == o_out.sphereDataConfig->spectral_modes_n_max
+		)
 		{
 			// Just copy the data
-			out = *this;
-			return out;
+			parmemcpy(o_out.spectral_space_data, spectral_space_data, sizeof(Tcomplex)*sphereDataConfig->spectral_array_data_number_of_elements);
+			return;
 		}
 
-		if (scaling_mode == -1)
-		{
-			/*
-			 * more modes -> less modes
-			 */
-			SWEET_THREADING_SPACE_PARALLEL_FOR
-			for (int m = 0; m <= out.sphereDataConfig->spectral_modes_m_max; m++)
-			{
-				Tcomplex *dst = &out.spectral_space_data[out.sphereDataConfig->getArrayIndexByModes(m, m)];
-				Tcomplex *src = &spectral_space_data[sphereDataConfig->getArrayIndexByModes(m, m)];
-
-				std::size_t size = sizeof(Tcomplex)*(out.sphereDataConfig->spectral_modes_n_max-m+1);
-				memcpy(dst, src, size);
-			}
-		}
-		else
-		{
-			/*
-			 * less modes -> more modes
-			 */
-
-			// zero all values
-			out.spectral_set_zero();
-
-			SWEET_THREADING_SPACE_PARALLEL_FOR
-			for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
-			{
-				Tcomplex *dst = &out.spectral_space_data[out.sphereDataConfig->getArrayIndexByModes(m, m)];
-				Tcomplex *src = &spectral_space_data[sphereDataConfig->getArrayIndexByModes(m, m)];
+		p_getSpectralRemap(sphereDataConfig, o_out.sphereDataConfig).apply(spectral_space_data, o_out.spectral_space_data);
+	}
 
-				std::size_t size = sizeof(Tcomplex)*(sphereDataConfig->spectral_modes_n_max-m+1);
-				memcpy(dst, src, size);
-			}
-		}
 
+public:
+	SphereData_Spectral spectral_returnWithDifferentModes(
+			const SphereData_Config *i_sphereDataConfig
+	)	const
+	{
+		SphereData_Spectral out(i_sphereDataConfig);
+		spectral_remap_to(out);
 		return out;
 	}
 
@@ -664,7 +664,7 @@ private:
 	void alloc_data()
 	{
 		assert(spectral_space_data == nullptr);
-		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(sphereDataConfig->spectral_array_data_number_of_elements * sizeof(Tcomplex));
+		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(sphereDataConfig->spectral_array_data_number_of_elements * sizeof(Tcomplex), "SphereData_Spectral");
 	}
 
 
@@ -703,6 +703,35 @@ public:
 
 
 
+	/**
+	 * Return the cached coefficients per degree n of a diagonal operator,
+	 * see spectral_update_diagonal_n()
+	 */
+	template <typename TCoeffLambda>
+	static
+	std::shared_ptr<const std::vector<double>> get_cached_diagonal_coeffs_n(
+			const SphereData_Config *i_sphereDataConfig,
+			int i_kind,			///< DiagonalOperatorKind
+			const DiagonalOperatorCache<std::vector<double>>::Params &i_params,	///< all parameters of the coefficients
+			TCoeffLambda i_coeff_lambda		///< coefficient for degree n
+	)
+	{
+		return DiagonalOperatorCache<std::vector<double>>::get(
+				i_sphereDataConfig,
+				{{(std::size_t)i_sphereDataConfig->spectral_modes_n_max+1, (std::size_t)i_sphereDataConfig->spectral_modes_m_max+1}},
+				i_kind,
+				i_params,
+				[&](std::vector<double> &o_coeffs_n)
+				{
+					o_coeffs_n.resize(i_sphereDataConfig->spectral_modes_n_max+1);
+					for (int n = 0; n <= i_sphereDataConfig->spectral_modes_n_max; n++)
+						o_coeffs_n[n] = i_coeff_lambda(n);
+				}
+			);
+	}
+
+
+
 	/**
 	 * Solve a Helmholtz problem given by
 	 *
@@ -720,15 +749,17 @@ public:
 		const double a = i_a;
 		const double b = i_b/(r*r);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
-			{
-				io_data /= (a + (-b*(double)n*((double)n+1.0)));
-			}
-		);
+		std::shared_ptr<const std::vector<double>> coeffs_n = get_cached_diagonal_coeffs_n(
+				sphereDataConfig,
+				DIAGONAL_OPERATOR_HELMHOLTZ,
+				{{i_a, i_b, r, 0, 0, 0}},
+				[&](int n) -> double
+				{
+					return 1.0/(a + (-b*(double)n*((double)n+1.0)));
+				}
+			);
+
+		out.spectral_update_diagonal_n(coeffs_n->data());
 
 		return out;
 	}
@@ -747,19 +778,21 @@ public:
 	{
 		SphereData_Spectral out(*this);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
-			{
-				double laplace_op_2 = - (double)n*((double)n+1.0)/(r*r);
-				double laplace_op_4 = laplace_op_2 * laplace_op_2;
-				double laplace_op_6 = laplace_op_4 * laplace_op_2;
-				double laplace_op_8 = laplace_op_4 * laplace_op_4;
-				io_data /= (a + b[0] * laplace_op_2 + b[1] * laplace_op_4 + b[2] * laplace_op_6 + b[3] * laplace_op_8);
-			}
-		);
+		std::shared_ptr<const std::vector<double>> coeffs_n = get_cached_diagonal_coeffs_n(
+				sphereDataConfig,
+				DIAGONAL_OPERATOR_HELMHOLTZ_HIGHER_ORDER,
+				{{a, b[0], b[1], b[2], b[3], r}},
+				[&](int n) -> double
+				{
+					double laplace_op_2 = - (double)n*((double)n+1.0)/(r*r);
+					double laplace_op_4 = laplace_op_2 * laplace_op_2;
+					double laplace_op_6 = laplace_op_4 * laplace_op_2;
+					double laplace_op_8 = laplace_op_4 * laplace_op_4;
+					return 1.0/(a + b[0] * laplace_op_2 + b[1] * laplace_op_4 + b[2] * laplace_op_6 + b[3] * laplace_op_8);
+				}
+			);
+
+		out.spectral_update_diagonal_n(coeffs_n->data());
 
 		return out;
 	}
@@ -779,18 +812,12 @@ public:
 
 		const double b = 1.0/(r*r);
 
-		out.spectral_update_lambda(
-			[&](
-				int n, int m,
-				std::complex<double> &io_data
-			)
-			{
-				if (n == 0)
-					io_data = 0;
-				else
-					io_data /= (-b*(double)n*((double)n+1.0));
-			}
-		);
+		std::vector<double> coeffs_n(sphereDataConfig->spectral_modes_n_max+1);
+		coeffs_n[0] = 0;
+		for (int n = 1; n <= sphereDataConfig->spectral_modes_n_max; n++)
+			coeffs_n[n] = 1.0/(-b*(double)n*((double)n+1.0));
+
+		out.spectral_update_diagonal_n(coeffs_n.data());
 
 		return out;
 	}
@@ -801,15 +828,142 @@ public:
 	 */
 	const SphereData_Spectral& spectral_truncate()	const
 	{
-		SphereData_Physical tmp(sphereDataConfig);
+		if (	sphereDataConfig->physical_num_lat <= sphereDataConfig->spectral_modes_n_max ||
+				sphereDataConfig->physical_num_lon <= 2*sphereDataConfig->spectral_modes_m_max
+		)
+		{
+			/*
+			 * Not all modes are resolved on the grid, go via physical space
+			 */
+			SphereData_Physical tmp(sphereDataConfig);
 
-		SH_to_spat(sphereDataConfig->shtns, spectral_space_data, tmp.physical_space_data);
-		spat_to_SH(sphereDataConfig->shtns, tmp.physical_space_data, spectral_space_data);
+			SH_to_spat(sphereDataConfig->shtns, spectral_space_data, tmp.physical_space_data);
+			spat_to_SH(sphereDataConfig->shtns, tmp.physical_space_data, spectral_space_data);
+
+			return *this;
+		}
+
+		/*
+		 * All modes are exactly represented on the grid.
+		 * Only the imaginary parts of the m=0 modes are lost for real-valued data.
+		 */
+		for (int n = 0; n <= sphereDataConfig->spectral_modes_n_max; n++)
+			spectral_space_data[n].imag(0);
 
 		return *this;
 	}
 
 
+	/**
+	 * Multiply each mode (n,m) with a real coefficient depending only on n
+	 *
+	 * This is the case for all isotropic operators (Laplace, Helmholtz,
+	 * hyperdiffusion, ...) and avoids the indirect call of
+	 * spectral_update_lambda per coefficient.
+	 */
+	void spectral_update_diagonal_n(
+			const double *i_coeffs_n		///< coefficients for n = 0, ..., spectral_modes_n_max
+	)
+	{
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			Tcomplex *data = &spectral_space_data[sphereDataConfig->getArrayIndexByModes(m, m)] - m;
+
+			for (int n = m; n <= sphereDataConfig->spectral_modes_n_max; n++)
+				data[n] *= i_coeffs_n[n];
+		}
+	}
+
+
+	/**
+	 * Fused diagonal operator and axpy:
+	 *
+	 * this += i_alpha * D(i_x)
+	 *
+	 * with D given by real coefficients depending only on n
+	 */
+	void spectral_axpy_diagonal_n(
+			double i_alpha,
+			const double *i_coeffs_n,		///< coefficients for n = 0, ..., spectral_modes_n_max
+			const SphereData_Spectral &i_x
+	)
+	{
+		assert(sphereDataConfig == i_x.sphereDataConfig);
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR
+		for (int m = 0; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			std::size_t offset = sphereDataConfig->getArrayIndexByModes(m, m) - m;
+			Tcomplex *data = &spectral_space_data[offset];
+			const Tcomplex *x = &i_x.spectral_space_data[offset];
+
+			for (int n = m; n <= sphereDataConfig->spectral_modes_n_max; n++)
+				data[n] += (i_alpha*i_coeffs_n[n])*x[n];
+		}
+	}
+
+
+	/**
+	 * Fused linear combination with a number of terms known at compile time:
+	 *
+	 * this = i_x + sum_j i_alpha[j] * i_y[j]
+	 *
+	 * i_x may be this array itself.
+	 */
+	template <int t_num_terms>
+	void spectral_linear_combination(
+			const SphereData_Spectral &i_x,
+			const double *i_alpha,
+			const SphereData_Spectral *const *i_y
+	)
+	{
+		check(i_x.sphereDataConfig);
+
+		const Tcomplex *y[t_num_terms];
+		double alpha[t_num_terms];
+		for (int j = 0; j < t_num_terms; j++)
+		{
+			assert(sphereDataConfig == i_y[j]->sphereDataConfig);
+			y[j] = i_y[j]->spectral_space_data;
+			alpha[j] = i_alpha[j];
+		}
+
+		const Tcomplex *x = i_x.spectral_space_data;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
+		{
+			Tcomplex value = x[idx];
+			for (int j = 0; j < t_num_terms; j++)
+				value += alpha[j]*y[j][idx];
+
+			spectral_space_data[idx] = value;
+		}
+	}
+
+
+	/**
+	 * Fused in-place update without temporaries:
+	 *
+	 * this = i_alpha * i_x + i_beta * this
+	 */
+	void spectral_axpby(
+			double i_alpha,
+			const SphereData_Spectral &i_x,
+			double i_beta
+	)
+	{
+		check(i_x.sphereDataConfig);
+
+		const Tcomplex *x = i_x.spectral_space_data;
+
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (int idx = 0; idx < sphereDataConfig->spectral_array_data_number_of_elements; idx++)
+			spectral_space_data[idx] = i_alpha*x[idx] + i_beta*spectral_space_data[idx];
+	}
+
+
 	void spectral_update_lambda(
 			std::function<void(int,int,Tcomplex&)> i_lambda
 	)
@@ -1046,6 +1200,24 @@ public:
 	}
 
 
+	/**
+	 * Return statistics of all spectral coefficients in a single pass
+	 *
+	 * max_abs and sum_sqr are based on the modulus,
+	 * min, max and sum on the real part of the coefficients.
+	 */
+	ReduceStatistics spectral_reduce_statistics(
+			bool i_deterministic = false
+	)	const
+	{
+		return ReduceStatistics::reduce(
+				spectral_space_data,
+				sphereDataConfig->spectral_array_data_number_of_elements,
+				i_deterministic
+			);
+	}
+
+
 	/**
 	 * Return the max abs value
 	 */
@@ -1561,8 +1733,8 @@ public:
 			const SphereData_Spectral &i_array_data
 	)
 	{
-		SphereData_Spectral out = *this;
-		out = i_array_data.spectral_returnWithDifferentModes(out.sphereDataConfig);
+		SphereData_Spectral out(sphereDataConfig);
+		i_array_data.spectral_remap_to(out);
 		///std::cout << "RESTRICT " << i_array_data.sphereDataConfig->spectral_modes_n_max << " " << out.sphereDataConfig->spectral_modes_n_max << std::endl;
 
 		//////////////std::cout << i_array_data.spectral_reduce_max_abs() << std::endl;
@@ -1608,8 +1780,8 @@ public:
 	)
 	{
 
-		SphereData_Spectral out = *this;
-		out = i_array_data.spectral_returnWithDifferentModes(out.sphereDataConfig);
+		SphereData_Spectral out(sphereDataConfig);
+		i_array_data.spectral_remap_to(out);
 		////std::cout << "PAD ZEROS " << i_array_data.sphereDataConfig->spectral_modes_n_max << " " << out.sphereDataConfig->spectral_modes_n_max << std::endl;
 
 		////////////std::size_t M_coarse = i_array_data.sphereDataConfig->spectral_modes_m_max;
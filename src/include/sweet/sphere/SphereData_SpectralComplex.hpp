@@ -550,7 +550,7 @@ public:
 
 		sphereDataConfig = i_sphereConfig;
 
-		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(sphereDataConfig->spectral_complex_array_data_number_of_elements * sizeof(Tcomplex));
+		spectral_space_data = MemBlockAlloc::alloc<Tcomplex>(sphereDataConfig->spectral_complex_array_data_number_of_elements * sizeof(Tcomplex), "SphereData_SpectralComplex");
 	}
 
 
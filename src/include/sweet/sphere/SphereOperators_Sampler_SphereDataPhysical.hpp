@@ -597,131 +597,353 @@ public:
 
 
 public:
-	void bilinear_scalar(
-			const SphereData_Physical &i_data,	///< sampling data
+	/**
+	 * Precomputed bicubic interpolation at fixed positions
+	 *
+	 * This is a sparse interpolation operator with 4x4 entries for each
+	 * position. It refers to the data including the halo layers, see
+	 * updateSamplingData, and is separated in longitude and latitude to
+	 * support the limiter.
+	 */
+	struct BicubicPlan
+	{
+		/// Number of interpolation points
+		std::size_t number_of_elements = 0;
 
-			const ScalarDataArray &i_pos_x,		///< x positions of interpolation points
-			const ScalarDataArray &i_pos_y,		///< y positions of interpolation points
+		/// Sampling with pseudo points at the poles
+		bool pole_pseudo_points = false;
 
-			double *o_data,						///< output values
-			bool i_velocity_sampling,			///< swap sign for velocities,
-			bool i_pole_pseudo_points
+		/// First row in sampling data of each point
+		std::vector<int> idx_lat;
+
+		/// 4 columns in sampling data of each point
+		std::vector<int> idx_lon;
+
+		/// 4 weights along longitude of each point
+		std::vector<double> weights_lon;
+
+		/// 4 weights along latitude of each point
+		std::vector<double> weights_lat;
+	};
+
+
+
+	/**
+	 * Setup the interpolation plan for the given positions
+	 *
+	 * Same stencil and weights as bicubic_scalar
+	 */
+	void bicubic_plan_setup(
+			const ScalarDataArray &i_pos_lon,		///< x positions of interpolation points
+			const ScalarDataArray &i_pos_lat,		///< y positions of interpolation points
+			bool i_pole_pseudo_points,				///< reconstruct pole points
+			BicubicPlan &o_plan
 	)
 	{
 		assert(res[0] > 0);
-		assert(i_pos_x.number_of_elements == i_pos_y.number_of_elements);
-		assert((sphereDataConfig->physical_num_lon & 1) == 0);
+		assert(i_pos_lon.number_of_elements == i_pos_lat.number_of_elements);
 
-		// copy the data to an internal buffer including halo layers
-		updateSamplingData(i_data, 1, i_velocity_sampling, i_pole_pseudo_points);
+		std::size_t n = i_pos_lon.number_of_elements;
 
-		//int num_lon = sphereDataConfig->physical_num_lon;
-		int num_lat = sphereDataConfig->physical_num_lat;
+		o_plan.number_of_elements = n;
+		o_plan.pole_pseudo_points = i_pole_pseudo_points;
+		o_plan.idx_lat.resize(n);
+		o_plan.idx_lon.resize(4*n);
+		o_plan.weights_lon.resize(4*n);
+		o_plan.weights_lat.resize(4*n);
 
-		// longitude spacing
-		double s_lon = (double)i_data.sphereDataConfig->physical_num_lon / (2.0*M_PI);
+		const std::vector<double> &phi_lookup_ = (i_pole_pseudo_points ? phi_lookup_pseudo_points : phi_lookup);
+
+		// longitude angle delta
+		double dlon = (double)sphereDataConfig->physical_num_lon / (2.0*M_PI);
 
 		double L = -(-M_PI*0.5 - M_PI/ext_lat_M*1.5);
-		// total size of lat field (M_PI + extension)
-		// divided by number of cells
-		//double s = (M_PI+M_PI/ext_lat_M*3)/(double)(ext_lat_M-1);
 		double inv_s = (double)(ext_lat_M-1)/(M_PI+M_PI/ext_lat_M*3);
 
-		// iterate over all positions in parallel
-		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
-		for (std::size_t pos_idx = 0; pos_idx < i_pos_x.number_of_elements; pos_idx++)
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+		for (std::size_t pos_idx = 0; pos_idx < n; pos_idx++)
 		{
-			/*
-			 * Compute X information
-			 */
-			double array_x = wrapPeriodic(i_pos_x.scalar_data[pos_idx]*s_lon, (double)res[0]);
-
-			// compute position relative in cell \in [0;1]
-			double cell_rel_x = array_x - std::floor(array_x);
-			assert(cell_rel_x >= 0);
-			assert(cell_rel_x <= 1);
+			double pos_lat = i_pos_lat.scalar_data[pos_idx];
+			double pos_lon = i_pos_lon.scalar_data[pos_idx];
 
-			// compute array index
-			int array_idx_x = std::floor(array_x);
-			assert(array_idx_x >= 0);
-			assert(array_idx_x < sphereDataConfig->physical_num_lon);
+			if (pos_lat > M_PI*0.5)
+			{
+				pos_lat = M_PI-pos_lat;
+				pos_lon += M_PI;
+			}
 
-			/*
-			 * Compute Y information
-			 *
-			 * This is done via a lookup into phi_lookup since these
-			 * coordinates are not equidistantly spaced, but close to it
-			 */
-			// estimate array index for latitude
-			double phi = i_pos_y.scalar_data[pos_idx];
-			int est_lat_idx = (L - phi)*inv_s;
-#if SWEET_DEBUG
-			if (!(est_lat_idx >= 0))
+			if (pos_lat < -M_PI*0.5)
 			{
-				std::cout << "pos_idx: " << pos_idx << std::endl;
-				std::cout << "est_lat_idx: " << est_lat_idx << std::endl;
-				std::cout << "L: " << L << std::endl;
-				std::cout << "phi: " << phi << std::endl;
-				std::cout << "inv_s: " << inv_s << std::endl;
-				SWEETError("est_lat_idx");
+				pos_lat = -M_PI-pos_lat;
+				pos_lon += M_PI;
 			}
-#endif
-			assert(est_lat_idx >= 0);
+
+			double pos_array_x = wrapPeriodic(pos_lon*dlon, (double)res[0]);
+			double cell_rel_x = pos_array_x - std::floor(pos_array_x);
+			int array_idx_x = std::floor(pos_array_x);
+
+			int est_lat_idx = (L - pos_lat)*inv_s;
+			assert(est_lat_idx >= 1);
 			assert(est_lat_idx < ext_lat_M-1);
 
-			if (phi_lookup[est_lat_idx] < phi)
+			if (phi_lookup_[est_lat_idx] < pos_lat)
 				est_lat_idx--;
-			else if (phi_lookup[est_lat_idx+1] > phi)
+			else if (phi_lookup_[est_lat_idx+1] > pos_lat)
 				est_lat_idx++;
 
 			int array_idx_y = est_lat_idx;
-			assert(array_idx_y >= 0);
-			assert(array_idx_y < ext_lat_M);
+			assert(array_idx_y >= 1);
+			assert(array_idx_y < ext_lat_M-1);
 
-			assert(phi_lookup[array_idx_y] >= phi);
-			assert(phi_lookup[array_idx_y+1] <= phi);
+			o_plan.idx_lat[pos_idx] = array_idx_y-1;
 
+			for (int k = 0; k < 4; k++)
+				o_plan.idx_lon[4*pos_idx+k] = wrapPeriodic(array_idx_x-1+k, res[0]);
 
-			/**
-			 * See http://www.paulinternet.nl/?page=bicubic
-			 */
+			interpolation_lagrange_equidistant_weights<4>(cell_rel_x+1.0, &o_plan.weights_lon[4*pos_idx]);
+			interpolation_lagrange_nonequidistant_weights<4>(&phi_lookup_[array_idx_y-1], pos_lat, &o_plan.weights_lat[4*pos_idx]);
+		}
+	}
 
-			// precompute x-position indices since they are reused 4 times
-			int idx_i[2];
-			{
-				idx_i[0] = wrapPeriodic(array_idx_x, res[0]);
-				idx_i[1] = wrapPeriodic(array_idx_x+1, res[0]);
-			}
 
-			/**
-			 * iterate over rows and interpolate over the columns in the x direction
-			 */
-			// start at this row
-			int idx_j = array_idx_y;
 
-			double q[2];
-			for (int kj = 0; kj < 2; kj++)
+	/**
+	 * Apply the interpolation plan to the data
+	 */
+	void bicubic_plan_apply(
+			const BicubicPlan &i_plan,
+			const SphereData_Physical &i_data,		///< sampling data
+			double *o_data,							///< output values
+			bool i_velocity_sampling,
+			bool i_limiter							///< Use limiter for interpolation to avoid unphysical local extrema
+	)
+	{
+		assert(res[0] > 0);
+
+		updateSamplingData(i_data, 3, i_velocity_sampling, i_plan.pole_pseudo_points);
+
+		int num_lon = sphereDataConfig->physical_num_lon;
+		const double *data = sampling_data.data();
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+		for (std::size_t pos_idx = 0; pos_idx < i_plan.number_of_elements; pos_idx++)
+		{
+			const int *idx_i = &i_plan.idx_lon[4*pos_idx];
+			const double *w_lon = &i_plan.weights_lon[4*pos_idx];
+			const double *w_lat = &i_plan.weights_lat[4*pos_idx];
+
+			const double *row = data + i_plan.idx_lat[pos_idx]*num_lon;
+
+			double q[4];
+			for (int kj = 0; kj < 4; kj++)
 			{
-				assert(idx_j >= 0);
-				assert(idx_j < num_lat+4);
-				double p[2];
+				double p[4] = {row[idx_i[0]], row[idx_i[1]], row[idx_i[2]], row[idx_i[3]]};
 
-				p[0] = sampling_data_(idx_j, idx_i[0]);
-				p[1] = sampling_data_(idx_j, idx_i[1]);
+				q[kj] = w_lon[0]*p[0] + w_lon[1]*p[1] + w_lon[2]*p[2] + w_lon[3]*p[3];
 
-				assert(0.0 <= cell_rel_x && cell_rel_x <= 1.0);
-				q[kj] = interpolation_lagrange_equidistant<2>(p, cell_rel_x);
+				if (i_limiter)
+				{
+					q[kj] = std::min(q[kj], std::max(p[1], p[2]));
+					q[kj] = std::max(q[kj], std::min(p[1], p[2]));
+				}
 
-				idx_j++;
+				row += num_lon;
 			}
 
-			// interpolation in y direction
-			double value = interpolation_lagrange_nonequidistant<2>(&phi_lookup[array_idx_y], q, phi);
+			double value = w_lat[0]*q[0] + w_lat[1]*q[1] + w_lat[2]*q[2] + w_lat[3]*q[3];
+
+			if (i_limiter)
+			{
+				value = std::min(value, std::max(q[1], q[2]));
+				value = std::max(value, std::min(q[1], q[2]));
+			}
 
 			o_data[pos_idx] = value;
 		}
 	}
 
+
+
+	SphereData_Physical bicubic_plan_apply_ret_phys(
+			const BicubicPlan &i_plan,
+			const SphereData_Physical &i_data,		///< sampling data
+			bool i_velocity_sampling,
+			bool i_limiter
+	)
+	{
+		SphereData_Physical o_data(i_data.sphereDataConfig);
+
+		assert(i_plan.number_of_elements == (std::size_t)o_data.sphereDataConfig->physical_array_data_number_of_elements);
+
+		bicubic_plan_apply(i_plan, i_data, o_data.physical_space_data, i_velocity_sampling, i_limiter);
+		return o_data;
+	}
+
+
+
+public:
+	/**
+	 * Copy the data including halo layers to an external buffer for
+	 * bilinear_scalar__point.
+	 *
+	 * This allows sampling several fields at the same position.
+	 */
+	void bilinear_prepare(
+			const SphereData_Physical &i_data,		///< sampling data
+			bool i_velocity_sampling,				///< swap sign for velocities
+			bool i_pole_pseudo_points,
+			std::vector<double> &o_sampling_data	///< buffer with halo layers
+	)
+	{
+		assert(res[0] > 0);
+		assert((sphereDataConfig->physical_num_lon & 1) == 0);
+
+		updateSamplingData(i_data, 1, i_velocity_sampling, i_pole_pseudo_points);
+		o_sampling_data.swap(sampling_data);
+	}
+
+
+
+	/**
+	 * Bilinear interpolation of a single point
+	 */
+	inline
+	double bilinear_scalar__point(
+			const double *i_sampling_data,		///< data including halo layers, see bilinear_prepare
+			double i_pos_x,						///< longitude of interpolation point
+			double i_pos_y						///< latitude of interpolation point
+	)	const
+	{
+		int num_lon = sphereDataConfig->physical_num_lon;
+
+		// longitude spacing
+		double s_lon = (double)num_lon / (2.0*M_PI);
+
+		double L = -(-M_PI*0.5 - M_PI/ext_lat_M*1.5);
+		// total size of lat field (M_PI + extension)
+		// divided by number of cells
+		double inv_s = (double)(ext_lat_M-1)/(M_PI+M_PI/ext_lat_M*3);
+
+		/*
+		 * Compute X information
+		 */
+		double array_x = wrapPeriodic(i_pos_x*s_lon, (double)res[0]);
+
+		// compute position relative in cell \in [0;1]
+		double cell_rel_x = array_x - std::floor(array_x);
+		assert(cell_rel_x >= 0);
+		assert(cell_rel_x <= 1);
+
+		// compute array index
+		int array_idx_x = std::floor(array_x);
+		assert(array_idx_x >= 0);
+		assert(array_idx_x < num_lon);
+
+		/*
+		 * Compute Y information
+		 *
+		 * This is done via a lookup into phi_lookup since these
+		 * coordinates are not equidistantly spaced, but close to it
+		 */
+		// estimate array index for latitude
+		double phi = i_pos_y;
+		int est_lat_idx = (L - phi)*inv_s;
+#if SWEET_DEBUG
+		if (!(est_lat_idx >= 0))
+		{
+			std::cout << "est_lat_idx: " << est_lat_idx << std::endl;
+			std::cout << "L: " << L << std::endl;
+			std::cout << "phi: " << phi << std::endl;
+			std::cout << "inv_s: " << inv_s << std::endl;
+			SWEETError("est_lat_idx");
+		}
+#endif
+		assert(est_lat_idx >= 0);
+		assert(est_lat_idx < ext_lat_M-1);
+
+		if (phi_lookup[est_lat_idx] < phi)
+			est_lat_idx--;
+		else if (phi_lookup[est_lat_idx+1] > phi)
+			est_lat_idx++;
+
+		int array_idx_y = est_lat_idx;
+		assert(array_idx_y >= 0);
+		assert(array_idx_y < ext_lat_M);
+
+		assert(phi_lookup[array_idx_y] >= phi);
+		assert(phi_lookup[array_idx_y+1] <= phi);
+
+
+		/**
+		 * See http://www.paulinternet.nl/?page=bicubic
+		 */
+
+		// precompute x-position indices since they are reused 2 times
+		int idx_i[2];
+		{
+			idx_i[0] = wrapPeriodic(array_idx_x, res[0]);
+			idx_i[1] = wrapPeriodic(array_idx_x+1, res[0]);
+		}
+
+		/**
+		 * iterate over rows and interpolate over the columns in the x direction
+		 */
+		// start at this row
+		int idx_j = array_idx_y;
+
+		double q[2];
+		for (int kj = 0; kj < 2; kj++)
+		{
+			assert(idx_j >= 0);
+			assert(idx_j < ext_lat_M);
+			double p[2];
+
+			p[0] = i_sampling_data[idx_j*num_lon + idx_i[0]];
+			p[1] = i_sampling_data[idx_j*num_lon + idx_i[1]];
+
+			assert(0.0 <= cell_rel_x && cell_rel_x <= 1.0);
+			q[kj] = interpolation_lagrange_equidistant<2>(p, cell_rel_x);
+
+			idx_j++;
+		}
+
+		// interpolation in y direction
+		return interpolation_lagrange_nonequidistant<2>(&phi_lookup[array_idx_y], q, i_pos_y);
+	}
+
+
+
+public:
+	void bilinear_scalar(
+			const SphereData_Physical &i_data,	///< sampling data
+
+			const ScalarDataArray &i_pos_x,		///< x positions of interpolation points
+			const ScalarDataArray &i_pos_y,		///< y positions of interpolation points
+
+			double *o_data,						///< output values
+			bool i_velocity_sampling,			///< swap sign for velocities,
+			bool i_pole_pseudo_points
+	)
+	{
+		assert(res[0] > 0);
+		assert(i_pos_x.number_of_elements == i_pos_y.number_of_elements);
+		assert((sphereDataConfig->physical_num_lon & 1) == 0);
+
+		// copy the data to an internal buffer including halo layers
+		updateSamplingData(i_data, 1, i_velocity_sampling, i_pole_pseudo_points);
+
+		const double *data = sampling_data.data();
+
+		// iterate over all positions in parallel
+		SWEET_THREADING_SPACE_PARALLEL_FOR_SIMD
+		for (std::size_t pos_idx = 0; pos_idx < i_pos_x.number_of_elements; pos_idx++)
+			o_data[pos_idx] = bilinear_scalar__point(data, i_pos_x.scalar_data[pos_idx], i_pos_y.scalar_data[pos_idx]);
+	}
+
 public:
 	void bilinear_scalar(
 			const SphereData_Physical &i_data,	///< sampling data
@@ -10,9 +10,14 @@
 
 #include <sweet/MemBlockAlloc.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/sphere/SphereData_DiagonalOperator.hpp>
 #include <sweet/sphere/SphereHelpers_SPHIdentities.hpp>
 #include <sweet/SimulationVariables.hpp>
 
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+#	include <omp.h>
+#endif
+
 
 
 class SphereOperators_SphereData	:
@@ -39,6 +44,12 @@ private:
 	double ir;		// 1/radius
 	double ir2;		// 1/radius^2
 
+	// Precomputed diagonal operators
+	SphereData_DiagonalOperator diag_laplace;
+	SphereData_DiagonalOperator diag_root_laplace;
+	SphereData_DiagonalOperator diag_inv_laplace;
+	SphereData_DiagonalOperator diag_inv_root_laplace;
+
 
 public:
 	SphereOperators_SphereData(
@@ -147,6 +158,60 @@ public:
 		delete [] mx;
 #endif
 
+		setup_diagonal_operators();
+	}
+
+
+
+private:
+	void setup_diagonal_operators()
+	{
+		diag_laplace.setup(sphereDataConfig,
+				[&](int n) -> double
+				{
+					return -(double)n*((double)n+1.0)*(ir*ir);
+				}
+			);
+
+		diag_root_laplace.setup(sphereDataConfig,
+				[&](int n) -> double
+				{
+					return std::sqrt((double)n*((double)n+1.0))*(ir);
+				}
+			);
+
+		diag_inv_laplace.setup(sphereDataConfig,
+				[&](int n) -> double
+				{
+					if (n == 0)
+						return 0;
+
+					return 1.0/(-(double)n*((double)n+1.0)*ir*ir);
+				}
+			);
+
+		diag_inv_root_laplace.setup(sphereDataConfig,
+				[&](int n) -> double
+				{
+					if (n == 0)
+						return 0;
+
+					return 1.0/(std::sqrt((double)n*((double)n+1.0))*ir);
+				}
+			);
+	}
+
+
+
+public:
+	const SphereData_DiagonalOperator& get_diag_laplace()	const
+	{
+		return diag_laplace;
+	}
+
+	const SphereData_DiagonalOperator& get_diag_inv_laplace()	const
+	{
+		return diag_inv_laplace;
 	}
 
 
@@ -792,16 +857,7 @@ public:
 			const SphereData_Spectral &i_sph_data
 	)	const
 	{
-		SphereData_Spectral out_sph_data(i_sph_data);
-
-		out_sph_data.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
-				{
-					o_data *= -(double)n*((double)n+1.0)*(ir*ir);
-				}
-			);
-
-		return out_sph_data;
+		return diag_laplace(i_sph_data);
 	}
 
 	/**
@@ -811,16 +867,7 @@ public:
 			const SphereData_Spectral &i_sph_data
 	)	const
 	{
-		SphereData_Spectral out_sph_data(i_sph_data);
-
-		out_sph_data.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
-				{
-					o_data *= std::sqrt((double)n*((double)n+1.0))*(ir);
-				}
-			);
-
-		return out_sph_data;
+		return diag_root_laplace(i_sph_data);
 	}
 
 	/**
@@ -830,19 +877,7 @@ public:
 			const SphereData_Spectral &i_sph_data
 	)	const
 	{
-		SphereData_Spectral out(i_sph_data);
-
-		out.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
-				{
-					if (n != 0)
-						o_data /= -(double)n*((double)n+1.0)*ir*ir;
-					else
-						o_data = 0;
-				}
-			);
-
-		return out;
+		return diag_inv_laplace(i_sph_data);
 	}
 
 
@@ -853,19 +888,7 @@ public:
 			const SphereData_Spectral &i_sph_data
 	)	const
 	{
-		SphereData_Spectral out(i_sph_data);
-
-		out.spectral_update_lambda(
-				[&](int n, int m, std::complex<double> &o_data)
-				{
-					if (n != 0)
-						o_data /= std::sqrt((double)n*((double)n+1.0))*ir;
-					else
-						o_data = 0;
-				}
-			);
-
-		return out;
+		return diag_inv_root_laplace(i_sph_data);
 	}
 
 
@@ -913,24 +936,29 @@ public:
 			double i_r
 	)
 	{
-		SphereData_Spectral out = i_data;
-
-		const double r      = i_r;
-
-		std::array<double, 4> visc_factors;
-		if (i_order == 2)
-			visc_factors = {-i_coef, 0, 0, 0};
-		else if (i_order == 4)
-			visc_factors = {0, -i_coef, 0, 0};
-		else if (i_order == 6)
-			visc_factors = {0, 0, -i_coef, 0};
-		else if (i_order == 8)
-			visc_factors = {0, 0, 0, -i_coef};
-		else
+		if (i_order != 2 && i_order != 4 && i_order != 6 && i_order != 8)
 			SWEETError("This viscosity order is not supported: " + std::to_string(i_order));
 
-		out  = out.spectral_solve_helmholtz_higher_order(1.0, visc_factors, r);
+		const double r = i_r;
+		const int q = i_order/2;
+
+		/*
+		 * The operator only changes with the time step size or viscosity.
+		 * It's cached for each set of parameters, also for concurrent callers.
+		 */
+		std::shared_ptr<const std::vector<double>> coeffs_n = SphereData_Spectral::get_cached_diagonal_coeffs_n(
+				sphereDataConfig,
+				DIAGONAL_OPERATOR_IMPLICIT_HYPERDIFFUSION,
+				{{i_coef, (double)i_order, i_r, 0, 0, 0}},
+				[&](int n) -> double
+				{
+					double laplace_op_2 = - (double)n*((double)n+1.0)/(r*r);
+					return 1.0/(1.0 - i_coef*std::pow(laplace_op_2, q));
+				}
+			);
 
+		SphereData_Spectral out(i_data);
+		out.spectral_update_diagonal_n(coeffs_n->data());
 		return out;
 	}
 
@@ -3,6 +3,9 @@
 #define SPHEREDATA_TIMESTEPPING_EXPLICITRK_HPP__
 
 #include <sweet/sphere/SphereData_Spectral.hpp>
+#include <sweet/TimesteppingEmbeddedRK.hpp>
+#include <sweet/TimesteppingLowStorageRK.hpp>
+#include <sweet/TimesteppingExplicitRKStages.hpp>
 #include <limits>
 
 class SphereTimestepping_ExplicitRK
@@ -17,6 +20,15 @@ class SphereTimestepping_ExplicitRK
 
 	int runge_kutta_order;
 
+	// Embedded RK pairs for adaptive time stepping
+	TimesteppingEmbeddedRK<SphereData_Spectral> embeddedRK;
+
+	// Coefficients of low-storage RK methods (negative orders)
+	TimesteppingLowStorageRK lowStorageRK;
+
+	// Fused stage combinations of RK methods with compile-time tableaux
+	TimesteppingExplicitRKStages<SphereData_Spectral> explicitRKStages;
+
 public:
 	SphereTimestepping_ExplicitRK()	:
 		runge_kutta_order(-1)
@@ -33,10 +45,20 @@ public:
 		if (RK_prog0_stage_t.size() != 0)	///< already allocated?
 			return;
 
+		MemBlockAllocTag memTag("rk_stages");
+
 		runge_kutta_order = i_rk_stages;
 		int N = runge_kutta_order;
 
-		if (N <= 0 || N > 4)
+		if (TimesteppingLowStorageRK::isLowStorageOrder(runge_kutta_order))
+		{
+			/*
+			 * Low-storage RK: One buffer for the tendencies and
+			 * one register independent of the number of stages
+			 */
+			N = 2;
+		}
+		else if (N <= 0 || N > 4)
 			SWEETError("Invalid order for RK time stepping");
 
 		RK_prog0_stage_t.resize(N);
@@ -61,6 +83,8 @@ public:
 		if (RK_prog0_stage_t.size() != 0)	///< already allocated?
 			return;
 
+		MemBlockAllocTag memTag("rk_stages");
+
 		runge_kutta_order = i_rk_stages;
 		int N = runge_kutta_order;
 
@@ -83,25 +107,23 @@ public:
 
 	~SphereTimestepping_ExplicitRK()
 	{
-		int N = runge_kutta_order;
-
 		if (RK_prog0_stage_t.size() != 0)
 		{
-			for (int i = 0; i < N; i++)
+			for (std::size_t i = 0; i < RK_prog0_stage_t.size(); i++)
 				delete RK_prog0_stage_t[i];
 			RK_prog0_stage_t.resize(0);
 		}
 
 		if (RK_prog1_stage_t.size() != 0)
 		{
-			for (int i = 0; i < N; i++)
+			for (std::size_t i = 0; i < RK_prog1_stage_t.size(); i++)
 				delete RK_prog1_stage_t[i];
 			RK_prog1_stage_t.resize(0);
 		}
 
 		if (RK_prog2_stage_t.size() != 0)
 		{
-			for (int i = 0; i < N; i++)
+			for (std::size_t i = 0; i < RK_prog2_stage_t.size(); i++)
 				delete RK_prog2_stage_t[i];
 			RK_prog2_stage_t.resize(0);
 		}
@@ -109,14 +131,14 @@ public:
 
 		if (RK_vel_u.size() != 0)
 		{
-			for (int i = 0; i < N; i++)
+			for (std::size_t i = 0; i < RK_vel_u.size(); i++)
 				delete RK_vel_u[i];
 			RK_vel_u.resize(0);
 		}
 
 		if (RK_vel_v.size() != 0)
 		{
-			for (int i = 0; i < N; i++)
+			for (std::size_t i = 0; i < RK_vel_v.size(); i++)
 				delete RK_vel_v[i];
 			RK_vel_v.resize(0);
 		}
@@ -159,189 +181,86 @@ public:
 	{
 		resetAndSetup(io_h.sphereDataConfig, i_runge_kutta_order);
 
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,	// input
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],	// output
-					*RK_prog1_stage_t[0],
-					*RK_prog2_stage_t[0],
-					i_simulation_time
-			);
-
-			io_h += i_dt**RK_prog0_stage_t[0];
-			io_u += i_dt**RK_prog1_stage_t[0];
-			io_v += i_dt**RK_prog2_stage_t[0];
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					*RK_prog1_stage_t[0],
-					*RK_prog2_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h + ( i_dt*a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u + ( i_dt*a2[0]*(*RK_prog1_stage_t[0]) ),
-					io_v + ( i_dt*a2[0]*(*RK_prog2_stage_t[0]) ),
-					*RK_prog0_stage_t[1],
-					*RK_prog1_stage_t[1],
-					*RK_prog2_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			io_h += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_prog0_stage_t[1]) );
-			io_u += i_dt*(/* b[0]*(*RK_u_t[0]) +*/ b[1]*(*RK_prog1_stage_t[1]) );
-			io_v += i_dt*(/* b[0]*(*RK_v_t[0]) +*/ b[1]*(*RK_prog2_stage_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					*RK_prog1_stage_t[0],
-					*RK_prog2_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u	+ i_dt*( a2[0]*(*RK_prog1_stage_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_prog2_stage_t[0]) ),
-					*RK_prog0_stage_t[1],
-					*RK_prog1_stage_t[1],
-					*RK_prog2_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a3[0]*(*RK_prog0_stage_t[0]) + a3[1]*(*RK_prog0_stage_t[1]) ),
-					io_u	+ i_dt*( a3[0]*(*RK_prog1_stage_t[0]) + a3[1]*(*RK_prog1_stage_t[1]) ),
-					io_v	+ i_dt*( a3[0]*(*RK_prog2_stage_t[0]) + a3[1]*(*RK_prog2_stage_t[1]) ),
-					*RK_prog0_stage_t[2],
-					*RK_prog1_stage_t[2],
-					*RK_prog2_stage_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			io_h += i_dt*( (b[0]*(*RK_prog0_stage_t[0])) + (b[1]*(*RK_prog0_stage_t[1]))  + (b[2]*(*RK_prog0_stage_t[2])) );
-			io_u += i_dt*( (b[0]*(*RK_prog1_stage_t[0])) + (b[1]*(*RK_prog1_stage_t[1]))  + (b[2]*(*RK_prog1_stage_t[2])) );
-			io_v += i_dt*( (b[0]*(*RK_prog2_stage_t[0])) + (b[1]*(*RK_prog2_stage_t[1]))  + (b[2]*(*RK_prog2_stage_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
+		if (TimesteppingLowStorageRK::isLowStorageOrder(i_runge_kutta_order))
 		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
 			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
+			 * 2N-storage RK, see TimesteppingLowStorageRK
+			 *
+			 * RK_prog*_stage_t[0]: tendencies
+			 * RK_prog*_stage_t[1]: register dU
 			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					*RK_prog1_stage_t[0],
-					*RK_prog2_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u	+ i_dt*( a2[0]*(*RK_prog1_stage_t[0]) ),
-					io_v	+ i_dt*( a2[0]*(*RK_prog2_stage_t[0]) ),
-					*RK_prog0_stage_t[1],
-					*RK_prog1_stage_t[1],
-					*RK_prog2_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_prog0_stage_t[1]) ),
-					io_u	+ i_dt*( /*a3[0]*(*RK_u_t[0]) +*/ a3[1]*(*RK_prog1_stage_t[1]) ),
-					io_v	+ i_dt*( /*a3[0]*(*RK_v_t[0]) +*/ a3[1]*(*RK_prog2_stage_t[1]) ),
-					*RK_prog0_stage_t[2],
-					*RK_prog1_stage_t[2],
-					*RK_prog2_stage_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_prog0_stage_t[2]) ),
-					io_u	+ i_dt*( /*a4[0]*(*RK_u_t[0]) + a4[1]*(*RK_u_t[1]) +*/ a4[2]*(*RK_prog1_stage_t[2]) ),
-					io_v	+ i_dt*( /*a4[0]*(*RK_v_t[0]) + a4[1]*(*RK_v_t[1]) +*/ a4[2]*(*RK_prog2_stage_t[2]) ),
-					*RK_prog0_stage_t[3],
-					*RK_prog1_stage_t[3],
-					*RK_prog2_stage_t[3],
-					i_simulation_time + c[2]*i_dt
-			);
-
-
-			io_h += i_dt*( (b[0]*(*RK_prog0_stage_t[0])) + (b[1]*(*RK_prog0_stage_t[1]))  + (b[2]*(*RK_prog0_stage_t[2])) + (b[3]*(*RK_prog0_stage_t[3])) );
-			io_u += i_dt*( (b[0]*(*RK_prog1_stage_t[0])) + (b[1]*(*RK_prog1_stage_t[1]))  + (b[2]*(*RK_prog1_stage_t[2])) + (b[3]*(*RK_prog1_stage_t[3])) );
-			io_v += i_dt*( (b[0]*(*RK_prog2_stage_t[0])) + (b[1]*(*RK_prog2_stage_t[1]))  + (b[2]*(*RK_prog2_stage_t[2])) + (b[3]*(*RK_prog2_stage_t[3])) );
+			lowStorageRK.setup(i_runge_kutta_order);
+
+			SphereData_Spectral &h_t = *RK_prog0_stage_t[0];
+			SphereData_Spectral &u_t = *RK_prog1_stage_t[0];
+			SphereData_Spectral &v_t = *RK_prog2_stage_t[0];
+
+			SphereData_Spectral &dh = *RK_prog0_stage_t[1];
+			SphereData_Spectral &du = *RK_prog1_stage_t[1];
+			SphereData_Spectral &dv = *RK_prog2_stage_t[1];
+
+			for (int i = 0; i < lowStorageRK.stages; i++)
+			{
+				(i_baseClass->*i_compute_euler_timestep_update)(
+						io_h,
+						io_u,
+						io_v,
+						h_t,
+						u_t,
+						v_t,
+						i_simulation_time + lowStorageRK.c[i]*i_dt
+				);
+
+				// fused in-place updates to avoid temporaries
+				if (i == 0)
+				{
+					dh = h_t;
+					du = u_t;
+					dv = v_t;
+
+					dh *= i_dt;
+					du *= i_dt;
+					dv *= i_dt;
+				}
+				else
+				{
+					dh.spectral_axpby(i_dt, h_t, lowStorageRK.A[i]);
+					du.spectral_axpby(i_dt, u_t, lowStorageRK.A[i]);
+					dv.spectral_axpby(i_dt, v_t, lowStorageRK.A[i]);
+				}
+
+				io_h.spectral_axpby(lowStorageRK.B[i], dh, 1.0);
+				io_u.spectral_axpby(lowStorageRK.B[i], du, 1.0);
+				io_v.spectral_axpby(lowStorageRK.B[i], dv, 1.0);
+			}
 		}
 		else
 		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
+			SphereData_Spectral *U[3] = {&io_h, &io_u, &io_v};
+			std::vector<SphereData_Spectral*> *U_stage_t[3] = {&RK_prog0_stage_t, &RK_prog1_stage_t, &RK_prog2_stage_t};
+
+			explicitRKStages.run_timestep(
+					i_runge_kutta_order,
+					[&](SphereData_Spectral *const *i_U, int i_stage, double i_time)
+					{
+						(i_baseClass->*i_compute_euler_timestep_update)(
+								*i_U[0],
+								*i_U[1],
+								*i_U[2],
+								*RK_prog0_stage_t[i_stage],
+								*RK_prog1_stage_t[i_stage],
+								*RK_prog2_stage_t[i_stage],
+								i_time
+						);
+					},
+					[&](int i_stage, int i_field) -> SphereData_Spectral&
+					{
+						return *(*U_stage_t[i_field])[i_stage];
+					},
+					U, 3,
+					i_dt,
+					i_simulation_time
+				);
 		}
 	}
 
@@ -383,162 +302,28 @@ public:
 	{
 		resetAndSetup_na(io_h.sphereDataConfig, i_runge_kutta_order);
 
-		if (i_runge_kutta_order == 1)
-		{
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,	// input
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],	// output
-					i_simulation_time
-			);
-
-			io_h += i_dt**RK_prog0_stage_t[0];
-		}
-		else if (i_runge_kutta_order == 2)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * --------------
-			 *     | 0   1    b
-			 */
-			double a2[1] = {0.5};
-			double b[2] = {0.0, 1.0};
-			double c[1] = {0.5};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h + ( i_dt*a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			io_h += i_dt*(/* b[0]*(*RK_h_t[0]) +*/ b[1]*(*RK_prog0_stage_t[1]) );
-		}
-		else if (i_runge_kutta_order == 3)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/3 | 1/3
-			 * 2/3 | 0    2/3
-			 * --------------
-			 *     | 1/4  0   3/4
-			 */
-			double a2[1] = {1.0/3.0};
-			double a3[2] = {0.0, 2.0/3.0};
-			double b[3] = {1.0/4.0, 0.0, 3.0/4.0};
-			double c[2] = {1.0/3.0, 2.0/3.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a3[0]*(*RK_prog0_stage_t[0]) + a3[1]*(*RK_prog0_stage_t[1]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			io_h += i_dt*( (b[0]*(*RK_prog0_stage_t[0])) + (b[1]*(*RK_prog0_stage_t[1]))  + (b[2]*(*RK_prog0_stage_t[2])) );
-		}
-		else if (i_runge_kutta_order == 4)
-		{
-			// See https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods#Explicit_Runge.E2.80.93Kutta_methods
-			// See https://de.wikipedia.org/wiki/Runge-Kutta-Verfahren
-			/*
-			 * c     a
-			 * 0   |
-			 * 1/2 | 1/2
-			 * 1/2 | 0    1/2
-			 * 1   | 0    0    1
-			 * --------------
-			 *     | 1/6  1/3  1/3  1/6
-			 */
-			double a2[1] = {0.5};
-			double a3[2] = {0.0, 0.5};
-			double a4[3] = {0.0, 0.0, 1.0};
-			double b[4] = {1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0};
-			double c[3] = {0.5, 0.5, 1.0};
-
-			// STAGE 1
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h,
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[0],
-					i_simulation_time
-			);
-
-			// STAGE 2
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( a2[0]*(*RK_prog0_stage_t[0]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[1],
-					i_simulation_time + c[0]*i_dt
-			);
-
-			// STAGE 3
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a3[0]*(*RK_P_t[0]) +*/ a3[1]*(*RK_prog0_stage_t[1]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[2],
-					i_simulation_time + c[1]*i_dt
-			);
-
-			// STAGE 4
-			(i_baseClass->*i_compute_euler_timestep_update)(
-					io_h	+ i_dt*( /*a4[0]*(*RK_P_t[0]) + a4[1]*(*RK_P_t[1]) +*/ a4[2]*(*RK_prog0_stage_t[2]) ),
-					io_u,
-					io_v,
-					*RK_prog0_stage_t[3],
-					i_simulation_time + c[2]*i_dt
+		SphereData_Spectral *U[1] = {&io_h};
+
+		explicitRKStages.run_timestep(
+				i_runge_kutta_order,
+				[&](SphereData_Spectral *const *i_U, int i_stage, double i_time)
+				{
+					(i_baseClass->*i_compute_euler_timestep_update)(
+							*i_U[0],
+							io_u,
+							io_v,
+							*RK_prog0_stage_t[i_stage],
+							i_time
+					);
+				},
+				[&](int i_stage, int) -> SphereData_Spectral&
+				{
+					return *RK_prog0_stage_t[i_stage];
+				},
+				U, 1,
+				i_dt,
+				i_simulation_time
 			);
-
-
-			io_h += i_dt*( (b[0]*(*RK_prog0_stage_t[0])) + (b[1]*(*RK_prog0_stage_t[1]))  + (b[2]*(*RK_prog0_stage_t[2])) + (b[3]*(*RK_prog0_stage_t[3])) );
-		}
-		else
-		{
-			std::cerr << "This order of the Runge-Kutta time stepping is not supported!" << std::endl;
-			exit(-1);
-		}
 	}
 
 
@@ -920,6 +705,59 @@ public:
 	}
 
 
+
+	/**
+	 * Execute an adaptive time step with an embedded RK pair
+	 * (order 3: Bogacki-Shampine 3(2), order 5: Dormand-Prince 5(4)).
+	 *
+	 * io_dt is the time step size to try first and returns the
+	 * accepted time step size. o_dt_next is the proposal for the next step.
+	 */
+	template <class BaseClass>
+	void run_timestep_adaptive(
+			BaseClass *i_baseClass,
+			void (BaseClass::*i_compute_euler_timestep_update)(
+					const SphereData_Spectral &i_P,	///< prognostic variables
+					const SphereData_Spectral &i_u,	///< prognostic variables
+					const SphereData_Spectral &i_v,	///< prognostic variables
+
+					SphereData_Spectral &o_P_t,		///< time updates
+					SphereData_Spectral &o_u_t,		///< time updates
+					SphereData_Spectral &o_v_t,		///< time updates
+
+					double i_simulation_time	///< simulation time, e.g. for tidal waves
+			),
+
+			SphereData_Spectral &io_var0,
+			SphereData_Spectral &io_var1,
+			SphereData_Spectral &io_var2,
+
+			double &io_dt,				///< in: time step size to try, out: accepted time step size
+			double &o_dt_next,			///< proposed time step size for next time step
+
+			int i_runge_kutta_order,	///< Order of embedded RK pair
+
+			double i_atol,
+			double i_rtol,
+			double i_dt_min,
+			double i_dt_max,
+
+			double i_simulation_time	///< Current simulation time.
+	)
+	{
+		if (!embeddedRK.isSetup() || embeddedRK.tableau.order != i_runge_kutta_order)
+			embeddedRK.setup(i_runge_kutta_order, i_atol, i_rtol, i_dt_min, i_dt_max);
+
+		embeddedRK.run_timestep(
+				i_baseClass,
+				i_compute_euler_timestep_update,
+				io_var0, io_var1, io_var2,
+				io_dt, o_dt_next,
+				i_simulation_time
+			);
+	}
+
+
 };
 
 #endif
@@ -58,6 +58,50 @@ public:
 
 	EnumTrajectories trajectory_method;
 
+	/// Compute departure points with the fused per-point kernel
+	bool semi_lagrangian_fused_departure_points;
+
+
+	/*
+	 * Iteration statistics of the fused departure point computation
+	 */
+	struct DeparturePointStatistics
+	{
+		/// Number of departure point computations
+		std::size_t num_calls = 0;
+
+		/// Total number of departure points
+		std::size_t num_points = 0;
+
+		/// Total number of fixpoint iterations of all departure points
+		std::size_t num_iterations = 0;
+
+		/// Maximum number of fixpoint iterations of a single departure point
+		int max_iterations = 0;
+
+		/// Number of departure points which didn't converge
+		std::size_t num_unconverged = 0;
+
+
+		void output()	const
+		{
+			std::cout << "[MULE] sl_departure_points_num_calls: " << num_calls << std::endl;
+			std::cout << "[MULE] sl_departure_points_num_points: " << num_points << std::endl;
+			std::cout << "[MULE] sl_departure_points_avg_iterations: " << (num_points > 0 ? (double)num_iterations/(double)num_points : 0.0) << std::endl;
+			std::cout << "[MULE] sl_departure_points_max_iterations: " << max_iterations << std::endl;
+			std::cout << "[MULE] sl_departure_points_num_unconverged: " << num_unconverged << std::endl;
+		}
+	};
+
+	DeparturePointStatistics departure_points_stats;
+
+private:
+	/// Velocities including halo layers for the fused kernel
+	std::vector<double> fused_sampling_data_u;
+	std::vector<double> fused_sampling_data_v;
+
+public:
+
 
 	SphereTimestepping_SemiLagrangian(
 			SimulationVariables &i_simVars
@@ -78,10 +122,19 @@ public:
 	}
 
 
+	~SphereTimestepping_SemiLagrangian()
+	{
+		if (departure_points_stats.num_calls > 0 && simVars.misc.verbosity > 0)
+			departure_points_stats.output();
+	}
+
+
 	void setup(
 		const SphereData_Config *i_sphereDataConfig
 	)
 	{
+		MemBlockAllocTag memTag("semi_lagrangian");
+
 		sphereDataConfig = i_sphereDataConfig;
 		sphereSampler.setup(sphereDataConfig);
 
@@ -108,6 +161,7 @@ public:
 		semi_lagrangian_convergence_threshold = simVars.disc.semi_lagrangian_convergence_threshold;
 		semi_lagrangian_approximate_sphere_geometry = simVars.disc.semi_lagrangian_approximate_sphere_geometry;
 		semi_lagrangian_interpolation_limiter = simVars.disc.semi_lagrangian_interpolation_limiter;
+		semi_lagrangian_fused_departure_points = simVars.disc.semi_lagrangian_fused_departure_points;
 
 
 
@@ -289,6 +343,277 @@ public:
 
 
 
+	/**
+	 * Do 1st order accurate advection on the sphere for a single point,
+	 * see doAdvectionOnSphere
+	 */
+	inline static
+	void doAdvectionOnSphere__scalar(
+		double i_pos_x,
+		double i_pos_y,
+		double i_pos_z,
+
+		double i_dt_velocity_x,
+		double i_dt_velocity_y,
+		double i_dt_velocity_z,
+
+		double &o_pos_x,
+		double &o_pos_y,
+		double &o_pos_z,
+
+		bool i_approximate_sphere_geometry
+	)
+	{
+		if (i_approximate_sphere_geometry)
+		{
+			o_pos_x = i_pos_x + i_dt_velocity_x;
+			o_pos_y = i_pos_y + i_dt_velocity_y;
+			o_pos_z = i_pos_z + i_dt_velocity_z;
+
+			double inv_length = 1.0/std::sqrt(o_pos_x*o_pos_x + o_pos_y*o_pos_y + o_pos_z*o_pos_z);
+			o_pos_x *= inv_length;
+			o_pos_y *= inv_length;
+			o_pos_z *= inv_length;
+			return;
+		}
+
+		/*
+		 * Rotation axis with normalization threshold for vanishing velocities
+		 */
+		double rotation_axis_x = i_pos_y*i_dt_velocity_z - i_pos_z*i_dt_velocity_y;
+		double rotation_axis_y = i_pos_z*i_dt_velocity_x - i_pos_x*i_dt_velocity_z;
+		double rotation_axis_z = i_pos_x*i_dt_velocity_y - i_pos_y*i_dt_velocity_x;
+
+		const double threshold2 = 1e-20*1e-20;
+		double length2 = rotation_axis_x*rotation_axis_x + rotation_axis_y*rotation_axis_y + rotation_axis_z*rotation_axis_z;
+		double inv_length = 1.0/std::sqrt(std::max(length2, threshold2));
+
+		rotation_axis_x *= inv_length;
+		rotation_axis_y *= inv_length;
+		rotation_axis_z *= inv_length;
+
+		double angle = std::sqrt(i_dt_velocity_x*i_dt_velocity_x + i_dt_velocity_y*i_dt_velocity_y + i_dt_velocity_z*i_dt_velocity_z);
+
+		SWEETVectorMath::point_rotate_3d_normalized_rotation_axis__scalar(
+				i_pos_x, i_pos_y, i_pos_z,
+				angle,
+				rotation_axis_x, rotation_axis_y, rotation_axis_z,
+				o_pos_x, o_pos_y, o_pos_z
+			);
+	}
+
+
+
+	/*
+	 * Fused computation of SL departure points
+	 *
+	 * Computes the same trajectories as the array-based implementation in
+	 * semi_lag_departure_points_settls_specialized, but the entire fixpoint
+	 * iteration of each departure point is done without any temporary
+	 * arrays. Each point stops iterating individually once its update is
+	 * below the convergence threshold.
+	 */
+	void semi_lag_departure_points_fused(
+		const SphereData_Physical &i_u_lon_prev,	///< Velocities at time t-1
+		const SphereData_Physical &i_v_lat_prev,
+
+		const SphereData_Physical &i_dt_u_lon, 		///< Velocities at time t
+		const SphereData_Physical &i_dt_v_lat,
+
+		ScalarDataArray &o_pos_lon_D, 	///< OUTPUT: Position of departure points x / y
+		ScalarDataArray &o_pos_lat_D
+	)
+	{
+		o_pos_lon_D.setup_if_required(pos_lon_A);
+		o_pos_lat_D.setup_if_required(pos_lon_A);
+
+		std::size_t num_elements = o_pos_lon_D.number_of_elements;
+
+		if (timestepping_order != 1 && timestepping_order != 2)
+			SWEETError("Only 1st and 2nd order time integration supported");
+
+		int max_iterations = 0;
+
+		/*
+		 * Trajectory with velocity at arrival point A and sampled velocity V:
+		 *
+		 * D_{k+1} = advect(A, -(sample_scale*V + arrival_scale*vel_A))
+		 */
+		double start_scale = 1.0;
+		double sample_scale = 1.0;
+		double arrival_scale = 0.0;
+		bool sample_at_midpoint = false;
+		bool reflect_midpoint = false;
+
+		if (timestepping_order == 2)
+		{
+			max_iterations = semi_lagrangian_max_iterations;
+
+			if (trajectory_method == E_TRAJECTORY_METHOD_CANONICAL)
+			{
+				sample_at_midpoint = true;
+			}
+			else if (trajectory_method == E_TRAJECTORY_METHOD_MIDPOINT_RITCHIE)
+			{
+				start_scale = 0.5;
+				sample_scale = 0.5;
+				reflect_midpoint = true;
+			}
+			else if (trajectory_method == E_TRAJECTORY_METHOD_SETTLS_HORTAL)
+			{
+				sample_scale = 0.5;
+				arrival_scale = 0.5;
+			}
+			else
+			{
+				SWEETError("Unknown departure point calculation method");
+			}
+		}
+
+		if (max_iterations > 0)
+		{
+			bool pseudo_points = simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points;
+
+			if (trajectory_method == E_TRAJECTORY_METHOD_SETTLS_HORTAL)
+			{
+				// Extrapolate velocities at departure points
+				sphereSampler.bilinear_prepare(2.0*i_dt_u_lon - i_u_lon_prev, true, pseudo_points, fused_sampling_data_u);
+				sphereSampler.bilinear_prepare(2.0*i_dt_v_lat - i_v_lat_prev, true, pseudo_points, fused_sampling_data_v);
+			}
+			else
+			{
+				sphereSampler.bilinear_prepare(i_dt_u_lon, true, pseudo_points, fused_sampling_data_u);
+				sphereSampler.bilinear_prepare(i_dt_v_lat, true, pseudo_points, fused_sampling_data_v);
+			}
+		}
+
+		const double *sampling_u = fused_sampling_data_u.data();
+		const double *sampling_v = fused_sampling_data_v.data();
+
+		const double *u_A = i_dt_u_lon.physical_space_data;
+		const double *v_A = i_dt_v_lat.physical_space_data;
+
+		double threshold = semi_lagrangian_convergence_threshold;
+		bool approximate_geometry = semi_lagrangian_approximate_sphere_geometry;
+
+		std::size_t num_iterations = 0;
+		std::size_t num_unconverged = 0;
+		int max_iterations_point = 0;
+		double max_diff = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for PROC_BIND_CLOSE reduction(+:num_iterations,num_unconverged) reduction(max:max_iterations_point,max_diff)
+#endif
+		for (std::size_t i = 0; i < num_elements; i++)
+		{
+			double ax = pos_x_A.scalar_data[i];
+			double ay = pos_y_A.scalar_data[i];
+			double az = pos_z_A.scalar_data[i];
+
+			// Polar => Cartesian velocities
+			double vel_x_A, vel_y_A, vel_z_A;
+			SWEETVectorMath::velocity_latlon_to_cartesian__scalar(
+					pos_lon_A.scalar_data[i], pos_lat_A.scalar_data[i],
+					u_A[i], v_A[i],
+					vel_x_A, vel_y_A, vel_z_A
+				);
+
+			double dx, dy, dz;
+			doAdvectionOnSphere__scalar(
+					ax, ay, az,
+					-start_scale*vel_x_A, -start_scale*vel_y_A, -start_scale*vel_z_A,
+					dx, dy, dz,
+					approximate_geometry
+				);
+
+			int iters = 0;
+			double diff = -1;
+			for (; iters < max_iterations; iters++)
+			{
+				// position to sample velocities
+				double px = dx, py = dy, pz = dz;
+				if (sample_at_midpoint)
+				{
+					px = 0.5*(ax + dx);
+					py = 0.5*(ay + dy);
+					pz = 0.5*(az + dz);
+				}
+
+				double lon, lat;
+				SWEETVectorMath::point_cartesian_to_latlon__scalar(px, py, pz, lon, lat);
+
+				double u = sphereSampler.bilinear_scalar__point(sampling_u, lon, lat);
+				double v = sphereSampler.bilinear_scalar__point(sampling_v, lon, lat);
+
+				double vel_x, vel_y, vel_z;
+				SWEETVectorMath::velocity_latlon_to_cartesian__scalar(lon, lat, u, v, vel_x, vel_y, vel_z);
+
+				double new_dx, new_dy, new_dz;
+				doAdvectionOnSphere__scalar(
+						ax, ay, az,
+						-(sample_scale*vel_x + arrival_scale*vel_x_A),
+						-(sample_scale*vel_y + arrival_scale*vel_y_A),
+						-(sample_scale*vel_z + arrival_scale*vel_z_A),
+						new_dx, new_dy, new_dz,
+						approximate_geometry
+					);
+
+				diff = std::abs(dx-new_dx) + std::abs(dy-new_dy) + std::abs(dz-new_dz);
+
+				dx = new_dx;
+				dy = new_dy;
+				dz = new_dz;
+
+				if (diff < threshold)
+				{
+					iters++;
+					break;
+				}
+			}
+
+			num_iterations += iters;
+			max_iterations_point = std::max(max_iterations_point, iters);
+
+			if (threshold > 0 && diff > threshold)
+			{
+				num_unconverged++;
+				max_diff = std::max(max_diff, diff);
+			}
+
+			if (reflect_midpoint)
+			{
+				// Given the midpoint, we compute the full time step
+				double dot2 = 2.0*(dx*ax + dy*ay + dz*az);
+
+				dx = dot2*dx - ax;
+				dy = dot2*dy - ay;
+				dz = dot2*dz - az;
+			}
+
+			// convert final points from Cartesian space to angular space
+			SWEETVectorMath::point_cartesian_to_latlon__scalar(
+					dx, dy, dz,
+					o_pos_lon_D.scalar_data[i], o_pos_lat_D.scalar_data[i]
+				);
+		}
+
+		if (num_unconverged > 0)
+		{
+			std::cout << "WARNING: Over convergence tolerance" << std::endl;
+			std::cout << "+ maxAbs: " << max_diff << std::endl;
+			std::cout << "+ Convergence tolerance: " << semi_lagrangian_convergence_threshold << std::endl;
+			std::cout << "+ Unconverged departure points: " << num_unconverged << std::endl;
+		}
+
+		departure_points_stats.num_calls++;
+		departure_points_stats.num_points += num_elements;
+		departure_points_stats.num_iterations += num_iterations;
+		departure_points_stats.max_iterations = std::max(departure_points_stats.max_iterations, max_iterations_point);
+		departure_points_stats.num_unconverged += num_unconverged;
+	}
+
+
+
 	/*
 	 * Compute SL departure points on unit sphere for given dt*(u,v) velocities
 	 *
@@ -307,6 +632,16 @@ public:
 		ScalarDataArray &o_pos_lat_D
 	)
 	{
+		if (semi_lagrangian_fused_departure_points)
+		{
+			semi_lag_departure_points_fused(
+					i_u_lon_prev, i_v_lat_prev,
+					i_dt_u_lon, i_dt_v_lat,
+					o_pos_lon_D, o_pos_lat_D
+				);
+			return;
+		}
+
 		o_pos_lon_D.setup_if_required(pos_lon_A);
 		o_pos_lat_D.setup_if_required(pos_lon_A);
 
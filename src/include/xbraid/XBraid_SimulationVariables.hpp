@@ -178,6 +178,31 @@ struct XBraid_SimulationVariables
 	 */
 	int xbraid_spatial_coarsening = 0;
 
+	/**
+	 * Number of thread groups to process independent time points
+	 * within one rank concurrently with OpenMP tasks.
+	 * The threads are distributed equally among the groups
+	 * for the spatial parallelization.
+	 */
+	int xbraid_thread_groups = 1;
+
+	/**
+	 * Fidelity levels of the time steppers on the coarse levels used in the
+	 * first iterations, starting with the cheapest one, e.g. "rexi_ci_n=32,rexi_ci_n=64".
+	 * The configured time steppers are used as the last level.
+	 */
+	std::string xbraid_coarse_fidelity_levels = "";
+
+	/**
+	 * Raise fidelity if the residual is below this factor times the tolerance
+	 */
+	double xbraid_coarse_fidelity_switch_factor = 10;
+
+	/**
+	 * Raise fidelity if the residual is reduced by less than this rate in one iteration
+	 */
+	double xbraid_coarse_fidelity_max_rate = 0.5;
+
 
 	void outputConfig()
 	{
@@ -217,6 +242,10 @@ struct XBraid_SimulationVariables
 		std::cout << " + xbraid_path_fine_csv_files: "          << xbraid_path_fine_csv_files          << std::endl;
 		std::cout << " + xbraid_store_iterations: "             << xbraid_store_iterations             << std::endl;
 		std::cout << " + xbraid_spatial_coarsening: "           << xbraid_spatial_coarsening           << std::endl;
+		std::cout << " + xbraid_thread_groups: "                << xbraid_thread_groups                << std::endl;
+		std::cout << " + xbraid_coarse_fidelity_levels: "       << xbraid_coarse_fidelity_levels       << std::endl;
+		std::cout << " + xbraid_coarse_fidelity_switch_factor: " << xbraid_coarse_fidelity_switch_factor << std::endl;
+		std::cout << " + xbraid_coarse_fidelity_max_rate: "     << xbraid_coarse_fidelity_max_rate     << std::endl;
 	}
 
 	void printOptions()
@@ -257,6 +286,10 @@ struct XBraid_SimulationVariables
 		std::cout << "	--xbraid-path-fine-csv-files [string]        XBraid parameter path_fine_csv_files, default: ''"         << std::endl;
 		std::cout << "	--xbraid-store-iterations [0/1]              XBraid parameter store_iterations, default: 0"             << std::endl;
 		std::cout << "	--xbraid-spatial-coarsening [0/1]            XBraid parameter spatial_coarsening, default: 0"           << std::endl;
+		std::cout << "	--xbraid-thread-groups [int]                 Number of thread groups for time points within a rank, default: 1" << std::endl;
+		std::cout << "	--xbraid-coarse-fidelity-levels [string]     Cheaper time steppers on coarse levels for the first iterations, e.g. rexi_ci_n=32, default: ''" << std::endl;
+		std::cout << "	--xbraid-coarse-fidelity-switch-factor [float] Raise coarse fidelity if residual < factor*tol, default: 10" << std::endl;
+		std::cout << "	--xbraid-coarse-fidelity-max-rate [float]    Raise coarse fidelity if residual is reduced by less than this rate, default: 0.5" << std::endl;
 		std::cout << ""                                                                                                         << std::endl;
 	}
 
@@ -368,6 +401,18 @@ struct XBraid_SimulationVariables
 		io_long_options[io_next_free_program_option] = {"xbraid-spatial-coarsening", required_argument, 0, 256+io_next_free_program_option};
 		io_next_free_program_option++;
 
+		io_long_options[io_next_free_program_option] = {"xbraid-thread-groups", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"xbraid-coarse-fidelity-levels", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"xbraid-coarse-fidelity-switch-factor", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
+		io_long_options[io_next_free_program_option] = {"xbraid-coarse-fidelity-max-rate", required_argument, 0, 256+io_next_free_program_option};
+		io_next_free_program_option++;
+
 	}
 	
 	/**
@@ -416,8 +461,12 @@ struct XBraid_SimulationVariables
 			case 31: xbraid_path_fine_csv_files       = optarg;		return -1;
 			case 32: xbraid_store_iterations          = atoi(optarg);	return -1;
 			case 33: xbraid_spatial_coarsening        = atoi(optarg);	return -1;
+			case 34: xbraid_thread_groups             = atoi(optarg);	return -1;
+			case 35: xbraid_coarse_fidelity_levels    = optarg;		return -1;
+			case 36: xbraid_coarse_fidelity_switch_factor = atof(optarg);	return -1;
+			case 37: xbraid_coarse_fidelity_max_rate  = atof(optarg);	return -1;
 		}
-		return 34;
+		return 38;
 	}
 
 };
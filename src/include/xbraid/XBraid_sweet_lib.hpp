@@ -11,8 +11,13 @@
 
 #include <braid.hpp>
 #include <common_pint/PInT_Common.hpp>
+#include <common_pint/PInT_CoarseFidelity.hpp>
 #include <parareal/Parareal_GenericData.hpp>
 
+#if SWEET_THREADING
+#include <omp.h>
+#endif
+
 #if SWEET_XBRAID_SCALAR
 	#include <parareal/Parareal_GenericData_Scalar.hpp>
 	#include "src/programs/ode_scalar_timeintegrators/ODE_Scalar_TimeSteppers.hpp"
@@ -250,6 +255,25 @@ public:
 	// Effective number of levels
 	int nlevels = -1;
 
+	// Time steppers and simulation variables of each thread group (group 0 uses timeSteppers and simVars_levels)
+	std::vector<std::vector<t_tsmType*>> timeSteppers_thread_groups;
+	std::vector<std::vector<SimulationVariables*>> simVars_levels_thread_groups;
+
+	// Number of thread groups and threads for the spatial parallelization of each group
+	int thread_groups = 1;
+	int threads_per_group = 1;
+
+	// Adaptive fidelity of the time steppers on the coarse levels
+	PInT_CoarseFidelity coarseFidelity;
+
+	// Time steppers and simulation variables of each fidelity level: [fidelity][group][level]
+	// The last fidelity level and level 0 use the configured time steppers.
+	std::vector<std::vector<std::vector<t_tsmType*>>> timeSteppers_fidelity;
+	std::vector<std::vector<std::vector<SimulationVariables*>>> simVars_levels_fidelity;
+
+	// Last iteration in which the coarse fidelity was updated
+	int coarse_fidelity_iter = -1;
+
 public:
 
 	// Constructor·
@@ -303,6 +327,17 @@ public:
 
 	virtual ~sweet_BraidApp()
 	{
+		// restore configured time steppers before releasing them
+		if (this->timeSteppers_fidelity.size() > 0)
+			this->set_coarse_fidelity(this->coarseFidelity.num_levels() - 1);
+
+		for (std::size_t f = 0; f + 1 < this->timeSteppers_fidelity.size(); f++)
+			for (std::size_t g = 0; g < this->timeSteppers_fidelity[f].size(); g++)
+				for (std::size_t level = 1; level < this->timeSteppers_fidelity[f][g].size(); level++)
+				{
+					delete this->timeSteppers_fidelity[f][g][level];
+					delete this->simVars_levels_fidelity[f][g][level];
+				}
 
 		for (std::vector<t_tsmType*>::iterator it = this->timeSteppers.begin();
 							it != this->timeSteppers.end();
@@ -313,6 +348,13 @@ public:
 				*it = nullptr;
 			}
 
+		for (std::size_t g = 1; g < this->timeSteppers_thread_groups.size(); g++)
+			for (std::size_t level = 0; level < this->timeSteppers_thread_groups[g].size(); level++)
+			{
+				delete this->timeSteppers_thread_groups[g][level];
+				delete this->simVars_levels_thread_groups[g][level];
+			}
+
 		for (std::vector<sweet_BraidVector*>::iterator it = this->xbraid_data_ref_exact.begin();
 								it != this->xbraid_data_ref_exact.end();
 								it++)
@@ -415,6 +457,117 @@ public:
 		this->setup();
 	}
 
+
+	/*
+	 * Run XBraid
+	 *
+	 * With more than one thread group, XBraid is executed by the master
+	 * thread of a team with one thread per group. Time steps and vector
+	 * operations are then deferred to OpenMP tasks with dependencies on
+	 * the vectors they access. Independent time points (e.g. the F-points
+	 * of different C-intervals during F-relaxation) are therefore processed
+	 * concurrently by the thread groups while each chain of time steps is
+	 * kept in order. Each task uses threads_per_group threads in space.
+	 *
+	 * Only the master thread calls XBraid and MPI.
+	 */
+	void drive(
+			BraidCore& i_core
+	)
+	{
+#if SWEET_THREADING
+		if (this->thread_groups > 1)
+		{
+			this->threads_per_group = std::max(1, omp_get_max_threads()/this->thread_groups);
+
+			int max_active_levels = omp_get_max_active_levels();
+			omp_set_max_active_levels(2);
+
+#pragma omp parallel num_threads(this->thread_groups) proc_bind(spread)
+#pragma omp master
+			{
+				// inherited by all tasks created by this thread
+				omp_set_num_threads(this->threads_per_group);
+
+				i_core.Drive();
+			}
+
+			omp_set_max_active_levels(max_active_levels);
+			return;
+		}
+#endif
+
+		i_core.Drive();
+	}
+
+private:
+	/*
+	 * Wait for all deferred time steps and vector operations
+	 * before vectors are accessed outside of tasks
+	 */
+	void sync_tasks()
+	{
+#if SWEET_THREADING
+		if (this->thread_groups > 1)
+		{
+#pragma omp taskwait
+		}
+#endif
+	}
+
+public:
+
+private:
+	/*
+	 * Create timestepper for a level with the given simulation variables
+	 */
+	t_tsmType* create_timestepper(
+			int i_level,
+			SimulationVariables* i_simVars_level
+	)
+	{
+		int level = i_level;
+
+#if SWEET_XBRAID_SCALAR
+		ODE_Scalar_TimeSteppers* tsm = new ODE_Scalar_TimeSteppers;
+		tsm->setup(
+				*i_simVars_level
+			);
+#elif SWEET_XBRAID_PLANE
+	#if SWEET_XBRAID_PLANE_SWE
+		SWE_Plane_TimeSteppers* tsm = new SWE_Plane_TimeSteppers;
+		tsm->setup(
+				tsms[level],
+				i_simVars_level->disc.timestepping_order,
+				i_simVars_level->disc.timestepping_order2,
+				*this->op_plane[level],
+				*i_simVars_level
+			);
+	#elif SWEET_XBRAID_PLANE_BURGERS
+		Burgers_Plane_TimeSteppers* tsm = new Burgers_Plane_TimeSteppers;
+		tsm->setup(
+				tsms[level],
+				i_simVars_level->disc.timestepping_order,
+				i_simVars_level->disc.timestepping_order2,
+				*this->op_plane[level],
+				*i_simVars_level
+			);
+	#endif
+#elif SWEET_XBRAID_SPHERE
+
+		SWE_Sphere_TimeSteppers* tsm = new SWE_Sphere_TimeSteppers;
+		tsm->setup(
+					tsms[level],
+					*this->op_sphere[level],
+					*i_simVars_level
+				);
+
+#endif
+
+		return tsm;
+	}
+
+
 public:
 	/*
 	 * Setup timesteppers for each level.
@@ -453,41 +606,7 @@ public:
 
 			std::cout << "Timestep size at level " << level << " : " << this->simVars_levels[level]->timecontrol.current_timestep_size << std::endl;
 
-#if SWEET_XBRAID_SCALAR
-			ODE_Scalar_TimeSteppers* tsm = new ODE_Scalar_TimeSteppers;
-			tsm->setup(
-					*this->simVars_levels[level]
-				);
-#elif SWEET_XBRAID_PLANE
-	#if SWEET_XBRAID_PLANE_SWE
-			SWE_Plane_TimeSteppers* tsm = new SWE_Plane_TimeSteppers;
-			tsm->setup(
-					tsms[level],
-					tsos[level],
-					tsos2[level],
-					*this->op_plane[level],
-					*this->simVars_levels[level]
-				);
-	#elif SWEET_XBRAID_PLANE_BURGERS
-			Burgers_Plane_TimeSteppers* tsm = new Burgers_Plane_TimeSteppers;
-			tsm->setup(
-					tsms[level],
-					tsos[level],
-					tsos2[level],
-					*this->op_plane[level],
-					*this->simVars_levels[level]
-				);
-	#endif
-#elif SWEET_XBRAID_SPHERE
-
-			SWE_Sphere_TimeSteppers* tsm = new SWE_Sphere_TimeSteppers;
-			tsm->setup(
-						tsms[level],
-						*this->op_sphere[level],
-						*this->simVars_levels[level]
-					);
-
-#endif
+			t_tsmType* tsm = this->create_timestepper(level, this->simVars_levels[level]);
 
 			// get back the original timestep size
 			////////this->simVars->timecontrol.current_timestep_size = dt;
@@ -509,6 +628,128 @@ public:
 			}
 		}
 
+		/*
+		 * Setup time steppers for each thread group
+		 *
+		 * The time steppers store the state of the time integration
+		 * (e.g. the previous solution for SL methods), hence each group
+		 * requires its own copies. Operators and data configs are shared.
+		 * Cached operators (e.g. for implicit diffusion) are shared
+		 * through a synchronized cache, hence they can be called concurrently.
+		 */
+		this->timeSteppers_thread_groups.push_back(this->timeSteppers);
+		this->simVars_levels_thread_groups.push_back(this->simVars_levels);
+
+		for (int g = 1; g < this->thread_groups; g++)
+		{
+			std::vector<t_tsmType*> tsm_group;
+			std::vector<SimulationVariables*> simVars_group;
+
+			for (int level = 0; level < this->simVars->xbraid.xbraid_max_levels; level++)
+			{
+				simVars_group.push_back(new SimulationVariables(*this->simVars_levels[level]));
+				tsm_group.push_back(this->create_timestepper(level, simVars_group[level]));
+			}
+
+			this->timeSteppers_thread_groups.push_back(tsm_group);
+			this->simVars_levels_thread_groups.push_back(simVars_group);
+		}
+
+		/*
+		 * Setup time steppers on the coarse levels for each fidelity level
+		 */
+		if (this->coarseFidelity.enabled())
+		{
+			for (int f = 0; f < this->coarseFidelity.num_levels() - 1; f++)
+			{
+				std::vector<std::vector<t_tsmType*>> tsm_fidelity;
+				std::vector<std::vector<SimulationVariables*>> simVars_fidelity;
+
+				for (int g = 0; g < this->thread_groups; g++)
+				{
+					// finest level is never changed
+					std::vector<t_tsmType*> tsm_group = {this->timeSteppers_thread_groups[g][0]};
+					std::vector<SimulationVariables*> simVars_group = {this->simVars_levels_thread_groups[g][0]};
+
+					for (int level = 1; level < this->simVars->xbraid.xbraid_max_levels; level++)
+					{
+						SimulationVariables* simVars_level = new SimulationVariables(*this->simVars_levels_thread_groups[g][level]);
+						this->coarseFidelity.apply(f, *simVars_level);
+
+						simVars_group.push_back(simVars_level);
+						tsm_group.push_back(this->create_timestepper(level, simVars_level));
+					}
+
+					tsm_fidelity.push_back(tsm_group);
+					simVars_fidelity.push_back(simVars_group);
+				}
+
+				this->timeSteppers_fidelity.push_back(tsm_fidelity);
+				this->simVars_levels_fidelity.push_back(simVars_fidelity);
+			}
+
+			this->timeSteppers_fidelity.push_back(this->timeSteppers_thread_groups);
+			this->simVars_levels_fidelity.push_back(this->simVars_levels_thread_groups);
+
+			this->set_coarse_fidelity(0);
+		}
+	}
+
+private:
+	/*
+	 * Use the time steppers of the given fidelity level on all coarse levels
+	 */
+	void set_coarse_fidelity(
+			int i_fidelity
+	)
+	{
+		for (std::size_t g = 0; g < this->timeSteppers_thread_groups.size(); g++)
+		{
+			this->timeSteppers_thread_groups[g] = this->timeSteppers_fidelity[i_fidelity][g];
+			this->simVars_levels_thread_groups[g] = this->simVars_levels_fidelity[i_fidelity][g];
+		}
+	}
+
+	/*
+	 * Raise the fidelity of the time steppers on the coarse levels
+	 * if required by the residual of the last iteration.
+	 *
+	 * The residual norms are global, hence all ranks switch consistently.
+	 * The coarse grid correction is recomputed in each iteration,
+	 * hence no further data has to be updated.
+	 *
+	 * The stored SL previous solutions (sol_prev) remain valid since the
+	 * time step sizes of the coarse levels can't be changed by the fidelity
+	 * levels (see setup()).
+	 */
+	void update_coarse_fidelity(
+			BraidStepStatus&	io_status
+	)
+	{
+		int iter;
+		io_status.GetIter(&iter);
+
+		if (iter <= this->coarse_fidelity_iter)
+			return;
+		this->coarse_fidelity_iter = iter;
+
+		int nrequest = -1;
+		double rnorm = -1;
+		io_status.GetRNorms(&nrequest, &rnorm);
+
+		if (nrequest < 1 || rnorm < 0)
+			return;
+
+		if (!this->coarseFidelity.update(rnorm, this->simVars->xbraid.xbraid_tol))
+			return;
+
+		if (this->rank == 0)
+			std::cout << "Switching to coarse fidelity level " << this->coarseFidelity.current_level << " with residual " << rnorm << std::endl;
+
+		// pending time steps still use the current time steppers
+		this->sync_tasks();
+
+		this->set_coarse_fidelity(this->coarseFidelity.current_level);
 	}
 
 public:
@@ -517,6 +758,33 @@ public:
 
 		PInT_Common::setup();
 
+		this->thread_groups = this->simVars->xbraid.xbraid_thread_groups;
+
+		if (this->thread_groups < 1)
+			SWEETError("Number of XBraid thread groups must be at least 1");
+
+#if !SWEET_THREADING
+		if (this->thread_groups > 1)
+			SWEETError("XBraid thread groups require threading to be enabled");
+#endif
+
+		this->coarseFidelity.setup(
+				this->simVars->xbraid.xbraid_coarse_fidelity_levels,
+				this->simVars->xbraid.xbraid_coarse_fidelity_switch_factor,
+				this->simVars->xbraid.xbraid_coarse_fidelity_max_rate
+			);
+
+		// time step sizes of the coarse levels are given by the coarsening factor
+		for (int f = 0; f < this->coarseFidelity.num_levels(); f++)
+			if (this->coarseFidelity.levels[f].timestep_size > 0)
+				SWEETError("Time step size can't be changed for XBraid coarse fidelity levels");
+
+		if (this->coarseFidelity.enabled() && this->rank == 0)
+		{
+			std::cout << "Coarse fidelity levels:" << std::endl;
+			this->coarseFidelity.outputConfig();
+		}
+
 
 
 		// get buffer size
@@ -743,8 +1011,13 @@ public:
 	}
 
 private:
-	void store_prev_solution(
-					sweet_BraidVector* i_U,
+	/*
+	 * Return the container to store the solution at i_time_id for SL
+	 * or nullptr if nothing has to be stored.
+	 *
+	 * The solution itself is copied by the caller (possibly in a task).
+	 */
+	sweet_BraidVector* get_prev_solution_store(
 					int i_time_id,
 					int i_level,
 					int iter
@@ -753,26 +1026,32 @@ private:
 		// if not SL scheme: nothing to do
 		//if ( std::find(this->SL_tsm.begin(), this->SL_tsm.end(), this->tsms[i_level]) == this->SL_tsm.end())
 		if ( ! this->is_SL[i_level] )
-			return;
+			return nullptr;
 
 		// if solution has already been stored in this iteration: nothing to do
 		if ( this->sol_prev_iter[i_level][i_time_id] == iter )
-			return;
+			return nullptr;
 		///assert(this->sol_prev_iter[i_level][i_time_id] == iter - 1);
 
 		// create vector if necessary
 		if ( ! this->sol_prev[i_level][i_time_id] )
+		{
+			MemBlockAllocTag memTag("xbraid_sol_prev");
 			this->sol_prev[i_level][i_time_id] = this->create_new_vector(i_level);
+		}
 
-		// set solution
-		*this->sol_prev[i_level][i_time_id] = *i_U;
 		this->sol_prev_iter[i_level][i_time_id] = iter;
 		this->first_timeid_level[i_level] = std::min(first_timeid_level[i_level], i_time_id);
 		this->last_timeid_level[i_level] = std::max(last_timeid_level[i_level], i_time_id);
+
+		return this->sol_prev[i_level][i_time_id];
 	}
 
-	void set_prev_solution(
-					sweet_BraidVector* i_U,
+	/*
+	 * Return the previous solution for SL time steps starting at i_time_id
+	 * or nullptr if the solution itself has to be used.
+	 */
+	sweet_BraidVector* get_prev_solution(
 					int i_time_id,
 					int i_level
 				)
@@ -781,7 +1060,7 @@ private:
 		// if not SL scheme: nothing to do
 		///if (  std::find(this->SL_tsm.begin(), this->SL_tsm.end(), this->tsms[i_level]) == this->SL_tsm.end())
 		if ( ! this->is_SL[i_level] )
-			return;
+			return nullptr;
 
 		// if t == 0 or prev solution not available
 		// then: prev_solution = solution
@@ -798,9 +1077,107 @@ private:
 			prev_sol_exists = false;
 
 		if (prev_sol_exists)
-			this->timeSteppers[i_level]->master->set_previous_solution(this->sol_prev[i_level][i_time_id - 1]->data);
+			return this->sol_prev[i_level][i_time_id - 1];
+
+		return nullptr;
+	}
+
+private:
+	/*
+	 * Time step of U from tstart to tstop on the given level
+	 * with the time steppers of the given thread group
+	 *
+	 * \param i_U_prev		previous solution for SL methods (nullptr: use U)
+	 * \param o_U_store_start	store solution at tstart for SL methods (nullptr: not stored)
+	 * \param o_U_store_stop	store solution at tstop for SL methods (nullptr: not stored)
+	 */
+	void run_timestep_level(
+			sweet_BraidVector*	U,
+			sweet_BraidVector*	i_U_prev,
+			sweet_BraidVector*	o_U_store_start,
+			sweet_BraidVector*	o_U_store_stop,
+			double			tstart,
+			double			tstop,
+			int			level,
+			int			i_group
+	)
+	{
+		t_tsmType* tsm = this->timeSteppers_thread_groups[i_group][level];
+
+		// Vector defined in the current level (defined via interpolation if necessary)
+		sweet_BraidVector* U_level = this->create_new_vector(level);
+
+		// Interpolate to coarser grid in space if necessary
+		if (this->simVars->xbraid.xbraid_spatial_coarsening && level > 0)
+		/////if (this->simVars->xbraid.xbraid_spatial_coarsening)
+			U_level->data->restrict(*U->data);
+		else
+			*U_level->data = *U->data;
+
+		// store solution for SL
+		if (o_U_store_start)
+			*o_U_store_start = *U_level;
+
+		// set prev solution for SL
+		if (this->is_SL[level])
+			tsm->master->set_previous_solution(i_U_prev ? i_U_prev->data : U_level->data);
+
+		// each thread group has its own copies of the SimulationVariables of all levels
+		SimulationVariables* simVars_level = this->simVars_levels_thread_groups[i_group][level];
+		simVars_level->timecontrol.current_simulation_time = tstart;
+		simVars_level->timecontrol.current_timestep_size = tstop - tstart;
+
+		///std::cout << rank << " " << iter << " " << level << " " << tstart << " " << tstop << std::endl;
+		tsm->master->run_timestep(
+								U_level->data,
+								tstop - tstart,
+								tstart
+		);
+
+
+		// Apply viscosity at posteriori, for all methods explicit diffusion for non spectral schemes and implicit for spectral
+		// The diffusion operators are shared by all thread groups through the synchronized operator cache
+		///if (simVars->sim.viscosity != 0 && simVars->misc.use_nonlinear_only_visc == 0)
+		if (this->viscosity_coefficients[level] != 0 && simVars->misc.use_nonlinear_only_visc == 0)
+		{
+#if SWEET_XBRAID_PLANE
+			for (int i = 0; i < N; i++)
+			{
+				PlaneData_Spectral* field = U_level->data->get_pointer_to_data_PlaneData_Spectral()->simfields[i];
+				*field = this->op_plane[level]->implicit_diffusion(	*field,
+											(tstop - tstart) * this->viscosity_coefficients[level],
+											this->viscosity_orders[level]);
+											///(tstop - tstart) * this->simVars->sim.viscosity,
+											///this->simVars->sim.viscosity_order);
+			}
+#elif SWEET_XBRAID_SPHERE
+			for (int i = 0; i < N; i++)
+			{
+				SphereData_Spectral* field = U_level->data->get_pointer_to_data_SphereData_Spectral()->simfields[i];
+				///*field = this->op_sphere[level]->implicit_diffusion(	*field,
+				///							(tstop - tstart) * this->viscosity_coefficients[level],
+				///							///(tstop - tstart) * this->simVars->sim.viscosity,
+				///							this->simVars->sim.sphere_radius);
+				*field = this->op_sphere[level]->implicit_hyperdiffusion(	*field,
+												(tstop - tstart) * this->viscosity_coefficients[level],
+												///(tstop - tstart) * this->simVars->sim.viscosity,
+												this->viscosity_orders[level],
+												this->simVars->sim.sphere_radius);
+			}
+#endif
+		}
+
+		if (o_U_store_stop)
+			*o_U_store_stop = *U_level;
+
+		// Interpolate to finest grid in space if necessary
+		if (this->simVars->xbraid.xbraid_spatial_coarsening && level > 0)
+		/////if (this->simVars->xbraid.xbraid_spatial_coarsening)
+			U->data->pad_zeros(*U_level->data);
 		else
-			this->timeSteppers[i_level]->master->set_previous_solution(i_U->data);
+			*U->data = *U_level->data;
+
+		delete U_level;
 	}
 
 public:
@@ -840,6 +1217,9 @@ public:
 			io_status.GetNLevels(&this->nlevels);
 		}
 
+		if (this->coarseFidelity.enabled())
+			this->update_coarse_fidelity(io_status);
+
 
 
 		// Vector defined in the finest level
@@ -857,17 +1237,6 @@ public:
 		io_status.GetTIndex(&time_id);
 		io_status.GetIter(&iter);
 
-		// Vector defined in the current level (defined via interpolation if necessary)
-		sweet_BraidVector* U_level = this->create_new_vector(level);
-
-		// Interpolate to coarser grid in space if necessary
-		if (this->simVars->xbraid.xbraid_spatial_coarsening && level > 0)
-		/////if (this->simVars->xbraid.xbraid_spatial_coarsening)
-			U_level->data->restrict(*U->data);
-		else
-			*U_level->data = *U->data;
-
-
 		// create containers for prev solution
 		if (this->sol_prev[level].size() == 0)
 		{
@@ -882,71 +1251,37 @@ public:
 				///this->sol_prev[level].push_back(this->create_new_vector());
 		}
 
-		// store solution for SL
+		/*
+		 * Bookkeeping of SL solutions follows the order of the calls by XBraid,
+		 * only the data is copied in the time step
+		 */
+		sweet_BraidVector* U_store_start = nullptr;
 		if (time_id == 0)
-			this->store_prev_solution(U_level, time_id, level, iter);
+			U_store_start = this->get_prev_solution_store(time_id, level, iter);
 
-		// set prev solution for SL
-		this->set_prev_solution(U_level, time_id, level);
+		sweet_BraidVector* U_prev = this->get_prev_solution(time_id, level);
+		sweet_BraidVector* U_store_stop = this->get_prev_solution_store(time_id + 1, level, iter);
 
-		// TODO: check if this is thread safe
-		/////this->simVars->timecontrol.current_simulation_time = tstart;
-		/////this->simVars->timecontrol.current_timestep_size = tstop - tstart;
-		// TODO
+#if SWEET_THREADING
+		// vectors for dependencies of tasks (U if not used)
+		sweet_BraidVector* dep_prev = U_prev ? U_prev : U;
+		sweet_BraidVector* dep_store_start = U_store_start ? U_store_start : U;
+		sweet_BraidVector* dep_store_stop = U_store_stop ? U_store_stop : U;
 
-		///std::cout << rank << " " << iter << " " << level << " " << tstart << " " << tstop << std::endl;
-		this->timeSteppers[level]->master->run_timestep(
-								U_level->data,
-								tstop - tstart,
-								tstart
-		);
-
-
-		// Apply viscosity at posteriori, for all methods explicit diffusion for non spectral schemes and implicit for spectral
-		///if (simVars->sim.viscosity != 0 && simVars->misc.use_nonlinear_only_visc == 0)
-		if (this->viscosity_coefficients[level] != 0 && simVars->misc.use_nonlinear_only_visc == 0)
+#pragma omp task if(this->thread_groups > 1) depend(inout: U[0]) depend(in: *dep_prev) depend(out: *dep_store_start, *dep_store_stop)
+#endif
 		{
-#if SWEET_XBRAID_PLANE
-			for (int i = 0; i < N; i++)
-			{
-				PlaneData_Spectral* field = U_level->data->get_pointer_to_data_PlaneData_Spectral()->simfields[i];
-				*field = this->op_plane[level]->implicit_diffusion(	*field,
-											(tstop - tstart) * this->viscosity_coefficients[level],
-											this->viscosity_orders[level]);
-											///(tstop - tstart) * this->simVars->sim.viscosity,
-											///this->simVars->sim.viscosity_order);
-			}
-#elif SWEET_XBRAID_SPHERE
-			for (int i = 0; i < N; i++)
-			{
-				SphereData_Spectral* field = U_level->data->get_pointer_to_data_SphereData_Spectral()->simfields[i];
-				///*field = this->op_sphere[level]->implicit_diffusion(	*field,
-				///							(tstop - tstart) * this->viscosity_coefficients[level],
-				///							///(tstop - tstart) * this->simVars->sim.viscosity,
-				///							this->simVars->sim.sphere_radius);
-				*field = this->op_sphere[level]->implicit_hyperdiffusion(	*field,
-												(tstop - tstart) * this->viscosity_coefficients[level],
-												///(tstop - tstart) * this->simVars->sim.viscosity,
-												this->viscosity_orders[level],
-												this->simVars->sim.sphere_radius);
-			}
+			int group = 0;
+#if SWEET_THREADING
+			if (this->thread_groups > 1)
+				group = omp_get_thread_num();
 #endif
+			this->run_timestep_level(U, U_prev, U_store_start, U_store_stop, tstart, tstop, level, group);
 		}
 
-		this->store_prev_solution(U_level, time_id + 1, level, iter);
-
-		// Interpolate to finest grid in space if necessary
-		if (this->simVars->xbraid.xbraid_spatial_coarsening && level > 0)
-		/////if (this->simVars->xbraid.xbraid_spatial_coarsening)
-			U->data->pad_zeros(*U_level->data);
-		else
-			*U->data = *U_level->data;
-
 		/* Tell XBraid no refinement */
 		io_status.SetRFactor(1);
 
-		delete U_level;
-
 		return 0;
 	}
 
@@ -994,6 +1329,9 @@ public:
 			)
 	{
 
+		// simulation variables of the time steppers may be modified
+		this->sync_tasks();
+
 		sweet_BraidVector* U = create_new_vector(0);
 
 	// Set correct resolution in SimVars
@@ -1300,7 +1638,12 @@ public:
 	{
 		sweet_BraidVector* U = (sweet_BraidVector*) i_U;
 		sweet_BraidVector* V = create_new_vector(U->level);
+
+#if SWEET_THREADING
+#pragma omp task if(this->thread_groups > 1) depend(in: U[0]) depend(out: V[0])
+#endif
 		*V = *U;
+
 		*o_V = (braid_Vector) V;
 
 		return 0;
@@ -1315,6 +1658,10 @@ public:
 			braid_Vector	i_U)
 	{
 		sweet_BraidVector* U = (sweet_BraidVector*) i_U;
+
+#if SWEET_THREADING
+#pragma omp task if(this->thread_groups > 1) depend(inout: U[0])
+#endif
 		delete U;
 
 		return 0;
@@ -1336,6 +1683,9 @@ public:
 		sweet_BraidVector* X = (sweet_BraidVector*) i_X;
 		sweet_BraidVector* Y = (sweet_BraidVector*) io_Y;
 
+#if SWEET_THREADING
+#pragma omp task if(this->thread_groups > 1) depend(in: X[0]) depend(inout: Y[0])
+#endif
 		*Y = *X * i_alpha + *Y * i_beta;
 
 		return 0;
@@ -1364,6 +1714,8 @@ public:
 
 		sweet_BraidVector *U = (sweet_BraidVector*) i_U;
 
+		this->sync_tasks();
+
 		/* Retrieve current time from Status Object */
 		////braid_AccessStatusGetT(astatus, &t);
 		io_astatus.GetT(&t);
@@ -1496,6 +1848,9 @@ public:
 			double*       o_norm)
 	{
 		sweet_BraidVector* U = (sweet_BraidVector*) i_U;
+
+		this->sync_tasks();
+
 		///*o_norm = U->data->reduce_norm2();
 		/////std::cout << "MIN SPECTRAL " << this->min_spectral_size << std::endl;
 		/////*o_norm = U->data->spectral_reduce_maxAbs(this->min_spectral_size);
@@ -1557,6 +1912,8 @@ public:
 
 		sweet_BraidVector* U = (sweet_BraidVector*) i_U;
 
+		this->sync_tasks();
+
 #if SWEET_XBRAID_SCALAR
 		double* dbuffer = (double*) o_buffer;
 #else
@@ -3,6 +3,7 @@
  */
 
 #include "../advection_sphere_timeintegrators/SphereAdvection_TS_na_sl.hpp"
+#include <cstring>
 
 
 
@@ -34,6 +35,115 @@ std::string SphereAdvection_TS_na_sl::get_help()
 
 
 
+bool SphereAdvection_TS_na_sl::is_bitwise_equal(
+		const SphereData_Physical &i_a,
+		const SphereData_Physical &i_b
+)
+{
+	if (i_a.sphereDataConfig == nullptr || i_b.sphereDataConfig == nullptr)
+		return false;
+
+	std::size_t n = i_a.sphereDataConfig->physical_array_data_number_of_elements;
+
+	if (n != (std::size_t)i_b.sphereDataConfig->physical_array_data_number_of_elements)
+		return false;
+
+	return std::memcmp(i_a.physical_space_data, i_b.physical_space_data, sizeof(double)*n) == 0;
+}
+
+
+
+/*
+ * Compute departure points and setup the interpolation plan
+ *
+ * For stationary velocities, both are reused if neither the velocities
+ * nor the time step size changed since the last call.
+ */
+void SphereAdvection_TS_na_sl::update_departure_points(
+		const SphereData_Physical &i_U_u_prev,
+		const SphereData_Physical &i_U_v_prev,
+		const SphereData_Physical &i_U_u,
+		const SphereData_Physical &i_U_v,
+		bool i_stationary_velocities
+)
+{
+	double dt_div_radius = simVars.timecontrol.current_timestep_size / simVars.sim.sphere_radius;
+
+	if (i_stationary_velocities && departure_points_cache_valid)
+	{
+		if (
+				departure_points_cache_dt_div_radius == dt_div_radius		&&
+				is_bitwise_equal(departure_points_cache_U_u, i_U_u)			&&
+				is_bitwise_equal(departure_points_cache_U_v, i_U_v)			&&
+				is_bitwise_equal(departure_points_cache_U_u_prev, i_U_u_prev)	&&
+				is_bitwise_equal(departure_points_cache_U_v_prev, i_U_v_prev)
+		)
+		{
+			departure_points_num_reused++;
+			return;
+		}
+	}
+
+	semiLagrangian.semi_lag_departure_points_settls_specialized(
+			dt_div_radius*i_U_u_prev, dt_div_radius*i_U_v_prev,
+			dt_div_radius*i_U_u, dt_div_radius*i_U_v,
+
+			pos_lon_D, pos_lat_D
+	);
+
+	sphereSampler.bicubic_plan_setup(
+			pos_lon_D, pos_lat_D,
+			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
+			departure_points_plan
+		);
+
+	departure_points_num_updates++;
+
+	departure_points_cache_valid = i_stationary_velocities;
+	if (!departure_points_cache_valid)
+		return;
+
+	departure_points_cache_dt_div_radius = dt_div_radius;
+	departure_points_cache_U_u_prev = i_U_u_prev;
+	departure_points_cache_U_v_prev = i_U_v_prev;
+	departure_points_cache_U_u = i_U_u;
+	departure_points_cache_U_v = i_U_v;
+}
+
+
+
+/*
+ * Sample field at departure points
+ */
+SphereData_Physical SphereAdvection_TS_na_sl::sample_departure_points(
+		const SphereData_Physical &i_data,
+
+		const ScalarDataArray &i_pos_lon_D,
+		const ScalarDataArray &i_pos_lat_D,
+
+		bool i_velocity_sampling,
+		const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan
+)
+{
+	if (i_plan != nullptr)
+		return sphereSampler.bicubic_plan_apply_ret_phys(
+				*i_plan,
+				i_data,
+				i_velocity_sampling,
+				simVars.disc.semi_lagrangian_interpolation_limiter
+			);
+
+	return sphereSampler.bicubic_scalar_ret_phys(
+			i_data,
+			i_pos_lon_D, i_pos_lat_D,
+			i_velocity_sampling,
+			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
+			simVars.disc.semi_lagrangian_interpolation_limiter
+		);
+}
+
+
+
 /*
  * SL treatment of 3D Vector in Cartesian space
  */
@@ -47,7 +157,9 @@ void SphereAdvection_TS_na_sl::interpolate_departure_point_vec_3d(
 
 		SphereData_Spectral &o_vec0,
 		SphereData_Spectral &o_vec1,
-		SphereData_Spectral &o_vec2
+		SphereData_Spectral &o_vec2,
+
+		const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan
 )
 {
 	const SphereData_Config *sphereDataConfig = i_vec0.sphereDataConfig;
@@ -61,28 +173,25 @@ void SphereAdvection_TS_na_sl::interpolate_departure_point_vec_3d(
 	 */
 #if 1
 
-	SphereData_Physical u_tmp_D = sphereSampler.bicubic_scalar_ret_phys(
+	SphereData_Physical u_tmp_D = sample_departure_points(
 			o_vec0.toPhys(),
 			i_pos_lon_D, i_pos_lat_D,
 			false,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
-			simVars.disc.semi_lagrangian_interpolation_limiter
+			i_plan
 		);
 
-	SphereData_Physical v_tmp_D = sphereSampler.bicubic_scalar_ret_phys(
+	SphereData_Physical v_tmp_D = sample_departure_points(
 			o_vec1.toPhys(),
 			i_pos_lon_D, i_pos_lat_D,
 			false,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
-			simVars.disc.semi_lagrangian_interpolation_limiter
+			i_plan
 		);
 
-	SphereData_Physical w_tmp_D = sphereSampler.bicubic_scalar_ret_phys(
+	SphereData_Physical w_tmp_D = sample_departure_points(
 			o_vec2.toPhys(),
 			i_pos_lon_D, i_pos_lat_D,
 			false,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
-			simVars.disc.semi_lagrangian_interpolation_limiter
+			i_plan
 		);
 
 #else
@@ -200,7 +309,9 @@ void SphereAdvection_TS_na_sl::interpolate_departure_point_vec_uv(
 		const ScalarDataArray &i_pos_lat_D,
 
 		SphereData_Physical &o_u,
-		SphereData_Physical &o_v
+		SphereData_Physical &o_v,
+
+		const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan
 )
 {
 	const SphereData_Config *sphereDataConfig = i_u.sphereDataConfig;
@@ -217,20 +328,18 @@ void SphereAdvection_TS_na_sl::interpolate_departure_point_vec_uv(
 	/*
 	 * First we sample the field at the departure point
 	 */
-	SphereData_Physical u_tmp_D = sphereSampler.bicubic_scalar_ret_phys(
+	SphereData_Physical u_tmp_D = sample_departure_points(
 			i_u,
 			i_pos_lon_D, i_pos_lat_D,
 			true,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
-			simVars.disc.semi_lagrangian_interpolation_limiter
+			i_plan
 		);
 
-	SphereData_Physical v_tmp_D = sphereSampler.bicubic_scalar_ret_phys(
+	SphereData_Physical v_tmp_D = sample_departure_points(
 			i_v,
 			i_pos_lon_D, i_pos_lat_D,
 			true,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
-			simVars.disc.semi_lagrangian_interpolation_limiter
+			i_plan
 		);
 
 	/*
@@ -357,8 +466,6 @@ void SphereAdvection_TS_na_sl::run_timestep_1(
 		const BenchmarksSphereAdvection *i_sphereBenchmarks
 )
 {
-	const SphereData_Config *sphereDataConfig = io_U_phi.sphereDataConfig;
-
 	if (i_simulation_timestamp == 0)
 	{
 		U_u_prev = io_U_u;
@@ -374,29 +481,21 @@ void SphereAdvection_TS_na_sl::run_timestep_1(
 		i_sphereBenchmarks->master->get_varying_velocities(U_u_prev, U_v_prev, i_simulation_timestamp - i_dt);
 	}
 
-	// OUTPUT: position of departure points at t
-	ScalarDataArray pos_lon_D(sphereDataConfig->physical_array_data_number_of_elements);
-	ScalarDataArray pos_lat_D(sphereDataConfig->physical_array_data_number_of_elements);
-
-	double dt_div_radius = simVars.timecontrol.current_timestep_size / simVars.sim.sphere_radius;
-
-	semiLagrangian.semi_lag_departure_points_settls_specialized(
-			dt_div_radius*U_u_prev, dt_div_radius*U_v_prev,
-			dt_div_radius*io_U_u, dt_div_radius*io_U_v,
-
-			pos_lon_D, pos_lat_D
+	// OUTPUT: position of departure points at t and their interpolation plan
+	update_departure_points(
+			U_u_prev, U_v_prev,
+			io_U_u, io_U_v,
+			i_sphereBenchmarks == nullptr
 	);
 
 	U_u_prev = io_U_u;
 	U_v_prev = io_U_v;
 
 	SphereData_Physical new_prog_phi_phys =
-		sphereSampler.bicubic_scalar_ret_phys(
+		sphereSampler.bicubic_plan_apply_ret_phys(
+			departure_points_plan,
 			io_U_phi.toPhys(),
-			pos_lon_D,
-			pos_lat_D,
 			false,
-			simVars.disc.semi_lagrangian_sampler_use_pole_pseudo_points,
 			simVars.disc.semi_lagrangian_interpolation_limiter
 	);
 
@@ -433,17 +532,11 @@ void SphereAdvection_TS_na_sl::run_timestep_2(
 		i_sphereBenchmarks->master->get_varying_velocities(U_u_prev, U_v_prev, i_simulation_timestamp - i_dt);
 	}
 
-	// OUTPUT: position of departure points at t
-	ScalarDataArray pos_lon_d(sphereDataConfig->physical_array_data_number_of_elements);
-	ScalarDataArray pos_lat_d(sphereDataConfig->physical_array_data_number_of_elements);
-
-	double dt_div_radius = simVars.timecontrol.current_timestep_size / simVars.sim.sphere_radius;
-
-	semiLagrangian.semi_lag_departure_points_settls_specialized(
-			dt_div_radius*U_u_prev, dt_div_radius*U_v_prev,
-			dt_div_radius*io_U_u, dt_div_radius*io_U_v,
-
-			pos_lon_d, pos_lat_d
+	// OUTPUT: position of departure points at t and their interpolation plan
+	update_departure_points(
+			U_u_prev, U_v_prev,
+			io_U_u, io_U_v,
+			i_sphereBenchmarks == nullptr
 	);
 
 
@@ -457,10 +550,12 @@ void SphereAdvection_TS_na_sl::run_timestep_2(
 	interpolate_departure_point_vec_uv(
 			u, v,
 
-			pos_lon_d,
-			pos_lat_d,
+			pos_lon_D,
+			pos_lat_D,
+
+			new_u, new_v,
 
-			new_u, new_v
+			&departure_points_plan
 	);
 
 	op.uv_to_vrtdiv(
@@ -484,8 +579,6 @@ void SphereAdvection_TS_na_sl::run_timestep_3(
 		const BenchmarksSphereAdvection *i_sphereBenchmarks
 )
 {
-	const SphereData_Config *sphereDataConfig = io_prognostic_fields[0]->sphereDataConfig;
-
 	if (i_simulation_timestamp == 0)
 	{
 		U_u_prev = io_U_u;
@@ -501,17 +594,11 @@ void SphereAdvection_TS_na_sl::run_timestep_3(
 		i_sphereBenchmarks->master->get_varying_velocities(U_u_prev, U_v_prev, i_simulation_timestamp - i_dt);
 	}
 
-	// OUTPUT: position of departure points at t
-	ScalarDataArray pos_lon_d(sphereDataConfig->physical_array_data_number_of_elements);
-	ScalarDataArray pos_lat_d(sphereDataConfig->physical_array_data_number_of_elements);
-
-	double dt_div_radius = simVars.timecontrol.current_timestep_size / simVars.sim.sphere_radius;
-
-	semiLagrangian.semi_lag_departure_points_settls_specialized(
-			dt_div_radius*U_u_prev, dt_div_radius*U_v_prev,
-			dt_div_radius*io_U_u, dt_div_radius*io_U_v,
-
-			pos_lon_d, pos_lat_d
+	// OUTPUT: position of departure points at t and their interpolation plan
+	update_departure_points(
+			U_u_prev, U_v_prev,
+			io_U_u, io_U_v,
+			i_sphereBenchmarks == nullptr
 	);
 
 
@@ -521,12 +608,14 @@ void SphereAdvection_TS_na_sl::run_timestep_3(
 			*io_prognostic_fields[1],
 			*io_prognostic_fields[2],
 
-			pos_lon_d,
-			pos_lat_d,
+			pos_lon_D,
+			pos_lat_D,
 
 			*io_prognostic_fields[0],
 			*io_prognostic_fields[1],
-			*io_prognostic_fields[2]
+			*io_prognostic_fields[2],
+
+			&departure_points_plan
 	);
 }
 
@@ -610,7 +699,11 @@ SphereAdvection_TS_na_sl::SphereAdvection_TS_na_sl(
 		simVars(i_simVars),
 		op(i_op),
 		semiLagrangian(simVars),
-		sphereSampler(semiLagrangian.sphereSampler)
+		sphereSampler(semiLagrangian.sphereSampler),
+		departure_points_cache_valid(false),
+		departure_points_cache_dt_div_radius(0),
+		departure_points_num_updates(0),
+		departure_points_num_reused(0)
 {
 	setup(simVars.disc.timestepping_order);
 
@@ -621,5 +714,10 @@ SphereAdvection_TS_na_sl::SphereAdvection_TS_na_sl(
 
 SphereAdvection_TS_na_sl::~SphereAdvection_TS_na_sl()
 {
+	if (simVars.misc.verbosity > 0 && departure_points_num_updates > 0)
+	{
+		std::cout << "[MULE] sl_departure_points_num_updates: " << departure_points_num_updates << std::endl;
+		std::cout << "[MULE] sl_departure_points_num_reused: " << departure_points_num_reused << std::endl;
+	}
 }
 
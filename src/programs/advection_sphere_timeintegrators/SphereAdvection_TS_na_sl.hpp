@@ -30,6 +30,47 @@ class SphereAdvection_TS_na_sl	: public SphereAdvection_TS_interface
 
 	SphereData_Physical U_u_prev, U_v_prev;
 
+	/*
+	 * Departure points and their interpolation plan
+	 *
+	 * For stationary velocity fields and a fixed time step size, they are
+	 * only computed once and reused in all further time steps.
+	 */
+	ScalarDataArray pos_lon_D, pos_lat_D;
+	SphereOperators_Sampler_SphereDataPhysical::BicubicPlan departure_points_plan;
+
+	bool departure_points_cache_valid;
+	double departure_points_cache_dt_div_radius;
+	SphereData_Physical departure_points_cache_U_u_prev, departure_points_cache_U_v_prev;
+	SphereData_Physical departure_points_cache_U_u, departure_points_cache_U_v;
+
+	std::size_t departure_points_num_updates;
+	std::size_t departure_points_num_reused;
+
+	static
+	bool is_bitwise_equal(
+			const SphereData_Physical &i_a,
+			const SphereData_Physical &i_b
+	);
+
+	void update_departure_points(
+			const SphereData_Physical &i_U_u_prev,
+			const SphereData_Physical &i_U_v_prev,
+			const SphereData_Physical &i_U_u,
+			const SphereData_Physical &i_U_v,
+			bool i_stationary_velocities
+	);
+
+	SphereData_Physical sample_departure_points(
+			const SphereData_Physical &i_data,
+
+			const ScalarDataArray &i_pos_lon_D,
+			const ScalarDataArray &i_pos_lat_D,
+
+			bool i_velocity_sampling,
+			const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan
+	);
+
 public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method);
 
@@ -60,7 +101,9 @@ public:
 
 			SphereData_Spectral &o_u,
 			SphereData_Spectral &o_v,
-			SphereData_Spectral &o_w
+			SphereData_Spectral &o_w,
+
+			const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan = nullptr	///< precomputed interpolation plan for departure points
 	);
 
 	void interpolate_departure_point_vec_uv(
@@ -71,7 +114,9 @@ public:
 			const ScalarDataArray &i_pos_lat_D,
 
 			SphereData_Physical &o_u,
-			SphereData_Physical &o_v
+			SphereData_Physical &o_v,
+
+			const SphereOperators_Sampler_SphereDataPhysical::BicubicPlan *i_plan = nullptr	///< precomputed interpolation plan for departure points
 	);
 
 	void run_timestep(
@@ -388,7 +388,7 @@ int main(int i_argc, char *i_argv[])
 			BraidCore core(MPI_COMM_WORLD, &app);
 			app.setup(core);
 			// Run Simulation
-			core.Drive();
+			app.drive(core);
 		}
 
 	}
@@ -28,6 +28,7 @@ int main(
 			"lambda-real",			/// Real part of lambda
 			"lambda-imag",			/// Imaginary part of lambda
 			"test-mode",			/// Type of test
+			"populate-cache-only",	/// Only populate the REXI coefficient cache
 			nullptr
 	};
 
@@ -38,6 +39,7 @@ int main(
 	simVars.bogus.var[1] = "";
 	simVars.bogus.var[2] = "";
 	simVars.bogus.var[3] = "";
+	simVars.bogus.var[4] = "";
 
 	if (!simVars.setupFromMainParameters(i_argc, i_argv, bogus_var_names, false))
 	{
@@ -49,6 +51,8 @@ int main(
 		std::cout << "  --test-mode=..." << std::endl;
 		std::cout << "        0: use standard time stepping" << std::endl;
 		std::cout << "        1: always start from u(0) with increasing time step sizes" << std::endl;
+		std::cout << "	--populate-cache-only=[0/1]" << std::endl;
+		std::cout << "        Only load the REXI coefficients to fill the cache given by --rexi-coefficients-cache" << std::endl;
 		return -1;
 	}
 
@@ -70,13 +74,23 @@ int main(
 	if (simVars.bogus.var[3] != "")
 		lambda_imag = atoi(simVars.bogus.var[3].c_str());
 
-	if (simVars.timecontrol.current_timestep_size <= 0)
+	bool populate_cache_only = false;
+	if (simVars.bogus.var[4] != "")
+		populate_cache_only = atoi(simVars.bogus.var[4].c_str());
+
+	if (populate_cache_only && simVars.rexi.rexi_coefficients_cache == "")
+	{
+		std::cerr << "Error: Specify cache directory with --rexi-coefficients-cache" << std::endl;
+		return -1;
+	}
+
+	if (simVars.timecontrol.current_timestep_size <= 0 && !populate_cache_only)
 	{
 		std::cerr << "Error: Specify time step size" << std::endl;
 		return -1;
 	}
 
-	if (std::isinf(std::abs(lambda)))
+	if (std::isinf(std::abs(lambda)) && !populate_cache_only)
 	{
 		std::cerr << "Error: Specify \\lambda of linear operators" << std::endl;
 		return -1;
@@ -100,7 +114,7 @@ int main(
 	}
 	else if (simVars.rexi.exp_method == "file")
 	{
-		rexiCoefficientsSet.setup_from_files(simVars.rexi.rexi_files);
+		rexiCoefficientsSet.setup_from_files(simVars.rexi.rexi_files, simVars.rexi.rexi_coefficients_cache);
 
 		if (rexiCoefficientsSet.rexiCoefficientVector.size() == 0)
 			SWEETError("No REXI coefficient loaded");
@@ -119,6 +133,12 @@ int main(
 		SWEETError("This REXI method is not supported");
 	}
 
+	if (populate_cache_only)
+	{
+		std::cout << "REXI coefficients cached in '" << simVars.rexi.rexi_coefficients_cache << "'" << std::endl;
+		return 0;
+	}
+
 	std::cout << "+ test_mode: " << test_mode << std::endl;
 
 	simVars.rexi.outputConfig();
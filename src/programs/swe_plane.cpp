@@ -34,11 +34,13 @@
 #include <ostream>
 #include <algorithm>
 #include <sstream>
+#include <map>
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include <sweet/SimulationBenchmarkTiming.hpp>
+#include <sweet/ParameterSweep.hpp>
 
 #include "swe_plane_benchmarks/SWEPlaneBenchmarksCombined.hpp"
 #include "swe_plane_timeintegrators/SWE_Plane_TimeSteppers.hpp"
@@ -53,6 +55,12 @@
 PlaneDataConfig planeDataConfigInstance;
 PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
 
+/*
+ * Operators shared by all simulation instances (parameter sweeps).
+ * If not set, each simulation instance sets up its own ones.
+ */
+PlaneOperators *planeOperators = nullptr;
+
 
 
 #ifndef SWEET_MPI
@@ -160,8 +168,11 @@ public:
 
 	NormalModesData normalmodes;
 
+	// Finite difference operators of this instance if no shared operators are given
+	PlaneOperators op_instance;
+
 	// Finite difference operators
-	PlaneOperators op;
+	PlaneOperators &op;
 
 	/// Diagnostic measures at initial stage, Initialize with 0
 	double diagnostics_energy_start = 0;
@@ -198,8 +209,11 @@ public:
 		normalmodes(planeDataConfig),
 
 		// Initialises operators
-		op(planeDataConfig, simVars.sim.plane_domain_size, simVars.disc.space_use_spectral_basis_diffs)
+		op(planeOperators != nullptr ? *planeOperators : op_instance)
 	{
+		if (planeOperators == nullptr)
+			op_instance.setup(planeDataConfig, simVars.sim.plane_domain_size, simVars.disc.space_use_spectral_basis_diffs);
+
 		// Calls initialisation of the run (e.g. sets u, v, h)
 		reset();
 
@@ -291,6 +305,10 @@ public:
 				simVars
 			);
 
+		// Other time steppers would silently ignore it
+		if (simVars.timecontrol.dt_adaptive && !timeSteppers.master->supports_adaptive_timestepping())
+			SWEETError("Adaptive time stepping is not supported by the time stepping method '"+simVars.disc.timestepping_method+"'");
+
 		if (simVars.misc.compute_errors)
 		{
 			//Compute difference to initial condition (makes more sense in steady state cases, but useful in others too)
@@ -421,7 +439,8 @@ public:
 								3,
 								simVars,
 								this,
-								&SimulationInstance::run_timestep
+								&SimulationInstance::run_timestep,
+								timeSteppers.master->uses_mpi_collectives()
 						);
 
 		std::cout << "\n Done normal mode analysis in separate class" << std::endl;
@@ -433,6 +452,12 @@ public:
 	 */
 	void run_timestep()
 	{
+		/*
+		 * Use time step size proposed by adaptive time stepping
+		 */
+		if (simVars.timecontrol.dt_adaptive)
+			simVars.timecontrol.adaptive_setup_timestep_size(simVars.iodata.output_each_sim_seconds > 0 ? simVars.iodata.output_next_sim_seconds : -1);
+
 		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
 			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
 
@@ -467,6 +492,9 @@ public:
 		simVars.timecontrol.current_simulation_time += simVars.timecontrol.current_timestep_size;
 		simVars.timecontrol.current_timestep_nr++;
 
+		if (simVars.timecontrol.dt_adaptive)
+			simVars.timecontrol.adaptive_finish_timestep();
+
 		if (simVars.timecontrol.current_simulation_time > simVars.timecontrol.max_simulation_time)
 			SWEETError("Max simulation time exceeded!");
 
@@ -1020,6 +1048,281 @@ public:
 
 
 
+/*
+ * Run the simulation (or normal mode analysis) for the current simVars
+ *
+ * \return 0 on success, 1 if an instability was detected
+ */
+int simulation_run()
+{
+#if SWEET_MPI
+	int mpi_rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+#endif
+
+	SimulationInstance *simulationSWE = new SimulationInstance;
+	//Setting initial conditions and workspace - in case there is no GUI
+
+	// also initializes diagnostics
+	// already called in constructor
+	//simulationSWE->reset();
+
+#if SWEET_MPI
+	MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+
+	if (simVars.misc.normal_mode_analysis_generation > 0)
+	{
+		simulationSWE->normal_mode_analysis();
+	}
+	else
+	{
+		SimulationBenchmarkTimings::getInstance().main_timestepping.start();
+
+		// Main time loop
+		while (true)
+		{
+			// Stop simulation if requested
+			if (simulationSWE->should_quit())
+				break;
+
+			// Main call for timestep run
+			simulationSWE->run_timestep();
+
+			// Instability
+			if (simVars.misc.instability_checks)
+			{
+				if (simulationSWE->instability_detected())
+				{
+					std::cerr << "INSTABILITY DETECTED" << std::endl;
+					delete simulationSWE;
+					return 1;
+				}
+			}
+		}
+
+		SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
+	}
+
+
+	if (simVars.iodata.output_file_name.size() > 0)
+		std::cout << "[MULE] reference_filenames: " << simulationSWE->output_filenames << std::endl;
+
+	// End of run output results
+	std::cout << "***************************************************" << std::endl;
+	std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
+	std::cout << "Time per time step: " << SimulationBenchmarkTimings::getInstance().main_timestepping()/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
+	std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
+
+	simulationSWE->compute_errors();
+
+
+#if SWEET_MPI
+	if (mpi_rank == 0)
+#endif
+	{
+		if (simVars.misc.verbosity > 0)
+		{
+			std::cout << "DIAGNOSTICS ENERGY DIFF:\t" << std::abs((simVars.diag.total_energy-simulationSWE->diagnostics_energy_start)/simulationSWE->diagnostics_energy_start) << std::endl;
+			std::cout << "DIAGNOSTICS MASS DIFF:\t" << std::abs((simVars.diag.total_mass-simulationSWE->diagnostics_mass_start)/simulationSWE->diagnostics_mass_start) << std::endl;
+			std::cout << "DIAGNOSTICS POTENTIAL ENSTROPHY DIFF:\t" << std::abs((simVars.diag.total_potential_enstrophy-simulationSWE->diagnostics_potential_enstrophy_start)/simulationSWE->diagnostics_potential_enstrophy_start) << std::endl;
+
+			if (simVars.misc.compute_errors)
+			{
+				std::cout << "DIAGNOSTICS BENCHMARK DIFF H:\t" << simulationSWE->benchmark.t0_error_max_abs_h_pert << std::endl;
+				std::cout << "DIAGNOSTICS BENCHMARK DIFF U:\t" << simulationSWE->benchmark.t0_error_max_abs_u << std::endl;
+				std::cout << "DIAGNOSTICS BENCHMARK DIFF V:\t" << simulationSWE->benchmark.t0_error_max_abs_v << std::endl;
+			}
+
+			std::cout << "[MULE] error_end_linf_h_pert: " << simulationSWE->benchmark.t0_error_max_abs_h_pert << std::endl;
+			std::cout << "[MULE] error_end_linf_u: " << simulationSWE->benchmark.t0_error_max_abs_u << std::endl;
+			std::cout << "[MULE] error_end_linf_v: " << simulationSWE->benchmark.t0_error_max_abs_v << std::endl;
+			std::cout << std::endl;
+		}
+
+		if (simulationSWE->compute_error_to_analytical_solution)
+		{
+			std::cout << "DIAGNOSTICS ANALYTICAL RMS H:\t" << simulationSWE->benchmark.analytical_error_rms_h << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL RMS U:\t" << simulationSWE->benchmark.analytical_error_rms_u << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL RMS V:\t" << simulationSWE->benchmark.analytical_error_rms_v << std::endl;
+
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS H:\t" << simulationSWE->benchmark.analytical_error_maxabs_h << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS U:\t" << simulationSWE->benchmark.analytical_error_maxabs_u << std::endl;
+			std::cout << "DIAGNOSTICS ANALYTICAL MAXABS V:\t" << simulationSWE->benchmark.analytical_error_maxabs_v << std::endl;
+		}
+	}
+
+	std::cout << "[MULE] simulation_successfully_finished: 1" << std::endl;
+
+
+	delete simulationSWE;
+
+	return 0;
+}
+
+
+
+/*
+ * Run all configurations of the sweep file
+ *
+ * The FFT plans are set up only once for each resolution and the
+ * operators only once for each resolution and domain size. Concurrent
+ * configurations are run by workers, which are new instances of this
+ * program.
+ *
+ * \return number of failed configurations
+ */
+int main_sweep(int i_argc, char *i_argv[], const char *i_bogus_var_names[])
+{
+#if SWEET_GUI
+	if (simVars.misc.gui_enabled)
+		SWEETError("GUI not supported for parameter sweeps");
+#endif
+
+#if SWEET_PARAREAL
+	if (simVars.parareal.enabled)
+		SWEETError("Parareal not supported for parameter sweeps");
+#endif
+
+#if SWEET_MPI
+	SWEETError("Parameter sweeps not supported with MPI");
+#endif
+
+	ParameterSweep sweep;
+	sweep.load(simVars.sweep.sweep_file);
+
+	int sweep_parallel = simVars.sweep.sweep_parallel;
+	int sweep_worker_id = simVars.sweep.sweep_worker_id;
+	std::string base_output_file_name = simVars.iodata.output_file_name;
+
+	std::vector<std::string> args_storage;
+	std::vector<char*> args;
+
+	/*
+	 * FFT plans for each resolution given by the program arguments
+	 */
+	struct SweepResolution
+	{
+		PlaneDataConfig *config;
+		int res_physical[2];
+		int res_spectral[2];
+	};
+	std::map<std::string, SweepResolution> resolutions;
+
+	/*
+	 * Operators for each resolution and the parameters they depend on
+	 */
+	std::map<std::string, PlaneOperators*> operators;
+
+	auto setup_config = [&](int i_config_id)
+	{
+		sweep.get_args(i_config_id, i_argc, i_argv, args_storage, args);
+
+		simVars.reset_to_defaults();
+		if (!simVars.setupFromMainParameters(args.size()-1, args.data(), i_bogus_var_names))
+			SWEETError(std::string("Invalid arguments in sweep configuration: ")+sweep.config_lines[i_config_id]);
+
+		std::ostringstream key;
+		key << simVars.disc.space_res_physical[0] << "," << simVars.disc.space_res_physical[1] << ",";
+		key << simVars.disc.space_res_spectral[0] << "," << simVars.disc.space_res_spectral[1];
+
+		if (resolutions.find(key.str()) == resolutions.end())
+		{
+			SweepResolution r;
+
+			// reuse global instance for the first resolution
+			if (resolutions.empty())
+				r.config = &planeDataConfigInstance;
+			else
+				r.config = new PlaneDataConfig;
+
+			r.config->setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+			for (int i = 0; i < 2; i++)
+			{
+				r.res_physical[i] = simVars.disc.space_res_physical[i];
+				r.res_spectral[i] = simVars.disc.space_res_spectral[i];
+			}
+
+			resolutions[key.str()] = r;
+		}
+
+		SweepResolution &r = resolutions[key.str()];
+
+		// resolution which was determined during the setup
+		for (int i = 0; i < 2; i++)
+		{
+			simVars.disc.space_res_physical[i] = r.res_physical[i];
+			simVars.disc.space_res_spectral[i] = r.res_spectral[i];
+		}
+
+		planeDataConfig = r.config;
+
+		std::ostringstream op_key;
+		op_key.precision(17);
+		op_key << key.str() << "," << simVars.sim.plane_domain_size[0] << "," << simVars.sim.plane_domain_size[1];
+		op_key << "," << simVars.disc.space_use_spectral_basis_diffs;
+
+		if (operators.find(op_key.str()) == operators.end())
+			operators[op_key.str()] = new PlaneOperators(r.config, simVars.sim.plane_domain_size, simVars.disc.space_use_spectral_basis_diffs);
+
+		planeOperators = operators[op_key.str()];
+
+		// output files for each configuration
+		if (simVars.iodata.output_file_name == base_output_file_name && base_output_file_name != "")
+			simVars.iodata.output_file_name = ParameterSweep::get_prefixed_filename(i_config_id, base_output_file_name);
+	};
+
+	int num_failed = sweep.run(
+			sweep_parallel,
+			sweep_worker_id,
+			i_argc,
+			i_argv,
+			[&](int i_config_id) -> int
+			{
+				setup_config(i_config_id);
+
+				// counters are opened once per process (i.e. per worker) by the threads of this process
+				if (simVars.misc.performance_counters)
+					SimulationBenchmarkTimings::getInstance().setup_performance_counters(std::strtoull(simVars.misc.performance_counters_raw_event.c_str(), nullptr, 16));
+
+				SimulationBenchmarkTimings::getInstance().reset();
+				SimulationBenchmarkTimings::getInstance().main.start();
+
+				int retval = simulation_run();
+
+				SimulationBenchmarkTimings::getInstance().main.stop();
+
+				std::cout << std::endl;
+				SimulationBenchmarkTimings::getInstance().output();
+
+				return retval;
+			}
+		);
+
+	for (auto &o : operators)
+		delete o.second;
+
+	planeOperators = nullptr;
+
+	for (auto &r : resolutions)
+	{
+		if (r.second.config == &planeDataConfigInstance)
+			continue;
+
+		delete r.second.config;
+	}
+
+	planeDataConfig = &planeDataConfigInstance;
+
+	std::cout << "[MULE] sweep_num_failed: " << num_failed << std::endl;
+
+	return num_failed;
+}
+
+
+
 int main(int i_argc, char *i_argv[])
 {
 #if __MIC__
@@ -1066,6 +1369,12 @@ int main(int i_argc, char *i_argv[])
 #endif
 		return -1;
 	}
+
+	if (simVars.sweep.sweep_file != "")
+		return ParameterSweep::get_worker_exit_status(main_sweep(i_argc, i_argv, bogus_var_names));
+
+	if (simVars.misc.performance_counters)
+		SimulationBenchmarkTimings::getInstance().setup_performance_counters(std::strtoull(simVars.misc.performance_counters_raw_event.c_str(), nullptr, 16));
 	
 	if (simVars.misc.verbosity > 5)
 		std::cout << " + Setting up FFT plans..." << std::flush;
@@ -1251,7 +1560,7 @@ int main(int i_argc, char *i_argv[])
 				BraidCore core(MPI_COMM_WORLD, &app);
 				app.setup(core);
 				// Run Simulation
-				core.Drive();
+				app.drive(core);
 			}
 
 
@@ -1285,99 +1594,9 @@ int main(int i_argc, char *i_argv[])
 		else
 #endif
 		{
-			SimulationInstance *simulationSWE = new SimulationInstance;
-			//Setting initial conditions and workspace - in case there is no GUI
-
-			// also initializes diagnostics
-			// already called in constructor
-			//simulationSWE->reset();
-
-#if SWEET_MPI
-			MPI_Barrier(MPI_COMM_WORLD);
-#endif
-
-
-			if (simVars.misc.normal_mode_analysis_generation > 0)
-			{
-				simulationSWE->normal_mode_analysis();
-			}
-			else
-			{
-				SimulationBenchmarkTimings::getInstance().main_timestepping.start();
-
-				// Main time loop
-				while (true)
-				{
-					// Stop simulation if requested
-					if (simulationSWE->should_quit())
-						break;
-
-					// Main call for timestep run
-					simulationSWE->run_timestep();
-
-					// Instability
-					if (simVars.misc.instability_checks)
-					{
-						if (simulationSWE->instability_detected())
-							SWEETError("INSTABILITY DETECTED");
-					}
-				}
-
-				SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
-			}
-
-
-			if (simVars.iodata.output_file_name.size() > 0)
-				std::cout << "[MULE] reference_filenames: " << simulationSWE->output_filenames << std::endl;
-
-			// End of run output results
-			std::cout << "***************************************************" << std::endl;
-			std::cout << "Number of time steps: " << simVars.timecontrol.current_timestep_nr << std::endl;
-			std::cout << "Time per time step: " << SimulationBenchmarkTimings::getInstance().main_timestepping()/(double)simVars.timecontrol.current_timestep_nr << " sec/ts" << std::endl;
-			std::cout << "Last time step size: " << simVars.timecontrol.current_timestep_size << std::endl;
-
-			simulationSWE->compute_errors();
-
-
-#if SWEET_MPI
-			if (mpi_rank == 0)
-#endif
-			{
-				if (simVars.misc.verbosity > 0)
-				{
-					std::cout << "DIAGNOSTICS ENERGY DIFF:\t" << std::abs((simVars.diag.total_energy-simulationSWE->diagnostics_energy_start)/simulationSWE->diagnostics_energy_start) << std::endl;
-					std::cout << "DIAGNOSTICS MASS DIFF:\t" << std::abs((simVars.diag.total_mass-simulationSWE->diagnostics_mass_start)/simulationSWE->diagnostics_mass_start) << std::endl;
-					std::cout << "DIAGNOSTICS POTENTIAL ENSTROPHY DIFF:\t" << std::abs((simVars.diag.total_potential_enstrophy-simulationSWE->diagnostics_potential_enstrophy_start)/simulationSWE->diagnostics_potential_enstrophy_start) << std::endl;
-
-					if (simVars.misc.compute_errors)
-					{
-						std::cout << "DIAGNOSTICS BENCHMARK DIFF H:\t" << simulationSWE->benchmark.t0_error_max_abs_h_pert << std::endl;
-						std::cout << "DIAGNOSTICS BENCHMARK DIFF U:\t" << simulationSWE->benchmark.t0_error_max_abs_u << std::endl;
-						std::cout << "DIAGNOSTICS BENCHMARK DIFF V:\t" << simulationSWE->benchmark.t0_error_max_abs_v << std::endl;
-					}
-
-					std::cout << "[MULE] error_end_linf_h_pert: " << simulationSWE->benchmark.t0_error_max_abs_h_pert << std::endl;
-					std::cout << "[MULE] error_end_linf_u: " << simulationSWE->benchmark.t0_error_max_abs_u << std::endl;
-					std::cout << "[MULE] error_end_linf_v: " << simulationSWE->benchmark.t0_error_max_abs_v << std::endl;
-					std::cout << std::endl;
-				}
-
-				if (simulationSWE->compute_error_to_analytical_solution)
-				{
-					std::cout << "DIAGNOSTICS ANALYTICAL RMS H:\t" << simulationSWE->benchmark.analytical_error_rms_h << std::endl;
-					std::cout << "DIAGNOSTICS ANALYTICAL RMS U:\t" << simulationSWE->benchmark.analytical_error_rms_u << std::endl;
-					std::cout << "DIAGNOSTICS ANALYTICAL RMS V:\t" << simulationSWE->benchmark.analytical_error_rms_v << std::endl;
-
-					std::cout << "DIAGNOSTICS ANALYTICAL MAXABS H:\t" << simulationSWE->benchmark.analytical_error_maxabs_h << std::endl;
-					std::cout << "DIAGNOSTICS ANALYTICAL MAXABS U:\t" << simulationSWE->benchmark.analytical_error_maxabs_u << std::endl;
-					std::cout << "DIAGNOSTICS ANALYTICAL MAXABS V:\t" << simulationSWE->benchmark.analytical_error_maxabs_v << std::endl;
-				}
-			}
-
-			std::cout << "[MULE] simulation_successfully_finished: 1" << std::endl;
-
-
-			delete simulationSWE;
+			// IMPORANT: EXIT IN CASE OF INSTABILITIES
+			if (simulation_run() != 0)
+				SWEETError("INSTABILITY DETECTED");
 		} // end of gui not enabled
 
 		SimulationBenchmarkTimings::getInstance().main.stop();
@@ -1389,6 +1608,11 @@ int main(int i_argc, char *i_argv[])
 			std::cout << std::endl;
 			SimulationBenchmarkTimings::getInstance().output();
 		}
+#if SWEET_MPI
+		// counters of rank 0 are already part of the timing output
+		if (mpi_rank != 0)
+			SimulationBenchmarkTimings::getInstance().output_performance_counters();
+#endif
 	}
 #if SWEET_MPI && (SWEET_PARAREAL != 2) && (!SWEET_XBRAID)
 	else
@@ -17,6 +17,8 @@
 #include <sweet/plane/PlaneData_SpectralComplex.hpp>
 #include <sweet/SimulationVariables.hpp>
 #include <sweet/plane/PlaneOperators.hpp>
+#include <sweet/NormalModeColumnAssembly.hpp>
+#include <libmath/ArnoldiEigenSolver.hpp>
 #include <functional>
 #if SWEET_EIGEN
 #include <Eigen/Eigenvalues>
@@ -27,6 +29,146 @@
 class SWE_Plane_Normal_Modes
 {
 public:
+	/*
+	 * Matrix-free normal mode analysis
+	 *
+	 * The time stepper is used as a linear operator on the physical
+	 * degrees of freedom and the leading eigenvalues and eigenvectors are
+	 * computed with the Arnoldi method instead of assembling the full
+	 * matrix with one time step per degree of freedom.
+	 *
+	 * Generation 5: Linearization 1/dt * (U(t+dt) - U(t))
+	 * Generation 15: Propagator over max_timesteps_nr time steps
+	 */
+	template <typename TCallbackClass>
+	static
+	void normal_mode_analysis_arnoldi(
+			PlaneData_Spectral* io_prog[3],
+			int number_of_prognostic_variables,
+			SimulationVariables &i_simVars,
+			TCallbackClass *i_class,
+			void(TCallbackClass::* const i_run_timestep_method)(void)
+	)
+	{
+		const PlaneDataConfig *planeDataConfig = io_prog[0]->planeDataConfig;
+
+		int num_timesteps = 1;
+		if (i_simVars.misc.normal_mode_analysis_generation >= 10)
+		{
+			if (i_simVars.timecontrol.max_timesteps_nr > 0)
+				num_timesteps = i_simVars.timecontrol.max_timesteps_nr;
+		}
+
+		std::size_t num_dofs_per_prog = planeDataConfig->physical_array_data_number_of_elements;
+		std::size_t num_dofs = number_of_prognostic_variables*num_dofs_per_prog;
+
+		PlaneData_Physical tmp(planeDataConfig);
+
+		auto apply = [&](const double *i_x, double *o_y)
+		{
+			// reset time control
+			i_simVars.timecontrol.current_timestep_nr = 0;
+			i_simVars.timecontrol.current_simulation_time = 0;
+
+			for (int prog_id = 0; prog_id < number_of_prognostic_variables; prog_id++)
+			{
+				const double *x = i_x + prog_id*num_dofs_per_prog;
+				for (std::size_t i = 0; i < num_dofs_per_prog; i++)
+					tmp.physical_space_data[i] = x[i];
+
+				io_prog[prog_id]->loadPlaneDataPhysical(tmp);
+			}
+
+			for (int i = 0; i < num_timesteps; i++)
+				(i_class->*i_run_timestep_method)();
+
+			for (int prog_id = 0; prog_id < number_of_prognostic_variables; prog_id++)
+			{
+				const double *x = i_x + prog_id*num_dofs_per_prog;
+				double *y = o_y + prog_id*num_dofs_per_prog;
+
+				tmp = io_prog[prog_id]->toPhys();
+				for (std::size_t i = 0; i < num_dofs_per_prog; i++)
+				{
+					y[i] = tmp.physical_space_data[i];
+
+					if (i_simVars.misc.normal_mode_analysis_generation == 5)
+						y[i] = (y[i] - x[i])/i_simVars.timecontrol.current_timestep_size;
+				}
+			}
+		};
+
+		ArnoldiEigenSolver arnoldi;
+		arnoldi.num_eigenvalues = i_simVars.misc.normal_mode_analysis_num_modes;
+		arnoldi.krylov_dim = i_simVars.misc.normal_mode_analysis_krylov_dim;
+		arnoldi.tolerance = i_simVars.misc.normal_mode_analysis_tolerance;
+		arnoldi.verbosity = i_simVars.misc.verbosity;
+
+		arnoldi.solve(num_dofs, apply);
+
+		std::cout << "Arnoldi iterations: " << arnoldi.num_restarts+1 << " restart cycles, " << arnoldi.num_operator_applications << " operator applications for " << num_dofs << " degrees of freedom" << std::endl;
+		if (!arnoldi.converged)
+			std::cout << "WARNING: Arnoldi iterations did not converge" << std::endl;
+
+		// only the first MPI rank writes the output
+		if (!NormalModeColumnAssembly().is_writer())
+			return;
+
+		const char* filename;
+		char buffer_real[1024];
+
+		if (i_simVars.iodata.output_file_name == "")
+			filename = "output_%s_normalmodes.csv";
+		else
+			filename = i_simVars.iodata.output_file_name.c_str();
+
+		sprintf(buffer_real, filename, "normal_modes_arnoldi", i_simVars.timecontrol.current_timestep_size*num_timesteps*i_simVars.iodata.output_time_scale);
+		std::ofstream file(buffer_real, std::ios_base::trunc);
+		std::cout << "Writing leading normal modes to file '" << buffer_real << "'" << std::endl;
+
+		sprintf(buffer_real, filename, "normal_modes_arnoldi_vectors", i_simVars.timecontrol.current_timestep_size*num_timesteps*i_simVars.iodata.output_time_scale);
+		std::ofstream file_vectors(buffer_real, std::ios_base::trunc);
+
+		file << std::setprecision(20);
+		file_vectors << std::setprecision(20);
+
+		file << "# t " << (num_timesteps*i_simVars.timecontrol.current_timestep_size) << std::endl;
+		file << "# g " << i_simVars.sim.gravitation << std::endl;
+		file << "# h " << i_simVars.sim.h0 << std::endl;
+		file << "# f " << i_simVars.sim.plane_rotating_f0 << std::endl;
+		file << "# physresx " << planeDataConfig->physical_res[0] << std::endl;
+		file << "# physresy " << planeDataConfig->physical_res[1] << std::endl;
+		file << "# normalmodegeneration " << i_simVars.misc.normal_mode_analysis_generation << std::endl;
+		file << "# converged " << arnoldi.converged << std::endl;
+		file << "# eigenvalue_real\teigenvalue_imag\tresidual" << std::endl;
+
+		for (std::size_t i = 0; i < arnoldi.eigenvalues.size(); i++)
+			file << arnoldi.eigenvalues[i].real() << "\t" << arnoldi.eigenvalues[i].imag() << "\t" << arnoldi.residuals[i] << std::endl;
+
+		/*
+		 * One eigenvector per line: Real parts of the physical values
+		 * of all prognostic variables, then imaginary parts
+		 */
+		for (std::size_t i = 0; i < arnoldi.eigenvectors.size(); i++)
+		{
+			const std::vector<std::complex<double>> &x = arnoldi.eigenvectors[i];
+
+			for (std::size_t k = 0; k < num_dofs; k++)
+				file_vectors << x[k].real() << "\t";
+
+			for (std::size_t k = 0; k < num_dofs; k++)
+			{
+				file_vectors << x[k].imag();
+				if (k != num_dofs-1)
+					file_vectors << "\t";
+				else
+					file_vectors << std::endl;
+			}
+		}
+	}
+
+
+
 
 	template <typename TCallbackClass>
 	static
@@ -37,7 +179,9 @@ public:
 			int number_of_prognostic_variables,
 			SimulationVariables &i_simVars, // Simulation variables
 			TCallbackClass *i_class,
-			void(TCallbackClass::* const i_run_timestep_method)(void)
+			void(TCallbackClass::* const i_run_timestep_method)(void),
+
+			bool i_timestepper_uses_mpi_collectives	///< see SWE_Plane_TS_interface::uses_mpi_collectives()
 	)
 	{
 
@@ -272,6 +416,14 @@ public:
 			SWEETError("SWE_Plane_Normal_Modes: Cannot test this without Eigen library. Please compile with --eigen=enable");
 #endif
 		}
+		else if (i_simVars.misc.normal_mode_analysis_generation % 10 == 5)
+		{
+			if (number_of_prognostic_variables != 3 && number_of_prognostic_variables != 1)
+				SWEETError("Not yet supported");
+
+			PlaneData_Spectral* prog[3] = {&io_prog_h_pert, &io_prog_u, &io_prog_v};
+			normal_mode_analysis_arnoldi(prog, number_of_prognostic_variables, i_simVars, i_class, i_run_timestep_method);
+		}
 		/*
 		 * Do a normal mode analysis using perturbation, see
 		 * Hillary Weller, John Thuburn, Collin J. Cotter,
@@ -290,9 +442,21 @@ public:
 				filename = i_simVars.iodata.output_file_name.c_str();
 
 
+			/*
+			 * Columns are distributed across MPI ranks
+			 * (replicated if the time stepper communicates)
+			 */
+			NormalModeColumnAssembly nmca(i_timestepper_uses_mpi_collectives);
+			std::size_t column_id = 0;
+			std::vector<double> row;
+
 			sprintf(buffer_real, filename, "normal_modes_physical", i_simVars.timecontrol.current_timestep_size*i_simVars.iodata.output_time_scale);
-			std::ofstream file(buffer_real, std::ios_base::trunc);
-			std::cout << "Writing normal mode analysis to file '" << buffer_real << "'" << std::endl;
+			std::ofstream file;
+			if (nmca.is_writer())
+			{
+				file.open(buffer_real, std::ios_base::trunc);
+				std::cout << "Writing normal mode analysis to file '" << buffer_real << "'" << std::endl;
+			}
 
 			std::cout << "WARNING: OUTPUT IS TRANSPOSED!" << std::endl;
 
@@ -380,63 +544,62 @@ public:
 			{
 				if (i_simVars.misc.normal_mode_analysis_generation == 1 || i_simVars.misc.normal_mode_analysis_generation == 11)
 				{
+					row.resize(number_of_prognostic_variables*planeDataConfig->physical_array_data_number_of_elements);
+
 					// iterate over physical space
 					for (std::size_t outer_i = 0; outer_i < planeDataConfig->physical_array_data_number_of_elements; outer_i++)
 					{
-						// reset time control
-						i_simVars.timecontrol.current_timestep_nr = 0;
-						i_simVars.timecontrol.current_simulation_time = 0;
-
-						std::cout << "." << std::flush;
+						std::size_t col = column_id++;
+						if (!nmca.is_active(col))
+							continue;
 
-						for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-							prog[inner_prog_id]->spectral_set_zero();
+						if (nmca.is_owner(col))
+						{
+							// reset time control
+							i_simVars.timecontrol.current_timestep_nr = 0;
+							i_simVars.timecontrol.current_simulation_time = 0;
 
-						// activate mode
-						///prog[outer_prog_id]->request_data_physical();
-						///prog[outer_prog_id]->physical_space_data[outer_i] = 1;
-						PlaneData_Physical tmp = prog[outer_prog_id]->toPhys();
-						tmp.physical_space_data[outer_i] = 1;
-						prog[outer_prog_id]->loadPlaneDataPhysical(tmp);
+							std::cout << "." << std::flush;
 
-						/*
-						 * RUN timestep
-						 */
+							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+								prog[inner_prog_id]->spectral_set_zero();
 
-						(i_class->*i_run_timestep_method)();
+							// activate mode
+							PlaneData_Physical tmp = prog[outer_prog_id]->toPhys();
+							tmp.physical_space_data[outer_i] = 1;
+							prog[outer_prog_id]->loadPlaneDataPhysical(tmp);
 
-						if (i_simVars.misc.normal_mode_analysis_generation == 1)
-						{
 							/*
-							 * compute
-							 * 1/dt * (U(t+1) - U(t))
+							 * RUN timestep
 							 */
-							///////prog[outer_prog_id]->request_data_physical();
-							///////prog[outer_prog_id]->physical_space_data[outer_i] -= 1.0;
-							PlaneData_Physical tmp2 = prog[outer_prog_id]->toPhys();
-							tmp2.physical_space_data[outer_i] -= 1.0;
+
+							(i_class->*i_run_timestep_method)();
 
 							for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-								tmp2 /= i_simVars.timecontrol.current_timestep_size;
-								//(*prog[inner_prog_id]) /= i_simVars.timecontrol.current_timestep_size;
+							{
+								tmp = prog[inner_prog_id]->toPhys();
 
-							prog[outer_prog_id]->loadPlaneDataPhysical(tmp2);
-						}
+								if (i_simVars.misc.normal_mode_analysis_generation == 1)
+								{
+									/*
+									 * compute
+									 * 1/dt * (U(t+1) - U(t))
+									 */
+									if (inner_prog_id == outer_prog_id)
+										tmp.physical_space_data[outer_i] -= 1.0;
 
-						tmp = prog[outer_prog_id]->toPhys();
-						for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-						{
-							///prog[inner_prog_id]->request_data_physical();
-							for (std::size_t k = 0; k < planeDataConfig->physical_array_data_number_of_elements; k++)
-							{
-								///file << prog[inner_prog_id]->physical_space_data[k];
-								file << tmp.physical_space_data[k];
-								if (inner_prog_id != number_of_prognostic_variables-1 || k != planeDataConfig->physical_array_data_number_of_elements-1)
-									file << "\t";
-								else
-									file << std::endl;
+									tmp /= i_simVars.timecontrol.current_timestep_size;
+								}
+
+								for (std::size_t k = 0; k < planeDataConfig->physical_array_data_number_of_elements; k++)
+									row[inner_prog_id*planeDataConfig->physical_array_data_number_of_elements+k] = tmp.physical_space_data[k];
 							}
 						}
+
+						nmca.gather(col, row);
+
+						if (nmca.is_writer())
+							nmca.write(file, row);
 					}
 				}
 #if 1
@@ -446,6 +609,8 @@ public:
 					SWEETError("Only available with if plane spectral space is activated during compile time!");
 #else
 
+					row.resize(2*number_of_prognostic_variables*specmodes);
+
 					// iterate over spectral space
 					for (int r = 0; r < 2; r++)
 					{
@@ -454,87 +619,70 @@ public:
 						{
 							for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
 							{
-								// reset time control
-								i_simVars.timecontrol.current_timestep_nr = 0;
-								i_simVars.timecontrol.current_simulation_time = 0;
-
-								std::cout << "." << std::flush;
-
-								for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-									prog[inner_prog_id]->spectral_set_zero();
+								std::size_t col = column_id++;
+								if (!nmca.is_active(col))
+									continue;
 
-								// activate mode via real coefficient
-								prog[outer_prog_id]->spectral_set(j, i, 1.0);
-
-								/*
-								 * RUN timestep
-								 */
-								(i_class->*i_run_timestep_method)();
-
-
-								if (i_simVars.misc.normal_mode_analysis_generation == 3)
+								if (nmca.is_owner(col))
 								{
-									/*
-									 * compute
-									 * 1/dt * (U(t+1) - U(t))
-									 */
-									///prog[outer_prog_id]->request_data_spectral();
+									// reset time control
+									i_simVars.timecontrol.current_timestep_nr = 0;
+									i_simVars.timecontrol.current_simulation_time = 0;
 
-									std::complex<double> val = prog[outer_prog_id]->spectral_get(j, i);
-									val = val - 1.0;
-									prog[outer_prog_id]->spectral_set(j, i, val);
+									std::cout << "." << std::flush;
 
 									for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-										(*prog[inner_prog_id]) /= i_simVars.timecontrol.current_timestep_size;
-								}
+										prog[inner_prog_id]->spectral_set_zero();
 
-
-								for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-								{
-									///prog[inner_prog_id]->request_data_spectral();
+									// activate mode via real coefficient
+									prog[outer_prog_id]->spectral_set(j, i, 1.0);
 
 									/*
-									 * REAL
+									 * RUN timestep
 									 */
+									(i_class->*i_run_timestep_method)();
 
-									for (int r = 0; r < 2; r++)
+
+									if (i_simVars.misc.normal_mode_analysis_generation == 3)
 									{
-										for (std::size_t j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
-										{
-											for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
-											{
-												file << prog[inner_prog_id]->spectral_get(j, i).real();
-												file << "\t";
-											}
-										}
+										/*
+										 * compute
+										 * 1/dt * (U(t+1) - U(t))
+										 */
+										std::complex<double> val = prog[outer_prog_id]->spectral_get(j, i);
+										val = val - 1.0;
+										prog[outer_prog_id]->spectral_set(j, i, val);
+
+										for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
+											(*prog[inner_prog_id]) /= i_simVars.timecontrol.current_timestep_size;
 									}
-								}
 
-
-								for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
-								{
 									/*
-									 * IMAG
+									 * Real parts of all prognostic variables, then imaginary parts
 									 */
-									int c = 0;
-									for (int r = 0; r < 2; r++)
+									for (int inner_prog_id = 0; inner_prog_id < number_of_prognostic_variables; inner_prog_id++)
 									{
-										for (std::size_t j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
+										int c = 0;
+										for (int r = 0; r < 2; r++)
 										{
-											for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
+											for (std::size_t j = planeDataConfig->spectral_data_iteration_ranges[r][1][0]; j < planeDataConfig->spectral_data_iteration_ranges[r][1][1]; j++)
 											{
-												file << prog[inner_prog_id]->spectral_get(j, i).imag();
-
-												if (inner_prog_id != number_of_prognostic_variables-1 || c != specmodes-1)
-													file << "\t";
-												else
-													file << std::endl;
-
-												c++;
+												for (std::size_t i = planeDataConfig->spectral_data_iteration_ranges[r][0][0]; i < planeDataConfig->spectral_data_iteration_ranges[r][0][1]; i++)
+												{
+													std::complex<double> val = prog[inner_prog_id]->spectral_get(j, i);
+													row[inner_prog_id*specmodes+c] = val.real();
+													row[(number_of_prognostic_variables+inner_prog_id)*specmodes+c] = val.imag();
+													c++;
+												}
 											}
 										}
 									}
 								}
+
+								nmca.gather(col, row);
+
+								if (nmca.is_writer())
+									nmca.write(file, row);
 							}
 						}
 					}
@@ -29,6 +29,26 @@ public:
 			double i_sim_timestamp
 	) = 0;
 
+	/*
+	 * Return true if the time step size is controlled by the time stepper
+	 * with --dt-adaptive (embedded RK pairs). The accepted and proposed
+	 * time step sizes are returned in simVars.timecontrol.
+	 */
+	virtual bool supports_adaptive_timestepping()
+	{
+		return false;
+	}
+
+	/*
+	 * Return true if each time step communicates over MPI (e.g. REXI
+	 * terms distributed over the ranks). All ranks then have to run
+	 * each time step together.
+	 */
+	virtual bool uses_mpi_collectives()
+	{
+		return false;
+	}
+
 #if (SWEET_PARAREAL && SWEET_PARAREAL_PLANE) || (SWEET_XBRAID && SWEET_XBRAID_PLANE)
 	void run_timestep(
 			Parareal_GenericData* io_data,
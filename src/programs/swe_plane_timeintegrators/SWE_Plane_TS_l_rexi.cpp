@@ -52,15 +52,24 @@ void SWE_Plane_TS_l_rexi::setup(
 			simVars.misc.verbosity
 	);
 
+	if (!retval)
+		SWEETError(std::string("Phi function '")+i_function_name+std::string("' not available"));
+
+	/*
+	 * Only the real part of the REXI terms is used for the real-valued
+	 * prognostic variables, hence conjugate poles lead to the same result
+	 */
+	if (rexiSimVars->conjugate_pairs)
+	{
+		int num_pairs = rexiCoefficients.reduce_conjugate_pairs();
+		std::cout << "Merged " << num_pairs << " conjugate REXI pole pairs" << std::endl;
+	}
+
 	rexi_alphas = rexiCoefficients.alphas;
 	rexi_betas = rexiCoefficients.betas;
 	rexi_gamma = rexiCoefficients.gamma;
 
 
-	if (!retval)
-		SWEETError(std::string("Phi function '")+i_function_name+std::string("' not available"));
-
-
 	std::cout << "Number of total REXI coefficients N = " << rexi_alphas.size() << std::endl;
 
 	std::size_t N = rexi_alphas.size();
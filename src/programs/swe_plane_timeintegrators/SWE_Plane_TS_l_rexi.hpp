@@ -106,6 +106,18 @@ public:
 			PlaneOperators &i_op
 		);
 
+	/*
+	 * REXI terms are distributed over the MPI ranks
+	 */
+	bool uses_mpi_collectives()
+	{
+#if SWEET_MPI
+		return !rexi_use_direct_solution;
+#else
+		return false;
+#endif
+	}
+
 	void setup(
 			EXP_SimulationVariables &i_rexi,
 			const std::string &i_function_name,
@@ -50,6 +50,11 @@ public:
 			PlaneOperators &i_op
 		);
 
+	bool uses_mpi_collectives()
+	{
+		return ts_l_rexi.uses_mpi_collectives();
+	}
+
 	void setup(
 			EXP_SimulationVariables &i_rexi,
 
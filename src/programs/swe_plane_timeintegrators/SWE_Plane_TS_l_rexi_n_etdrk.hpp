@@ -41,6 +41,11 @@ public:
 			PlaneOperators &i_op
 		);
 
+	bool uses_mpi_collectives()
+	{
+		return ts_phi0_rexi.uses_mpi_collectives();
+	}
+
 	void setup(
 			EXP_SimulationVariables &i_rexi,
 			int i_timestepping_order,
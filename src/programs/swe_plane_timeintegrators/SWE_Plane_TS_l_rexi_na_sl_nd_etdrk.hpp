@@ -64,6 +64,11 @@ public:
 		);
 
 
+	bool uses_mpi_collectives()
+	{
+		return ts_phi0_rexi.uses_mpi_collectives();
+	}
+
 	void setup(
 		int i_timestepping_order,
 		bool i_use_only_linear_divergence
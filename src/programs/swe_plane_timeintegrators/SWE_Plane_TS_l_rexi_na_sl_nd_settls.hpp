@@ -55,6 +55,11 @@ public:
 			PlaneOperators &i_op
 		);
 
+	bool uses_mpi_collectives()
+	{
+		return ts_l_rexi.uses_mpi_collectives();
+	}
+
 	void setup(
 			//REXI_SimulationVariables &i_rexi,
 			//int i_with_nonlinear
@@ -116,8 +116,16 @@ void SWE_Plane_TS_ln_erk::euler_timestep_update(
 		 */
 
 
-		U_phys = op.avg_b_x(total_h_phys)*i_u_phys;
-		V_phys = op.avg_b_y(total_h_phys)*i_v_phys;
+		// Both averages of the height in a single sweep
+		PlaneData_Physical total_h_avg_b_x_phys(i_h.planeDataConfig);
+		PlaneData_Physical total_h_avg_b_y_phys(i_h.planeDataConfig);
+		total_h_phys.kernel_apply_fused(
+				{&op.avg_b_x, &op.avg_b_y},
+				{&total_h_avg_b_x_phys, &total_h_avg_b_y_phys}
+			);
+
+		U_phys = total_h_avg_b_x_phys*i_u_phys;
+		V_phys = total_h_avg_b_y_phys*i_v_phys;
 		H_phys = simVars.sim.gravitation*total_h_phys + 0.5*(op.avg_f_x(i_u_phys*i_u_phys) + op.avg_f_y(i_v_phys*i_v_phys));
 
 		U.loadPlaneDataPhysical(U_phys);
@@ -128,7 +136,7 @@ void SWE_Plane_TS_ln_erk::euler_timestep_update(
 		// Potential vorticity
 		PlaneData_Physical total_h_pv_phys = total_h_phys;
 		PlaneData_Spectral total_h_pv = total_h_phys(i_h.planeDataConfig);
-		total_h_pv_phys = op.avg_b_x(op.avg_b_y(total_h_phys));
+		total_h_pv_phys = op.avg_b_x(total_h_avg_b_y_phys);
 		total_h_pv.loadPlaneDataPhysical(total_h_pv_phys);
 
 #if 0
@@ -182,6 +190,35 @@ void SWE_Plane_TS_ln_erk::run_timestep(
 	if (i_dt <= 0)
 		SWEETError("SWE_Plane_TS_ln_erk: Only constant time step size allowed");
 
+	if (simVars.timecontrol.dt_adaptive)
+	{
+		/*
+		 * Adaptive time stepping with embedded RK pair
+		 *
+		 * The accepted time step size is written back to the time control
+		 * since this is used for the viscosity and the simulation time.
+		 */
+		double dt = i_dt;
+		double dt_next;
+
+		timestepping_rk.run_timestep_adaptive(
+				this,
+				&SWE_Plane_TS_ln_erk::euler_timestep_update,
+				io_h, io_u, io_v,
+				dt, dt_next,
+				timestepping_order,
+				simVars.timecontrol.dt_adaptive_atol,
+				simVars.timecontrol.dt_adaptive_rtol,
+				simVars.timecontrol.dt_adaptive_min,
+				simVars.timecontrol.dt_adaptive_max,
+				i_simulation_timestamp
+			);
+
+		simVars.timecontrol.current_timestep_size = dt;
+		simVars.timecontrol.adaptive_next_timestep_size = dt_next;
+		return;
+	}
+
 	// standard time stepping
 	timestepping_rk.run_timestep(
 			this,
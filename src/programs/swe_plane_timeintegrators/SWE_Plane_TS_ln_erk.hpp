@@ -61,6 +61,11 @@ public:
 			double i_simulation_timestamp = -1
 	);
 
+	bool supports_adaptive_timestepping()
+	{
+		return true;
+	}
+
 
 
 	virtual ~SWE_Plane_TS_ln_erk();
@@ -14,6 +14,10 @@
 
 
 #include <stdexcept>
+#include <random>
+#include <vector>
+#include <map>
+#include <sstream>
 
 #if SWEET_GUI
 	#include <sweet/VisSweet.hpp>
@@ -39,6 +43,7 @@
 #include "swe_sphere_timeintegrators/SWE_Sphere_NormalModeAnalysis.hpp"
 
 #include <sweet/SimulationBenchmarkTiming.hpp>
+#include <sweet/ParameterSweep.hpp>
 #include <sweet/sphere/SphereData_DebugContainer.hpp>
 
 #if SWEET_PARAREAL
@@ -57,6 +62,13 @@ SphereData_Config sphereDataConfigInstance_nodealiasing;
 SphereData_Config *sphereDataConfig = &sphereDataConfigInstance;
 SphereData_Config *sphereDataConfig_nodealiasing = &sphereDataConfigInstance_nodealiasing;
 
+/*
+ * Operators shared by all simulation instances (parameter sweeps).
+ * If not set, each simulation instance sets up its own ones.
+ */
+SphereOperators_SphereData *sphereOperators = nullptr;
+SphereOperators_SphereData *sphereOperators_nodealiasing = nullptr;
+
 
 #if SWEET_GUI
 	PlaneDataConfig planeDataConfigInstance;
@@ -72,9 +84,13 @@ SphereData_Config *sphereDataConfig_nodealiasing = &sphereDataConfigInstance_nod
 
 class SimulationInstance
 {
+	// Operators of this instance if no shared operators are given
+	SphereOperators_SphereData op_instance;
+	SphereOperators_SphereData op_nodealiasing_instance;
+
 public:
-	SphereOperators_SphereData op;
-	SphereOperators_SphereData op_nodealiasing;
+	SphereOperators_SphereData &op;
+	SphereOperators_SphereData &op_nodealiasing;
 
 	SWE_Sphere_TimeSteppers timeSteppers;
 
@@ -91,6 +107,21 @@ public:
 	SphereData_Spectral prog_vrt;
 	SphereData_Spectral prog_div;
 
+	/*
+	 * Ensemble members 1, ..., ensemble_size-1
+	 *
+	 * Member 0 is stored in prog_* so that diagnostics, GUI and
+	 * the normal mode analysis work unmodified for this member.
+	 * All members share the operators and the time stepper
+	 * including its solver setup.
+	 */
+	std::vector<SphereData_Spectral> ensemble_phi_pert;
+	std::vector<SphereData_Spectral> ensemble_vrt;
+	std::vector<SphereData_Spectral> ensemble_div;
+
+	/// Suffix of output variable names for the ensemble member currently written
+	std::string output_ensemble_suffix;
+
 	Stopwatch stopwatch;
 
 #if SWEET_GUI
@@ -112,8 +143,8 @@ public:
 
 public:
 	SimulationInstance()	:
-		op(sphereDataConfig, &(simVars.sim)),
-		op_nodealiasing(sphereDataConfig_nodealiasing, &(simVars.sim)),
+		op(sphereOperators != nullptr ? *sphereOperators : op_instance),
+		op_nodealiasing(sphereOperators_nodealiasing != nullptr ? *sphereOperators_nodealiasing : op_nodealiasing_instance),
 		prog_phi_pert(sphereDataConfig),
 		prog_vrt(sphereDataConfig),
 		prog_div(sphereDataConfig),
@@ -132,6 +163,11 @@ public:
 		MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
 #endif
 
+		if (sphereOperators == nullptr)
+			op_instance.setup(sphereDataConfig, &(simVars.sim));
+
+		if (sphereOperators_nodealiasing == nullptr)
+			op_nodealiasing_instance.setup(sphereDataConfig_nodealiasing, &(simVars.sim));
 
 		reset();
 
@@ -199,6 +235,8 @@ public:
 			prog_div.load_nodealiasing(prog_div_nodealiasing);
 		}
 
+		setup_ensemble();
+
 		/*
 		 * SETUP time steppers
 		 */
@@ -207,6 +245,13 @@ public:
 
 		std::cout << "[MULE] timestepper_string_id: " << timeSteppers.master->string_id() << std::endl;
 
+		// Other time steppers would silently ignore it
+		if (simVars.timecontrol.dt_adaptive && !timeSteppers.master->supports_adaptive_timestepping())
+			SWEETError("Adaptive time stepping is not supported by the time stepping method '"+timeSteppers.master->string_id()+"'");
+
+		if (simVars.ensemble.ensemble_size > 1 && timeSteppers.master->keeps_state_between_timesteps())
+			SWEETError("Ensembles are not supported by time stepping methods storing previous solutions");
+
 		update_diagnostics();
 
 		simVars.diag.backup_reference();
@@ -237,6 +282,56 @@ public:
 	}
 
 
+	/*
+	 * Setup ensemble members as copies of member 0 with a
+	 * random perturbation of the geopotential
+	 */
+	void setup_ensemble()
+	{
+		int N = simVars.ensemble.ensemble_size;
+
+		if (N > 1 && simVars.timecontrol.dt_adaptive)
+			SWEETError("Adaptive time stepping is not supported for ensembles");
+
+		ensemble_phi_pert.assign(N-1, prog_phi_pert);
+		ensemble_vrt.assign(N-1, prog_vrt);
+		ensemble_div.assign(N-1, prog_div);
+
+		if (simVars.ensemble.perturbation_amplitude == 0)
+			return;
+
+		for (int m = 1; m < N; m++)
+		{
+			std::mt19937 gen(simVars.ensemble.perturbation_seed + m);
+			std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+			SphereData_Physical perturbation(sphereDataConfig);
+
+			// Generate serially for reproducible perturbations
+			for (std::size_t i = 0; i < sphereDataConfig->physical_array_data_number_of_elements; i++)
+				perturbation.physical_space_data[i] = simVars.ensemble.perturbation_amplitude*dist(gen);
+
+			ensemble_phi_pert[m-1] += SphereData_Spectral(perturbation);
+		}
+	}
+
+
+
+	/*
+	 * Swap the state of member i_member with member 0 (prog_*)
+	 */
+	void ensemble_swap_member(int i_member)
+	{
+		if (i_member == 0)
+			return;
+
+		prog_phi_pert.swap(ensemble_phi_pert[i_member-1]);
+		prog_vrt.swap(ensemble_vrt[i_member-1]);
+		prog_div.swap(ensemble_div[i_member-1]);
+	}
+
+
+
 	/**
 	 * Write file to data and return string of file name
 	 */
@@ -253,12 +348,14 @@ public:
 		const char* filename_template_arg = "output_spec_arg_%s.txt"; //.c_str();
 		int reduce_mode_factor = 4;
 
-		sprintf(buffer, filename_template_arg, i_name);
+		std::string name = i_name + output_ensemble_suffix;
+
+		sprintf(buffer, filename_template_arg, name.c_str());
 		i_sphereData.spectrum_phase_file_write_line(buffer, 
 			i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale,
 			20, 10e-20, reduce_mode_factor);
 
-		sprintf(buffer, filename_template_ampl, i_name);
+		sprintf(buffer, filename_template_ampl, name.c_str());
 		i_sphereData.spectrum_abs_file_write_line(buffer, 
 			i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale,
 			20, 10e-20, reduce_mode_factor);
@@ -282,7 +379,8 @@ public:
 		SphereData_Physical sphereData = i_sphereData.toPhys();
 
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
-		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
+		std::string name = i_name + output_ensemble_suffix;
+		sprintf(buffer, filename_template, name.c_str(), simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
 
 		if (i_phi_shifted)
 			sphereData.physical_file_write_lon_pi_shifted(buffer, "vorticity, lon pi shifted");
@@ -306,7 +404,8 @@ public:
 
 		SphereData_Spectral sphereData(i_sphereData);
 		const char* filename_template = simVars.iodata.output_file_name.c_str();
-		sprintf(buffer, filename_template, i_name, simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
+		std::string name = i_name + output_ensemble_suffix;
+		sprintf(buffer, filename_template, name.c_str(), simVars.timecontrol.current_simulation_time*simVars.iodata.output_time_scale);
 		sphereData.file_write_binary_spectral(buffer);
 
 		return buffer;
@@ -325,6 +424,33 @@ public:
 		if (simVars.iodata.output_file_name.length() == 0)
 			return;
 
+		/*
+		 * Write output of each ensemble member by making it member 0
+		 */
+		if (simVars.ensemble.ensemble_size > 1 && output_ensemble_suffix.empty())
+		{
+			// Reference filenames are provided for member 0 only
+			std::string reference_filenames;
+
+			for (int m = 0; m < simVars.ensemble.ensemble_size; m++)
+			{
+				char buffer[32];
+				sprintf(buffer, "_ens%03d", m);
+				output_ensemble_suffix = buffer;
+
+				ensemble_swap_member(m);
+				write_file_output();
+				ensemble_swap_member(m);
+
+				if (m == 0)
+					reference_filenames = output_reference_filenames;
+			}
+
+			output_ensemble_suffix = "";
+			output_reference_filenames = reference_filenames;
+			return;
+		}
+
 		std::cout << "Writing output files at simulation time: " << simVars.timecontrol.current_simulation_time << " secs" << std::endl;
 
 		if (simVars.iodata.output_file_mode == "csv")
@@ -336,18 +462,27 @@ public:
 
 			output_filename = write_file_csv(h, "prog_h");
 			output_reference_filenames += ";"+output_filename;
-			std::cout << " + " << output_filename << " (min: " << h.toPhys().physical_reduce_min() << ", max: " << h.toPhys().physical_reduce_max() << ")" << std::endl;
+			{
+				ReduceStatistics stats = h.toPhys().physical_reduce_statistics(simVars.misc.reduce_deterministic);
+				std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+			}
 
 			output_filename = write_file_csv(prog_phi_pert, "prog_phi_pert");
 			output_reference_filenames = output_filename;
-			std::cout << " + " << output_filename << " (min: " << prog_phi_pert.toPhys().physical_reduce_min() << ", max: " << prog_phi_pert.toPhys().physical_reduce_max() << ")" << std::endl;
+			{
+				ReduceStatistics stats = prog_phi_pert.toPhys().physical_reduce_statistics(simVars.misc.reduce_deterministic);
+				std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+			}
 
 			SphereData_Physical phi_phys = h.toPhys() * simVars.sim.gravitation;
 			SphereData_Spectral phi(sphereDataConfig);
 			phi.loadSphereDataPhysical(phi_phys);
 			output_filename = write_file_csv(phi, "prog_phi");
 			output_reference_filenames = output_filename;
-			std::cout << " + " << output_filename << " (min: " << phi_phys.physical_reduce_min() << ", max: " << phi_phys.physical_reduce_max() << ")" << std::endl;
+			{
+				ReduceStatistics stats = phi_phys.physical_reduce_statistics(simVars.misc.reduce_deterministic);
+				std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+			}
 
 			SphereData_Physical u(sphereDataConfig);
 			SphereData_Physical v(sphereDataConfig);
@@ -385,7 +520,10 @@ public:
 				output_reference_filenames = output_filename;
 				SphereData_Physical prog_phys = prog_phi_pert.toPhys();
 
-				std::cout << " + " << output_filename << " (min: " << prog_phys.physical_reduce_min() << ", max: " << prog_phys.physical_reduce_max() << ")" << std::endl;
+				{
+					ReduceStatistics stats = prog_phys.physical_reduce_statistics(simVars.misc.reduce_deterministic);
+					std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+				}
 			}
 
 			{
@@ -393,7 +531,10 @@ public:
 				output_reference_filenames += ";"+output_filename;
 				SphereData_Physical prog_phys = prog_vrt.toPhys();
 
-				std::cout << " + " << output_filename << " (min: " << prog_phys.physical_reduce_min() << ", max: " << prog_phys.physical_reduce_max() << ")" << std::endl;
+				{
+					ReduceStatistics stats = prog_phys.physical_reduce_statistics(simVars.misc.reduce_deterministic);
+					std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+				}
 			}
 
 			{
@@ -401,7 +542,10 @@ public:
 				output_reference_filenames += ";"+output_filename;
 				SphereData_Physical prog_phys = prog_div.toPhys();
 
-				std::cout << " + " << output_filename << " (min: " << prog_phys.physical_reduce_min() << ", max: " << prog_phys.physical_reduce_max() << ")" << std::endl;
+				{
+					ReduceStatistics stats = prog_phys.physical_reduce_statistics(simVars.misc.reduce_deterministic);
+					std::cout << " + " << output_filename << " (min: " << stats.min << ", max: " << stats.max << ")" << std::endl;
+				}
 			}
 		}
 		else if (simVars.iodata.output_file_mode == "csv_spec_evol"){
@@ -562,7 +706,10 @@ public:
 #if SWEET_MPI
 			if (mpi_rank == 0)
 #endif
-				std::cout << "prog_phi min/max:\t" << prog_phi_pert.toPhys().physical_reduce_min() << ", " << prog_phi_pert.toPhys().physical_reduce_max() << std::endl;
+			{
+				ReduceStatistics stats = prog_phi_pert.toPhys().physical_reduce_statistics(simVars.misc.reduce_deterministic);
+				std::cout << "prog_phi min/max:\t" << stats.min << ", " << stats.max << std::endl;
+			}
 		}
 
 		if (simVars.iodata.output_each_sim_seconds > 0)
@@ -643,13 +790,23 @@ public:
 
 	bool detect_instability()
 	{
-		if (prog_phi_pert.spectral_is_first_nan_or_inf())
+		if (prog_phi_pert.spectral_reduce_statistics(simVars.misc.reduce_deterministic).nan_or_inf)
 		{
 			std::cout << "Infinity value detected" << std::endl;
 			std::cerr << "Infinity value detected" << std::endl;
 			return true;
 		}
 
+		for (std::size_t m = 0; m < ensemble_phi_pert.size(); m++)
+		{
+			if (ensemble_phi_pert[m].spectral_reduce_statistics(simVars.misc.reduce_deterministic).nan_or_inf)
+			{
+				std::cout << "Infinity value detected in ensemble member " << m+1 << std::endl;
+				std::cerr << "Infinity value detected in ensemble member " << m+1 << std::endl;
+				return true;
+			}
+		}
+
 		return false;
 	}
 
@@ -662,27 +819,49 @@ public:
 			timestep_check_output();
 #endif
 
+		/*
+		 * Use time step size proposed by adaptive time stepping
+		 */
+		if (simVars.timecontrol.dt_adaptive)
+			simVars.timecontrol.adaptive_setup_timestep_size(simVars.iodata.output_each_sim_seconds > 0 ? simVars.iodata.output_next_sim_seconds : -1);
+
 		if (simVars.timecontrol.current_simulation_time + simVars.timecontrol.current_timestep_size > simVars.timecontrol.max_simulation_time)
 			simVars.timecontrol.current_timestep_size = simVars.timecontrol.max_simulation_time - simVars.timecontrol.current_simulation_time;
 
-		timeSteppers.master->run_timestep(
-				prog_phi_pert, prog_vrt, prog_div,
-				simVars.timecontrol.current_timestep_size,
-				simVars.timecontrol.current_simulation_time
-			);
+		if (simVars.ensemble.ensemble_size == 1)
+		{
+			timeSteppers.master->run_timestep(
+					prog_phi_pert, prog_vrt, prog_div,
+					simVars.timecontrol.current_timestep_size,
+					simVars.timecontrol.current_simulation_time
+				);
 
+			apply_viscosity(prog_phi_pert, prog_vrt, prog_div);
+		}
+		else
+		{
+			/*
+			 * Advance all ensemble members with the same time step size
+			 */
+			std::vector<SphereData_Spectral*> phi_pert(1, &prog_phi_pert);
+			std::vector<SphereData_Spectral*> vrt(1, &prog_vrt);
+			std::vector<SphereData_Spectral*> div(1, &prog_div);
 
+			for (std::size_t m = 0; m < ensemble_phi_pert.size(); m++)
+			{
+				phi_pert.push_back(&ensemble_phi_pert[m]);
+				vrt.push_back(&ensemble_vrt[m]);
+				div.push_back(&ensemble_div[m]);
+			}
 
-		// Apply viscosity at posteriori, for all methods explicit diffusion for non spectral schemes and implicit for spectral
+			timeSteppers.master->run_timestep_ensemble(
+					phi_pert, vrt, div,
+					simVars.timecontrol.current_timestep_size,
+					simVars.timecontrol.current_simulation_time
+				);
 
-		if (simVars.sim.viscosity != 0 && simVars.misc.use_nonlinear_only_visc == 0)
-		{
-			///prog_vrt = op.implicit_diffusion(prog_vrt, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
-			///prog_div = op.implicit_diffusion(prog_div, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
-			///prog_phi_pert = op.implicit_diffusion(prog_phi_pert, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
-			prog_vrt = op.implicit_hyperdiffusion(prog_vrt, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
-			prog_div = op.implicit_hyperdiffusion(prog_div, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
-			prog_phi_pert = op.implicit_hyperdiffusion(prog_phi_pert, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
+			for (std::size_t m = 0; m < phi_pert.size(); m++)
+				apply_viscosity(*phi_pert[m], *vrt[m], *div[m]);
 		}
 
 
@@ -690,6 +869,9 @@ public:
 		simVars.timecontrol.current_simulation_time += simVars.timecontrol.current_timestep_size;
 		simVars.timecontrol.current_timestep_nr++;
 
+		if (simVars.timecontrol.dt_adaptive)
+			simVars.timecontrol.adaptive_finish_timestep();
+
 #if SWEET_GUI
 		timestep_check_output();
 #endif
@@ -697,6 +879,28 @@ public:
 
 
 
+	/*
+	 * Apply viscosity at posteriori, for all methods explicit diffusion for non spectral schemes and implicit for spectral
+	 */
+	void apply_viscosity(
+			SphereData_Spectral &io_phi_pert,
+			SphereData_Spectral &io_vrt,
+			SphereData_Spectral &io_div
+	)
+	{
+		if (simVars.sim.viscosity != 0 && simVars.misc.use_nonlinear_only_visc == 0)
+		{
+			///io_vrt = op.implicit_diffusion(io_vrt, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
+			///io_div = op.implicit_diffusion(io_div, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
+			///io_phi_pert = op.implicit_diffusion(io_phi_pert, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.sphere_radius);
+			io_vrt = op.implicit_hyperdiffusion(io_vrt, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
+			io_div = op.implicit_hyperdiffusion(io_div, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
+			io_phi_pert = op.implicit_hyperdiffusion(io_phi_pert, simVars.timecontrol.current_timestep_size*simVars.sim.viscosity, simVars.sim.viscosity_order, simVars.sim.sphere_radius);
+		}
+	}
+
+
+
 	void normalmode_analysis()
 	{
 		NormalModeAnalysisSphere::normal_mode_analysis(
@@ -705,7 +909,8 @@ public:
 				prog_div,
 				simVars,
 				this,
-				&SimulationInstance::run_timestep
+				&SimulationInstance::run_timestep,
+				timeSteppers.master->uses_mpi_collectives()
 			);
 	}
 
@@ -998,6 +1203,327 @@ public:
 };
 
 
+/*
+ * Run the simulation (or normal mode analysis) for the current simVars
+ *
+ * \return 0 on success, 1 if an instability was detected
+ */
+int simulation_run()
+{
+#if SWEET_MPI
+	int mpi_rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+#endif
+
+	SimulationInstance *simulationSWE = new SimulationInstance;
+
+	if (simVars.misc.normal_mode_analysis_generation > 0)
+	{
+		simulationSWE->normalmode_analysis();
+	}
+	else
+	{
+		// Do first output before starting timer
+		simulationSWE->timestep_check_output();
+#if SWEET_MPI
+		// Start counting time
+		if (mpi_rank == 0)
+		{
+			std::cout << "********************************************************************************" << std::endl;
+			std::cout << "Parallel performance information: MPI barrier & timer starts here" << std::endl;
+			std::cout << "********************************************************************************" << std::endl;
+		}
+		MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+		SimulationBenchmarkTimings::getInstance().main_timestepping.start();
+
+		// Main time loop
+		while (true)
+		{
+			// Stop simulation if requested
+			if (simulationSWE->should_quit())
+				break;
+
+			// Test for some output to be done
+			simulationSWE->timestep_check_output();
+
+			// Main call for timestep run
+			simulationSWE->run_timestep();
+
+			// Instability
+			if (simVars.misc.instability_checks)
+			{
+#if SWEET_MPI
+				if (mpi_rank == 0)
+#endif
+				{
+					if (simulationSWE->detect_instability())
+					{
+						std::cout << "INSTABILITY DETECTED" << std::endl;
+						std::cerr << "INSTABILITY DETECTED" << std::endl;
+#if SWEET_MPI
+						// Only the first rank checks for instabilities, the other ones would wait forever
+						MPI_Abort(MPI_COMM_WORLD, 1);
+#endif
+						delete simulationSWE;
+						return 1;
+					}
+				}
+			}
+		}
+
+		// Stop counting time
+		SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
+
+#if SWEET_MPI
+		MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+		if (simVars.misc.verbosity > 0)
+			std::cout << std::endl;
+#if SWEET_MPI
+		// Start counting time
+		if (mpi_rank == 0)
+		{
+			std::cout << "********************************************************************************" << std::endl;
+			std::cout << "Parallel performance information: timer stopped here" << std::endl;
+			std::cout << "********************************************************************************" << std::endl;
+		}
+#endif
+
+		// Do some output after the time loop
+		simulationSWE->timestep_check_output();
+	}
+
+#if SWEET_MPI
+	// Start counting time
+	if (mpi_rank == 0)
+#endif
+	{
+		if (simVars.iodata.output_file_name.size() > 0)
+			std::cout << "[MULE] reference_filenames: " << simulationSWE->output_reference_filenames << std::endl;
+	}
+
+	std::cout << "[MULE] simulation_successfully_finished: 1" << std::endl;
+
+	delete simulationSWE;
+
+	return 0;
+}
+
+
+
+/*
+ * Run all configurations of the sweep file
+ *
+ * The spectral transformations are set up only once for each resolution
+ * and the operators only once for each resolution and set of simulation
+ * coefficients. Concurrent configurations are run by workers, which are
+ * new instances of this program.
+ *
+ * \return number of failed configurations
+ */
+int main_sweep(int i_argc, char *i_argv[], const char *i_bogus_var_names[])
+{
+#if SWEET_GUI
+	if (simVars.misc.gui_enabled)
+		SWEETError("GUI not supported for parameter sweeps");
+#endif
+
+#if SWEET_PARAREAL
+	if (simVars.parareal.enabled)
+		SWEETError("Parareal not supported for parameter sweeps");
+#endif
+
+#if SWEET_MPI
+	if (simVars.sweep.sweep_parallel > 1)
+		SWEETError("Concurrent configurations of parameter sweeps not supported with MPI");
+#endif
+
+#if SWEET_MPI
+	int mpi_rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+#endif
+
+	ParameterSweep sweep;
+	sweep.load(simVars.sweep.sweep_file);
+
+	int sweep_parallel = simVars.sweep.sweep_parallel;
+	int sweep_worker_id = simVars.sweep.sweep_worker_id;
+	std::string base_output_file_name = simVars.iodata.output_file_name;
+
+	std::vector<std::string> args_storage;
+	std::vector<char*> args;
+
+	/*
+	 * Spectral transformations (with and without dealiasing) for each
+	 * resolution given by the program arguments
+	 */
+	struct SweepResolution
+	{
+		SphereData_Config *config;
+		SphereData_Config *config_nodealiasing;
+		int res_physical[2];
+		int res_spectral[2];
+	};
+	std::map<std::string, SweepResolution> resolutions;
+
+	/*
+	 * Operators (with and without dealiasing) for each resolution and
+	 * the simulation coefficients they depend on
+	 */
+	struct SweepOperators
+	{
+		SphereOperators_SphereData *op;
+		SphereOperators_SphereData *op_nodealiasing;
+	};
+	std::map<std::string, SweepOperators> operators;
+
+	auto setup_config = [&](int i_config_id)
+	{
+		sweep.get_args(i_config_id, i_argc, i_argv, args_storage, args);
+
+		simVars.reset_to_defaults();
+		if (!simVars.setupFromMainParameters(args.size()-1, args.data(), i_bogus_var_names))
+			SWEETError(std::string("Invalid arguments in sweep configuration: ")+sweep.config_lines[i_config_id]);
+
+		std::ostringstream key;
+		key << simVars.disc.space_res_physical[0] << "," << simVars.disc.space_res_physical[1] << ",";
+		key << simVars.disc.space_res_spectral[0] << "," << simVars.disc.space_res_spectral[1];
+
+		if (resolutions.find(key.str()) == resolutions.end())
+		{
+			SweepResolution r;
+
+			// reuse global instances for the first resolution
+			if (resolutions.empty())
+			{
+				r.config = &sphereDataConfigInstance;
+				r.config_nodealiasing = &sphereDataConfigInstance_nodealiasing;
+			}
+			else
+			{
+				r.config = new SphereData_Config;
+				r.config_nodealiasing = new SphereData_Config;
+			}
+
+			r.config->setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans, simVars.misc.verbosity);
+
+			int res_physical_nodealias[2] = {
+					2*simVars.disc.space_res_spectral[0],
+					simVars.disc.space_res_spectral[1]
+				};
+
+			r.config_nodealiasing->setupAuto(res_physical_nodealias, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans, simVars.misc.verbosity);
+
+			for (int i = 0; i < 2; i++)
+			{
+				r.res_physical[i] = simVars.disc.space_res_physical[i];
+				r.res_spectral[i] = simVars.disc.space_res_spectral[i];
+			}
+
+			resolutions[key.str()] = r;
+		}
+
+		SweepResolution &r = resolutions[key.str()];
+
+		// resolution which was determined during the setup
+		for (int i = 0; i < 2; i++)
+		{
+			simVars.disc.space_res_physical[i] = r.res_physical[i];
+			simVars.disc.space_res_spectral[i] = r.res_spectral[i];
+		}
+
+		sphereDataConfig = r.config;
+		sphereDataConfig_nodealiasing = r.config_nodealiasing;
+
+		std::ostringstream op_key;
+		op_key.precision(17);
+		op_key << key.str() << "," << simVars.sim.sphere_radius << "," << simVars.sim.sphere_rotating_coriolis_omega;
+		op_key << "," << simVars.sim.sphere_use_fsphere << "," << simVars.sim.sphere_fsphere_f0;
+
+		if (operators.find(op_key.str()) == operators.end())
+		{
+			SweepOperators o;
+			o.op = new SphereOperators_SphereData(r.config, &(simVars.sim));
+			o.op_nodealiasing = new SphereOperators_SphereData(r.config_nodealiasing, &(simVars.sim));
+			operators[op_key.str()] = o;
+		}
+
+		sphereOperators = operators[op_key.str()].op;
+		sphereOperators_nodealiasing = operators[op_key.str()].op_nodealiasing;
+
+#if SWEET_MPI
+		if (mpi_rank > 0)
+		{
+			simVars.misc.verbosity = 0;
+	#if !SWEET_XBRAID
+			simVars.iodata.output_each_sim_seconds = -1;
+	#endif
+		}
+#endif
+
+		// output files for each configuration
+		if (simVars.iodata.output_file_name == base_output_file_name && base_output_file_name != "")
+			simVars.iodata.output_file_name = ParameterSweep::get_prefixed_filename(i_config_id, base_output_file_name);
+	};
+
+	int num_failed = sweep.run(
+			sweep_parallel,
+			sweep_worker_id,
+			i_argc,
+			i_argv,
+			[&](int i_config_id) -> int
+			{
+				setup_config(i_config_id);
+
+				// counters are opened once per process (i.e. per worker) by the threads of this process
+				if (simVars.misc.performance_counters)
+					SimulationBenchmarkTimings::getInstance().setup_performance_counters(std::strtoull(simVars.misc.performance_counters_raw_event.c_str(), nullptr, 16));
+
+				SimulationBenchmarkTimings::getInstance().reset();
+				SimulationBenchmarkTimings::getInstance().main.start();
+
+				int retval = simulation_run();
+
+				SimulationBenchmarkTimings::getInstance().main.stop();
+				SimulationBenchmarkTimings::getInstance().output();
+				std::cout << "[MULE] simVars.timecontrol.current_timestep_nr: " << simVars.timecontrol.current_timestep_nr << std::endl;
+				std::cout << "[MULE] simVars.timecontrol.current_timestep_size: " << simVars.timecontrol.current_timestep_size << std::endl;
+
+				return retval;
+			}
+		);
+
+	for (auto &o : operators)
+	{
+		delete o.second.op;
+		delete o.second.op_nodealiasing;
+	}
+
+	sphereOperators = nullptr;
+	sphereOperators_nodealiasing = nullptr;
+
+	for (auto &r : resolutions)
+	{
+		if (r.second.config == &sphereDataConfigInstance)
+			continue;
+
+		delete r.second.config;
+		delete r.second.config_nodealiasing;
+	}
+
+	sphereDataConfig = &sphereDataConfigInstance;
+	sphereDataConfig_nodealiasing = &sphereDataConfigInstance_nodealiasing;
+
+	std::cout << "[MULE] sweep_num_failed: " << num_failed << std::endl;
+
+	return num_failed;
+}
+
+
+
 int main_real(int i_argc, char *i_argv[])
 {
 
@@ -1044,6 +1570,19 @@ int main_real(int i_argc, char *i_argv[])
 		return -1;
 	}
 
+	if (simVars.sweep.sweep_file != "")
+	{
+		int num_failed = main_sweep(i_argc, i_argv, bogus_var_names);
+
+#if SWEET_MPI
+		MPI_Finalize();
+#endif
+		return ParameterSweep::get_worker_exit_status(num_failed);
+	}
+
+	if (simVars.misc.performance_counters)
+		SimulationBenchmarkTimings::getInstance().setup_performance_counters(std::strtoull(simVars.misc.performance_counters_raw_event.c_str(), nullptr, 16));
+
 	if (simVars.misc.verbosity > 3)
 		std::cout << " + setup SH sphere transformations..." << std::endl;
 
@@ -1266,7 +1805,7 @@ int main_real(int i_argc, char *i_argv[])
 				BraidCore core(MPI_COMM_WORLD, &app);
 				app.setup(core);
 				// Run Simulation
-				core.Drive();
+				app.drive(core);
 			}
 
 			if (simVars.xbraid.xbraid_spatial_coarsening)
@@ -1293,96 +1832,11 @@ int main_real(int i_argc, char *i_argv[])
 		else
 #endif
 		{
-			SimulationInstance *simulationSWE = new SimulationInstance;
-
-			if (simVars.misc.normal_mode_analysis_generation > 0)
-			{
-				simulationSWE->normalmode_analysis();
-			}
-			else
-			{
-				// Do first output before starting timer
-				simulationSWE->timestep_check_output();
-#if SWEET_MPI
-				// Start counting time
-				if (mpi_rank == 0)
-				{
-					std::cout << "********************************************************************************" << std::endl;
-					std::cout << "Parallel performance information: MPI barrier & timer starts here" << std::endl;
-					std::cout << "********************************************************************************" << std::endl;
-				}
-				MPI_Barrier(MPI_COMM_WORLD);
-#endif
-
-				SimulationBenchmarkTimings::getInstance().main_timestepping.start();
-
-				// Main time loop
-				while (true)
-				{
-					// Stop simulation if requested
-					if (simulationSWE->should_quit())
-						break;
-
-					// Test for some output to be done
-					simulationSWE->timestep_check_output();
-
-					// Main call for timestep run
-					simulationSWE->run_timestep();
-
-					// Instability
-					if (simVars.misc.instability_checks)
-					{
-#if SWEET_MPI
-						if (mpi_rank == 0)
-#endif
-						{
-							if (simulationSWE->detect_instability())
-							{
-								std::cout << "INSTABILITY DETECTED" << std::endl;
-								std::cerr << "INSTABILITY DETECTED" << std::endl;
-								// IMPORANT: EXIT IN CASE OF INSTABILITIES
-								exit(1);
-								break;
-							}
-						}
-					}
-				}
-
-				// Stop counting time
-				SimulationBenchmarkTimings::getInstance().main_timestepping.stop();
-
-#if SWEET_MPI
-				MPI_Barrier(MPI_COMM_WORLD);
-#endif
-
-				if (simVars.misc.verbosity > 0)
-					std::cout << std::endl;
-#if SWEET_MPI
-				// Start counting time
-				if (mpi_rank == 0)
-				{
-					std::cout << "********************************************************************************" << std::endl;
-					std::cout << "Parallel performance information: timer stopped here" << std::endl;
-					std::cout << "********************************************************************************" << std::endl;
-				}
-#endif
-
-				// Do some output after the time loop
-				simulationSWE->timestep_check_output();
-			}
+			int retval = simulation_run();
 
-#if SWEET_MPI
-			// Start counting time
-			if (mpi_rank == 0)
-#endif
-			{
-				if (simVars.iodata.output_file_name.size() > 0)
-					std::cout << "[MULE] reference_filenames: " << simulationSWE->output_reference_filenames << std::endl;
-			}
-
-			std::cout << "[MULE] simulation_successfully_finished: 1" << std::endl;
-
-			delete simulationSWE;
+			// IMPORANT: EXIT IN CASE OF INSTABILITIES
+			if (retval != 0)
+				exit(retval);
 		}
 
 		SimulationBenchmarkTimings::getInstance().main.stop();
@@ -1410,6 +1864,10 @@ int main_real(int i_argc, char *i_argv[])
 	}
 
 #if SWEET_MPI
+	// counters of rank 0 are already part of the timing output
+	if (mpi_rank != 0)
+		SimulationBenchmarkTimings::getInstance().output_performance_counters();
+
 	MPI_Finalize();
 #endif
 
@@ -6,13 +6,220 @@
 #define SRC_PROGRAMS_SWE_SPHERE_TIMEINTEGRATORS_SWE_SPHERE_NORMALMODEANALYSIS_HPP_
 
 #include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/NormalModeColumnAssembly.hpp>
+#include <libmath/ArnoldiEigenSolver.hpp>
 
 
 
 class NormalModeAnalysisSphere
 {
+	/*
+	 * Degrees of freedom of the real-valued state in spectral space:
+	 * For each prognostic variable and each mode (n, m) the real part
+	 * and, for m > 0, the imaginary part of the coefficient.
+	 * The imaginary parts of the m = 0 modes are zero for real fields.
+	 */
+	static
+	void setup_dof_map(
+			const SphereData_Config *i_sphereDataConfig,
+			std::vector<std::size_t> &o_dof_idx,
+			std::vector<int> &o_dof_imag
+	)
+	{
+		o_dof_idx.clear();
+		o_dof_imag.clear();
+
+		for (int m = 0; m <= i_sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			for (int n = m; n <= i_sphereDataConfig->spectral_modes_n_max; n++)
+			{
+				std::size_t idx = i_sphereDataConfig->getArrayIndexByModes(n, m);
+
+				o_dof_idx.push_back(idx);
+				o_dof_imag.push_back(0);
+
+				if (m > 0)
+				{
+					o_dof_idx.push_back(idx);
+					o_dof_imag.push_back(1);
+				}
+			}
+		}
+	}
+
+
+
+	/*
+	 * Row of the (transposed) output: Real parts of all prognostic
+	 * variables, then imaginary parts
+	 */
+	static
+	void fill_row(
+			SphereData_Spectral* i_prog[3],
+			int i_max_prog_id,
+			std::vector<double> &o_row
+	)
+	{
+		std::size_t N = i_prog[0]->sphereDataConfig->spectral_array_data_number_of_elements;
+
+		for (int prog_id = 0; prog_id < i_max_prog_id; prog_id++)
+		{
+			for (std::size_t k = 0; k < N; k++)
+			{
+				o_row[prog_id*N+k] = i_prog[prog_id]->spectral_space_data[k].real();
+				o_row[(i_max_prog_id+prog_id)*N+k] = i_prog[prog_id]->spectral_space_data[k].imag();
+			}
+		}
+	}
+
+
 
 public:
+	/*
+	 * Matrix-free normal mode analysis
+	 *
+	 * The time stepper is used as a linear operator on the real-valued
+	 * spectral degrees of freedom and the leading eigenvalues and
+	 * eigenvectors are computed with the Arnoldi method. This requires
+	 * only (a few times) krylov_dim time steps instead of one per
+	 * degree of freedom.
+	 *
+	 * Generation 5: Linearization 1/dt * (U(t+dt) - U(t))
+	 * Generation 15: Propagator over max_timesteps_nr time steps
+	 */
+	template <typename TCallbackClass>
+	static
+	void normal_mode_analysis_arnoldi(
+			SphereData_Spectral* io_prog[3],
+
+			SimulationVariables &i_simVars,
+
+			TCallbackClass *i_class,
+			void(TCallbackClass::* const i_run_timestep_method)(void)
+	)
+	{
+		const SphereData_Config *sphereDataConfig = io_prog[0]->sphereDataConfig;
+		int max_prog_id = 3;
+
+		if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
+			SWEETError("Leapfrog time stepping not supported for matrix-free normal mode analysis");
+
+		int num_timesteps = 1;
+		if (i_simVars.misc.normal_mode_analysis_generation >= 10)
+		{
+			if (i_simVars.timecontrol.max_timesteps_nr > 0)
+				num_timesteps = i_simVars.timecontrol.max_timesteps_nr;
+		}
+
+		std::vector<std::size_t> dof_idx;
+		std::vector<int> dof_imag;
+		setup_dof_map(sphereDataConfig, dof_idx, dof_imag);
+
+		std::size_t num_dofs_per_prog = dof_idx.size();
+		std::size_t num_dofs = max_prog_id*num_dofs_per_prog;
+
+		auto apply = [&](const double *i_x, double *o_y)
+		{
+			// reset time control
+			i_simVars.timecontrol.current_timestep_nr = 0;
+			i_simVars.timecontrol.current_simulation_time = 0;
+
+			for (int prog_id = 0; prog_id < max_prog_id; prog_id++)
+			{
+				io_prog[prog_id]->spectral_set_zero();
+
+				const double *x = i_x + prog_id*num_dofs_per_prog;
+				for (std::size_t i = 0; i < num_dofs_per_prog; i++)
+				{
+					if (dof_imag[i])
+						io_prog[prog_id]->spectral_space_data[dof_idx[i]].imag(x[i]);
+					else
+						io_prog[prog_id]->spectral_space_data[dof_idx[i]].real(x[i]);
+				}
+			}
+
+			for (int i = 0; i < num_timesteps; i++)
+				(i_class->*i_run_timestep_method)();
+
+			for (int prog_id = 0; prog_id < max_prog_id; prog_id++)
+			{
+				const double *x = i_x + prog_id*num_dofs_per_prog;
+				double *y = o_y + prog_id*num_dofs_per_prog;
+
+				for (std::size_t i = 0; i < num_dofs_per_prog; i++)
+				{
+					const std::complex<double> &val = io_prog[prog_id]->spectral_space_data[dof_idx[i]];
+					y[i] = dof_imag[i] ? val.imag() : val.real();
+
+					if (i_simVars.misc.normal_mode_analysis_generation == 5)
+						y[i] = (y[i] - x[i])/i_simVars.timecontrol.current_timestep_size;
+				}
+			}
+		};
+
+		ArnoldiEigenSolver arnoldi;
+		arnoldi.num_eigenvalues = i_simVars.misc.normal_mode_analysis_num_modes;
+		arnoldi.krylov_dim = i_simVars.misc.normal_mode_analysis_krylov_dim;
+		arnoldi.tolerance = i_simVars.misc.normal_mode_analysis_tolerance;
+		arnoldi.verbosity = i_simVars.misc.verbosity;
+
+		arnoldi.solve(num_dofs, apply);
+
+		std::cout << "Arnoldi iterations: " << arnoldi.num_restarts+1 << " restart cycles, " << arnoldi.num_operator_applications << " operator applications for " << num_dofs << " degrees of freedom" << std::endl;
+		if (!arnoldi.converged)
+			std::cout << "WARNING: Arnoldi iterations did not converge" << std::endl;
+
+		// only the first MPI rank writes the output
+		if (!NormalModeColumnAssembly().is_writer())
+			return;
+
+		char buffer_real[1024];
+		const char* filename = i_simVars.iodata.output_file_name.c_str();
+
+		sprintf(buffer_real, filename, "normal_modes_arnoldi", i_simVars.timecontrol.current_timestep_size*num_timesteps*i_simVars.iodata.output_time_scale);
+		std::ofstream file(buffer_real, std::ios_base::trunc);
+		std::cout << "Writing leading normal modes to file '" << buffer_real << "'" << std::endl;
+
+		sprintf(buffer_real, filename, "normal_modes_arnoldi_vectors", i_simVars.timecontrol.current_timestep_size*num_timesteps*i_simVars.iodata.output_time_scale);
+		std::ofstream file_vectors(buffer_real, std::ios_base::trunc);
+
+		file << std::setprecision(20);
+		file_vectors << std::setprecision(20);
+
+		file << "# t " << (num_timesteps*i_simVars.timecontrol.current_timestep_size) << std::endl;
+		file << "# g " << i_simVars.sim.gravitation << std::endl;
+		file << "# h " << i_simVars.sim.h0 << std::endl;
+		file << "# r " << i_simVars.sim.sphere_radius << std::endl;
+		file << "# f " << i_simVars.sim.sphere_rotating_coriolis_omega << std::endl;
+		file << "# converged " << arnoldi.converged << std::endl;
+		file << "# eigenvalue_real\teigenvalue_imag\tresidual" << std::endl;
+
+		for (std::size_t i = 0; i < arnoldi.eigenvalues.size(); i++)
+			file << arnoldi.eigenvalues[i].real() << "\t" << arnoldi.eigenvalues[i].imag() << "\t" << arnoldi.residuals[i] << std::endl;
+
+		/*
+		 * One eigenvector per line: Real parts of the degrees of freedom
+		 * (see setup_dof_map) of all prognostic variables, then imaginary parts
+		 */
+		for (std::size_t i = 0; i < arnoldi.eigenvectors.size(); i++)
+		{
+			const std::vector<std::complex<double>> &x = arnoldi.eigenvectors[i];
+
+			for (std::size_t k = 0; k < num_dofs; k++)
+				file_vectors << x[k].real() << "\t";
+
+			for (std::size_t k = 0; k < num_dofs; k++)
+			{
+				file_vectors << x[k].imag();
+				if (k != num_dofs-1)
+					file_vectors << "\t";
+				else
+					file_vectors << std::endl;
+			}
+		}
+	}
+
+
 	template <typename TCallbackClass>
 	static
 	void normal_mode_analysis(
@@ -23,11 +230,28 @@ public:
 			SimulationVariables &i_simVars,
 
 			TCallbackClass *i_class,
-			void(TCallbackClass::* const i_run_timestep_method)(void)
+			void(TCallbackClass::* const i_run_timestep_method)(void),
+
+			bool i_timestepper_uses_mpi_collectives	///< see SWE_Sphere_TS_interface::uses_mpi_collectives()
 	)
 	{
 		const SphereData_Config *sphereDataConfig = io_prog_phi.sphereDataConfig;
 
+		if (i_simVars.misc.normal_mode_analysis_generation % 10 == 5)
+		{
+			SphereData_Spectral* prog[3] = {&io_prog_phi, &io_prog_vort, &io_prog_div};
+			normal_mode_analysis_arnoldi(prog, i_simVars, i_class, i_run_timestep_method);
+			return;
+		}
+
+		/*
+		 * Columns are distributed across MPI ranks
+		 * (replicated if the time stepper communicates)
+		 */
+		NormalModeColumnAssembly nmca(i_timestepper_uses_mpi_collectives);
+		std::size_t column_id = 0;
+		std::vector<double> row(2*3*sphereDataConfig->spectral_array_data_number_of_elements);
+
 		/*
 		 * Do a normal mode analysis, see
 		 * Hillary Weller, John Thuburn, Collin J. Cotter,
@@ -41,8 +265,12 @@ public:
 		else
 			sprintf(buffer_real, filename, "normal_modes_physical", i_simVars.timecontrol.current_timestep_size*i_simVars.iodata.output_time_scale);
 
-		std::ofstream file(buffer_real, std::ios_base::trunc);
-		std::cout << "Writing normal mode analysis to file '" << buffer_real << "'" << std::endl;
+		std::ofstream file;
+		if (nmca.is_writer())
+		{
+			file.open(buffer_real, std::ios_base::trunc);
+			std::cout << "Writing normal mode analysis to file '" << buffer_real << "'" << std::endl;
+		}
 
 		std::cout << "WARNING: OUTPUT IS TRANSPOSED!" << std::endl;
 
@@ -185,78 +413,71 @@ public:
 				{
 					for (int imag_i = 0; imag_i < 2; imag_i++)
 					{
-						// reset time control
-						i_simVars.timecontrol.current_timestep_nr = 0;
-						i_simVars.timecontrol.current_simulation_time = 0;
-
-						for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-							prog[inner_prog_id]->spectral_set_zero();
+						std::size_t col = column_id++;
+						if (!nmca.is_active(col))
+							continue;
 
-						// activate mode
-						if (imag_i)
-							prog[outer_prog_id]->spectral_space_data[outer_i].imag(1);
-						else
-							prog[outer_prog_id]->spectral_space_data[outer_i].real(1);
-
-						// In case of a multi-step scheme, reset it!
-						if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
+						if (nmca.is_owner(col))
 						{
-							SWEETError("TODO 01943934");
-							//spheredata_timestepping_explicit_leapfrog.resetAndSetup(prog_h, i_simVars.disc.timestepping_order, i_simVars.disc.leapfrog_robert_asselin_filter);
+							// reset time control
+							i_simVars.timecontrol.current_timestep_nr = 0;
+							i_simVars.timecontrol.current_simulation_time = 0;
 
-							i_simVars.timecontrol.current_timestep_size = leapfrog_start_timesteps_size;
+							for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
+								prog[inner_prog_id]->spectral_set_zero();
 
-							for (int i = 0; i < leapfrog_start_num_timesteps; i++)
-								(i_class->*i_run_timestep_method)();
+							// activate mode
+							if (imag_i)
+								prog[outer_prog_id]->spectral_space_data[outer_i].imag(1);
+							else
+								prog[outer_prog_id]->spectral_space_data[outer_i].real(1);
 
-							i_simVars.timecontrol.current_timestep_size = leapfrog_end_timestep_size;
+							// In case of a multi-step scheme, reset it!
+							if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
+							{
+								SWEETError("TODO 01943934");
+								//spheredata_timestepping_explicit_leapfrog.resetAndSetup(prog_h, i_simVars.disc.timestepping_order, i_simVars.disc.leapfrog_robert_asselin_filter);
 
-							(i_class->*i_run_timestep_method)();
+								i_simVars.timecontrol.current_timestep_size = leapfrog_start_timesteps_size;
 
-							i_simVars.timecontrol.current_timestep_size = leapfrog_original_timestep_size;
-						}
-						else
-						{
-							(i_class->*i_run_timestep_method)();
-						}
+								for (int i = 0; i < leapfrog_start_num_timesteps; i++)
+									(i_class->*i_run_timestep_method)();
 
-						for (int i = 1; i < num_timesteps; i++)
-							(i_class->*i_run_timestep_method)();
+								i_simVars.timecontrol.current_timestep_size = leapfrog_end_timestep_size;
 
+								(i_class->*i_run_timestep_method)();
 
+								i_simVars.timecontrol.current_timestep_size = leapfrog_original_timestep_size;
+							}
+							else
+							{
+								(i_class->*i_run_timestep_method)();
+							}
 
-						if (i_simVars.misc.normal_mode_analysis_generation == 2)
-						{
-							/*
-							 * compute
-							 * 1/dt * (U(t+1) - U(t))
-							 */
-							prog[outer_prog_id]->spectral_space_data[outer_i] -= 1.0;
+							for (int i = 1; i < num_timesteps; i++)
+								(i_class->*i_run_timestep_method)();
 
-							for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-								prog[inner_prog_id]->operator*=(1.0/i_simVars.timecontrol.current_timestep_size);
-						}
 
-						for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-						{
-							for (int k = 0; k < sphereDataConfig->spectral_array_data_number_of_elements; k++)
-							{
-								file << prog[inner_prog_id]->spectral_space_data[k].real();
-								file << "\t";
-							}
-						}
 
-						for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-						{
-							for (int k = 0; k < sphereDataConfig->spectral_array_data_number_of_elements; k++)
+							if (i_simVars.misc.normal_mode_analysis_generation == 2)
 							{
-								file << prog[inner_prog_id]->spectral_space_data[k].imag();
-								if (inner_prog_id != max_prog_id-1 || k != sphereDataConfig->spectral_array_data_number_of_elements-1)
-									file << "\t";
-								else
-									file << std::endl;
+								/*
+								 * compute
+								 * 1/dt * (U(t+1) - U(t))
+								 */
+								prog[outer_prog_id]->spectral_space_data[outer_i] -= 1.0;
+
+								for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
+									prog[inner_prog_id]->operator*=(1.0/i_simVars.timecontrol.current_timestep_size);
 							}
+
+							fill_row(prog, max_prog_id, row);
 						}
+
+						nmca.gather(col, row);
+
+						if (nmca.is_writer())
+							nmca.write(file, row);
 					}
 				}
 			}
@@ -265,83 +486,75 @@ public:
 				// iterate over spectral space
 				for (int outer_i = 0; outer_i < sphereDataConfig->spectral_array_data_number_of_elements; outer_i++)
 				{
-					// reset time control
-					i_simVars.timecontrol.current_timestep_nr = 0;
-					i_simVars.timecontrol.current_simulation_time = 0;
-
-					std::cout << "." << std::flush;
-
-					for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-						prog[inner_prog_id]->spectral_set_zero();
+					std::size_t col = column_id++;
+					if (!nmca.is_active(col))
+						continue;
 
-					// activate mode via real coefficient
-					prog[outer_prog_id]->spectral_space_data[outer_i].real(1);
+					if (nmca.is_owner(col))
+					{
+						// reset time control
+						i_simVars.timecontrol.current_timestep_nr = 0;
+						i_simVars.timecontrol.current_simulation_time = 0;
 
+						std::cout << "." << std::flush;
 
-					// In case of a multi-step scheme, reset it!
-					if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
-					{
-						SWEETError("TODO 01839471");
-						//spheredata_timestepping_explicit_leapfrog.resetAndSetup(prog_h, i_simVars.disc.timestepping_order, i_simVars.disc.leapfrog_robert_asselin_filter);
+						for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
+							prog[inner_prog_id]->spectral_set_zero();
 
-						i_simVars.timecontrol.current_timestep_size = leapfrog_start_timesteps_size;
+						// activate mode via real coefficient
+						prog[outer_prog_id]->spectral_space_data[outer_i].real(1);
 
-						for (int i = 0; i < leapfrog_start_num_timesteps; i++)
-							(i_class->*i_run_timestep_method)();
 
-						i_simVars.timecontrol.current_timestep_size = leapfrog_end_timestep_size;
+						// In case of a multi-step scheme, reset it!
+						if (i_simVars.disc.timestepping_method.find("_lf") != std::string::npos)
+						{
+							SWEETError("TODO 01839471");
+							//spheredata_timestepping_explicit_leapfrog.resetAndSetup(prog_h, i_simVars.disc.timestepping_order, i_simVars.disc.leapfrog_robert_asselin_filter);
 
-						(i_class->*i_run_timestep_method)();
+							i_simVars.timecontrol.current_timestep_size = leapfrog_start_timesteps_size;
 
-						i_simVars.timecontrol.current_timestep_size = leapfrog_original_timestep_size;
+							for (int i = 0; i < leapfrog_start_num_timesteps; i++)
+								(i_class->*i_run_timestep_method)();
 
-						if (num_timesteps > 1)
-							SWEETError("Doesn't make sense because the previous time step is half the time step size in advance");
-					}
-					else
-					{
-						(i_class->*i_run_timestep_method)();
-					}
+							i_simVars.timecontrol.current_timestep_size = leapfrog_end_timestep_size;
 
-					for (int i = 1; i < num_timesteps; i++)
-					{
-						(i_class->*i_run_timestep_method)();
-					}
+							(i_class->*i_run_timestep_method)();
 
-					if (i_simVars.misc.normal_mode_analysis_generation == 3)
-					{
-						/*
-						 * Compute
-						 *    1/dt * (U(t+1) - U(t))
-						 * for linearization
-						 */
-						prog[outer_prog_id]->spectral_space_data[outer_i] -= 1.0;
+							i_simVars.timecontrol.current_timestep_size = leapfrog_original_timestep_size;
 
-						for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-							prog[inner_prog_id]->operator*=(1.0/i_simVars.timecontrol.current_timestep_size);
-					}
+							if (num_timesteps > 1)
+								SWEETError("Doesn't make sense because the previous time step is half the time step size in advance");
+						}
+						else
+						{
+							(i_class->*i_run_timestep_method)();
+						}
 
-					for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-					{
-						for (int k = 0; k < sphereDataConfig->spectral_array_data_number_of_elements; k++)
+						for (int i = 1; i < num_timesteps; i++)
 						{
-							file << prog[inner_prog_id]->spectral_space_data[k].real();
-							file << "\t";
+							(i_class->*i_run_timestep_method)();
 						}
-					}
 
-					for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
-					{
-						for (int k = 0; k < sphereDataConfig->spectral_array_data_number_of_elements; k++)
+						if (i_simVars.misc.normal_mode_analysis_generation == 3)
 						{
-							file << prog[inner_prog_id]->spectral_space_data[k].imag();
+							/*
+							 * Compute
+							 *    1/dt * (U(t+1) - U(t))
+							 * for linearization
+							 */
+							prog[outer_prog_id]->spectral_space_data[outer_i] -= 1.0;
 
-							if (inner_prog_id != max_prog_id-1 || k != sphereDataConfig->spectral_array_data_number_of_elements-1)
-								file << "\t";
-							else
-								file << std::endl;
+							for (int inner_prog_id = 0; inner_prog_id < max_prog_id; inner_prog_id++)
+								prog[inner_prog_id]->operator*=(1.0/i_simVars.timecontrol.current_timestep_size);
 						}
+
+						fill_row(prog, max_prog_id, row);
 					}
+
+					nmca.gather(col, row);
+
+					if (nmca.is_writer())
+						nmca.write(file, row);
 				}
 			}
 		}
@@ -8,6 +8,7 @@
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 #include <limits>
+#include <vector>
 #include <sweet/SimulationVariables.hpp>
 
 #if SWEET_PARAREAL || SWEET_XBRAID
@@ -42,6 +43,56 @@ public:
 			double i_simulation_timestamp
 	) = 0;
 
+	/*
+	 * Timestepping of all ensemble members with this time stepper
+	 *
+	 * The default advances one member after the other. Time steppers
+	 * with solvers which can process several right-hand sides at once
+	 * override this.
+	 */
+	virtual void run_timestep_ensemble(
+			std::vector<SphereData_Spectral*> &io_h,	///< prognostic variables of members
+			std::vector<SphereData_Spectral*> &io_u,	///< prognostic variables of members
+			std::vector<SphereData_Spectral*> &io_v,	///< prognostic variables of members
+
+			double i_fixed_dt,
+			double i_simulation_timestamp
+	)
+	{
+		for (std::size_t i = 0; i < io_h.size(); i++)
+			run_timestep(*io_h[i], *io_u[i], *io_v[i], i_fixed_dt, i_simulation_timestamp);
+	}
+
+	/*
+	 * Return true if the solution of previous time steps is stored
+	 * (e.g. for semi-Lagrangian or multistep methods).
+	 * Such time steppers can't be shared by ensemble members.
+	 */
+	virtual bool keeps_state_between_timesteps()
+	{
+		return false;
+	}
+
+	/*
+	 * Return true if the time step size is controlled by the time stepper
+	 * with --dt-adaptive (embedded RK pairs). The accepted and proposed
+	 * time step sizes are returned in simVars.timecontrol.
+	 */
+	virtual bool supports_adaptive_timestepping()
+	{
+		return false;
+	}
+
+	/*
+	 * Return true if each time step communicates over MPI (e.g. REXI
+	 * terms distributed over the ranks). All ranks then have to run
+	 * each time step together.
+	 */
+	virtual bool uses_mpi_collectives()
+	{
+		return false;
+	}
+
 	virtual bool implements_timestepping_method(
 			const std::string &i_timestepping_method
 		) = 0;
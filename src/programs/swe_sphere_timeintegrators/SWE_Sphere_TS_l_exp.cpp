@@ -320,6 +320,8 @@ void SWE_Sphere_TS_l_exp::setup(
 		int i_timestepping_order
 )
 {
+	MemBlockAllocTag memTag("rexi");
+
 	no_coriolis = i_no_coriolis;
 
 	rexiSimVars = &i_rexi;
@@ -429,6 +431,18 @@ void SWE_Sphere_TS_l_exp::setup(
 		if (!retval)
 			SWEETError(std::string("Phi function '")+function_name+std::string("' not provided or not supported"));
 
+		/*
+		 * Only the real part of the REXI terms is used for the real-valued
+		 * prognostic variables, hence conjugate poles lead to the same result
+		 */
+		if (rexiSimVars->conjugate_pairs)
+		{
+			int num_pairs = rexiCoefficients.reduce_conjugate_pairs();
+
+			if (simVars.misc.verbosity > 0)
+				std::cout << "REXI: Merged " << num_pairs << " conjugate pole pairs, remaining poles: " << rexiCoefficients.alphas.size() << std::endl;
+		}
+
 		rexi_alphas = rexiCoefficients.alphas;
 		for (std::size_t n = 0; n < rexi_alphas.size(); n++)
 			rexi_alphas[n] = -rexi_alphas[n];
@@ -464,17 +478,21 @@ void SWE_Sphere_TS_l_exp::setup(
 		}
 		#endif
 
+		int memTagId = MemBlockAlloc::accounting_get_tag_id();
+
 		// use a kind of serialization of the input to avoid threading conflicts in the ComplexFFT generation
 		for (int j = 0; j < num_local_rexi_par_threads; j++)
 		{
 			#if SWEET_THREADING_TIME_REXI
-			#pragma omp parallel for schedule(static,1) default(none) shared(std::cout,std::cerr,j)
+			#pragma omp parallel for schedule(static,1) default(none) shared(std::cout,std::cerr,j,memTagId)
 			#endif
 			for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 			{
 				if (local_thread_id != j)
 					continue;
 
+				MemBlockAllocTag threadMemTag(memTagId);
+
 				#if SWEET_DEBUG && SWEET_THREADING_TIME_REXI
 					if (omp_get_thread_num() != local_thread_id)
 					{
@@ -552,11 +570,17 @@ void SWE_Sphere_TS_l_exp::p_update_coefficients(
 	}
 #endif
 
+	// also called for new time step sizes outside of setup()
+	MemBlockAllocTag memTag("rexi");
+	int memTagId = MemBlockAlloc::accounting_get_tag_id();
+
 	#if SWEET_THREADING_TIME_REXI
-	#pragma omp parallel for schedule(static,1) default(none) shared(std::cout)
+	#pragma omp parallel for schedule(static,1) default(none) shared(std::cout,memTagId)
 	#endif
 	for (int local_thread_id = 0; local_thread_id < num_local_rexi_par_threads; local_thread_id++)
 	{
+		MemBlockAllocTag threadMemTag(memTagId);
+
 		std::size_t start, end;
 		p_get_workload_start_end(start, end, local_thread_id);
 		int local_size = (int)end-(int)start;
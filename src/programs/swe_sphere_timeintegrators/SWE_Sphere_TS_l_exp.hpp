@@ -53,6 +53,18 @@ public:
 	bool implements_timestepping_method(
 				const std::string &i_timestepping_method
 		);
+	/*
+	 * REXI terms are distributed over the MPI ranks
+	 */
+	bool uses_mpi_collectives()
+	{
+#if SWEET_MPI
+		return use_exp_method_rexi;
+#else
+		return false;
+#endif
+	}
+
 	std::string string_id();
 	void setup_auto();
 
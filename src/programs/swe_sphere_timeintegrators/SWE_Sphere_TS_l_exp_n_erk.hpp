@@ -39,6 +39,11 @@ public:
 	}
 
 public:
+	bool uses_mpi_collectives()
+	{
+		return timestepping_l_rexi.uses_mpi_collectives();
+	}
+
 	std::string string_id()
 	{
 		std::string s = "l_exp_n_erk_ver";
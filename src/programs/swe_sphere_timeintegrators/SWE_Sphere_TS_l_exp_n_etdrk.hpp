@@ -23,6 +23,11 @@ class SWE_Sphere_TS_l_exp_n_etdrk	: public SWE_Sphere_TS_interface
 public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
+	bool uses_mpi_collectives()
+	{
+		return ts_phi0_exp.uses_mpi_collectives();
+	}
+
 	std::string string_id();
 	void setup_auto();
 
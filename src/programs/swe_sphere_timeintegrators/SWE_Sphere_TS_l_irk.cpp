@@ -135,6 +135,64 @@ void SWE_Sphere_TS_l_irk::run_timestep(
 
 
 
+/*
+ * Same as run_timestep, but the banded solver for the divergence
+ * processes all members with a single factorization per block
+ */
+void SWE_Sphere_TS_l_irk::run_timestep_ensemble(
+		std::vector<SphereData_Spectral*> &io_phi,	///< prognostic variables of members
+		std::vector<SphereData_Spectral*> &io_vrt,	///< prognostic variables of members
+		std::vector<SphereData_Spectral*> &io_div,	///< prognostic variables of members
+
+		double i_fixed_dt,
+		double i_simulation_timestamp
+)
+{
+	if (no_coriolis)
+	{
+		// Only diagonal solves in spectral space, nothing to batch
+		SWE_Sphere_TS_interface::run_timestep_ensemble(io_phi, io_vrt, io_div, i_fixed_dt, i_simulation_timestamp);
+		return;
+	}
+
+	if (TimeStepSizeChanged::is_changed(timestep_size, i_fixed_dt, true))
+		update_coefficients(i_fixed_dt);
+
+	std::size_t num_members = io_phi.size();
+
+	if (timestepping_order == 2)
+	{
+		/*
+		 * Explicit Euler
+		 */
+		for (std::size_t i = 0; i < num_members; i++)
+			l_erk->run_timestep(*io_phi[i], *io_vrt[i], *io_div[i], dt_explicit, i_simulation_timestamp);
+	}
+
+	double gh0 = simVars.sim.gravitation*simVars.sim.h0;
+	double dt_two_omega = dt_implicit*2.0*simVars.sim.sphere_rotating_coriolis_omega;
+
+	std::vector<SphereData_Spectral> rhs(num_members, SphereData_Spectral(sphereDataConfig));
+	std::vector<const SphereData_Spectral*> rhs_ptr(num_members);
+
+	for (std::size_t i = 0; i < num_members; i++)
+	{
+		rhs[i] = *io_div[i] + ops.implicit_FJinv(*io_vrt[i], dt_two_omega) + ops.implicit_L(*io_phi[i], dt_implicit);
+		rhs_ptr[i] = &rhs[i];
+	}
+
+	// div1 is directly written to io_div
+	sphSolverDiv.solve(rhs_ptr, io_div);
+
+	for (std::size_t i = 0; i < num_members; i++)
+	{
+		*io_phi[i] = *io_phi[i] - dt_implicit*gh0*(*io_div[i]);
+		*io_vrt[i] = ops.implicit_Jinv(*io_vrt[i] - ops.implicit_F(*io_div[i], dt_two_omega), dt_two_omega);
+	}
+}
+
+
+
 void SWE_Sphere_TS_l_irk::update_coefficients(double i_timestep_size)
 {
 	timestep_size = i_timestep_size;
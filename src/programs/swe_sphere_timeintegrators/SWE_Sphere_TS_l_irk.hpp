@@ -110,6 +110,15 @@ public:
 			double i_simulation_timestamp = -1
 	);
 
+	void run_timestep_ensemble(
+			std::vector<SphereData_Spectral*> &io_phi,
+			std::vector<SphereData_Spectral*> &io_vrt,
+			std::vector<SphereData_Spectral*> &io_div,
+
+			double i_fixed_dt,
+			double i_simulation_timestamp
+	);
+
 
 	virtual ~SWE_Sphere_TS_l_irk();
 };
@@ -31,6 +31,11 @@ public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
 	std::string string_id();
+
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
 	void setup_auto();
 
 
@@ -35,6 +35,11 @@ public:
 		return false;
 	}
 
+	bool uses_mpi_collectives()
+	{
+		return timestepping_l_exp.uses_mpi_collectives();
+	}
+
 	std::string string_id()
 	{
 		std::string s = "lg_exp_lc_erk_ver";
@@ -35,6 +35,11 @@ public:
 		return false;
 	}
 
+	bool uses_mpi_collectives()
+	{
+		return timestepping_lg_rexi.uses_mpi_collectives();
+	}
+
 	std::string string_id()
 	{
 		std::string s = "lg_exp_lc_n_erk_ver";
@@ -20,6 +20,11 @@ class SWE_Sphere_TS_lg_exp_lc_n_etdrk	: public SWE_Sphere_TS_interface
 public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
+	bool uses_mpi_collectives()
+	{
+		return ts_phi0_rexi.uses_mpi_collectives();
+	}
+
 	std::string string_id();
 	void setup_auto();
 
@@ -22,7 +22,17 @@ class SWE_Sphere_TS_lg_exp_na_sl_lc_nr_etd_uv	: public SWE_Sphere_TS_interface
 public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
+	bool uses_mpi_collectives()
+	{
+		return ts_phi0_exp.uses_mpi_collectives();
+	}
+
 	std::string string_id();
+
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
 	void setup_auto();
 	void print_help();
 
@@ -118,6 +118,35 @@ void SWE_Sphere_TS_ln_erk::run_timestep(
 	if (i_fixed_dt <= 0)
 		SWEETError("Only constant time step size allowed");
 
+	if (simVars.timecontrol.dt_adaptive)
+	{
+		/*
+		 * Adaptive time stepping with embedded RK pair
+		 *
+		 * The accepted time step size is written back to the time control
+		 * since this is used for the viscosity and the simulation time.
+		 */
+		double dt = i_fixed_dt;
+		double dt_next;
+
+		timestepping_rk.run_timestep_adaptive(
+				this,
+				&SWE_Sphere_TS_ln_erk::euler_timestep_update_pert,
+				io_phi, io_vort, io_div,
+				dt, dt_next,
+				timestepping_order,
+				simVars.timecontrol.dt_adaptive_atol,
+				simVars.timecontrol.dt_adaptive_rtol,
+				simVars.timecontrol.dt_adaptive_min,
+				simVars.timecontrol.dt_adaptive_max,
+				i_simulation_timestamp
+			);
+
+		simVars.timecontrol.current_timestep_size = dt;
+		simVars.timecontrol.adaptive_next_timestep_size = dt_next;
+		return;
+	}
+
 	// standard time stepping
 	timestepping_rk.run_timestep(
 			this,
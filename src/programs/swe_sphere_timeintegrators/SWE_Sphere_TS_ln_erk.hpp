@@ -37,6 +37,11 @@ public:
 		return "ln_erk";
 	}
 
+	bool supports_adaptive_timestepping()
+	{
+		return true;
+	}
+
 	void setup_auto()
 	{
 		setup(timestepping_order);
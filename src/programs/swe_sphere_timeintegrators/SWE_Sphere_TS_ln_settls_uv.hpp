@@ -37,6 +37,11 @@ public:
 
 	std::string string_id();
 
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
+
 	void setup_auto();
 
 
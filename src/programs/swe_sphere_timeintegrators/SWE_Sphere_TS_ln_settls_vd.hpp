@@ -34,6 +34,11 @@ public:
 					);
 	std::string string_id();
 
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
+
 	std::string string_id_storage;
 
 	void setup_auto();
@@ -26,6 +26,16 @@ public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
 	std::string string_id();
+
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
+
+	bool uses_mpi_collectives()
+	{
+		return swe_sphere_ts_l_rexi != nullptr && swe_sphere_ts_l_rexi->uses_mpi_collectives();
+	}
 	void setup_auto();
 
 	std::string string_id_storage;
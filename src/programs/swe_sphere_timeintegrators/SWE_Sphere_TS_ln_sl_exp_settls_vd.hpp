@@ -29,6 +29,16 @@ public:
 	bool implements_timestepping_method(const std::string &i_timestepping_method
 					);
 	std::string string_id();
+
+	bool keeps_state_between_timesteps()
+	{
+		return true;
+	}
+
+	bool uses_mpi_collectives()
+	{
+		return swe_sphere_ts_l_exp != nullptr && swe_sphere_ts_l_exp->uses_mpi_collectives();
+	}
 	void setup_auto();
 	void print_help();
 
@@ -65,8 +65,8 @@ public:
 
 		buffer_size = (sphereDataConfig->spectral_modes_n_max+1)*sizeof(std::complex<double>);
 
-		buffer_in = MemBlockAlloc::alloc< std::complex<double> >(buffer_size);
-		buffer_out = MemBlockAlloc::alloc< std::complex<double> >(buffer_size);
+		buffer_in = MemBlockAlloc::alloc< std::complex<double> >(buffer_size, "SWESphBandedMatrixPhysicalComplex");
+		buffer_out = MemBlockAlloc::alloc< std::complex<double> >(buffer_size, "SWESphBandedMatrixPhysicalComplex");
 	}
 
 
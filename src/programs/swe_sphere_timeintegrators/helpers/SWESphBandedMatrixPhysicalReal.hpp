@@ -12,6 +12,8 @@
 #include <libmath/LapackBandedMatrixSolver.hpp>
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereHelpers_SPHIdentities.hpp>
+#include <vector>
+#include <algorithm>
 
 
 
@@ -739,6 +741,50 @@ public:
 
 		return out;
 	}
+
+
+
+	/**
+	 * Solve for several right-hand sides, e.g. of ensemble members.
+	 *
+	 * Each block of the banded matrix is factorized only once for all RHS.
+	 */
+	void solve(
+			const std::vector<const SphereData_Spectral*> &i_rhs,
+			std::vector<SphereData_Spectral*> &o_x,
+			bool i_ignore_first_mode = false
+	)	const
+	{
+		assert(i_rhs.size() == o_x.size());
+
+		int num_rhs = i_rhs.size();
+		std::vector<std::complex<double>> b((sphereDataConfig->spectral_modes_n_max+1)*num_rhs);
+
+		int m = 0;
+		if (i_ignore_first_mode)
+			m = 1;
+
+		for (; m <= sphereDataConfig->spectral_modes_m_max; m++)
+		{
+			int idx = sphereDataConfig->getArrayIndexByModes(m,m);
+			int size = sphereDataConfig->spectral_modes_n_max+1-m;
+
+			for (int r = 0; r < num_rhs; r++)
+				std::copy(&i_rhs[r]->spectral_space_data[idx], &i_rhs[r]->spectral_space_data[idx+size], &b[r*size]);
+
+			bandedMatrixSolver.solve_diagBandedInverse_Carray(
+							&lhs.data[idx*lhs.num_diagonals],
+							b.data(),
+							b.data(),
+							size,	// size of block
+							m,
+							num_rhs
+					);
+
+			for (int r = 0; r < num_rhs; r++)
+				std::copy(&b[r*size], &b[(r+1)*size], &o_x[r]->spectral_space_data[idx]);
+		}
+	}
 };
 
 
@@ -0,0 +1,200 @@
+/*
+ * test_arnoldi_eigensolver.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Test the matrix-free Arnoldi eigenvalue solver with a dense real matrix
+ * with known eigenvalues
+ */
+
+#include <iostream>
+#include <vector>
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <libmath/ArnoldiEigenSolver.hpp>
+
+
+typedef std::complex<double> complex;
+
+
+
+/*
+ * A = P D P^-1
+ *
+ * D is block diagonal with 2x2 blocks [a, -b; b, a] (eigenvalues a+-ib)
+ * and real eigenvalues on the diagonal.
+ * P = I + 0.5 u v^T is a well conditioned, non-orthogonal matrix.
+ */
+class TestMatrix
+{
+public:
+	int n;
+	std::vector<double> A;
+	std::vector<complex> eigenvalues;
+
+	TestMatrix(int i_n)	:
+		n(i_n)
+	{
+		std::vector<double> D(n*n, 0);
+
+		int i = 0;
+		for (; i+1 < n/2; i += 2)
+		{
+			double r = 1.0 - 0.9*i/n;
+			double phi = 0.3 + 0.1*i;
+			double a = r*std::cos(phi);
+			double b = r*std::sin(phi);
+
+			D[i*n+i] = a;
+			D[i*n+i+1] = -b;
+			D[(i+1)*n+i] = b;
+			D[(i+1)*n+i+1] = a;
+
+			eigenvalues.push_back(complex(a, b));
+			eigenvalues.push_back(complex(a, -b));
+		}
+
+		for (; i < n; i++)
+		{
+			double lambda = (i % 2 == 0 ? 1 : -1)*(0.5 - 0.4*i/n);
+			D[i*n+i] = lambda;
+			eigenvalues.push_back(lambda);
+		}
+
+		std::vector<double> u(n), v(n);
+		for (int k = 0; k < n; k++)
+		{
+			u[k] = std::sin(1.0+k);
+			v[k] = std::cos(2.0+3*k)/n;
+		}
+
+		double vu = 0;
+		for (int k = 0; k < n; k++)
+			vu += v[k]*u[k];
+
+		// P^-1 = I - s u v^T with s = 0.5/(1+0.5 v^T u)
+		double s = 0.5/(1.0+0.5*vu);
+
+		// A = (I + 0.5 u v^T) D (I - s u v^T)
+		std::vector<double> tmp(n*n);
+		for (int r = 0; r < n; r++)
+			for (int c = 0; c < n; c++)
+			{
+				double sum = D[r*n+c];
+				for (int k = 0; k < n; k++)
+					sum -= D[r*n+k]*s*u[k]*v[c];
+				tmp[r*n+c] = sum;
+			}
+
+		A.resize(n*n);
+		for (int r = 0; r < n; r++)
+			for (int c = 0; c < n; c++)
+			{
+				double sum = tmp[r*n+c];
+				for (int k = 0; k < n; k++)
+					sum += 0.5*u[r]*v[k]*tmp[k*n+c];
+				A[r*n+c] = sum;
+			}
+
+		std::stable_sort(eigenvalues.begin(), eigenvalues.end(),
+				[](const complex &a, const complex &b) -> bool { return std::abs(a) > std::abs(b); }
+			);
+	}
+
+
+	void apply(const double *i_x, double *o_y)	const
+	{
+		for (int r = 0; r < n; r++)
+		{
+			double sum = 0;
+			for (int c = 0; c < n; c++)
+				sum += A[r*n+c]*i_x[c];
+			o_y[r] = sum;
+		}
+	}
+};
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	SimulationVariables simVars;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	for (int n : {10, 64, 200})
+	{
+		std::cout << "Matrix size " << n << std::endl;
+
+		TestMatrix m(n);
+
+		ArnoldiEigenSolver arnoldi;
+		arnoldi.num_eigenvalues = 6;
+		arnoldi.krylov_dim = 30;
+		arnoldi.tolerance = 1e-11;
+		arnoldi.max_restarts = 200;
+		arnoldi.verbosity = simVars.misc.verbosity > 2;
+
+		arnoldi.solve(
+				n,
+				[&](const double *i_x, double *o_y) { m.apply(i_x, o_y); }
+			);
+
+		std::cout << " + restarts: " << arnoldi.num_restarts << std::endl;
+		std::cout << " + operator applications: " << arnoldi.num_operator_applications << std::endl;
+
+		if (!arnoldi.converged)
+			SWEETError("Arnoldi iterations did not converge");
+
+		for (std::size_t i = 0; i < arnoldi.eigenvalues.size(); i++)
+		{
+			complex lambda = arnoldi.eigenvalues[i];
+
+			// find closest exact eigenvalue
+			double min_error = std::numeric_limits<double>::infinity();
+			for (std::size_t j = 0; j < m.eigenvalues.size(); j++)
+				min_error = std::min(min_error, std::abs(lambda - m.eigenvalues[j]));
+
+			std::cout << " + eigenvalue " << lambda << ", error " << min_error << std::endl;
+
+			if (min_error > 1e-8)
+				SWEETError("Eigenvalue not found");
+
+			if (std::abs(std::abs(lambda) - std::abs(m.eigenvalues[i])) > 1e-8)
+				SWEETError("Eigenvalues not sorted by magnitude or leading eigenvalue missing");
+
+			// check eigenvector
+			const std::vector<complex> &x = arnoldi.eigenvectors[i];
+			std::vector<double> xr(n), xi(n), yr(n), yi(n);
+			for (int k = 0; k < n; k++)
+			{
+				xr[k] = x[k].real();
+				xi[k] = x[k].imag();
+			}
+			m.apply(xr.data(), yr.data());
+			m.apply(xi.data(), yi.data());
+
+			double residual = 0;
+			for (int k = 0; k < n; k++)
+				residual += std::norm(complex(yr[k], yi[k]) - lambda*x[k]);
+			residual = std::sqrt(residual);
+
+			if (residual > 1e-8)
+				SWEETError("Eigenvector residual too large");
+		}
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * test_grid_layout_transpose.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ * MULE_SCONS_OPTIONS: --sphere-spectral-space=enable
+ *
+ * Compare blocked transposes of grid layouts with element-wise copies
+ */
+
+#include <iostream>
+#include <vector>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <sweet/GridLayoutTranspose.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+
+
+SimulationVariables simVars;
+
+SphereData_Config sphereDataConfigInstance;
+SphereData_Config *sphereDataConfig = &sphereDataConfigInstance;
+
+
+
+void test_transpose(
+		int i_num_rows,
+		int i_num_cols
+)
+{
+	std::vector<double> src(i_num_rows*i_num_cols), dst(i_num_rows*i_num_cols);
+
+	for (std::size_t k = 0; k < src.size(); k++)
+		src[k] = (double)k;
+
+	for (int reverse = 0; reverse < 2; reverse++)
+	{
+		GridLayoutTranspose::transpose(src.data(), i_num_rows, i_num_cols, dst.data(), reverse);
+
+		for (int r = 0; r < i_num_rows; r++)
+			for (int c = 0; c < i_num_cols; c++)
+			{
+				int dst_row = reverse ? i_num_cols-1-c : c;
+				if (dst[dst_row*i_num_rows + r] != src[r*i_num_cols + c])
+					SWEETError("Transpose failed");
+			}
+	}
+
+	// out of place and in place row reversal
+	for (int inplace = 0; inplace < 2; inplace++)
+	{
+		std::vector<double> tmp = src;
+		double *o = inplace ? tmp.data() : dst.data();
+
+		GridLayoutTranspose::reverse_rows(tmp.data(), i_num_rows, i_num_cols, o);
+
+		for (int r = 0; r < i_num_rows; r++)
+			for (int c = 0; c < i_num_cols; c++)
+				if (o[(i_num_rows-1-r)*i_num_cols + c] != src[r*i_num_cols + c])
+					SWEETError("Row reversal failed");
+	}
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	/*
+	 * Sizes which are multiples of and unaligned to the block size
+	 */
+	int sizes[][2] = {{1, 1}, {1, 7}, {7, 1}, {32, 32}, {33, 31}, {64, 96}, {100, 37}, {129, 257}};
+
+	for (auto &size : sizes)
+	{
+		std::cout << "Testing " << size[0] << " x " << size[1] << std::endl;
+		test_transpose(size[0], size[1]);
+	}
+
+	if (simVars.disc.space_res_spectral[0] <= 0)
+	{
+		simVars.disc.space_res_spectral[0] = 127;
+		simVars.disc.space_res_spectral[1] = 127;
+	}
+
+	sphereDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	int num_lon = sphereDataConfig->physical_num_lon;
+	int num_lat = sphereDataConfig->physical_num_lat;
+	std::size_t n = sphereDataConfig->physical_array_data_number_of_elements;
+
+	std::cout << "Testing sphere grid " << num_lon << " x " << num_lat << std::endl;
+
+	std::vector<double> sphere(n), plane(n), sphere2(n), buffer(n);
+
+	for (std::size_t k = 0; k < n; k++)
+		sphere[k] = (double)k;
+
+	GridLayoutTranspose::sphere_to_plane(sphereDataConfig, sphere.data(), plane.data());
+
+	for (int j = 0; j < num_lat; j++)
+		for (int i = 0; i < num_lon; i++)
+		{
+#if SPHERE_DATA_GRID_LAYOUT	== SPHERE_DATA_LAT_CONTINUOUS
+			double value = sphere[i*num_lat + j];
+#else
+			double value = sphere[j*num_lon + i];
+#endif
+			if (plane[(num_lat-1-j)*num_lon + i] != value)
+				SWEETError("Sphere to plane conversion failed");
+		}
+
+	GridLayoutTranspose::plane_to_sphere(sphereDataConfig, plane.data(), sphere2.data());
+
+	if (sphere != sphere2)
+		SWEETError("Plane to sphere conversion failed");
+
+	const double *rows = GridLayoutTranspose::sphere_to_lon_contiguous(sphereDataConfig, sphere.data(), buffer.data());
+
+	for (int j = 0; j < num_lat; j++)
+		for (int i = 0; i < num_lon; i++)
+			if (rows[j*num_lon + i] != plane[(num_lat-1-j)*num_lon + i])
+				SWEETError("Sphere to longitude contiguous conversion failed");
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
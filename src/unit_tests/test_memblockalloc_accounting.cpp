@@ -0,0 +1,155 @@
+/*
+ * test_memblockalloc_accounting.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Accounting of memory per data type and subsystem tag
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <sweet/SWEETError.hpp>
+#include <sweet/MemBlockAlloc.hpp>
+#include <sweet/ScalarDataArray.hpp>
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	// has to be set before first use of the allocator
+	setenv("MEMBLOCKALLOC", "accounting=1", 1);
+
+	if (!MemBlockAlloc::accounting_enabled())
+		SWEETError("Accounting not enabled");
+
+	std::size_t n = 1000;
+	std::size_t bytes = n*sizeof(double);
+
+	{
+		MemBlockAllocTag tag("subsystem_a");
+
+		ScalarDataArray a(n), b(n);
+
+		{
+			// nested tag
+			MemBlockAllocTag tag("subsystem_b");
+
+			std::vector<ScalarDataArray> c(4, ScalarDataArray(n));
+		}
+
+		ScalarDataArray d(n);
+	}
+
+	// untagged data allocated in parallel regions
+	int num_threads = 1;
+#if SWEET_THREADING_SPACE
+	num_threads = omp_get_max_threads();
+#endif
+
+	std::vector<double*> e(num_threads);
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for
+#endif
+	for (int i = 0; i < num_threads; i++)
+		e[i] = MemBlockAlloc::alloc<double>(bytes);
+
+	MemBlockAlloc::output_accounting();
+
+	MemBlockAlloc::AccountingStats a = MemBlockAlloc::accounting_get_tag("subsystem_a");
+	MemBlockAlloc::AccountingStats b = MemBlockAlloc::accounting_get_tag("subsystem_b");
+	MemBlockAlloc::AccountingStats u = MemBlockAlloc::accounting_get_tag("untagged");
+	MemBlockAlloc::AccountingStats s = MemBlockAlloc::accounting_get_type("ScalarDataArray");
+	MemBlockAlloc::AccountingStats in_use = MemBlockAlloc::accounting_get_in_use();
+
+	if (a.current_bytes != 0 || a.peak_bytes != 3*bytes || a.num_allocs != 3)
+		SWEETError("Wrong accounting of subsystem_a");
+
+	// temporary of vector constructor is tagged as well
+	if (b.current_bytes != 0 || b.peak_bytes != 5*bytes || b.num_allocs != 5)
+		SWEETError("Wrong accounting of subsystem_b");
+
+	if (u.current_bytes != num_threads*bytes)
+		SWEETError("Wrong accounting of untagged data");
+
+	if (s.current_bytes != 0 || s.peak_bytes != 7*bytes)
+		SWEETError("Wrong accounting of ScalarDataArray");
+
+	if (in_use.current_bytes != num_threads*bytes || in_use.peak_bytes < 7*bytes)
+		SWEETError("Wrong accounting of memory in use");
+
+	for (int i = 0; i < num_threads; i++)
+		MemBlockAlloc::free(e[i], bytes);
+
+	if (MemBlockAlloc::accounting_get_in_use().current_bytes != 0)
+		SWEETError("Memory in use after releasing all data");
+
+#if SWEET_THREADING_SPACE
+	/*
+	 * Tags of concurrent subsystems (e.g. Parareal thread groups)
+	 */
+	int num_concurrent_threads = 1;
+
+#pragma omp parallel num_threads(2)
+	{
+		MemBlockAllocTag tag(omp_get_thread_num() == 0 ? "concurrent_a" : "concurrent_b");
+
+		// both tags are set before allocating data
+#pragma omp barrier
+
+		ScalarDataArray f(n*(omp_get_thread_num()+1));
+
+#pragma omp master
+		num_concurrent_threads = omp_get_num_threads();
+	}
+
+	if (num_concurrent_threads == 2)
+	{
+		if (MemBlockAlloc::accounting_get_tag("concurrent_a").peak_bytes != bytes)
+			SWEETError("Wrong accounting of concurrent_a");
+
+		if (MemBlockAlloc::accounting_get_tag("concurrent_b").peak_bytes != 2*bytes)
+			SWEETError("Wrong accounting of concurrent_b");
+	}
+
+	/*
+	 * Tag handed over to the threads of a parallel region (e.g. REXI terms)
+	 */
+	{
+		MemBlockAllocTag tag("parallel_region");
+
+		int tag_id = MemBlockAlloc::accounting_get_tag_id();
+
+		std::vector<double*> g(num_threads);
+
+#pragma omp parallel for
+		for (int i = 0; i < num_threads; i++)
+		{
+			MemBlockAllocTag thread_tag(tag_id);
+			g[i] = MemBlockAlloc::alloc<double>(bytes);
+		}
+
+		MemBlockAlloc::AccountingStats p = MemBlockAlloc::accounting_get_tag("parallel_region");
+
+		if (p.current_bytes != num_threads*bytes || p.num_allocs != num_threads)
+			SWEETError("Wrong accounting of allocations in parallel region");
+
+		for (int i = 0; i < num_threads; i++)
+			MemBlockAlloc::free(g[i], bytes);
+	}
+
+	if (MemBlockAlloc::accounting_get_tag("untagged").current_bytes != 0)
+		SWEETError("Untagged memory in use after parallel region");
+#endif
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
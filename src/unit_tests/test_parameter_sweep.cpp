@@ -0,0 +1,226 @@
+/*
+ * test_parameter_sweep.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Test parsing and (concurrent) execution of parameter sweeps
+ */
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <sweet/ParameterSweep.hpp>
+
+
+SimulationVariables simVars;
+
+
+
+/*
+ * Setup simVars for configuration i_config_id and write its parameters
+ */
+int run_config(
+		const ParameterSweep &i_sweep,
+		int i_config_id,
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	std::vector<std::string> args_storage;
+	std::vector<char*> args;
+	i_sweep.get_args(i_config_id, i_argc, i_argv, args_storage, args);
+
+	simVars.reset_to_defaults();
+	if (!simVars.setupFromMainParameters(args.size()-1, args.data(), nullptr, false))
+		return 1;
+
+	// something running in parallel in each process
+	double sum = 0;
+#if SWEET_THREADING
+#pragma omp parallel for reduction(+:sum)
+#endif
+	for (int i = 0; i < 1000; i++)
+		sum += i;
+
+	if (sum != 999*1000/2)
+		return 1;
+
+	std::string filename = ParameterSweep::get_prefixed_filename(i_config_id, "result.txt");
+	std::ofstream file(filename);
+	file << simVars.timecontrol.setup_timestep_size << " " << simVars.timecontrol.max_simulation_time << " " << getpid() << std::endl;
+
+	// failing configuration
+	if (simVars.timecontrol.setup_timestep_size < 0)
+		return 3;
+
+	return 0;
+}
+
+
+
+/*
+ * Check results and return the process id which ran each configuration
+ */
+std::vector<int> check_results(
+		int i_num_configs
+)
+{
+	double dts[] = {10, 20, 30, -1};
+	std::vector<int> pids;
+
+	for (int i = 0; i < i_num_configs; i++)
+	{
+		std::string filename = ParameterSweep::get_prefixed_filename(i, "result.txt");
+		std::ifstream file(filename);
+		if (!file.is_open())
+			SWEETError("Result file not found");
+
+		double dt, t;
+		int pid;
+		file >> dt >> t >> pid;
+		pids.push_back(pid);
+
+		if (dt != dts[i])
+			SWEETError("Wrong time step size");
+
+		// overridden in last configuration only
+		if (t != (i == 3 ? 50 : 100))
+			SWEETError("Program argument not used");
+
+		file.close();
+		std::remove(filename.c_str());
+	}
+
+	return pids;
+}
+
+
+
+int main(
+		int i_argc,
+		char *i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	/*
+	 * Process started as worker for concurrent configurations
+	 */
+	if (simVars.sweep.sweep_worker_id >= 0)
+	{
+		ParameterSweep sweep;
+		sweep.load(simVars.sweep.sweep_file);
+
+		int num_failed = sweep.run(
+				simVars.sweep.sweep_parallel,
+				simVars.sweep.sweep_worker_id,
+				i_argc,
+				i_argv,
+				[&](int i_config_id) -> int
+				{
+					return run_config(sweep, i_config_id, i_argc, i_argv);
+				}
+			);
+
+		return ParameterSweep::get_worker_exit_status(num_failed);
+	}
+
+	if (ParameterSweep::get_prefixed_filename(12, "dir/output_%s.csv") != "dir/sweep012_output_%s.csv")
+		SWEETError("Prefixed file name wrong");
+
+	char tmp_dir_template[] = "/tmp/sweet_sweep_XXXXXX";
+	char *tmp_dir = mkdtemp(tmp_dir_template);
+	if (tmp_dir == nullptr)
+		SWEETError("Unable to create temporary directory");
+
+	if (chdir(tmp_dir) != 0)
+		SWEETError("Unable to change directory");
+
+	{
+		std::ofstream file("sweep.txt");
+		file << "# comment" << std::endl;
+		file << "--dt=10" << std::endl;
+		file << std::endl;
+		file << "--dt=20   # comment" << std::endl;
+		file << "   --dt=30" << std::endl;
+		file << "--dt=-1 -t 50" << std::endl;
+	}
+
+	ParameterSweep sweep;
+	sweep.load("sweep.txt");
+
+	if (sweep.configs.size() != 4)
+		SWEETError("Wrong number of configurations");
+
+	for (int num_parallel : {1, 3})
+	{
+		std::cout << "Running sweep with " << num_parallel << " workers" << std::endl;
+
+		// base program arguments
+		std::vector<std::string> base_storage = {i_argv[0], "-t", "100", "--sweep-file=sweep.txt", "--sweep-parallel="+std::to_string(num_parallel)};
+		std::vector<char*> base_argv;
+		for (std::size_t i = 0; i < base_storage.size(); i++)
+			base_argv.push_back(&base_storage[i][0]);
+
+		int num_failed = sweep.run(
+				num_parallel,
+				-1,
+				base_argv.size(),
+				base_argv.data(),
+				[&](int i_config_id) -> int
+				{
+					return run_config(sweep, i_config_id, base_argv.size(), base_argv.data());
+				}
+			);
+
+		if (num_failed != 1)
+			SWEETError("Exactly one configuration should fail");
+
+		std::vector<int> pids = check_results(sweep.configs.size());
+
+		if (num_parallel == 1)
+		{
+			for (std::size_t i = 0; i < pids.size(); i++)
+				if (pids[i] != getpid())
+					SWEETError("Configuration not run in-process");
+		}
+		else
+		{
+			// strided subsets: worker 0 runs configurations 0 and 3 in-process
+			if (pids[0] != pids[3])
+				SWEETError("Configurations of a worker not run by the same process");
+
+			if (pids[0] == pids[1] || pids[0] == pids[2] || pids[1] == pids[2] || pids[0] == getpid())
+				SWEETError("Configurations of different workers run by the same process");
+
+			for (int w = 0; w < num_parallel; w++)
+			{
+				std::string filename = ParameterSweep::get_worker_log_filename(w);
+				std::ifstream file(filename);
+				if (!file.is_open())
+					SWEETError("Output of worker not found");
+
+				file.close();
+				std::remove(filename.c_str());
+			}
+		}
+
+		std::cout << " + OK" << std::endl;
+	}
+
+	std::remove("sweep.txt");
+	if (chdir("/") != 0 || rmdir(tmp_dir) != 0)
+		std::cerr << "Failed to remove " << tmp_dir << std::endl;
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
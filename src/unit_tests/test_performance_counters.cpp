@@ -0,0 +1,117 @@
+/*
+ * test_performance_counters.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Sample performance counters in timing regions
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <sweet/SWEETError.hpp>
+#include <sweet/Stopwatch.hpp>
+#include <sweet/PerformanceCounters.hpp>
+#include <sweet/SimulationBenchmarkTiming.hpp>
+
+
+
+/*
+ * Some work for all threads
+ */
+double work(
+		std::size_t i_n
+)
+{
+	std::vector<double> data(i_n);
+	double sum = 0;
+
+#if SWEET_THREADING_SPACE
+#pragma omp parallel for reduction(+:sum)
+#endif
+	for (std::size_t i = 0; i < i_n; i++)
+	{
+		data[i] = std::sin((double)i);
+		sum += data[i]*data[i];
+	}
+
+	return sum;
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	SimulationBenchmarkTimings &timings = SimulationBenchmarkTimings::getInstance();
+
+	// start before counters are set up
+	timings.main.start();
+
+	timings.setup_performance_counters();
+
+	PerformanceCounters &pc = PerformanceCounters::getInstance();
+
+	if (!pc.available)
+	{
+		std::cout << "No performance counters available, skipping tests" << std::endl;
+		return 0;
+	}
+
+	timings.main_timestepping.start();
+	double sum = work(1 << 24);
+	timings.main_timestepping.stop();
+
+	// nested calls are sampled only once
+	timings.main_setup.start();
+	timings.main_setup.start();
+	sum += work(1 << 20);
+	timings.main_setup.stop();
+	timings.main_setup.stop();
+
+	timings.main.stop();
+
+	std::cout << "Checksum: " << sum << std::endl;
+
+	timings.output();
+
+	const PerformanceCounterRegion *main_region = timings.main.get_performance_counters();
+	const PerformanceCounterRegion *ts_region = timings.main_timestepping.get_performance_counters();
+	const PerformanceCounterRegion *setup_region = timings.main_setup.get_performance_counters();
+
+	for (int e = 0; e < PerformanceCounters::NUM_EVENTS; e++)
+	{
+		if (!pc.event_available[e])
+			continue;
+
+		double v_main = main_region->get_total(e);
+		double v_ts = ts_region->get_total(e);
+		double v_setup = setup_region->get_total(e);
+
+		std::cout << PerformanceCounters::get_event_name(e) << ": " << v_main << " >= " << v_ts << " + " << v_setup << std::endl;
+
+		if (v_ts <= 0)
+			SWEETError("Counter of timing region is not positive");
+
+		// multiplexed counters are only estimates
+		if (v_main < 0.9*(v_ts + v_setup))
+			SWEETError("Counter of enclosing region is smaller than the ones of its subregions");
+	}
+
+	/*
+	 * Reset
+	 */
+	timings.reset();
+
+	if (ts_region->get_total(PerformanceCounters::EVENT_TASK_CLOCK) != 0)
+		SWEETError("Counters not reset");
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * test_pint_coarse_fidelity.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Test parsing of coarse fidelity levels and the decisions to raise the fidelity
+ */
+
+#include <iostream>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <common_pint/PInT_CoarseFidelity.hpp>
+
+
+
+void check_update(
+		PInT_CoarseFidelity &io_coarseFidelity,
+		double i_residual,
+		double i_tolerance,
+		bool i_expected_raise,
+		int i_expected_level
+)
+{
+	bool raise = io_coarseFidelity.update(i_residual, i_tolerance);
+
+	std::cout << " + residual " << i_residual << ": raise=" << raise << ", level=" << io_coarseFidelity.current_level << std::endl;
+
+	if (raise != i_expected_raise)
+		SWEETError("Unexpected decision to raise the fidelity level");
+
+	if (io_coarseFidelity.current_level != i_expected_level)
+		SWEETError("Unexpected fidelity level");
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	PInT_CoarseFidelity coarseFidelity;
+
+	{
+		std::cout << "Parsing of fidelity levels" << std::endl;
+
+		coarseFidelity.setup("", 10, 0.5);
+		if (coarseFidelity.enabled() || coarseFidelity.num_levels() != 1)
+			SWEETError("Only the configured coarse propagator expected");
+
+		coarseFidelity.setup("dt=400:rexi_ci_n=32,dt=200:order=2:order2=1", 10, 0.5);
+		if (!coarseFidelity.enabled() || coarseFidelity.num_levels() != 3)
+			SWEETError("Two fidelity levels and the configured coarse propagator expected");
+
+		const PInT_CoarseFidelity::Level &l0 = coarseFidelity.levels[0];
+		const PInT_CoarseFidelity::Level &l1 = coarseFidelity.levels[1];
+		if (l0.timestep_size != 400 || l0.rexi_ci_n != 32 || l0.timestepping_order != -1)
+			SWEETError("Invalid parameters of fidelity level 0");
+		if (l1.timestep_size != 200 || l1.timestepping_order != 2 || l1.timestepping_order2 != 1 || l1.rexi_ci_n != -1)
+			SWEETError("Invalid parameters of fidelity level 1");
+
+		SimulationVariables simVars;
+		simVars.timecontrol.current_timestep_size = 100;
+		simVars.disc.timestepping_order = 4;
+		simVars.rexi.ci_n = 128;
+
+		coarseFidelity.apply(0, simVars);
+		if (simVars.timecontrol.current_timestep_size != 400 || simVars.disc.timestepping_order != 4 || simVars.rexi.ci_n != 32)
+			SWEETError("Invalid parameters after applying fidelity level 0");
+	}
+
+	{
+		std::cout << "Raise fidelity if residual approaches tolerance" << std::endl;
+
+		coarseFidelity.setup("dt=400,dt=200", 10, 0.5);
+
+		// first residual: no convergence rate available yet
+		check_update(coarseFidelity, 1.0, 1e-3, false, 0);
+		check_update(coarseFidelity, 0.1, 1e-3, false, 0);
+
+		// below switch_factor*tolerance
+		check_update(coarseFidelity, 0.009, 1e-3, true, 1);
+
+		// convergence rate of the new level is not known: no stagnation detected
+		check_update(coarseFidelity, 0.02, 1e-3, false, 1);
+	}
+
+	{
+		std::cout << "Raise fidelity if convergence stagnates" << std::endl;
+
+		coarseFidelity.setup("dt=400,dt=200", 10, 0.5);
+
+		check_update(coarseFidelity, 1.0, 1e-6, false, 0);
+
+		// reduced by a factor of 0.25 < max_rate
+		check_update(coarseFidelity, 0.25, 1e-6, false, 0);
+
+		// reduced by a factor of 0.8 > max_rate
+		check_update(coarseFidelity, 0.2, 1e-6, true, 1);
+
+		check_update(coarseFidelity, 0.1, 1e-6, false, 1);
+		check_update(coarseFidelity, 0.09, 1e-6, true, 2);
+
+		// configured coarse propagator is never switched
+		check_update(coarseFidelity, 0.09, 1e-6, false, 2);
+		check_update(coarseFidelity, 1e-9, 1e-6, false, 2);
+	}
+
+	{
+		std::cout << "No threshold decision without tolerance" << std::endl;
+
+		coarseFidelity.setup("dt=400", 10, 0.5);
+
+		check_update(coarseFidelity, 1e-12, 0, false, 0);
+		check_update(coarseFidelity, 1e-13, 0, false, 0);
+		check_update(coarseFidelity, 1e-13, 0, true, 1);
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -78,6 +78,115 @@ void setupData123(
 	io_data.loadPlaneDataPhysical(tmp);
 }
 
+/*
+ * Wavenumbers of the spectral coefficient (j, i)
+ *
+ * \return false if the coefficient is not within the spectral iteration ranges
+ */
+bool getWavenumbers(
+		const PlaneDataConfig *i_planeDataConfig,
+		std::size_t i_j,
+		std::size_t i_i,
+		int &o_kx,
+		int &o_ky
+)
+{
+	const std::size_t (*ranges)[2][2] = i_planeDataConfig->spectral_data_iteration_ranges;
+
+	if (i_i < ranges[0][0][0] || i_i >= ranges[0][0][1])
+		return false;
+
+	o_kx = i_i;
+
+	if (i_j >= ranges[0][1][0] && i_j < ranges[0][1][1])
+	{
+		o_ky = i_j;
+		return true;
+	}
+
+	if (i_j >= ranges[1][1][0] && i_j < ranges[1][1][1])
+	{
+		o_ky = (int)i_j - (int)ranges[1][1][1];
+		return true;
+	}
+
+	return false;
+}
+
+
+/*
+ * Spectral coefficient (j, i) of the wavenumbers (kx, ky)
+ *
+ * \return false if these wavenumbers are not within the spectral iteration ranges
+ */
+bool getCoefficient(
+		const PlaneDataConfig *i_planeDataConfig,
+		int i_kx,
+		int i_ky,
+		std::size_t &o_j,
+		std::size_t &o_i
+)
+{
+	for (std::size_t j = 0; j < i_planeDataConfig->spectral_data_size[1]; j++)
+	{
+		for (std::size_t i = 0; i < i_planeDataConfig->spectral_data_size[0]; i++)
+		{
+			int kx, ky;
+			if (getWavenumbers(i_planeDataConfig, j, i, kx, ky) && kx == i_kx && ky == i_ky)
+			{
+				o_j = j;
+				o_i = i;
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+/*
+ * Compare the remapped data i_dst with i_src:
+ * Modes existing in both configurations must be preserved (up to the
+ * normalization of the FFT), all other modes must be zero.
+ *
+ * \return maximum error
+ */
+double testRemapSharedAndPaddedModes(
+		const PlaneData_Spectral &i_src,
+		const PlaneData_Spectral &i_dst
+)
+{
+	const PlaneDataConfig *src_config = i_src.planeDataConfig;
+	const PlaneDataConfig *dst_config = i_dst.planeDataConfig;
+
+	double rescale =
+			(double)(dst_config->physical_array_data_number_of_elements)
+			/
+			(double)(src_config->physical_array_data_number_of_elements);
+
+	double error = 0;
+	for (std::size_t j = 0; j < dst_config->spectral_data_size[1]; j++)
+	{
+		for (std::size_t i = 0; i < dst_config->spectral_data_size[0]; i++)
+		{
+			std::complex<double> expected = 0;
+
+			int kx, ky;
+			std::size_t src_j, src_i;
+			if (	getWavenumbers(dst_config, j, i, kx, ky) &&
+					getCoefficient(src_config, kx, ky, src_j, src_i)
+			)
+				expected = rescale*i_src.spectral_get(src_j, src_i);
+
+			error = std::max(error, std::abs(i_dst.spectral_get(j, i) - expected));
+		}
+	}
+
+	return error;
+}
+
+
 int main(int i_argc, char *i_argv[])
 {
 	// override flag
@@ -144,6 +253,29 @@ int main(int i_argc, char *i_argv[])
 
 			PlaneDataConfig *planeDataConfigDst = &planeDataConfigInstanceDst;
 
+			{
+				std::cout << "TESTING for preserved shared modes and zero padded modes" << std::endl;
+
+				setupData123(a);
+
+				PlaneData_Spectral b = a.spectral_returnWithDifferentModes(planeDataConfigDst);
+
+				double error = testRemapSharedAndPaddedModes(a, b);
+				if (error > epsilon)
+				{
+					std::cout << "Spectral data of A:" << std::endl;
+					a.print_spectralData_zeroNumZero();
+
+					std::cout << "Spectral data of b:" << std::endl;
+					b.print_spectralData_zeroNumZero();
+
+					std::cout << "Error: " << error << std::endl;
+					SWEETError("Remapping must preserve shared modes and zero all other modes!");
+				}
+
+				std::cout << "PASSED (shared/padded modes) with error of " << error << std::endl;
+			}
+
 			/*
 			 * Iterate over relative frequencies
 			 * Only iterate up to real_modes/2 frequency since higher frequencies would be only
@@ -239,6 +239,72 @@ int main(int i_argc, char *i_argv[])
 							/ (norm_fft_x + norm_fft_y) // for second laplace operator
 							;
 
+					/*
+					 * Fused operators need to match the ones based on the full operator arrays
+					 */
+					{
+						PlaneData_Spectral g_spec = op.diff_c_x(h_spec) + h_spec;
+
+						double scale = op.diff_c_x(h_spec).toPhys().physical_reduce_max_abs() + op.diff_c_y(h_spec).toPhys().physical_reduce_max_abs();
+
+						double err_fused = std::max({
+								(op.diff_x(h_spec) - op.diff_c_x(h_spec)).toPhys().physical_reduce_max_abs(),
+								(op.diff_y(h_spec) - op.diff_c_y(h_spec)).toPhys().physical_reduce_max_abs(),
+								(op.div(h_spec, g_spec) - (op.diff_c_x(h_spec) + op.diff_c_y(g_spec))).toPhys().physical_reduce_max_abs(),
+								(op.vort(h_spec, g_spec) - (op.diff_c_x(g_spec) - op.diff_c_y(h_spec))).toPhys().physical_reduce_max_abs()
+							}) / scale;
+
+						double err_fused_J = (op.J(h_spec, g_spec) - (op.diff_c_x(h_spec)*op.diff_c_y(g_spec) - op.diff_c_y(h_spec)*op.diff_c_x(g_spec))).toPhys().physical_reduce_max_abs() / (scale*scale);
+
+						std::cout << " + error fused operators = " << err_fused << std::endl;
+						std::cout << " + error fused Jacobian = " << err_fused_J << std::endl;
+
+						if (std::max(err_fused, err_fused_J) > eps)
+							SWEETError("Fused operators differ from operators based on full arrays!");
+					}
+
+					/*
+					 * Blocked and fused stencils need to match a direct periodic evaluation
+					 */
+					{
+						PlaneData_Physical h_phys = h_spec.toPhys();
+
+						PlaneData_Physical avg_f_x(planeDataConfig), avg_f_y(planeDataConfig);
+						PlaneData_Physical avg_b_x(planeDataConfig), avg_b_y(planeDataConfig);
+
+						h_phys.kernel_apply_fused(
+								{&op.avg_f_x, &op.avg_f_y, &op.avg_b_x, &op.avg_b_y},
+								{&avg_f_x, &avg_f_y, &avg_b_x, &avg_b_y}
+							);
+
+						int rx = planeDataConfig->physical_res[0];
+						int ry = planeDataConfig->physical_res[1];
+
+						double err_stencil = 0;
+						for (int j = 0; j < ry; j++)
+						{
+							for (int i = 0; i < rx; i++)
+							{
+								double h = h_phys.physical_get(j, i);
+
+								err_stencil = std::max({
+										err_stencil,
+										std::abs(avg_f_x.physical_get(j, i) - 0.5*(h + h_phys.physical_get(j, (i+1) % rx))),
+										std::abs(avg_f_y.physical_get(j, i) - 0.5*(h + h_phys.physical_get((j+1) % ry, i))),
+										std::abs(avg_b_x.physical_get(j, i) - 0.5*(h + h_phys.physical_get(j, (i-1+rx) % rx))),
+										std::abs(avg_b_y.physical_get(j, i) - 0.5*(h + h_phys.physical_get((j-1+ry) % ry, i)))
+									});
+							}
+						}
+
+						err_stencil = std::max(err_stencil, (op.avg_b_x(h_phys) - avg_b_x).physical_reduce_max_abs());
+
+						std::cout << " + error fused stencils = " << err_stencil << std::endl;
+
+						if (err_stencil > eps)
+							SWEETError("Fused stencils differ from direct evaluation!");
+					}
+
 					if (simVars.disc.space_use_spectral_basis_diffs)
 					{
 						std::cout << "frequency = " << freq_x << " of " << simVars.disc.space_res_physical[0] / 2 << std::endl;
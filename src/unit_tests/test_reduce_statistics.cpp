@@ -0,0 +1,163 @@
+/*
+ * MULE_SCONS_OPTIONS: --plane-spectral-space=enable
+ *
+ * Test fused single-pass reductions against the individual reductions
+ */
+
+
+#include <sweet/plane/PlaneData_Spectral.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/ScalarDataArray.hpp>
+#include <sweet/ReduceStatistics.hpp>
+#include <sweet/SWEETError.hpp>
+
+#include <iostream>
+#include <cmath>
+#include <string>
+
+#if SWEET_THREADING_SPACE
+	#include <omp.h>
+#endif
+
+// Plane data config
+PlaneDataConfig planeDataConfigInstance;
+PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
+
+SimulationVariables simVars;
+
+
+
+void check(
+		double i_value,
+		double i_ref,
+		const std::string &i_name
+)
+{
+	double error = std::abs(i_value - i_ref)/std::max(1.0, std::abs(i_ref));
+
+	std::cout << " + " << i_name << ": " << i_value << " (ref: " << i_ref << ", error: " << error << ")" << std::endl;
+
+	if (error > 1e-12)
+		SWEETError("Error too large for " + i_name);
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	if (simVars.disc.space_res_physical[0] <= 0)
+		simVars.disc.space_res_physical[0] = 128;
+	if (simVars.disc.space_res_physical[1] <= 0)
+		simVars.disc.space_res_physical[1] = 128;
+
+	planeDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	PlaneData_Physical h(planeDataConfig);
+	h.physical_update_lambda_array_indices(
+		[&](int i, int j, double &io_data)
+		{
+			io_data = std::sin(0.1*i + 1.0)*std::cos(0.3*j) + 0.5;
+		}
+	);
+
+	{
+		std::cout << "Plane physical data" << std::endl;
+		ReduceStatistics stats = h.physical_reduce_statistics();
+
+		check(stats.min, h.physical_reduce_min(), "min");
+		check(stats.max, h.physical_reduce_max(), "max");
+		check(stats.max_abs, h.physical_reduce_max_abs(), "max_abs");
+		check(stats.sum, h.physical_reduce_sum_quad(), "sum");
+		check(stats.rms(), h.physical_reduce_rms(), "rms");
+		check(stats.integral, h.physical_reduce_sum_quad()/(double)planeDataConfig->physical_array_data_number_of_elements, "integral");
+
+		if (stats.nan_or_inf)
+			SWEETError("Invalid NaN/Inf detection");
+	}
+
+	{
+		std::cout << "Plane spectral data" << std::endl;
+		PlaneData_Spectral h_spec(planeDataConfig);
+		h_spec.loadPlaneDataPhysical(h);
+
+		ReduceStatistics stats = h_spec.spectral_reduce_statistics();
+
+		// spectral_reduce_max_abs() returns the squared modulus
+		check(stats.max_abs*stats.max_abs, h_spec.spectral_reduce_max_abs(), "max_abs");
+	}
+
+	{
+		std::cout << "Scalar data array" << std::endl;
+		ScalarDataArray a(1000003);
+		for (std::size_t i = 0; i < a.number_of_elements; i++)
+			a.scalar_data[i] = std::cos((double)i);
+
+		ReduceStatistics stats = a.reduce_statistics();
+
+		check(stats.min, a.reduce_min(), "min");
+		check(stats.max, a.reduce_max(), "max");
+		check(stats.max_abs, a.reduce_maxAbs(), "max_abs");
+		check(stats.sum, a.reduce_sum_quad(), "sum");
+
+		/*
+		 * Deterministic reductions must be bitwise identical for any number of threads
+		 */
+		auto weight = [](std::size_t i) -> double { return 1.0/(double)(i+1); };
+
+		ReduceStatistics stats_det = a.reduce_statistics(true);
+		ReduceStatistics stats_det_weighted = ReduceStatistics::reduce_weighted(a.scalar_data, a.number_of_elements, weight, true);
+
+#if SWEET_THREADING_SPACE
+		int max_threads = omp_get_max_threads();
+
+		for (int num_threads : {1, 2, 3, 7})
+		{
+			omp_set_num_threads(num_threads);
+#else
+		{
+			int num_threads = 1;
+#endif
+			ReduceStatistics s = a.reduce_statistics(true);
+			ReduceStatistics s_weighted = ReduceStatistics::reduce_weighted(a.scalar_data, a.number_of_elements, weight, true);
+
+			if (	s.min != stats_det.min || s.max != stats_det.max || s.max_abs != stats_det.max_abs ||
+					s.sum != stats_det.sum || s.sum_sqr != stats_det.sum_sqr ||
+					s_weighted.integral != stats_det_weighted.integral
+			)
+				SWEETError("Deterministic reduction not reproducible with " + std::to_string(num_threads) + " threads");
+		}
+#if SWEET_THREADING_SPACE
+		omp_set_num_threads(max_threads);
+#endif
+
+		std::cout << " + deterministic: OK" << std::endl;
+
+		/*
+		 * NaN and Inf detection
+		 */
+		a.scalar_data[a.number_of_elements/2] = std::numeric_limits<double>::quiet_NaN();
+		if (!a.reduce_statistics().nan_or_inf || !a.reduce_statistics(true).nan_or_inf)
+			SWEETError("NaN not detected");
+
+		a.scalar_data[a.number_of_elements/2] = -std::numeric_limits<double>::infinity();
+		if (!a.reduce_statistics().nan_or_inf)
+			SWEETError("Inf not detected");
+
+		// Finite values with an overflowing square must not be reported
+		a.scalar_data[a.number_of_elements/2] = 1e200;
+		if (a.reduce_statistics().nan_or_inf)
+			SWEETError("Large finite value detected as NaN/Inf");
+
+		std::cout << " + NaN/Inf detection: OK" << std::endl;
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * test_rexi_coefficients_cache.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ *
+ * Test the persistent on-disk cache of REXI coefficients
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <rexi/REXI.hpp>
+#include <rexi/REXICoefficients.hpp>
+#include <rexi/REXICoefficientsCache.hpp>
+
+
+typedef double T;
+
+
+
+void compare(
+		const REXICoefficients<T> &i_a,
+		const REXICoefficients<T> &i_b
+)
+{
+	if (i_a.alphas.size() != i_b.alphas.size() || i_a.betas.size() != i_b.betas.size())
+		SWEETError("Number of coefficients differ");
+
+	for (std::size_t i = 0; i < i_a.alphas.size(); i++)
+		if (i_a.alphas[i] != i_b.alphas[i] || i_a.betas[i] != i_b.betas[i])
+			SWEETError("Coefficients differ");
+
+	if (i_a.gamma != i_b.gamma)
+		SWEETError("Gamma differs");
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	SimulationVariables simVars;
+
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	char cache_dir_template[] = "/tmp/sweet_rexi_cache_XXXXXX";
+	char *cache_dir = mkdtemp(cache_dir_template);
+	if (cache_dir == nullptr)
+		SWEETError("Unable to create temporary directory");
+
+	EXP_SimulationVariables &rexiSimVars = simVars.rexi;
+	rexiSimVars.exp_method = "terry";
+	rexiSimVars.terry_h = 0.2;
+	rexiSimVars.terry_M = 64;
+
+	/*
+	 * Reference without cache
+	 */
+	REXICoefficients<T> ref;
+	REXI<T>::load(&rexiSimVars, "phi0", ref, 0);
+
+	rexiSimVars.rexi_coefficients_cache = cache_dir;
+
+	/*
+	 * Cache miss: Compute and store coefficients
+	 */
+	std::string key = REXICoefficientsCache<T>::key_terry("phi0", rexiSimVars.terry_h, rexiSimVars.terry_M, rexiSimVars.terry_L, rexiSimVars.terry_reduce_to_half, rexiSimVars.terry_normalization);
+
+	{
+		REXICoefficients<T> c;
+		std::string name;
+		if (REXICoefficientsCache<T>::load(cache_dir, key, c.alphas, c.betas, c.gamma, name))
+			SWEETError("Cache should be empty");
+
+		REXI<T>::load(&rexiSimVars, "phi0", c, 0);
+		compare(ref, c);
+	}
+
+	/*
+	 * Cache hit: Coefficients must be bitwise identical
+	 */
+	{
+		REXICoefficients<T> c;
+		std::string name;
+		if (!REXICoefficientsCache<T>::load(cache_dir, key, c.alphas, c.betas, c.gamma, name))
+			SWEETError("Coefficients not found in cache");
+
+		if (name != "phi0")
+			SWEETError("Function name mismatch");
+
+		compare(ref, c);
+		std::cout << " + cache hit: OK" << std::endl;
+	}
+
+	/*
+	 * Different parameters must not hit the cache
+	 */
+	{
+		REXICoefficients<T> c;
+		std::string name;
+		std::string key2 = REXICoefficientsCache<T>::key_terry("phi0", rexiSimVars.terry_h*0.5, rexiSimVars.terry_M, rexiSimVars.terry_L, rexiSimVars.terry_reduce_to_half, rexiSimVars.terry_normalization);
+		if (REXICoefficientsCache<T>::load(cache_dir, key2, c.alphas, c.betas, c.gamma, name))
+			SWEETError("Cache hit for different parameters");
+
+		std::cout << " + cache miss for different parameters: OK" << std::endl;
+	}
+
+	/*
+	 * Different floating point types must not share cache entries
+	 */
+	{
+		std::string key_float = REXICoefficientsCache<float>::key_terry("phi0", rexiSimVars.terry_h, rexiSimVars.terry_M, rexiSimVars.terry_L, rexiSimVars.terry_reduce_to_half, rexiSimVars.terry_normalization);
+		if (key_float == key)
+			SWEETError("Identical keys for different floating point types");
+
+		std::cout << " + keys for different floating point types: OK" << std::endl;
+	}
+
+	/*
+	 * T-REXI doesn't provide gamma: The cache must not store or overwrite the caller's gamma
+	 */
+	{
+		REXICoefficients<T> c;
+		std::string name;
+		if (!REXICoefficientsCache<T>::load(cache_dir, key, c.alphas, c.betas, c.gamma, name))
+			SWEETError("Coefficients not found in cache");
+
+		if (c.gamma != std::complex<T>(0))
+			SWEETError("Gamma of the caller stored in the cache");
+
+		// cache hit
+		c.gamma = 123.0;
+		REXI<T>::load(&rexiSimVars, "phi0", c.alphas, c.betas, c.gamma, 0);
+		if (c.gamma != std::complex<T>(123.0))
+			SWEETError("Gamma of the caller overwritten by the cache");
+
+		// cache miss
+		rexiSimVars.terry_M = 32;
+		REXI<T>::load(&rexiSimVars, "phi0", c.alphas, c.betas, c.gamma, 0);
+		rexiSimVars.terry_M = 64;
+		if (c.gamma != std::complex<T>(123.0))
+			SWEETError("Gamma of the caller overwritten");
+
+		std::string key_M32 = REXICoefficientsCache<T>::key_terry("phi0", rexiSimVars.terry_h, 32, rexiSimVars.terry_L, rexiSimVars.terry_reduce_to_half, rexiSimVars.terry_normalization);
+		if (!REXICoefficientsCache<T>::load(cache_dir, key_M32, c.alphas, c.betas, c.gamma, name) || c.gamma != std::complex<T>(0))
+			SWEETError("Gamma of the caller stored in the cache");
+
+		std::cout << " + gamma untouched: OK" << std::endl;
+	}
+
+	/*
+	 * File-based coefficients
+	 */
+	{
+		std::string filename = std::string(cache_dir) + "/coeffs.txt";
+
+		{
+			// Binary format, see REXICoefficients::load_from_file
+			double gamma[2] = {0.5, 0};
+			double alphas[4] = {1.0, -3.2, 2.3, 3};
+			double betas[4] = {5.1, -1, 3, 1.3};
+
+			std::ofstream file(filename, std::ios::out | std::ios::binary);
+			file << "# N 2" << std::endl;
+			file << "# function_name phi0" << std::endl;
+			file << "# binary 1" << std::endl;
+			file << "# gamma" << std::endl;
+			file.write((const char*)gamma, sizeof(gamma));
+			file << "# alphas" << std::endl;
+			file.write((const char*)alphas, sizeof(alphas));
+			file << "# betas" << std::endl;
+			file.write((const char*)betas, sizeof(betas));
+		}
+
+		REXICoefficients<T> c_ref;
+		c_ref.load_from_file(filename);
+
+		REXICoefficients<T> c_store;
+		c_store.load_from_file(filename, cache_dir);
+
+		REXICoefficients<T> c_load;
+		c_load.load_from_file(filename, cache_dir);
+
+		compare(c_ref, c_store);
+		compare(c_ref, c_load);
+
+		if (c_load.function_name != c_ref.function_name)
+			SWEETError("Function name mismatch");
+
+		std::cout << " + file coefficients: OK" << std::endl;
+	}
+
+	std::string cmd = std::string("rm -rf ") + cache_dir;
+	if (system(cmd.c_str()) != 0)
+		std::cerr << "Failed to remove " << cache_dir << std::endl;
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -243,6 +243,17 @@ int main(
 				simVars.misc.verbosity
 			);
 
+		/*
+		 * The linear operator is real-valued for the stiffness below
+		 * and we only use the real part of the solution
+		 */
+		if (simVars.rexi.conjugate_pairs)
+		{
+			std::size_t N = rexiCoefficients.alphas.size();
+			int num_pairs = rexiCoefficients.reduce_conjugate_pairs();
+			std::cout << "Merged " << num_pairs << " conjugate pairs, poles: " << N << " -> " << rexiCoefficients.alphas.size() << std::endl;
+		}
+
 		/*
 		 * Initial conditions: U(0)
 		 *
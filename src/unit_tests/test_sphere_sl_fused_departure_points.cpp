@@ -0,0 +1,170 @@
+/*
+ * test_sphere_sl_fused_departure_points.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ * MULE_SCONS_OPTIONS: --sphere-spectral-space=enable
+ *
+ * Compare the fused computation of semi-Lagrangian departure points with
+ * the array-based one for all trajectory methods
+ */
+
+#include <iostream>
+#include <cmath>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/sphere/SphereOperators_SphereData.hpp>
+#include <sweet/sphere/SphereTimestepping_SemiLagrangian.hpp>
+
+
+SimulationVariables simVars;
+
+SphereData_Config sphereDataConfigInstance;
+SphereData_Config *sphereDataConfig = &sphereDataConfigInstance;
+
+
+
+/*
+ * Compute departure points with the fused and array-based kernel
+ *
+ * \return max. difference of the departure points in Cartesian space
+ */
+double compare_departure_points(
+		const SphereData_Physical &i_u_prev,
+		const SphereData_Physical &i_v_prev,
+		const SphereData_Physical &i_u,
+		const SphereData_Physical &i_v,
+		SphereTimestepping_SemiLagrangian::DeparturePointStatistics &o_stats
+)
+{
+	SphereTimestepping_SemiLagrangian sl(simVars, sphereDataConfig);
+
+	ScalarDataArray lon_fused, lat_fused;
+	sl.semi_lagrangian_fused_departure_points = true;
+	sl.semi_lag_departure_points_settls_specialized(i_u_prev, i_v_prev, i_u, i_v, lon_fused, lat_fused);
+	o_stats = sl.departure_points_stats;
+
+	ScalarDataArray lon_arrays, lat_arrays;
+	sl.semi_lagrangian_fused_departure_points = false;
+	sl.semi_lag_departure_points_settls_specialized(i_u_prev, i_v_prev, i_u, i_v, lon_arrays, lat_arrays);
+
+	double max_error = 0;
+	for (std::size_t i = 0; i < lon_fused.number_of_elements; i++)
+	{
+		double x0, y0, z0, x1, y1, z1;
+		SWEETVectorMath::point_latlon_to_cartesian__scalar(lon_fused[i], lat_fused[i], x0, y0, z0);
+		SWEETVectorMath::point_latlon_to_cartesian__scalar(lon_arrays[i], lat_arrays[i], x1, y1, z1);
+
+		max_error = std::max(max_error, std::abs(x0-x1) + std::abs(y0-y1) + std::abs(z0-z1));
+	}
+
+	return max_error;
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	if (simVars.disc.space_res_spectral[0] <= 0)
+	{
+		simVars.disc.space_res_spectral[0] = 64;
+		simVars.disc.space_res_spectral[1] = 64;
+	}
+
+	sphereDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	/*
+	 * Velocities scaled by dt/radius on the unit sphere: solid body
+	 * rotation around a tilted axis plus a deformational component
+	 */
+	double dt_scale = 0.05;
+	SphereData_Physical u(sphereDataConfig), v(sphereDataConfig);
+	SphereData_Physical u_prev(sphereDataConfig), v_prev(sphereDataConfig);
+
+	u.physical_update_lambda(
+		[&](double lon, double lat, double &o_data)
+		{
+			o_data = dt_scale*(std::cos(lat)*std::cos(0.3) + std::sin(lat)*std::cos(lon)*std::sin(0.3) + 0.3*std::sin(2.0*lon)*std::cos(lat));
+		}
+	);
+	v.physical_update_lambda(
+		[&](double lon, double lat, double &o_data)
+		{
+			o_data = dt_scale*(-std::sin(lon)*std::sin(0.3) + 0.2*std::cos(lon)*std::cos(lat));
+		}
+	);
+
+	u_prev = 0.9*u;
+	v_prev = 1.1*v;
+
+	simVars.disc.semi_lagrangian_max_iterations = 10;
+	simVars.disc.semi_lagrangian_approximate_sphere_geometry = 0;
+
+	for (int order : {1, 2})
+	{
+		for (std::string method : {"settls", "canonical", "midpoint"})
+		{
+			if (order == 1 && method != "settls")
+				continue;
+
+			simVars.disc.timestepping_order = order;
+			simVars.disc.semi_lagrangian_departure_point_method = method;
+
+			/*
+			 * Without convergence threshold, both kernels do all iterations
+			 */
+			simVars.disc.semi_lagrangian_convergence_threshold = -1;
+
+			SphereTimestepping_SemiLagrangian::DeparturePointStatistics stats;
+			double error = compare_departure_points(u_prev, v_prev, u, v, stats);
+
+			std::cout << "Order " << order << ", method " << method << std::endl;
+			std::cout << " + max. difference (all iterations): " << error << std::endl;
+
+			if (error > 1e-12)
+				SWEETError("Fused and array-based departure points differ");
+
+			if (stats.num_iterations != (std::size_t)(order == 1 ? 0 : 10)*stats.num_points)
+				SWEETError("Wrong number of iterations");
+
+			if (order == 1)
+				continue;
+
+			/*
+			 * Early exit for each point
+			 */
+			simVars.disc.semi_lagrangian_convergence_threshold = 1e-10;
+
+			error = compare_departure_points(u_prev, v_prev, u, v, stats);
+
+			double avg_iterations = (double)stats.num_iterations/(double)stats.num_points;
+			std::cout << " + max. difference (early exit): " << error << std::endl;
+			std::cout << " + avg. iterations: " << avg_iterations << std::endl;
+			std::cout << " + max. iterations: " << stats.max_iterations << std::endl;
+			std::cout << " + unconverged points: " << stats.num_unconverged << std::endl;
+
+			if (error > 1e-9)
+				SWEETError("Fused and array-based departure points differ with early exit");
+
+			if (stats.num_unconverged != 0)
+				SWEETError("Departure points didn't converge");
+
+			if (!(avg_iterations < stats.max_iterations))
+				SWEETError("No early exit of departure points");
+		}
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * test_sphere_sl_interpolation_plan.cpp
+ *
+ *  Created on: 19 Oct 2026
+ *      Author: Martin Schreiber <schreiberx@gmail.com>
+ *
+ * MULE_SCONS_OPTIONS: --quadmath=disable
+ * MULE_SCONS_OPTIONS: --sphere-spectral-space=enable
+ *
+ * Compare the precomputed bicubic interpolation plan with the direct
+ * bicubic interpolation used for semi-Lagrangian methods
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/SWEETError.hpp>
+#include <sweet/ScalarDataArray.hpp>
+#include <sweet/sphere/SphereData_Config.hpp>
+#include <sweet/sphere/SphereData_Physical.hpp>
+#include <sweet/sphere/SphereOperators_Sampler_SphereDataPhysical.hpp>
+
+
+SimulationVariables simVars;
+
+SphereData_Config sphereDataConfigInstance;
+SphereData_Config *sphereDataConfig = &sphereDataConfigInstance;
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	if (simVars.disc.space_res_spectral[0] <= 0)
+	{
+		simVars.disc.space_res_spectral[0] = 64;
+		simVars.disc.space_res_spectral[1] = 64;
+	}
+
+	sphereDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	SphereOperators_Sampler_SphereDataPhysical sampler;
+	sampler.setup(sphereDataConfig);
+
+	SphereData_Physical data(sphereDataConfig);
+	data.physical_update_lambda(
+		[&](double lon, double lat, double &o_data)
+		{
+			o_data = std::cos(3.0*lon)*std::cos(lat)*std::cos(lat) + std::sin(2.0*lat) + 0.1*std::sin(lon);
+		}
+	);
+
+	/*
+	 * Random positions on the sphere including ones close to the poles
+	 */
+	std::size_t n = sphereDataConfig->physical_array_data_number_of_elements;
+	ScalarDataArray pos_lon(n), pos_lat(n);
+
+	std::srand(12345);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		double r0 = (double)std::rand()/(double)RAND_MAX;
+		double r1 = (double)std::rand()/(double)RAND_MAX;
+
+		pos_lon.scalar_data[i] = 2.0*M_PI*r0;
+		pos_lat.scalar_data[i] = std::asin(2.0*r1-1.0);
+
+		if (i % 10 == 0)
+			pos_lat.scalar_data[i] = (i % 20 == 0 ? 1 : -1)*(0.5*M_PI - 1e-3*r1);
+	}
+
+	ScalarDataArray values_direct(n), values_plan(n);
+
+	for (int pole_pseudo_points = 0; pole_pseudo_points < 2; pole_pseudo_points++)
+	{
+		SphereOperators_Sampler_SphereDataPhysical::BicubicPlan plan;
+		sampler.bicubic_plan_setup(pos_lon, pos_lat, pole_pseudo_points, plan);
+
+		if (plan.number_of_elements != n)
+			SWEETError("Wrong number of elements in plan");
+
+		for (int velocity_sampling = 0; velocity_sampling < 2; velocity_sampling++)
+		{
+			// not supported by sampler
+			if (pole_pseudo_points && velocity_sampling)
+				continue;
+
+			for (int limiter = 0; limiter < 2; limiter++)
+			{
+				sampler.bicubic_scalar(data, pos_lon, pos_lat, values_direct.scalar_data, velocity_sampling, pole_pseudo_points, limiter);
+
+				/*
+				 * Apply plan twice to make sure that it's reusable
+				 */
+				double max_error = 0;
+				for (int k = 0; k < 2; k++)
+				{
+					sampler.bicubic_plan_apply(plan, data, values_plan.scalar_data, velocity_sampling, limiter);
+
+					for (std::size_t i = 0; i < n; i++)
+						max_error = std::max(max_error, std::abs(values_direct.scalar_data[i] - values_plan.scalar_data[i]));
+				}
+
+				std::cout << "pole_pseudo_points=" << pole_pseudo_points;
+				std::cout << " velocity_sampling=" << velocity_sampling;
+				std::cout << " limiter=" << limiter;
+				std::cout << ": max. error " << max_error << std::endl;
+
+				if (max_error > 1e-13)
+					SWEETError("Interpolation plan and direct interpolation differ");
+			}
+		}
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -9,6 +9,12 @@
 #include <sweet/sphere/SphereData_Spectral.hpp>
 #include <sweet/sphere/SphereOperators_SphereData.hpp>
 #include <sweet/SWEETError.hpp>
+#include <array>
+#include <vector>
+
+#if SWEET_THREADING_SPACE
+	#include <omp.h>
+#endif
 
 
 
@@ -331,6 +337,208 @@ void run_tests()
 			if (div_max_error > eps)
 				SWEETError(" + ERROR! max error exceeds threshold");
 		}
+
+		if (true)
+		{
+			test_header("Testing diagonal operators (composition, fused axpy, hyperdiffusion)");
+
+			SphereData_Spectral h(sphereDataConfig);
+			SphereData_Physical h_phys(sphereDataConfig);
+			h_phys.physical_update_lambda_gaussian_grid(
+					[&](double a, double b, double &c){testSolutions.test_function__grid_gaussian(a,b,c);}
+			);
+			h.loadSphereDataPhysical(h_phys);
+
+			double scale = h.toPhys().physical_reduce_max_abs();
+
+			// inv_laplace(laplace(h)) == h without mean
+			SphereData_DiagonalOperator id = op.get_diag_inv_laplace()*op.get_diag_laplace();
+			SphereData_Spectral h_nomean = h;
+			h_nomean.spectral_set(0, 0, 0);
+
+			double error = (id(h) - h_nomean).toPhys().physical_reduce_max_abs()/scale;
+			std::cout << " + composition error: " << error << std::endl;
+			if (error > eps)
+				SWEETError(" + ERROR! max error exceeds threshold");
+
+			// y += alpha*D(x)
+			SphereData_Spectral y = h;
+			op.get_diag_laplace().apply_axpy(0.5, h, y);
+
+			error = (y - (h + 0.5*op.laplace(h))).toPhys().physical_reduce_max_abs()/(y.toPhys().physical_reduce_max_abs());
+			std::cout << " + axpy error: " << error << std::endl;
+			if (error > eps)
+				SWEETError(" + ERROR! max error exceeds threshold");
+
+			// Hyperdiffusion against Helmholtz solver
+			double coef = 1e-3;
+			for (int order = 2; order <= 8; order += 2)
+			{
+				std::array<double, 4> b = {0, 0, 0, 0};
+				b[order/2-1] = -coef;
+
+				SphereData_Spectral ref = h.spectral_solve_helmholtz_higher_order(1.0, b, simVars.sim.sphere_radius);
+				error = (op.implicit_hyperdiffusion(h, coef, order, simVars.sim.sphere_radius) - ref).toPhys().physical_reduce_max_abs()/scale;
+
+				std::cout << " + hyperdiffusion order " << order << " error: " << error << std::endl;
+				if (error > eps)
+					SWEETError(" + ERROR! max error exceeds threshold");
+			}
+
+#if SWEET_THREADING || SWEET_THREADING_SPACE
+			// Concurrent callers with different coefficients (e.g. thread groups of Parareal or XBraid)
+			int num_callers = 4;
+			std::vector<double> errors(num_callers);
+
+			DiagonalOperatorCache<std::vector<double>>::clear();
+
+#pragma omp parallel for num_threads(num_callers)
+			for (int i = 0; i < num_callers; i++)
+			{
+				std::array<double, 4> b = {0, 0, 0, 0};
+				b[1] = -coef*(i+1);
+
+				SphereData_Spectral ref = h.spectral_solve_helmholtz_higher_order(1.0, b, simVars.sim.sphere_radius);
+
+				errors[i] = 0;
+				for (int k = 0; k < 10; k++)
+					errors[i] = std::max(errors[i], (op.implicit_hyperdiffusion(h, coef*(i+1), 4, simVars.sim.sphere_radius) - ref).spectral_reduce_max_abs()/scale);
+			}
+
+			for (int i = 0; i < num_callers; i++)
+			{
+				std::cout << " + concurrent hyperdiffusion " << i << " error: " << errors[i] << std::endl;
+				if (errors[i] > eps)
+					SWEETError(" + ERROR! max error exceeds threshold");
+			}
+
+			// Operators of each caller are set up once and reused afterwards
+			std::size_t num_hits, num_misses;
+			DiagonalOperatorCache<std::vector<double>>::get_statistics(num_hits, num_misses);
+			std::cout << " + concurrent cache hits: " << num_hits << ", misses: " << num_misses << std::endl;
+			if (num_misses != 2*num_callers || num_hits != 9*num_callers)
+				SWEETError(" + ERROR! operators not reused by concurrent callers");
+#endif
+		}
+
+		if (true)
+		{
+			test_header("Testing spectral truncation and remapping without transformations");
+
+			SphereData_Physical h_phys(sphereDataConfig);
+			h_phys.physical_update_lambda_gaussian_grid(
+					[&](double a, double b, double &c){testSolutions.test_function__grid_gaussian(a,b,c);}
+			);
+			SphereData_Spectral h(h_phys);
+
+			// Add imaginary parts to m=0 modes which are not representable
+			SphereData_Spectral h_trunc = h;
+			for (int n = 0; n <= sphereDataConfig->spectral_modes_n_max; n++)
+				h_trunc.spectral_space_data[n] += std::complex<double>(0, 1.0);
+
+			h_trunc.spectral_truncate();
+
+			double error = (h_trunc - h).spectral_reduce_statistics().max_abs;
+			std::cout << " + truncation error: " << error << std::endl;
+			if (error > eps)
+				SWEETError(" + ERROR! max error exceeds threshold");
+
+			// Remapping to the same modes
+			error = (h.spectral_returnWithDifferentModes(sphereDataConfig) - h).spectral_reduce_statistics().max_abs;
+			std::cout << " + remapping error: " << error << std::endl;
+			if (error != 0)
+				SWEETError(" + ERROR! remapping to identical modes must be exact");
+
+			// Restriction (negative delta) and padding (positive delta) to different modes
+			for (int delta : {-8, -3, 3, 8})
+			{
+				int dst_modes[2] = {
+						sphereDataConfig->spectral_modes_m_max+1+delta,
+						sphereDataConfig->spectral_modes_n_max+1+delta
+				};
+
+				if (dst_modes[0] < 4 || dst_modes[1] < 4)
+					continue;
+
+				int dst_res_physical[2];
+				SphereData_Config sphereDataConfigDst;
+				sphereDataConfigDst.setupAutoPhysicalSpace(
+						dst_modes[0],
+						dst_modes[1],
+						&dst_res_physical[0],
+						&dst_res_physical[1],
+						simVars.misc.reuse_spectral_transformation_plans
+					);
+
+				SphereData_Spectral h_dst = h.spectral_returnWithDifferentModes(&sphereDataConfigDst);
+
+				// Shared modes must be identical, padded modes must be zero
+				error = 0;
+				for (int m = 0; m <= sphereDataConfigDst.spectral_modes_m_max; m++)
+				{
+					for (int n = m; n <= sphereDataConfigDst.spectral_modes_n_max; n++)
+					{
+						std::complex<double> expected = 0;
+						if (m <= sphereDataConfig->spectral_modes_m_max && n <= sphereDataConfig->spectral_modes_n_max)
+							expected = h.spectral_get_(n, m);
+
+						error = std::max(error, std::abs(h_dst.spectral_get_(n, m) - expected));
+					}
+				}
+
+				std::cout << " + remapping error (" << sphereDataConfig->spectral_modes_m_max << " -> " << sphereDataConfigDst.spectral_modes_m_max << "): " << error << std::endl;
+				if (error != 0)
+					SWEETError(" + ERROR! remapping must preserve shared modes and zero padded modes");
+
+				if (delta > 0)
+				{
+					// Padding followed by restriction must return the original data
+					error = (h_dst.spectral_returnWithDifferentModes(sphereDataConfig) - h).spectral_reduce_statistics().max_abs;
+					std::cout << " + padding/restriction error: " << error << std::endl;
+					if (error != 0)
+						SWEETError(" + ERROR! padding followed by restriction must be exact");
+				}
+			}
+		}
+
+		if (true)
+		{
+			test_header("Testing Gauss-weighted integral of fused reductions");
+
+			// integral over the unit sphere: 4*pi + 3*pi*2/3
+			SphereData_Physical h_phys(sphereDataConfig);
+			h_phys.physical_update_lambda(
+					[&](double i_lon, double i_lat, double &io_data)
+					{
+						io_data = 1.0 + 3.0*std::sin(i_lat)*std::sin(i_lat)*std::cos(i_lon)*std::cos(i_lon);
+					}
+			);
+
+			ReduceStatistics stats = h_phys.physical_reduce_statistics();
+
+			double error = std::abs(stats.integral - 6.0*M_PI);
+			std::cout << " + integral error: " << error << std::endl;
+			if (error > eps)
+				SWEETError(" + ERROR! max error exceeds threshold");
+
+			ReduceStatistics stats_det = h_phys.physical_reduce_statistics(true);
+
+			error = std::abs(stats_det.integral - stats.integral);
+			std::cout << " + deterministic integral error: " << error << std::endl;
+			if (error > eps)
+				SWEETError(" + ERROR! max error exceeds threshold");
+
+#if SWEET_THREADING_SPACE
+			int max_threads = omp_get_max_threads();
+			for (int num_threads : {1, 3})
+			{
+				omp_set_num_threads(num_threads);
+				if (h_phys.physical_reduce_statistics(true).integral != stats_det.integral)
+					SWEETError(" + ERROR! deterministic integral depends on number of threads");
+			}
+			omp_set_num_threads(max_threads);
+#endif
+		}
 	}
 };
 
@@ -0,0 +1,245 @@
+/*
+ * MULE_SCONS_OPTIONS: --plane-spectral-space=enable
+ *
+ * Test adaptive time stepping with embedded RK pairs
+ * based on the harmonic oscillator h_t = u, u_t = -h
+ */
+
+
+#include <sweet/plane/PlaneData_Spectral.hpp>
+#include <sweet/SimulationVariables.hpp>
+#include <sweet/plane/PlaneDataTimesteppingExplicitRK.hpp>
+#include <sweet/TimeStepSizeControllerPI.hpp>
+#include <sweet/SWEETError.hpp>
+
+#include <iostream>
+#include <cmath>
+
+// Plane data config
+PlaneDataConfig planeDataConfigInstance;
+PlaneDataConfig *planeDataConfig = &planeDataConfigInstance;
+
+SimulationVariables simVars;
+
+
+
+class SimulationTestEmbeddedRK
+{
+public:
+	PlaneData_Spectral prog_h;
+	PlaneData_Spectral prog_u;
+	PlaneData_Spectral prog_v;
+
+	PlaneDataTimesteppingExplicitRK timestepping;
+
+	int num_evaluations = 0;
+
+
+public:
+	SimulationTestEmbeddedRK()	:
+		prog_h(planeDataConfig),
+		prog_u(planeDataConfig),
+		prog_v(planeDataConfig)
+	{
+		PlaneData_Physical h_phys(planeDataConfig);
+		PlaneData_Physical zero_phys(planeDataConfig);
+
+		h_phys.physical_set_all_value(1.0);
+		zero_phys.physical_set_all_value(0);
+
+		prog_h.loadPlaneDataPhysical(h_phys);
+		prog_u.loadPlaneDataPhysical(zero_phys);
+		prog_v.loadPlaneDataPhysical(zero_phys);
+	}
+
+
+	void p_run_euler_timestep_update(
+			const PlaneData_Spectral &i_h,	///< prognostic variables
+			const PlaneData_Spectral &i_u,	///< prognostic variables
+			const PlaneData_Spectral &i_v,	///< prognostic variables
+
+			PlaneData_Spectral &o_h_t,	///< time updates
+			PlaneData_Spectral &o_u_t,	///< time updates
+			PlaneData_Spectral &o_v_t,	///< time updates
+
+			double i_current_timestamp = -1
+	)
+	{
+		o_h_t = i_u;
+		o_u_t = -i_h;
+		o_v_t = i_v*0.0;
+
+		num_evaluations++;
+	}
+
+
+	/*
+	 * Run until max simulation time and return the number of time steps
+	 *
+	 * Time steps are shortened to hit each output time exactly.
+	 */
+	int run(
+			int i_order,
+			double i_rtol,
+			double i_output_interval,
+			double &o_error
+	)
+	{
+		SimulationVariables::TimestepControl timecontrol = simVars.timecontrol;
+		timecontrol.current_simulation_time = 0;
+		timecontrol.current_timestep_size = timecontrol.setup_timestep_size;
+
+		double next_output_time = i_output_interval;
+		int num_outputs = 0;
+		int num_steps = 0;
+
+		while (timecontrol.current_simulation_time < timecontrol.max_simulation_time)
+		{
+			timecontrol.adaptive_setup_timestep_size(next_output_time);
+
+			double dt = timecontrol.current_timestep_size;
+			double dt_next;
+
+			timestepping.run_timestep_adaptive(
+					this,
+					&SimulationTestEmbeddedRK::p_run_euler_timestep_update,
+					prog_h, prog_u, prog_v,
+					dt, dt_next,
+					i_order,
+					0, i_rtol,
+					0, std::numeric_limits<double>::infinity(),
+					timecontrol.current_simulation_time
+				);
+
+			timecontrol.current_timestep_size = dt;
+			timecontrol.adaptive_next_timestep_size = dt_next;
+
+			timecontrol.current_simulation_time += dt;
+			timecontrol.adaptive_finish_timestep();
+
+			if (timecontrol.current_simulation_time > next_output_time)
+				SWEETError("Output time skipped");
+
+			if (timecontrol.current_simulation_time == next_output_time)
+			{
+				num_outputs++;
+				next_output_time += i_output_interval;
+			}
+
+			num_steps++;
+		}
+
+		if (timecontrol.current_simulation_time != timecontrol.max_simulation_time)
+			SWEETError("Max simulation time not hit exactly");
+
+		if (num_outputs != (int)(timecontrol.max_simulation_time/i_output_interval))
+			SWEETError("Wrong number of outputs");
+
+		double t = timecontrol.current_simulation_time;
+
+		PlaneData_Physical h_phys = prog_h.toPhys();
+		o_error = std::abs(h_phys.physical_get(0, 0) - std::cos(t));
+
+		return num_steps;
+	}
+};
+
+
+
+/*
+ * Deterministic checks of the PI controller
+ */
+void test_controller()
+{
+	TimeStepSizeControllerPI controller;
+	controller.setup(4);
+
+	double dt_next;
+
+	// Small growth factor: keep time step size bitwise identical
+	if (!controller.propose(0.1, 0.2, dt_next))
+		SWEETError("Step with err < 1 rejected");
+
+	if (dt_next != 0.1)
+		SWEETError("Time step size should be kept unchanged");
+
+	// Large error: reject and reduce time step size
+	if (controller.propose(0.1, 10.0, dt_next))
+		SWEETError("Step with err > 1 accepted");
+
+	if (dt_next >= 0.1)
+		SWEETError("Time step size should be reduced after rejection");
+
+	// Tiny error directly after rejection: no growth
+	if (!controller.propose(dt_next, 1e-6, dt_next))
+		SWEETError("Step with err < 1 rejected");
+
+	if (dt_next > 0.1*0.9)
+		SWEETError("Time step size should not grow directly after a rejection");
+
+	// Tiny error: growth limited by factor_max
+	double dt = dt_next;
+	controller.propose(dt, 1e-6, dt_next);
+	if (dt_next <= dt*controller.keep_factor_max || dt_next > dt*controller.factor_max*(1.0+1e-14))
+		SWEETError("Invalid time step size growth");
+
+	std::cout << "PI controller: OK" << std::endl;
+}
+
+
+
+int main(
+		int i_argc,
+		char *const i_argv[]
+)
+{
+	if (!simVars.setupFromMainParameters(i_argc, i_argv, nullptr, false))
+		return -1;
+
+	if (simVars.timecontrol.setup_timestep_size <= 0)
+		SWEETError("Timestep size <= 0!");
+
+	if (simVars.timecontrol.max_simulation_time == std::numeric_limits<double>::infinity())
+		SWEETError("Max. simulation time is unlimited, please specify e.g. -t 10");
+
+	if (simVars.disc.space_res_physical[0] <= 0)
+		simVars.disc.space_res_physical[0] = 16;
+	if (simVars.disc.space_res_physical[1] <= 0)
+		simVars.disc.space_res_physical[1] = 16;
+
+	planeDataConfigInstance.setupAuto(simVars.disc.space_res_physical, simVars.disc.space_res_spectral, simVars.misc.reuse_spectral_transformation_plans);
+
+	test_controller();
+
+	for (int order : {3, 5})
+	{
+		int prev_num_steps = 0;
+
+		for (double rtol : {1e-4, 1e-6, 1e-8})
+		{
+			SimulationTestEmbeddedRK sim;
+
+			double error;
+			int num_steps = sim.run(order, rtol, 0.7, error);
+
+			std::cout << "order " << order << ", rtol " << rtol << ": " << num_steps << " steps, ";
+			std::cout << sim.num_evaluations << " evaluations, error " << error << std::endl;
+
+			/*
+			 * The global error is not strictly bounded by the tolerance
+			 * but should be of the same magnitude times the integration time
+			 */
+			if (error > 10.0*rtol*simVars.timecontrol.max_simulation_time)
+				SWEETError("Error too large for given tolerance");
+
+			if (num_steps < prev_num_steps)
+				SWEETError("Tighter tolerance should not result in fewer time steps");
+
+			prev_num_steps = num_steps;
+		}
+	}
+
+	std::cout << "All tests successful" << std::endl;
+
+	return 0;
+}
@@ -16,6 +16,7 @@
 #include <unistd.h>
 #include <iomanip>
 #include <stdio.h>
+#include <cmath>
 
 // Plane data config
 PlaneDataConfig planeDataConfigInstance;
@@ -316,7 +317,8 @@ int main(
 	{
 		time_test_function_order = fun_order;
 
-		for (int ts_order = 1; ts_order <= 4; ts_order++)
+		// Negative orders: low-storage RK methods
+		for (int ts_order : {1, 2, 3, 4, -3, -4})
 		{
 			timestepping_runge_kutta_order = ts_order;
 
@@ -349,7 +351,7 @@ int main(
 					double error = (simulationTestRK->prog_h.toPhys()-benchmark_h_phys).physical_reduce_rms_quad();
 					std::cout << "with function order " << fun_order << " with RK timestepping of order " << ts_order << " resulted in RMS error " << error << "\t\t" << std::flush;
 
-					if (fun_order <= ts_order)
+					if (fun_order <= std::abs(ts_order))
 					{
 						if (error > 1e-8)
 						{
@@ -101,6 +101,11 @@ for function_name in function_name_list:
                 jg.runtime.rexi_files_coefficients = [coeffs]
                 jg.gen_jobscript_directory()
 
+                # Only solve for one pole of each conjugate pair
+                jg.runtime.rexi_conjugate_pairs = 1
+                jg.gen_jobscript_directory()
+                jg.runtime.rexi_conjugate_pairs = None
+
                 if True:
                     # Validate with C-implementation of CI-REXI method
                     jg.runtime.rexi_method = "ci"
@@ -231,6 +231,32 @@ if simulation_to_run == "xbraid":
             jg.runtime.parareal_coarse_slices = int(jg.runtime.max_simulation_time / (timestep_size_fine * cfactor) );
             jg.gen_jobscript_directory();
 
+    ## xbraid with different numbers of thread groups
+    elif (itest == 7):
+
+        jg.compile.threading = 'omp'
+        jg.runtime.xbraid_max_levels = 2
+        jg.runtime.xbraid_cfactor = 4
+        jg.runtime.xbraid_use_rand = 0
+        jg.runtime.xbraid_store_iterations = 1;
+        jg.runtime.xbraid_access_level = 2;
+
+        pspace = JobParallelizationDimOptions('space')
+        pspace.num_cores_per_rank = 1
+        pspace.num_threads_per_rank = jg.platform_resources.num_cores_per_socket
+        pspace.num_ranks = 1
+
+        ptime = JobParallelizationDimOptions('time')
+        ptime.num_cores_per_rank = 1
+        ptime.num_threads_per_rank = 1
+        ptime.num_ranks = 1
+
+        jg.setup_parallelization([pspace, ptime], override_insufficient_resources=True)
+
+        for thread_groups in [1, 2, 4]:
+            jg.runtime.xbraid_thread_groups = thread_groups
+            jg.gen_jobscript_directory()
+
     if (itest < 5):
         jg.gen_jobscript_directory();
 
@@ -0,0 +1,46 @@
+#! /usr/bin/env python3
+
+import sys
+import os
+
+from mule.postprocessing.JobsData import *
+
+from glob import glob
+
+
+## get number of thread groups of each job in this directory
+jd = JobsData('./job_bench_*', verbosity=0).get_flattened_data();
+
+thread_groups = {};
+for key in jd.keys():
+    path = os.path.basename(jd[key]["jobgeneration.p_job_dirpath"]);
+    thread_groups[path] = int(jd[key]["runtime.xbraid_thread_groups"]);
+
+## simulation with a single thread group
+list_ref = [job for job in thread_groups.keys() if thread_groups[job] == 1];
+assert len(list_ref) == 1;
+ref_job = list_ref[0];
+assert len(thread_groups) > 1;
+
+ref_files = sorted([os.path.basename(f) for f in glob(ref_job + "/output_*csv")]);
+assert len(ref_files) > 0;
+
+for job in sorted(thread_groups.keys()):
+
+    if job == ref_job:
+        continue;
+
+    print(" ** Comparing {} thread groups to a single one".format(thread_groups[job]));
+
+    files = sorted([os.path.basename(f) for f in glob(job + "/output_*csv")]);
+    if files != ref_files:
+        print("ERROR: Different output files");
+        sys.exit(1);
+
+    ## results have to be bitwise identical
+    for f in ref_files:
+        if open(ref_job + "/" + f, "rb").read() != open(job + "/" + f, "rb").read():
+            print("ERROR: Different results in " + f);
+            sys.exit(1);
+
+    print(" *** {} output files identical".format(len(files)));
@@ -11,6 +11,7 @@
 ###############
 ## Additional tests:
 ## itest = 6: check if parareal and xbraid with specific configurations provide identical results
+## itest = 7: check if xbraid provides identical results with 1 and more thread groups
 ###############
 
 
@@ -44,7 +45,7 @@ mkdir $dirname_offline_error;
 
 echo ""
 
-for itest in {-1..6};do
+for itest in {-1..7};do
 	echo "*********************";
 	echo "Running debug test" $itest;
 	echo "*********************";
@@ -66,6 +67,8 @@ for itest in {-1..6};do
 		echo "Misc. multilevel tests"
 	elif [ "$itest" == 6 ]; then
 		echo "Compare parareal and xbraid"
+	elif [ "$itest" == 7 ]; then
+		echo "Compare xbraid with 1 and more thread groups"
 	fi;
 	echo "";
 
@@ -244,6 +247,12 @@ for itest in {-1..6};do
 			./compare_parareal_xbraid_errors.py . $fine_sim 1
 		done;
 
+	elif [ "$itest" == 7 ]; then
+		./benchmarks_create.py xbraid $itest $tsm_fine $tsm_coarse 1 > tmp_job_benchmark_create_dummy.txt || exit 1
+		mule.benchmark.jobs_run_directly || exit 1
+		./compare_thread_groups.py || exit 1
+		mule.benchmark.cleanup_job_dirs || exit 1
+
 	fi;
 
 
@@ -0,0 +1,110 @@
+#! /usr/bin/env python3
+#
+#  Create Parareal jobs which only differ in the parallelization
+#
+#  Usage: ./benchmarks_create.py [slice_distribution|thread_groups]
+#
+#-------------------------------------------------------
+
+import os
+import sys
+
+#Classes containing sweet compile/run basic option
+from mule.JobGeneration import *
+from mule.SWEETRuntimeParametersScenarios import *
+from mule.JobParallelization import *
+from mule.JobParallelizationDimOptions import *
+
+
+parallelization = sys.argv[1];
+
+#Create main compile/run options
+jg = JobGeneration()
+
+jg.compile.program = "parareal_ode"
+jg.compile.mode = "debug"
+
+# Verbosity mode
+jg.runtime.verbosity = 3
+
+jg.compile.sphere_spectral_space = "enable";
+jg.compile.sphere_spectral_dealiasing = "enable";
+
+jg.runtime.benchmark_name = "unstablejet"
+
+jg.runtime.compute_error = 0
+
+jg = DisableGUI(jg)
+
+jg.runtime.rexi_method = 'direct'
+
+jg = RuntimeSWEPlaneEarthParam(jg)
+
+jg.runtime.viscosity = 0.0
+
+#
+# Time, Mode and Physical resolution
+#
+jg.runtime.max_simulation_time = 1.
+jg.runtime.output_timestep_size = .1
+jg.runtime.timestep_size = 0.005
+jg.runtime.space_res_spectral = 32
+
+## Parareal parameters
+jg.runtime.parareal_enabled = 1
+jg.runtime.parareal_convergence_threshold = -1
+jg.runtime.parareal_verbosity = 6
+jg.runtime.parareal_max_simulation_time = jg.runtime.max_simulation_time;
+jg.runtime.parareal_coarse_slices = 12;
+jg.runtime.parareal_coarse_timestep_size = 0.05;
+jg.runtime.parareal_store_iterations = 1;
+
+
+if parallelization == "slice_distribution":
+
+    ## Parareal with 3 MPI ranks in time
+    jg.compile.sweet_mpi = "enable"
+    jg.compile.parareal = "mpi";
+    jg.compile.threading = 'off'
+
+    pspace = JobParallelizationDimOptions('space')
+    pspace.num_cores_per_rank = 1
+    pspace.num_threads_per_rank = 1
+    pspace.num_ranks = 1
+
+    ptime = JobParallelizationDimOptions('time')
+    ptime.num_cores_per_rank = 1
+    ptime.num_threads_per_rank = 1
+    ptime.num_ranks = 3
+
+    jg.setup_parallelization([pspace, ptime], override_insufficient_resources=True)
+
+    for slice_distribution in ["block", "cyclic", "rebalance"]:
+        jg.runtime.parareal_slice_distribution = slice_distribution
+        jg.gen_jobscript_directory()
+
+elif parallelization == "thread_groups":
+
+    ## serial Parareal with concurrent fine time stepping in thread groups
+    jg.compile.parareal = "serial";
+    jg.compile.threading = 'omp'
+
+    pspace = JobParallelizationDimOptions('space')
+    pspace.num_cores_per_rank = 1
+    pspace.num_threads_per_rank = jg.platform_resources.num_cores_per_socket
+    pspace.num_ranks = 1
+
+    ptime = JobParallelizationDimOptions('time')
+    ptime.num_cores_per_rank = 1
+    ptime.num_threads_per_rank = 1
+    ptime.num_ranks = 1
+
+    jg.setup_parallelization([pspace, ptime], override_insufficient_resources=True)
+
+    for thread_groups in [1, 2, 4]:
+        jg.runtime.parareal_thread_groups = thread_groups
+        jg.gen_jobscript_directory()
+
+else:
+    print("Unknown parallelization " + parallelization);
+    sys.exit(1);
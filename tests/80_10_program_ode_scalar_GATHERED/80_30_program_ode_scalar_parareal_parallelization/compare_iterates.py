@@ -0,0 +1,49 @@
+#! /usr/bin/env python3
+#
+#  Check if the Parareal iterates of all jobs are bitwise identical
+#
+#  Usage: ./compare_iterates.py runtime.parameter_which_differs
+#
+#-------------------------------------------------------
+
+import sys
+import os
+
+from mule.postprocessing.JobsData import *
+
+from glob import glob
+
+
+param = sys.argv[1];
+
+jd = JobsData('./job_bench_*', verbosity=0).get_flattened_data();
+
+jobs = {};
+for key in jd.keys():
+    path = os.path.basename(jd[key]["jobgeneration.p_job_dirpath"]);
+    jobs[path] = jd[key][param];
+
+assert len(jobs) > 1;
+
+list_jobs = sorted(jobs.keys());
+ref_job = list_jobs[0];
+
+## all iterations are stored
+ref_files = sorted([os.path.basename(f) for f in glob(ref_job + "/output_*_iter*.csv")]);
+assert len(ref_files) > 0;
+
+for job in list_jobs[1:]:
+
+    print(" ** Comparing {} = {} to {}".format(param, jobs[job], jobs[ref_job]));
+
+    files = sorted([os.path.basename(f) for f in glob(job + "/output_*_iter*.csv")]);
+    if files != ref_files:
+        print("ERROR: Different output files");
+        sys.exit(1);
+
+    for f in ref_files:
+        if open(ref_job + "/" + f, "rb").read() != open(job + "/" + f, "rb").read():
+            print("ERROR: Different iterates in " + f);
+            sys.exit(1);
+
+    print(" *** {} iterates identical".format(len(files)));
@@ -0,0 +1,35 @@
+#! /bin/bash
+
+###############
+## Parareal iterates have to be bitwise identical for different parallelizations
+## slice_distribution: block, cyclic and rebalance distribution of the time slices to the MPI ranks
+## thread_groups: fine time stepping in 1, 2 and 4 thread groups
+###############
+
+cd "$(dirname $0)"
+
+set -e
+
+echo_info "Cleaning up..."
+mule.benchmark.cleanup_all || exit 1
+
+echo ""
+
+echo_info "---> Running Parareal with different distributions of time slices"
+./benchmarks_create.py slice_distribution > tmp_job_benchmark_create_dummy.txt || exit 1
+mule.benchmark.jobs_run_directly || exit 1
+./compare_iterates.py runtime.parareal_slice_distribution || exit 1
+mule.benchmark.cleanup_job_dirs || exit 1
+
+echo_info "---> Running Parareal with different numbers of thread groups"
+./benchmarks_create.py thread_groups > tmp_job_benchmark_create_dummy.txt || exit 1
+mule.benchmark.jobs_run_directly || exit 1
+./compare_iterates.py runtime.parareal_thread_groups || exit 1
+mule.benchmark.cleanup_job_dirs || exit 1
+
+rm -f tmp_job_benchmark_create_dummy.txt
+
+mule.benchmark.cleanup_all || exit 1
+
+echo ""
+echo_info "Test successful!"
@@ -0,0 +1,114 @@
+#! /usr/bin/env python3
+
+import os
+import sys
+
+from mule.JobMule import *
+from mule.utils import exec_program
+from mule.InfoError import *
+
+jg = JobGeneration()
+
+
+"""
+Compile parameters
+"""
+jg.compile.program = 'swe_sphere'
+
+jg.compile.plane_spectral_space = 'disable'
+jg.compile.plane_spectral_dealiasing = 'disable'
+jg.compile.sphere_spectral_space = 'enable'
+jg.compile.sphere_spectral_dealiasing = 'enable'
+
+jg.compile.mode = 'release'
+jg.compile.threading = 'omp'
+jg.compile.rexi_thread_parallel_sum = 'disable'
+jg.compile.quadmath = 'disable'
+
+# Breakdown of timings
+jg.compile.benchmark_timings = 'enable'
+
+jg.unique_id_filter = ['compile', 'parallelization', 'benchmark', 'runtime.rexi_params']
+
+
+"""
+Runtime parameters
+
+These are fixed configurations to compare timings with a baseline.
+Don't change them without updating the baselines.
+"""
+jg.runtime.benchmark_name = 'galewsky'
+
+jg.runtime.space_res_spectral = 128
+jg.runtime.space_res_physical = None
+
+jg.runtime.compute_error = 0
+jg.runtime.instability_checks = 0
+jg.runtime.verbosity = 2
+
+jg.runtime.rexi_method = ''
+jg.runtime.rexi_ci_n = 128
+jg.runtime.rexi_ci_max_real = 10
+jg.runtime.rexi_ci_max_imag = 10
+jg.runtime.rexi_ci_mu = 0
+jg.runtime.rexi_ci_primitive = 'circle'
+jg.runtime.rexi_sphere_preallocation = 1
+
+# no output of fields to only measure time stepping
+jg.runtime.output_timestep_size = None
+jg.runtime.output_filename = "-"
+
+
+"""
+Parallelization parameters
+"""
+pspace = JobParallelizationDimOptions('space')
+pspace.num_cores_per_rank = jg.platform_resources.num_cores_per_socket
+pspace.num_threads_per_rank = jg.platform_resources.num_cores_per_socket
+pspace.num_ranks = 1
+
+if pspace.num_threads_per_rank == 0:
+    pspace.num_cores_per_rank = 1
+    pspace.num_threads_per_rank = 1
+
+jg.setup_parallelization([pspace])
+
+
+# [method, order, order2, timestep size, number of time steps]
+ts_methods = [
+    ['ln_erk',                          4,    4,    60,     100],
+    ['lg_exp_lc_n_etdrk',               2,    2,    300,    20],
+    ['l_irk_na_sl_nr_settls_uv_only',   2,    2,    600,    20],
+]
+
+
+# Each configuration is executed several times in separate jobs
+# and compared with the minimum to reduce the impact of noise
+num_repetitions = int(os.environ.get('SWEET_PERFORMANCE_REPETITIONS', 3))
+
+def gen_jobscript_directories():
+    for r in range(num_repetitions):
+        jg.gen_jobscript_directory(jg.get_jobscript_directory()+'_rep'+str(r))
+
+
+
+#
+# allow including this file
+#
+if __name__ == "__main__":
+
+    for tsm in ts_methods:
+
+        jg.runtime.timestepping_method = tsm[0]
+        jg.runtime.timestepping_order = tsm[1]
+        jg.runtime.timestepping_order2 = tsm[2]
+        jg.runtime.timestep_size = tsm[3]
+        jg.runtime.max_simulation_time = tsm[3]*tsm[4]
+
+        if 'exp' in jg.runtime.timestepping_method:
+            jg.runtime.rexi_method = 'ci'
+            gen_jobscript_directories()
+            jg.runtime.rexi_method = ''
+
+        else:
+            gen_jobscript_directories()
@@ -0,0 +1,20 @@
+#! /usr/bin/env python3
+
+import sys
+
+from mule.postprocessing.PerformanceBaseline import *
+
+
+p = PerformanceBaseline('./job_bench_*')
+
+result = p.compare()
+
+if result == PerformanceBaseline.FAILED:
+    print("FAILED")
+    sys.exit(1)
+
+if result == PerformanceBaseline.SKIPPED:
+    print("Tests skipped")
+    sys.exit(0)
+
+print("Tests successful")
@@ -3,7 +3,8 @@
 cd "$(dirname $0)"
 
 if [[ -z "$1" ]]; then
-	TESTS=$(ls -1d ??_*/ ??_??_*/)
+	# Performance tests are only executed if explicitly requested
+	TESTS=$(ls -1d ??_*/ ??_??_*/ | grep -v "^9[0-9]_performance")
 else
 	TESTS=$@
 fi